@@ -0,0 +1,382 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "metavision/hal/decoders/aer/aer_decoder.h"
+#include "metavision/hal/decoders/evt2/evt2_decoder.h"
+#include "metavision/hal/decoders/evt21/evt21_decoder.h"
+#include "metavision/hal/decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/decoders/evt4/evt4_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
+#include "metavision/sdk/base/events/event_erc_counter.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/events/event_monitoring.h"
+#include "synthetic_raw_streams.h"
+
+using namespace Metavision;
+using namespace Metavision::benchmarks;
+
+namespace {
+
+// Size of the buffers handed to the decoders, in the range of what the cameras produce
+constexpr std::size_t kDecodeChunkBytes = 1 << 16;
+
+// Geometry of the synthetic streams, AER sensors being limited to 9 bits coordinates
+constexpr int kWidth     = 1280;
+constexpr int kHeight    = 720;
+constexpr int kAERWidth  = 320;
+constexpr int kAERHeight = 320;
+
+// Monitoring subtypes ignored by the decoders of the devices, see make_decoder
+const std::set<uint16_t> kMonitoringIdBlacklist = {0x0000, 0x0001, 0x0002, 0x0003, 0x0004,
+                                                   0x0005, 0x0006, 0x0007, 0x0008, 0x0009};
+
+/// @brief Counts the events output by a decoder, through the same facilities as the ones used by the devices
+class EventCounter {
+public:
+    EventCounter() {
+        count_buffers(*cd_decoder);
+        count_buffers(*ext_trigger_decoder);
+        count_buffers(*erc_counter_decoder);
+        count_buffers(*monitoring_decoder);
+        cd_vector_decoder->add_event_buffer_callback([this](const EventCDVector *begin, const EventCDVector *end) {
+            for (auto it = begin; it != end; ++it) {
+                count_ += std::bitset<32>(it->vector_mask).count();
+            }
+        });
+    }
+
+    EventCounter(const EventCounter &)            = delete;
+    EventCounter &operator=(const EventCounter &) = delete;
+
+    std::uint64_t count() const {
+        return count_;
+    }
+
+    const std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    const std::shared_ptr<I_EventDecoder<EventCDVector>> cd_vector_decoder =
+        std::make_shared<I_EventDecoder<EventCDVector>>();
+    const std::shared_ptr<I_EventDecoder<EventExtTrigger>> ext_trigger_decoder =
+        std::make_shared<I_EventDecoder<EventExtTrigger>>();
+    const std::shared_ptr<I_EventDecoder<EventERCCounter>> erc_counter_decoder =
+        std::make_shared<I_EventDecoder<EventERCCounter>>();
+    const std::shared_ptr<I_EventDecoder<EventMonitoring>> monitoring_decoder =
+        std::make_shared<I_EventDecoder<EventMonitoring>>();
+
+private:
+    template<typename Event>
+    void count_buffers(I_EventDecoder<Event> &decoder) {
+        decoder.add_event_buffer_callback([this](const Event *begin, const Event *end) { count_ += end - begin; });
+    }
+
+    std::uint64_t count_ = 0;
+};
+
+using DecoderFactory =
+    std::function<std::unique_ptr<I_EventsStreamDecoder>(const EventCounter &counter, int width, int height)>;
+
+struct DecoderSpec {
+    std::string name;
+    std::string format;
+    DecoderFactory make;
+};
+
+template<typename Decoder>
+DecoderSpec make_evt3_spec(const std::string &name) {
+    return {name, "EVT3", [](const EventCounter &c, int width, int height) {
+                return std::make_unique<Decoder>(true, height, width, c.cd_decoder, c.ext_trigger_decoder,
+                                                 c.erc_counter_decoder, c.monitoring_decoder, kMonitoringIdBlacklist);
+            }};
+}
+
+template<typename Decoder>
+DecoderSpec make_evt4_spec(const std::string &name) {
+    return {name, "EVT4", [](const EventCounter &c, int width, int height) {
+                return std::make_unique<Decoder>(true, width, height, c.cd_decoder, c.ext_trigger_decoder,
+                                                 c.erc_counter_decoder);
+            }};
+}
+
+const std::vector<DecoderSpec> &decoder_specs() {
+    static const std::vector<DecoderSpec> specs = {
+        {"EVT2Decoder", "EVT2",
+         [](const EventCounter &c, int, int) {
+             return std::make_unique<EVT2Decoder>(true, c.cd_decoder, c.ext_trigger_decoder, c.erc_counter_decoder,
+                                                  c.monitoring_decoder, kMonitoringIdBlacklist);
+         }},
+        {"EVT21Decoder", "EVT21",
+         [](const EventCounter &c, int, int) {
+             return std::make_unique<EVT21Decoder>(true, c.cd_decoder, c.ext_trigger_decoder, c.erc_counter_decoder,
+                                                   c.monitoring_decoder, kMonitoringIdBlacklist);
+         }},
+        {"EVT21VectorizedDecoder", "EVT21",
+         [](const EventCounter &c, int, int) {
+             return std::make_unique<EVT21VectorizedDecoder>(true, c.cd_vector_decoder, c.ext_trigger_decoder,
+                                                             c.erc_counter_decoder, c.monitoring_decoder,
+                                                             kMonitoringIdBlacklist);
+         }},
+        make_evt3_spec<EVT3Decoder>("EVT3Decoder"),
+        make_evt3_spec<UnsafeEVT3Decoder>("UnsafeEVT3Decoder"),
+        make_evt3_spec<RobustEVT3Decoder>("RobustEVT3Decoder"),
+        {"EVT3Decoder<cd_only>", "EVT3",
+         [](const EventCounter &c, int width, int height) {
+             return make_evt3_decoder(true, height, width, c.cd_decoder);
+         }},
+        make_evt4_spec<EVT4Decoder>("EVT4Decoder"),
+        make_evt4_spec<UnsafeEVT4Decoder>("UnsafeEVT4Decoder"),
+        make_evt4_spec<RobustEVT4Decoder>("RobustEVT4Decoder"),
+        {"EVT4VectorizedDecoder", "EVT4",
+         [](const EventCounter &c, int width, int height) {
+             return std::make_unique<EVT4VectorizedDecoder>(true, width, height, c.cd_vector_decoder,
+                                                            c.ext_trigger_decoder, c.erc_counter_decoder);
+         }},
+        {"AERDecoder<false>", "AER-8b",
+         [](const EventCounter &c, int, int) { return std::make_unique<AERDecoder<false>>(true, c.cd_decoder); }},
+        {"AERDecoder<true>", "AER-4b",
+         [](const EventCounter &c, int, int) { return std::make_unique<AERDecoder<true>>(true, c.cd_decoder); }},
+    };
+    return specs;
+}
+
+bool is_aer(const std::string &format) {
+    return format.rfind("AER", 0) == 0;
+}
+
+struct RawStream {
+    std::string format;
+    int width;
+    int height;
+    std::vector<std::uint8_t> data;
+};
+
+/// @brief Returns the synthetic stream of the given format and parameters, generating it on first use
+std::shared_ptr<const RawStream> get_synthetic_stream(const std::string &format, const StreamParams &params) {
+    static std::map<std::tuple<std::string, StreamProfile, double>, std::shared_ptr<const RawStream>> cache;
+
+    auto &stream = cache[std::make_tuple(format, params.profile, params.events_per_us)];
+    if (!stream) {
+        const auto events = generate_events(params);
+        auto new_stream   = std::make_shared<RawStream>(RawStream{format, params.width, params.height, {}});
+        if (format == "EVT2") {
+            new_stream->data = encode_evt2(events);
+        } else if (format == "EVT21") {
+            new_stream->data = encode_evt21(events);
+        } else if (format == "EVT3") {
+            new_stream->data = encode_evt3(events);
+        } else if (format == "EVT4") {
+            new_stream->data = encode_evt4(events);
+        } else {
+            new_stream->data = encode_aer(events, format == "AER-4b");
+        }
+        stream = new_stream;
+    }
+    return stream;
+}
+
+/// @brief Reads the header and at most @p max_bytes of data of a RAW file
+std::shared_ptr<const RawStream> load_raw_file(const std::string &path, std::size_t max_bytes) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("Unable to open RAW file " + path);
+    }
+
+    // The format field looks like "EVT3;height=720;width=1280"
+    const RawFileHeader header(ifs);
+    std::istringstream format_iss(header.get_field("format"));
+    auto stream = std::make_shared<RawStream>(RawStream{"", 0, 0, {}});
+    std::getline(format_iss, stream->format, ';');
+    for (std::string option; std::getline(format_iss, option, ';');) {
+        const auto sep = option.find('=');
+        if (sep == std::string::npos) {
+            continue;
+        }
+        const auto key = option.substr(0, sep);
+        if (key == "width") {
+            stream->width = std::stoi(option.substr(sep + 1));
+        } else if (key == "height") {
+            stream->height = std::stoi(option.substr(sep + 1));
+        }
+    }
+    if (stream->format.empty() || (!is_aer(stream->format) && (stream->width <= 0 || stream->height <= 0))) {
+        throw std::runtime_error("Unable to get the format and geometry of RAW file " + path +
+                                 ", files recorded with older versions are not supported");
+    }
+
+    stream->data.resize(max_bytes);
+    ifs.read(reinterpret_cast<char *>(stream->data.data()), max_bytes);
+    stream->data.resize(ifs.gcount());
+    if (stream->data.empty()) {
+        throw std::runtime_error("RAW file " + path + " has no event data");
+    }
+    return stream;
+}
+
+void decode_stream(benchmark::State &state, const DecoderSpec &spec,
+                   const std::function<std::shared_ptr<const RawStream>()> &get_stream) {
+    const auto stream = get_stream();
+
+    std::unique_ptr<EventCounter> counter;
+    std::unique_ptr<I_EventsStreamDecoder> decoder;
+    std::uint64_t num_events = 0;
+    for (auto _ : state) {
+        // A new decoder is used for each pass so that it always sees a consistent stream
+        state.PauseTiming();
+        decoder.reset();
+        counter = std::make_unique<EventCounter>();
+        decoder = spec.make(*counter, stream->width, stream->height);
+        state.ResumeTiming();
+
+        const auto *const end = stream->data.data() + stream->data.size();
+        for (const auto *it = stream->data.data(); it != end;) {
+            const auto *const chunk_end = it + std::min<std::size_t>(kDecodeChunkBytes, end - it);
+            decoder->decode(it, chunk_end);
+            it = chunk_end;
+        }
+        num_events = counter->count();
+    }
+
+    if (num_events == 0) {
+        state.SkipWithError("No event decoded, the stream does not match the decoder");
+        return;
+    }
+
+    const auto num_iterations = static_cast<std::int64_t>(state.iterations());
+    state.SetBytesProcessed(num_iterations * static_cast<std::int64_t>(stream->data.size()));
+    state.SetItemsProcessed(num_iterations * static_cast<std::int64_t>(num_events));
+    state.counters["events"]   = static_cast<double>(num_events);
+    state.counters["Mev/s"]    = benchmark::Counter(num_events * 1e-6, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["ns/event"] = benchmark::Counter(
+        num_events * 1e-9, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+void register_synthetic_benchmarks(std::size_t num_cd_events) {
+    const StreamProfile profiles[]   = {StreamProfile::Sparse, StreamProfile::VectorizedBursts,
+                                        StreamProfile::TriggerHeavy, StreamProfile::MonitoringHeavy};
+    const double events_per_us_list[] = {0.1, 1., 10.};
+
+    for (const auto &spec : decoder_specs()) {
+        for (const auto profile : profiles) {
+            // AER streams only carry CD events
+            if (is_aer(spec.format) &&
+                (profile == StreamProfile::TriggerHeavy || profile == StreamProfile::MonitoringHeavy)) {
+                continue;
+            }
+            for (const auto events_per_us : events_per_us_list) {
+                StreamParams params;
+                params.profile       = profile;
+                params.num_cd_events = num_cd_events;
+                params.events_per_us = events_per_us;
+                params.width         = is_aer(spec.format) ? kAERWidth : kWidth;
+                params.height        = is_aer(spec.format) ? kAERHeight : kHeight;
+
+                std::ostringstream name;
+                name << spec.name << "/" << to_string(profile) << "/events_per_us:" << events_per_us;
+                benchmark::RegisterBenchmark(name.str().c_str(), [spec, params](benchmark::State &state) {
+                    decode_stream(state, spec, [&]() { return get_synthetic_stream(spec.format, params); });
+                })->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+}
+
+void register_raw_file_benchmarks(const std::string &path, std::size_t max_bytes) {
+    const auto stream = load_raw_file(path, max_bytes);
+
+    bool has_decoder = false;
+    for (const auto &spec : decoder_specs()) {
+        if (spec.format != stream->format) {
+            continue;
+        }
+        has_decoder = true;
+
+        const auto name = spec.name + "/raw:" + path;
+        benchmark::RegisterBenchmark(name.c_str(), [spec, stream](benchmark::State &state) {
+            decode_stream(state, spec, [&]() { return stream; });
+        })->Unit(benchmark::kMillisecond);
+    }
+    if (!has_decoder) {
+        throw std::runtime_error("No decoder to benchmark for format " + stream->format + " of RAW file " + path);
+    }
+}
+
+void print_usage(const char *program) {
+    std::cerr << "Usage: " << program << " [benchmark options] [--raw_file=<path>]... [--raw_max_bytes=<n>]"
+              << " [--num_cd_events=<n>]" << std::endl
+              << std::endl
+              << "  --raw_file=<path>      Also benchmarks the decoders of the format of this RAW file on its content"
+              << std::endl
+              << "  --raw_max_bytes=<n>    Maximum number of bytes of event data loaded from each RAW file (default "
+              << "256 MiB)" << std::endl
+              << "  --num_cd_events=<n>    Number of CD events in each synthetic stream (default 1048576)" << std::endl
+              << std::endl
+              << "Use --benchmark_out=<file> --benchmark_out_format=json to get machine-readable results."
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    benchmark::Initialize(&argc, argv);
+
+    std::vector<std::string> raw_files;
+    std::size_t raw_max_bytes = 256 << 20;
+    std::size_t num_cd_events = 1 << 20;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto sep        = arg.find('=');
+            const auto key        = arg.substr(0, sep);
+            const auto value      = sep == std::string::npos ? std::string() : arg.substr(sep + 1);
+            if (key == "--raw_file" && !value.empty()) {
+                raw_files.push_back(value);
+            } else if (key == "--raw_max_bytes" && !value.empty()) {
+                raw_max_bytes = std::stoull(value);
+            } else if (key == "--num_cd_events" && !value.empty()) {
+                num_cd_events = std::stoull(value);
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+
+        register_synthetic_benchmarks(num_cd_events);
+        for (const auto &path : raw_files) {
+            register_raw_file_benchmarks(path, raw_max_bytes);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    benchmark::AddCustomContext("synthetic_stream_num_cd_events", std::to_string(num_cd_events));
+    benchmark::AddCustomContext("decode_chunk_bytes", std::to_string(kDecodeChunkBytes));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
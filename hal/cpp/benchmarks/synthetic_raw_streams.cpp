@@ -0,0 +1,369 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "metavision/hal/decoders/base/event_base.h"
+#include "metavision/hal/decoders/evt2/evt2_event_types.h"
+#include "metavision/hal/decoders/evt21/evt21_event_types.h"
+#include "metavision/hal/decoders/evt3/evt3_event_types.h"
+#include "metavision/hal/decoders/evt4/evt4_event_types.h"
+#include "synthetic_raw_streams.h"
+
+namespace Metavision {
+namespace benchmarks {
+
+namespace {
+
+constexpr int kVectorSize              = 32;
+constexpr int kMaxVectorsPerBurst      = 4;
+constexpr int kCDEventsPerTrigger      = 4;
+constexpr int kCDEventsPerMonitoring   = 4;
+constexpr std::uint16_t kEventRateType = 0x0014; // MASTER_IN_CD_EVENT_COUNT in all the formats
+
+template<typename Word, typename RawEvent>
+Word to_word(const RawEvent &raw_event) {
+    static_assert(sizeof(Word) == sizeof(RawEvent), "Raw event size does not match the word size");
+    Word word;
+    std::memcpy(&word, &raw_event, sizeof(Word));
+    return word;
+}
+
+template<typename Word>
+std::vector<std::uint8_t> to_bytes(const std::vector<Word> &words) {
+    std::vector<std::uint8_t> bytes(words.size() * sizeof(Word));
+    std::memcpy(bytes.data(), words.data(), bytes.size());
+    return bytes;
+}
+
+/// @brief Calls @p emit for each time high period reached by @p t since the previous call, so that no period is
+/// skipped even when there is no event in it
+class TimeHighTracker {
+public:
+    explicit TimeHighTracker(int num_bits_lsb) : num_bits_lsb_(num_bits_lsb) {}
+
+    template<typename F>
+    void update(timestamp t, F &&emit) {
+        const timestamp time_high = t >> num_bits_lsb_;
+        if (last_time_high_ < 0) {
+            emit(time_high);
+        } else {
+            for (timestamp th = last_time_high_ + 1; th <= time_high; ++th) {
+                emit(th);
+            }
+        }
+        last_time_high_ = std::max(last_time_high_, time_high);
+    }
+
+private:
+    const int num_bits_lsb_;
+    timestamp last_time_high_ = -1;
+};
+
+template<typename F>
+void for_each_vector_pixel(const SyntheticEvent &ev, F &&f) {
+    for (std::uint32_t mask = ev.data; mask != 0; mask &= mask - 1) {
+        int offset = 0;
+        while (((mask >> offset) & 1) == 0) {
+            ++offset;
+        }
+        f(static_cast<std::uint16_t>(ev.x + offset));
+    }
+}
+
+} // anonymous namespace
+
+std::string to_string(StreamProfile profile) {
+    switch (profile) {
+    case StreamProfile::Sparse:
+        return "sparse";
+    case StreamProfile::VectorizedBursts:
+        return "vectorized_bursts";
+    case StreamProfile::TriggerHeavy:
+        return "trigger_heavy";
+    case StreamProfile::MonitoringHeavy:
+        return "monitoring_heavy";
+    }
+    return "unknown";
+}
+
+std::vector<SyntheticEvent> generate_events(const StreamParams &params) {
+    if (params.events_per_us <= 0. || params.width < kVectorSize || params.height <= 0) {
+        throw std::invalid_argument("Invalid synthetic stream parameters");
+    }
+
+    // Only the raw output of the engine is used: contrary to the standard distributions, it is specified by the
+    // standard, so that the generated streams are the same on all platforms
+    std::mt19937 mt(params.seed);
+    const auto uniform = [&mt](std::uint32_t n) { return static_cast<std::uint32_t>(mt() % n); };
+
+    std::vector<SyntheticEvent> events;
+    const double us_per_event = 1. / params.events_per_us;
+    double t                  = 0.;
+    std::size_t num_cd_events = 0;
+    while (num_cd_events < params.num_cd_events) {
+        const timestamp ts = static_cast<timestamp>(t);
+        if (params.profile == StreamProfile::VectorizedBursts) {
+            const int num_vectors = std::min(kMaxVectorsPerBurst, params.width / kVectorSize);
+            const auto num_bases  = static_cast<std::uint32_t>(params.width / kVectorSize - num_vectors + 1);
+            const auto y          = static_cast<std::uint16_t>(uniform(params.height));
+            const auto p          = static_cast<std::uint8_t>(mt() & 1);
+            auto x                = static_cast<std::uint16_t>(uniform(num_bases) * kVectorSize);
+            for (int i = 0; i < num_vectors; ++i, x += kVectorSize) {
+                // ~75% of the pixels of the vectors are set
+                std::uint32_t mask = mt() | mt();
+                mask               = mask != 0 ? mask : 1;
+                events.push_back({SyntheticEvent::Type::CDVector, ts, x, y, p, 0, mask});
+
+                const auto num_pixels = static_cast<std::size_t>(std::bitset<kVectorSize>(mask).count());
+                num_cd_events += num_pixels;
+                t += num_pixels * us_per_event;
+            }
+            continue;
+        }
+
+        events.push_back({SyntheticEvent::Type::CD, ts, static_cast<std::uint16_t>(uniform(params.width)),
+                          static_cast<std::uint16_t>(uniform(params.height)), static_cast<std::uint8_t>(mt() & 1), 0,
+                          0});
+        ++num_cd_events;
+        t += us_per_event;
+
+        if (params.profile == StreamProfile::TriggerHeavy && num_cd_events % kCDEventsPerTrigger == 0) {
+            const auto p = static_cast<std::uint8_t>((num_cd_events / kCDEventsPerTrigger) & 1);
+            events.push_back({SyntheticEvent::Type::ExtTrigger, ts, 0, 0, p, 0, 0});
+        } else if (params.profile == StreamProfile::MonitoringHeavy && num_cd_events % kCDEventsPerMonitoring == 0) {
+            events.push_back({SyntheticEvent::Type::Monitoring, ts, 0, 0, 0, kEventRateType, kCDEventsPerMonitoring});
+        }
+    }
+    return events;
+}
+
+std::vector<std::uint8_t> encode_evt2(const std::vector<SyntheticEvent> &events) {
+    std::vector<std::uint32_t> words;
+    words.reserve(events.size() * 2);
+    TimeHighTracker time_high_tracker(EVT2EventsTimeStampBits);
+
+    for (const auto &ev : events) {
+        time_high_tracker.update(ev.t, [&words](timestamp th) {
+            words.push_back(to_word<std::uint32_t>(EventBase::RawEvent{
+                static_cast<unsigned int>(th), static_cast<unsigned int>(EVT2EventTypes::EVT_TIME_HIGH)}));
+        });
+
+        const auto ts = static_cast<unsigned int>(ev.t & ((1 << EVT2EventsTimeStampBits) - 1));
+        const auto cd = [&](std::uint16_t x) {
+            const auto type = ev.p ? EVT2EventTypes::CD_ON : EVT2EventTypes::CD_OFF;
+            words.push_back(to_word<std::uint32_t>(EVT2Event2D{ev.y, x, ts, static_cast<unsigned int>(type)}));
+        };
+        switch (ev.type) {
+        case SyntheticEvent::Type::CD:
+            cd(ev.x);
+            break;
+        case SyntheticEvent::Type::CDVector:
+            for_each_vector_pixel(ev, cd);
+            break;
+        case SyntheticEvent::Type::ExtTrigger:
+            words.push_back(to_word<std::uint32_t>(
+                EVT2EventExtTrigger{ev.p, 0, ev.id, 0, ts, static_cast<unsigned int>(EVT2EventTypes::EXT_TRIGGER)}));
+            break;
+        case SyntheticEvent::Type::Monitoring:
+            words.push_back(to_word<std::uint32_t>(
+                EVT2EventMonitor{ev.id, 0, 0, ts, static_cast<unsigned int>(EVT2EventTypes::OTHER)}));
+            words.push_back(
+                to_word<std::uint32_t>(EVT2Continued{ev.data, static_cast<std::uint32_t>(EVT2EventTypes::CONTINUED)}));
+            break;
+        }
+    }
+    return to_bytes(words);
+}
+
+std::vector<std::uint8_t> encode_evt21(const std::vector<SyntheticEvent> &events) {
+    std::vector<std::uint64_t> words;
+    words.reserve(events.size() * 2);
+    TimeHighTracker time_high_tracker(6);
+
+    for (const auto &ev : events) {
+        time_high_tracker.update(ev.t, [&words](timestamp th) {
+            words.push_back(to_word<std::uint64_t>(Evt21Raw::Event_TIME_HIGH{
+                0, static_cast<std::uint64_t>(th), static_cast<std::uint64_t>(Evt21EventTypes_4bits::EVT_TIME_HIGH)}));
+        });
+
+        const auto ts = static_cast<std::uint64_t>(ev.t & ((1 << 6) - 1));
+        switch (ev.type) {
+        case SyntheticEvent::Type::CD:
+        case SyntheticEvent::Type::CDVector: {
+            // Vectors of EVT2.1 are aligned on 32 pixels
+            const std::uint64_t x_base = ev.x & ~(kVectorSize - 1);
+            const std::uint64_t valid =
+                ev.type == SyntheticEvent::Type::CD ? (1u << (ev.x - x_base)) : ev.data << (ev.x - x_base);
+            const auto type = ev.p ? Evt21EventTypes_4bits::EVT_POS : Evt21EventTypes_4bits::EVT_NEG;
+            words.push_back(to_word<std::uint64_t>(
+                Evt21Raw::Event_2D{valid, ev.y, x_base, ts, static_cast<std::uint64_t>(type)}));
+            break;
+        }
+        case SyntheticEvent::Type::ExtTrigger:
+            words.push_back(to_word<std::uint64_t>(Evt21Raw::Event_EXT_TRIGGER{
+                0, ev.p, 0, ev.id, 0, ts, static_cast<std::uint64_t>(Evt21EventTypes_4bits::EXT_TRIGGER)}));
+            break;
+        case SyntheticEvent::Type::Monitoring:
+            words.push_back(to_word<std::uint64_t>(Evt21Raw::Event_OTHERS{
+                ev.data, ev.id, 0, 0, ts, static_cast<std::uint64_t>(Evt21EventTypes_4bits::OTHERS)}));
+            break;
+        }
+    }
+    return to_bytes(words);
+}
+
+std::vector<std::uint8_t> encode_evt3(const std::vector<SyntheticEvent> &events) {
+    using Type = Evt3EventTypes_4bits;
+
+    std::vector<std::uint16_t> words;
+    words.reserve(events.size() * 4);
+    TimeHighTracker time_high_tracker(12);
+
+    const auto raw = [&words](Type type, std::uint16_t content) {
+        words.push_back(to_word<std::uint16_t>(Evt3Raw::RawEvent{content, static_cast<std::uint16_t>(type)}));
+    };
+
+    // EVT3 is stateful: only the fields that change are emitted
+    timestamp last_time_low = -1;
+    int last_y              = -1;
+    int next_vect_base      = -1;
+    for (const auto &ev : events) {
+        time_high_tracker.update(ev.t, [&](timestamp th) {
+            raw(Type::EVT_TIME_HIGH, static_cast<std::uint16_t>(th & 0xFFF));
+            last_time_low = -1;
+        });
+
+        const timestamp time_low = ev.t & 0xFFF;
+        if (time_low != last_time_low) {
+            raw(Type::EVT_TIME_LOW, static_cast<std::uint16_t>(time_low));
+            last_time_low = time_low;
+        }
+
+        switch (ev.type) {
+        case SyntheticEvent::Type::CD:
+            if (ev.y != last_y) {
+                raw(Type::EVT_ADDR_Y, ev.y);
+                last_y = ev.y;
+            }
+            raw(Type::EVT_ADDR_X, static_cast<std::uint16_t>(ev.x | (ev.p << 11)));
+            break;
+        case SyntheticEvent::Type::CDVector: {
+            if (ev.y != last_y) {
+                raw(Type::EVT_ADDR_Y, ev.y);
+                last_y         = ev.y;
+                next_vect_base = -1;
+            }
+            // The vector base is incremented by the decoder after each vector, consecutive vectors do not repeat it
+            const int vect_base = ev.x | (ev.p << 11);
+            if (vect_base != next_vect_base) {
+                raw(Type::VECT_BASE_X, static_cast<std::uint16_t>(vect_base));
+            }
+            next_vect_base = vect_base + kVectorSize;
+            raw(Type::VECT_12, static_cast<std::uint16_t>(ev.data & 0xFFF));
+            raw(Type::VECT_12, static_cast<std::uint16_t>((ev.data >> 12) & 0xFFF));
+            raw(Type::VECT_8, static_cast<std::uint16_t>((ev.data >> 24) & 0xFF));
+            break;
+        }
+        case SyntheticEvent::Type::ExtTrigger:
+            raw(Type::EXT_TRIGGER, static_cast<std::uint16_t>(ev.p | (ev.id << 8)));
+            break;
+        case SyntheticEvent::Type::Monitoring:
+            raw(Type::OTHERS, ev.id);
+            raw(Type::CONTINUED_12, static_cast<std::uint16_t>(ev.data & 0xFFF));
+            raw(Type::CONTINUED_12, static_cast<std::uint16_t>((ev.data >> 12) & 0xFFF));
+            raw(Type::CONTINUED_4, static_cast<std::uint16_t>((ev.data >> 24) & 0xF));
+            break;
+        }
+    }
+    return to_bytes(words);
+}
+
+std::vector<std::uint8_t> encode_evt4(const std::vector<SyntheticEvent> &events) {
+    using Type = EVT4EventTypes;
+
+    std::vector<std::uint32_t> words;
+    words.reserve(events.size() * 2);
+    TimeHighTracker time_high_tracker(6);
+
+    for (const auto &ev : events) {
+        time_high_tracker.update(ev.t, [&words](timestamp th) {
+            words.push_back(to_word<std::uint32_t>(
+                EventBase::RawEvent{static_cast<unsigned int>(th), static_cast<unsigned int>(Type::EVT_TIME_HIGH)}));
+        });
+
+        const auto ts = static_cast<std::uint32_t>(ev.t & ((1 << 6) - 1));
+        switch (ev.type) {
+        case SyntheticEvent::Type::CD: {
+            const auto type = ev.p ? Type::CD_ON : Type::CD_OFF;
+            words.push_back(
+                to_word<std::uint32_t>(Evt4Raw::EVT4EventCD{ev.y, ev.x, ts, static_cast<std::uint32_t>(type)}));
+            break;
+        }
+        case SyntheticEvent::Type::CDVector: {
+            const auto type = ev.p ? Type::CD_VEC_ON : Type::CD_VEC_OFF;
+            words.push_back(
+                to_word<std::uint32_t>(Evt4Raw::EVT4EventCD{ev.y, ev.x, ts, static_cast<std::uint32_t>(type)}));
+            words.push_back(ev.data);
+            break;
+        }
+        case SyntheticEvent::Type::ExtTrigger:
+            words.push_back(to_word<std::uint32_t>(
+                Evt4Raw::EVT4EventExtTrigger{ev.p, 0, ev.id, 0, ts, static_cast<std::uint32_t>(Type::EXT_TRIGGER)}));
+            break;
+        case SyntheticEvent::Type::Monitoring:
+            words.push_back(to_word<std::uint32_t>(
+                Evt4Raw::EVT4EventMonitor{ev.id, 0, ts, static_cast<std::uint32_t>(Type::OTHER)}));
+            words.push_back(to_word<std::uint32_t>(Evt4Raw::EVT4EventMonitorMasterInCdEventCount{
+                ev.data, 0, static_cast<std::uint32_t>(Type::CONTINUED)}));
+            break;
+        }
+    }
+    return to_bytes(words);
+}
+
+std::vector<std::uint8_t> encode_aer(const std::vector<SyntheticEvent> &events, bool has_4_bits_interface) {
+    // AER words hold y on bits [0, 9), x on bits [9, 18) and the polarity on bit 18, the timestamps are given by the
+    // host clock. They are sent LSB first, on 20 bits with a 4 bits interface and 24 bits otherwise.
+    const int num_bits_per_event = has_4_bits_interface ? 20 : 24;
+
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(events.size() * 3);
+    std::uint64_t pending_bits = 0;
+    int num_pending_bits       = 0;
+    const auto push_event      = [&](std::uint16_t x, std::uint16_t y, std::uint8_t p) {
+        const std::uint64_t word = (y & 0x1FF) | ((x & 0x1FF) << 9) | (static_cast<std::uint64_t>(p & 1) << 18);
+        pending_bits |= word << num_pending_bits;
+        num_pending_bits += num_bits_per_event;
+        for (; num_pending_bits >= 8; num_pending_bits -= 8, pending_bits >>= 8) {
+            bytes.push_back(static_cast<std::uint8_t>(pending_bits & 0xFF));
+        }
+    };
+
+    for (const auto &ev : events) {
+        if (ev.type == SyntheticEvent::Type::CD) {
+            push_event(ev.x, ev.y, ev.p);
+        } else if (ev.type == SyntheticEvent::Type::CDVector) {
+            for_each_vector_pixel(ev, [&](std::uint16_t x) { push_event(x, ev.y, ev.p); });
+        }
+    }
+    if (num_pending_bits > 0) {
+        bytes.push_back(static_cast<std::uint8_t>(pending_bits & 0xFF));
+    }
+    return bytes;
+}
+
+} // namespace benchmarks
+} // namespace Metavision
@@ -0,0 +1,82 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_BENCHMARKS_SYNTHETIC_RAW_STREAMS_H
+#define METAVISION_HAL_BENCHMARKS_SYNTHETIC_RAW_STREAMS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+namespace benchmarks {
+
+/// @brief Shapes of the synthetic streams used to benchmark the decoders
+enum class StreamProfile {
+    Sparse,           ///< Isolated CD events at random locations
+    VectorizedBursts, ///< Runs of horizontally adjacent CD events sharing the same timestamp
+    TriggerHeavy,     ///< Isolated CD events interleaved with many external trigger events
+    MonitoringHeavy,  ///< Isolated CD events interleaved with many monitoring (event rate) events
+};
+
+/// @brief Returns the name of a stream profile, as used in the benchmark names
+std::string to_string(StreamProfile profile);
+
+/// @brief Parameters of a synthetic stream
+struct StreamParams {
+    StreamProfile profile = StreamProfile::Sparse;
+    /// Number of CD events in the stream
+    std::size_t num_cd_events = 1 << 20;
+    /// Mean CD event rate, in events per microsecond
+    double events_per_us = 1.;
+    int width            = 1280;
+    int height           = 720;
+    /// Seed of the random generator, streams generated with the same parameters are identical
+    std::uint32_t seed = 42;
+};
+
+/// @brief Format independent description of an element of a synthetic stream
+struct SyntheticEvent {
+    enum class Type : std::uint8_t { CD, CDVector, ExtTrigger, Monitoring };
+
+    Type type;
+    timestamp t;
+    std::uint16_t x;
+    std::uint16_t y;
+    std::uint8_t p;
+    /// Trigger channel id, or monitoring subtype
+    std::uint16_t id;
+    /// Pixel mask starting at x for vectors, or monitoring payload
+    std::uint32_t data;
+};
+
+/// @brief Generates the events of a synthetic stream, sorted by timestamp
+std::vector<SyntheticEvent> generate_events(const StreamParams &params);
+
+/// @brief Encoders of synthetic events in the various RAW formats
+///
+/// Time high words are emitted for every time high period, including the empty ones, as a sensor would do.
+/// Vectors are split in single CD events for the formats that do not support them and every format not supporting
+/// some event type drops it.
+/// @{
+std::vector<std::uint8_t> encode_evt2(const std::vector<SyntheticEvent> &events);
+std::vector<std::uint8_t> encode_evt21(const std::vector<SyntheticEvent> &events);
+std::vector<std::uint8_t> encode_evt3(const std::vector<SyntheticEvent> &events);
+std::vector<std::uint8_t> encode_evt4(const std::vector<SyntheticEvent> &events);
+std::vector<std::uint8_t> encode_aer(const std::vector<SyntheticEvent> &events, bool has_4_bits_interface);
+/// @}
+
+} // namespace benchmarks
+} // namespace Metavision
+
+#endif // METAVISION_HAL_BENCHMARKS_SYNTHETIC_RAW_STREAMS_H
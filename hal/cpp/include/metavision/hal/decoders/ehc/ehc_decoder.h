@@ -20,6 +20,10 @@
 
 namespace Metavision {
 
+/// @brief Base class of the decoders of event frames, accumulating raw data until a frame is complete
+///
+/// The frames are filled in place: the data of a complete frame is swapped into a frame of the decoder pool, and the
+/// decoder goes on accumulating into the buffer of the recycled frame.
 template<class FrameType, typename T>
 class EHCDecoder : public I_EventFrameDecoder<FrameType> {
     using RawData = typename I_EventFrameDecoder<FrameType>::RawData;
@@ -43,6 +47,7 @@ public:
                                      reinterpret_cast<const T *>(cur_raw_data + elems_to_add));
             if (event_frame_data_.size() == size_full_) {
                 finalize_event_frame(event_frame_data_);
+                // The buffer swapped back from a recycled frame already has the capacity of a full frame
                 event_frame_data_.clear();
                 event_frame_data_.reserve(size_full_);
             }
@@ -61,25 +66,34 @@ private:
 class Histo3dDecoder : public EHCDecoder<RawEventFrameHisto, uint8_t> {
 public:
     Histo3dDecoder(int height, int width, unsigned neg_bits, unsigned pos_bits, bool padded) :
-        EHCDecoder(height, width, padded ? 2 : 1), frame_histo_(height, width, neg_bits, pos_bits, !padded) {}
+        EHCDecoder(height, width, padded ? 2 : 1), neg_bits_(neg_bits), pos_bits_(pos_bits), packed_(!padded) {
+        // Checks the configuration as soon as the decoder is built
+        RawEventFrameHisto(1, 1, neg_bits, pos_bits, packed_);
+    }
 
     virtual uint8_t get_raw_event_size_bytes() const override {
-        return frame_histo_.get_config().packed ? 1 : 2;
+        return packed_ ? 1 : 2;
     }
 
 private:
     virtual void finalize_event_frame(std::vector<uint8_t> &frame_data) override {
-        frame_histo_.get_data().swap(frame_data);
-        add_event_frame(frame_histo_);
+        // All the frames of the pool share the decoder configuration, only their data has to be replaced
+        auto frame = acquire_event_frame(height_, width_, neg_bits_, pos_bits_, packed_);
+        frame->get_data().swap(frame_data);
+        add_pooled_event_frame(frame);
     }
 
-    RawEventFrameHisto frame_histo_;
+    const unsigned neg_bits_;
+    const unsigned pos_bits_;
+    const bool packed_;
 };
 
 class Diff3dDecoder : public EHCDecoder<RawEventFrameDiff, int8_t> {
 public:
-    Diff3dDecoder(int height, int width, unsigned nbits) :
-        EHCDecoder(height, width, 1), frame_diff_(height, width, nbits) {}
+    Diff3dDecoder(int height, int width, unsigned nbits) : EHCDecoder(height, width, 1), nbits_(nbits) {
+        // Checks the configuration as soon as the decoder is built
+        RawEventFrameDiff(1, 1, nbits);
+    }
 
     virtual uint8_t get_raw_event_size_bytes() const override {
         return 1;
@@ -87,11 +101,13 @@ public:
 
 private:
     virtual void finalize_event_frame(std::vector<int8_t> &frame_data) override {
-        frame_diff_.get_data().swap(frame_data);
-        add_event_frame(frame_diff_);
+        // All the frames of the pool share the decoder configuration, only their data has to be replaced
+        auto frame = acquire_event_frame(height_, width_, nbits_);
+        frame->get_data().swap(frame_data);
+        add_pooled_event_frame(frame);
     }
 
-    RawEventFrameDiff frame_diff_;
+    const unsigned nbits_;
 };
 
 } // namespace Metavision
@@ -14,6 +14,8 @@
 
 #include <atomic>
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <mutex>
 #include <set>
 
@@ -31,7 +33,13 @@
 namespace Metavision {
 namespace detail {
 
-template<class Validator>
+/// @brief EVT3 decoder
+///
+/// The @p HAS_TRIGGERS, @p HAS_ERC and @p HAS_MONITORING parameters allow instantiating a decoder specialized for
+/// a stream configuration: when one of them is false, the decoding of the corresponding events is compiled out of the
+/// decoding loop and those events are dropped. When it is true, the events are forwarded if a decoder was provided
+/// for them at construction.
+template<class Validator, bool HAS_TRIGGERS = true, bool HAS_ERC = true, bool HAS_MONITORING = true>
 class EVT3Decoder : public I_EventsStreamDecoder {
 public:
     using RawEvent       = Evt3Raw::RawEvent;
@@ -60,14 +68,23 @@ public:
                               erc_count_event_decoder),
         validator(height, width),
         height_(height),
-        event_monitoring_decoder_(event_monitoring_decoder),
-        monitoring_id_blacklist_(monitoring_id_blacklist) {
+        has_trigger_decoder_(HAS_TRIGGERS && event_ext_trigger_decoder),
+        has_erc_count_decoder_(HAS_ERC && erc_count_event_decoder),
+        event_monitoring_decoder_(HAS_MONITORING ? event_monitoring_decoder :
+                                                   std::shared_ptr<I_EventDecoder<EventMonitoring>>()) {
         last_timestamp_.time = 0;
 
         if (event_monitoring_decoder_) {
             monitoring_event_forwarder_.reset(
                 new DecodedEventForwarder<EventMonitoring, 1>(event_monitoring_decoder_.get()));
         }
+
+        // Master types are encoded on the 12 bits of the raw event content, other ids can't be matched
+        for (const auto id : monitoring_id_blacklist) {
+            if (id < monitoring_id_blacklist_.size()) {
+                monitoring_id_blacklist_.set(id);
+            }
+        }
     }
 
     virtual bool get_timestamp_shift(timestamp &ts_shift) const override {
@@ -162,10 +179,13 @@ private:
 
     template<bool DO_TIMESHIFT>
     uint32_t decode_events_buffer(const RawEvent *&cur_raw_ev, const RawEvent *const raw_ev_end) {
-        auto &cd_forwarder        = cd_event_forwarder();
-        auto &trigger_forwarder   = trigger_event_forwarder();
-        auto &erc_count_forwarder = erc_count_event_forwarder();
-        auto &monitoring_forwarder = *monitoring_event_forwarder_;
+        auto &cd_forwarder = cd_event_forwarder();
+        // Forwarders of the optional event types, null when the type is compiled out or has no decoder
+        DecodedEventForwarder<EventExtTrigger, 1> *trigger_forwarder =
+            has_trigger_decoder_ ? &trigger_event_forwarder() : nullptr;
+        DecodedEventForwarder<EventERCCounter, 1> *erc_count_forwarder =
+            has_erc_count_decoder_ ? &erc_count_event_forwarder() : nullptr;
+        DecodedEventForwarder<EventMonitoring, 1> *monitoring_forwarder = monitoring_event_forwarder_.get();
         for (; cur_raw_ev != raw_ev_end;) {
             const uint16_t type = cur_raw_ev->type;
             if (type == static_cast<EventTypesUnderlying_t>(EventTypesEnum::EVT_ADDR_X)) {
@@ -239,17 +259,22 @@ private:
 
                 ++cur_raw_ev;
             } else if (type == static_cast<EventTypesUnderlying_t>(EventTypesEnum::EXT_TRIGGER)) {
-                if (validator.validate_ext_trigger(cur_raw_ev)) {
-                    const Evt3Raw::Event_ExtTrigger *ev_exttrigger =
-                        reinterpret_cast<const Evt3Raw::Event_ExtTrigger *>(cur_raw_ev);
-                    trigger_forwarder.forward(static_cast<short>(ev_exttrigger->pol), last_timestamp<DO_TIMESHIFT>(),
-                                              static_cast<short>(ev_exttrigger->id));
+                if constexpr (HAS_TRIGGERS) {
+                    if (validator.validate_ext_trigger(cur_raw_ev) && trigger_forwarder) {
+                        const Evt3Raw::Event_ExtTrigger *ev_exttrigger =
+                            reinterpret_cast<const Evt3Raw::Event_ExtTrigger *>(cur_raw_ev);
+                        trigger_forwarder->forward(static_cast<short>(ev_exttrigger->pol),
+                                                   last_timestamp<DO_TIMESHIFT>(),
+                                                   static_cast<short>(ev_exttrigger->id));
+                    }
                 }
                 ++cur_raw_ev;
             } else if (type == static_cast<EventTypesUnderlying_t>(EventTypesEnum::OTHERS)) {
                 const uint16_t master_type = cur_raw_ev->content;
 
-                if (monitoring_id_blacklist_.count(master_type) > 0) {
+                // Without any consumer, the master event is skipped like a blacklisted one: its continued words
+                // are handled as state updates
+                if (!(HAS_ERC || HAS_MONITORING) || monitoring_id_blacklist_[master_type]) {
                     ++cur_raw_ev;
                     continue;
                 }
@@ -275,11 +300,21 @@ private:
                     cur_raw_ev += next_offset;
                 }
 
-                monitoring_forwarder.forward(last_timestamp<DO_TIMESHIFT>(), master_type, payload);
-                if (master_type == static_cast<uint16_t>(Evt3MasterEventTypes::MASTER_RATE_CONTROL_CD_EVENT_COUNT)) {
-                    erc_count_forwarder.forward(last_timestamp<DO_TIMESHIFT>(), payload, true);
-                } else if (master_type == static_cast<uint16_t>(Evt3MasterEventTypes::MASTER_IN_CD_EVENT_COUNT)) {
-                    erc_count_forwarder.forward(last_timestamp<DO_TIMESHIFT>(), payload, false);
+                if constexpr (HAS_MONITORING) {
+                    if (monitoring_forwarder) {
+                        monitoring_forwarder->forward(last_timestamp<DO_TIMESHIFT>(), master_type, payload);
+                    }
+                }
+                if constexpr (HAS_ERC) {
+                    if (erc_count_forwarder) {
+                        if (master_type ==
+                            static_cast<uint16_t>(Evt3MasterEventTypes::MASTER_RATE_CONTROL_CD_EVENT_COUNT)) {
+                            erc_count_forwarder->forward(last_timestamp<DO_TIMESHIFT>(), payload, true);
+                        } else if (master_type ==
+                                   static_cast<uint16_t>(Evt3MasterEventTypes::MASTER_IN_CD_EVENT_COUNT)) {
+                            erc_count_forwarder->forward(last_timestamp<DO_TIMESHIFT>(), payload, false);
+                        }
+                    }
                 }
             } else {
                 // The objective is to reduce the number of possible cases
@@ -385,11 +420,27 @@ private:
     uint32_t height_           = 65536;
     std::vector<RawEvent> incomplete_multiword_raw_event_;
     std::ptrdiff_t raw_events_missing_count_{0};
+    const bool has_trigger_decoder_;
+    const bool has_erc_count_decoder_;
     std::shared_ptr<I_EventDecoder<EventMonitoring>> event_monitoring_decoder_;
     std::unique_ptr<DecodedEventForwarder<EventMonitoring, 1>> monitoring_event_forwarder_;
-    const std::set<uint16_t> monitoring_id_blacklist_;
+    std::bitset<1 << 12> monitoring_id_blacklist_;
 };
 
+/// @brief Instantiates the EVT3 decoder specialized for the event types that have a decoder
+template<class Validator, bool... FEATURES, typename... Args>
+std::unique_ptr<I_EventsStreamDecoder> make_specialized_evt3_decoder(const std::array<bool, 3> &has_decoders,
+                                                                     Args &&...args) {
+    constexpr std::size_t index = sizeof...(FEATURES);
+    if constexpr (index == std::tuple_size<std::array<bool, 3>>::value) {
+        return std::make_unique<EVT3Decoder<Validator, FEATURES...>>(std::forward<Args>(args)...);
+    } else if (has_decoders[index]) {
+        return make_specialized_evt3_decoder<Validator, FEATURES..., true>(has_decoders, std::forward<Args>(args)...);
+    } else {
+        return make_specialized_evt3_decoder<Validator, FEATURES..., false>(has_decoders, std::forward<Args>(args)...);
+    }
+}
+
 } // namespace detail
 
 using EVT3Decoder       = detail::EVT3Decoder<decoder::evt3::BasicCheckValidator>;
@@ -420,9 +471,14 @@ inline std::unique_ptr<I_EventsStreamDecoder> make_evt3_decoder(
     const std::shared_ptr<I_EventDecoder<EventMonitoring>> &monitoring_event_decoder =
         std::shared_ptr<I_EventDecoder<EventMonitoring>>(),
     const std::set<uint16_t> &monitoring_id_blacklist = std::set<uint16_t>()) {
+    // The default decoder is specialized for the configuration of the stream, so that the decoding of the event
+    // types nobody listens to is compiled out
     std::unique_ptr<I_EventsStreamDecoder> decoder =
-        std::make_unique<EVT3Decoder>(time_shifting_enabled, height, width, event_cd_decoder, event_ext_trigger_decoder,
-                                      erc_count_event_decoder, monitoring_event_decoder, monitoring_id_blacklist);
+        detail::make_specialized_evt3_decoder<decoder::evt3::BasicCheckValidator>(
+            {static_cast<bool>(event_ext_trigger_decoder), static_cast<bool>(erc_count_event_decoder),
+             static_cast<bool>(monitoring_event_decoder)},
+            time_shifting_enabled, height, width, event_cd_decoder, event_ext_trigger_decoder, erc_count_event_decoder,
+            monitoring_event_decoder, monitoring_id_blacklist);
 
     if (std::getenv("MV_FLAGS_EVT3_THROW_ON_NON_MONOTONIC_TIME_HIGH") || std::getenv("MV_FLAGS_EVT3_ROBUST_DECODER")) {
         MV_HAL_LOG_INFO() << "Using EVT3 Robust decoder.";
@@ -14,26 +14,32 @@
 
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/base/utils/detail/bitinstructions.h"
 #include "metavision/hal/facilities/i_event_decoder.h"
 #include "metavision/hal/decoders/evt4/evt4_event_types.h"
 #include "metavision/hal/decoders/evt4/evt4_validator.h"
+#include "metavision/hal/utils/detail/type_check.h"
 
 #include <cstdint>
 #include <cstdlib>
 #include <optional>
+#include <type_traits>
+#include <variant>
 
 namespace Metavision {
 
 namespace detail {
 
-template<class Validator>
+template<class Validator, typename OutputCDType = EventCD>
 class EVT4Decoder : public I_EventsStreamDecoder {
 public:
-    using RawEvent        = Evt4Raw::RawEvent;
-    using EventTypesEnum  = EVT4EventTypes;
-    using Event_Word_Type = std::uint32_t;
+    using RawEvent         = Evt4Raw::RawEvent;
+    using EventTypesEnum   = EVT4EventTypes;
+    using Event_Word_Type  = std::uint32_t;
+    using EventCDForwarder = I_EventsStreamDecoder::DecodedEventForwarder<OutputCDType>;
+    using OutputCDTypes    = std::variant<EventCD, EventCDVector>;
 
     static constexpr std::uint8_t NumBitsInTimestampLSB{6};
     static constexpr std::uint8_t NumBitsInTimestampMSB{28};
@@ -46,8 +52,9 @@ public:
 
     EVT4Decoder(
         bool time_shifting_enabled, const std::optional<std::uint32_t> &width = std::nullopt,
-        const std::optional<std::uint32_t> &height                       = std::nullopt,
-        const std::shared_ptr<I_EventDecoder<EventCD>> &event_cd_decoder = std::shared_ptr<I_EventDecoder<EventCD>>(),
+        const std::optional<std::uint32_t> &height = std::nullopt,
+        const std::shared_ptr<I_EventDecoder<OutputCDType>> &event_cd_decoder =
+            std::shared_ptr<I_EventDecoder<OutputCDType>>(),
         const std::shared_ptr<I_EventDecoder<EventExtTrigger>> &event_ext_trigger_decoder =
             std::shared_ptr<I_EventDecoder<EventExtTrigger>>(),
         const std::shared_ptr<I_EventDecoder<EventERCCounter>> &erc_count_event_decoder =
@@ -55,6 +62,9 @@ public:
         I_EventsStreamDecoder(time_shifting_enabled, event_cd_decoder, event_ext_trigger_decoder,
                               erc_count_event_decoder),
         validator_(width.value_or(MaxWidth), height.value_or(MaxHeight)) {
+        static_assert(Metavision::detail::is_in_type_list_v<OutputCDType, OutputCDTypes>,
+                      "Error, cannot construct EVT4Decoder with specified OutputCDType... Supported types are: "
+                      "{EventCD, EventCDVector}.");
         ev_other_.subtype = static_cast<std::uint16_t>(EVT4EventSubTypes::UNUSED);
     }
 
@@ -102,23 +112,40 @@ private:
         decode_events_buffer(cur_raw_ev, raw_ev_end);
     }
 
-    inline void decode_event_vector(DecodedEventForwarder<EventCD> &cd_forwarder, const Evt4Raw::EVT4EventCD *ev_cd,
-                                    uint32_t pol, const uint32_t *vect_data) {
+    inline void decode_event_vector(EventCDForwarder &cd_forwarder, const Evt4Raw::EVT4EventCD *ev_cd, uint32_t pol,
+                                    const uint32_t *vect_data) {
         if (!validator_.validate_event_cd_vec(ev_cd, vect_data)) {
             return;
         }
         std::uint32_t valid   = *vect_data;
         const std::uint32_t x = ev_cd->x;
         const std::uint32_t y = ev_cd->y;
-        while (valid) {
-            auto off = ctz_not_zero(valid);
-            valid &= valid - 1; // Reset LSB set bit to zero
-            cd_forwarder.forward(x + off, y, pol, last_timestamp_);
+
+        if constexpr (std::is_same_v<OutputCDType, EventCDVector>) {
+            if (valid) {
+                cd_forwarder.forward(static_cast<std::uint16_t>(x), static_cast<std::uint16_t>(y), pol != 0, valid,
+                                     last_timestamp_);
+            }
+        } else {
+            // Room for the whole vector is made once, so that the events are written without checking for a flush
+            cd_forwarder.reserve(32);
+            if (valid == 0xFFFFFFFF) {
+                // Full vectors are frequent on dense scenes, their expansion does not depend on the mask
+                for (std::uint32_t off = 0; off < 32; ++off) {
+                    cd_forwarder.forward_unsafe(x + off, y, pol, last_timestamp_);
+                }
+                return;
+            }
+            while (valid) {
+                auto off = ctz_not_zero(valid);
+                valid &= valid - 1; // Reset LSB set bit to zero
+                cd_forwarder.forward_unsafe(x + off, y, pol, last_timestamp_);
+            }
         }
     }
 
     void decode_events_buffer(const RawEvent *&cur_raw_ev, const RawEvent *const raw_ev_end) {
-        auto &cd_forwarder        = cd_event_forwarder();
+        auto &cd_forwarder        = cd_event_forwarder<OutputCDType>();
         auto &trigger_forwarder   = trigger_event_forwarder();
         auto &erc_count_forwarder = erc_count_event_forwarder();
         if (cd_vec_open_ && cur_raw_ev < raw_ev_end) {
@@ -137,8 +164,13 @@ private:
                     continue;
                 }
                 last_timestamp_ = base_time_ + ev_cd->timestamp;
-                cd_forwarder.forward(static_cast<std::uint16_t>(ev_cd->x), static_cast<std::uint16_t>(ev_cd->y),
-                                     type & 1, last_timestamp_);
+                if constexpr (std::is_same_v<OutputCDType, EventCDVector>) {
+                    cd_forwarder.forward(static_cast<std::uint16_t>(ev_cd->x), static_cast<std::uint16_t>(ev_cd->y),
+                                         (type & 1) != 0, 1U, last_timestamp_);
+                } else {
+                    cd_forwarder.forward(static_cast<std::uint16_t>(ev_cd->x), static_cast<std::uint16_t>(ev_cd->y),
+                                         type & 1, last_timestamp_);
+                }
             } else if (type == static_cast<EventTypesUnderlying_t>(EventTypesEnum::CD_VEC_OFF) ||
                        type == static_cast<EventTypesUnderlying_t>(EventTypesEnum::CD_VEC_ON)) { // CD Vector
                 const auto *ev_cd = reinterpret_cast<const Evt4Raw::EVT4EventCD *>(ev);
@@ -257,6 +289,8 @@ using EVT4Decoder       = detail::EVT4Decoder<decoder::evt4::NotifyValidator>;
 using UnsafeEVT4Decoder = detail::EVT4Decoder<decoder::evt4::NullCheckValidator>;
 using RobustEVT4Decoder = detail::EVT4Decoder<decoder::evt4::RobustValidator>;
 
+using EVT4VectorizedDecoder = detail::EVT4Decoder<decoder::evt4::NotifyValidator, EventCDVector>;
+
 inline std::unique_ptr<I_EventsStreamDecoder> make_evt4_decoder(
     bool time_shifting_enabled, const std::optional<std::uint32_t> &width = std::nullopt,
     const std::optional<std::uint32_t> &height                       = std::nullopt,
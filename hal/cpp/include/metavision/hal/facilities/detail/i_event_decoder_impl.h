@@ -14,11 +14,24 @@
 
 #include <memory>
 
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/hal/utils/hal_log.h"
 #include "metavision/hal/utils/hal_error_code.h"
 #include "metavision/hal/utils/hal_exception.h"
 
 namespace Metavision {
+namespace detail {
+
+template<typename Event>
+timestamp decoded_event_time(const Event &ev) {
+    return ev.t;
+}
+
+inline timestamp decoded_event_time(const EventCDVector &ev) {
+    return ev.event_timestamp;
+}
+
+} // namespace detail
 
 template<typename Event>
 size_t I_EventDecoder<Event>::add_event_buffer_callback(const EventBufferCallback_t &cb) {
@@ -26,6 +39,16 @@ size_t I_EventDecoder<Event>::add_event_buffer_callback(const EventBufferCallbac
     return next_cb_idx_++;
 }
 
+template<typename Event>
+size_t I_EventDecoder<Event>::add_event_buffer_sink(EventBufferSink &sink) {
+    auto &entry       = sinks_map_[next_cb_idx_];
+    entry.sink        = &sink;
+    entry.batch_size  = sink.get_preferred_batch_size();
+    entry.max_latency = sink.get_max_latency();
+    entry.pending.reserve(entry.batch_size);
+    return next_cb_idx_++;
+}
+
 template<typename Event>
 bool I_EventDecoder<Event>::remove_callback(size_t callback_id) {
     auto it = cbs_map_.find(callback_id);
@@ -33,6 +56,12 @@ bool I_EventDecoder<Event>::remove_callback(size_t callback_id) {
         cbs_map_.erase(it);
         return true;
     }
+    auto sink_it = sinks_map_.find(callback_id);
+    if (sink_it != sinks_map_.end()) {
+        deliver_pending(sink_it->second);
+        sinks_map_.erase(sink_it);
+        return true;
+    }
     return false;
 }
 
@@ -42,9 +71,47 @@ void I_EventDecoder<Event>::add_event_buffer(EventIterator_t begin, EventIterato
     for (auto it = cbs_map_.begin(), it_end = cbs_map_.end(); it != it_end; ++it) {
         it->second(begin, end);
     }
+    for (auto it = sinks_map_.begin(), it_end = sinks_map_.end(); it != it_end; ++it) {
+        auto &entry = it->second;
+        if (entry.pending.empty() && static_cast<size_t>(std::distance(begin, end)) >= entry.batch_size) {
+            // The batch is large enough, it is forwarded without being copied
+            entry.sink->on_event_buffer(begin, end);
+            continue;
+        }
+        entry.pending.insert(entry.pending.end(), begin, end);
+        if (entry.pending.size() >= entry.batch_size) {
+            deliver_pending(entry);
+        }
+    }
+}
+
+template<typename Event>
+void I_EventDecoder<Event>::flush_sinks(timestamp current_time) {
+    for (auto it = sinks_map_.begin(), it_end = sinks_map_.end(); it != it_end; ++it) {
+        auto &entry = it->second;
+        if (!entry.pending.empty() &&
+            current_time - detail::decoded_event_time(entry.pending.front()) >= entry.max_latency) {
+            deliver_pending(entry);
+        }
+    }
+}
+
+template<typename Event>
+void I_EventDecoder<Event>::flush_sinks() {
+    for (auto it = sinks_map_.begin(), it_end = sinks_map_.end(); it != it_end; ++it) {
+        deliver_pending(it->second);
+    }
 }
 /// @endcond
 
+template<typename Event>
+void I_EventDecoder<Event>::deliver_pending(SinkEntry &entry) {
+    if (!entry.pending.empty()) {
+        entry.sink->on_event_buffer(entry.pending.data(), entry.pending.data() + entry.pending.size());
+        entry.pending.clear();
+    }
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_HAL_I_EVENT_DECODER_IMPL_H
@@ -14,6 +14,7 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/hal/facilities/i_registrable_facility.h"
@@ -29,6 +30,34 @@ public:
     using EventBufferCallback_t = std::function<void(EventIterator_t begin, EventIterator_t end)>;
     using Event_t               = Event;
 
+    /// @brief Interface of an object consuming the batches of decoded events
+    ///
+    /// Contrary to a callback, a sink is reached through a single virtual call per batch, which lets the compiler
+    /// inline the processing of the events in the final override. A sink can also ask for batches larger than the ones
+    /// produced by the decoder.
+    class EventBufferSink {
+    public:
+        virtual ~EventBufferSink() = default;
+
+        /// @brief Processes a batch of decoded events
+        /// @param begin Iterator to the first event of the batch
+        /// @param end Iterator past the last event of the batch
+        virtual void on_event_buffer(EventIterator_t begin, EventIterator_t end) = 0;
+
+        /// @brief Gets the number of events to gather before calling the sink
+        /// @return The preferred batch size, or 0 to receive the batches as they are decoded
+        virtual size_t get_preferred_batch_size() const {
+            return 0;
+        }
+
+        /// @brief Gets the maximum duration, in us, during which decoded events can wait for a batch to be complete
+        /// @note The latency is checked against the last decoded timestamp each time the decoder flushes its events,
+        /// so a batch may be delivered before reaching the preferred size
+        virtual timestamp get_max_latency() const {
+            return 0;
+        }
+    };
+
     /// @brief Sets the functions to call to each batch of decoded events
     /// @param cb Callback to add
     /// @return ID of the added callback
@@ -36,7 +65,18 @@ public:
     /// @note It's not allowed to add/remove a callback from the callback itself
     size_t add_event_buffer_callback(const EventBufferCallback_t &cb);
 
-    /// @brief Removes a previously registered callback
+    /// @brief Adds a sink to call with batches of decoded events
+    ///
+    /// The batch size and latency preferences of the sink are read when it is added.
+    /// @param sink Sink to add, which must outlive its registration
+    /// @return ID of the added sink, which can be removed with @ref remove_callback
+    /// @note This method is not thread safe. You should add/remove the various sinks before starting the streaming
+    /// @note Events still pending when the stream ends are delivered by @ref I_EventsStreamDecoder::flush_sinks
+    size_t add_event_buffer_sink(EventBufferSink &sink);
+
+    /// @brief Removes a previously registered callback or sink
+    ///
+    /// The events a sink is still waiting for are delivered to it before it is removed.
     /// @param callback_id Callback ID
     /// @return true if the callback has been unregistered correctly, false otherwise.
     /// @sa @ref add_event_buffer_callback
@@ -44,10 +84,27 @@ public:
 
     /// @cond DEV
     void add_event_buffer(EventIterator_t begin, EventIterator_t end);
+
+    /// @brief Delivers the events pending in sinks whose maximum latency has elapsed
+    /// @param current_time Last decoded timestamp
+    void flush_sinks(timestamp current_time);
+
+    /// @brief Delivers all the events pending in sinks, whatever their preferred batch size and maximum latency
+    void flush_sinks();
     /// @endcond
 
 private:
+    struct SinkEntry {
+        EventBufferSink *sink;
+        size_t batch_size;
+        timestamp max_latency;
+        std::vector<Event> pending;
+    };
+
+    static void deliver_pending(SinkEntry &entry);
+
     std::map<size_t, EventBufferCallback_t> cbs_map_;
+    std::map<size_t, SinkEntry> sinks_map_;
     size_t next_cb_idx_{0};
 };
 
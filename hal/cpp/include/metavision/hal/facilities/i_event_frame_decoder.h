@@ -17,6 +17,7 @@
 #include <memory>
 #include <mutex>
 
+#include "metavision/sdk/base/utils/object_pool.h"
 #include "metavision/hal/facilities/i_decoder.h"
 #include "metavision/hal/facilities/i_registrable_facility.h"
 #include "metavision/hal/utils/data_transfer.h"
@@ -79,7 +80,22 @@ public:
 
 protected:
     /// @cond DEV
+    /// @brief Copies a decoded frame into a frame of the pool and hands it out
     void add_event_frame(const FrameType &frame);
+
+    /// @brief Gets a frame from the pool of the decoder, to be filled and handed out with @ref add_pooled_event_frame
+    ///
+    /// A frame goes back to the pool, with its buffers, when the last reference to it is released. In steady state,
+    /// frames are thus recycled instead of being allocated.
+    /// @param args Arguments forwarded to the frame constructor if the pool has no frame left to recycle
+    /// @return A frame, holding the data it had when it was last handed out if it is recycled
+    template<typename... Args>
+    std::shared_ptr<FrameType> acquire_event_frame(Args &&...args) {
+        return frame_pool_.acquire(std::forward<Args>(args)...);
+    }
+
+    /// @brief Hands out a frame obtained from @ref acquire_event_frame
+    void add_pooled_event_frame(const std::shared_ptr<const FrameType> &frame);
     /// @endcond
 
     const unsigned height_;
@@ -89,6 +105,7 @@ private:
     std::map<size_t, EventFrameCallback_t> cbs_map_;
     size_t next_cb_idx_{0};
 
+    SharedObjectPool<FrameType> frame_pool_ = SharedObjectPool<FrameType>::make_unbounded(0);
     std::shared_ptr<const FrameType> last_frame_;
     std::mutex last_frame_lock_;
 };
@@ -116,14 +133,21 @@ std::shared_ptr<const FrameType> I_EventFrameDecoder<FrameType>::get_last_frame(
 /// @cond DEV
 template<class FrameType>
 void I_EventFrameDecoder<FrameType>::add_event_frame(const FrameType &frame) {
+    // Assigning to a recycled frame reuses its buffers
+    auto new_frame = acquire_event_frame();
+    *new_frame     = frame;
+    add_pooled_event_frame(new_frame);
+}
+
+template<class FrameType>
+void I_EventFrameDecoder<FrameType>::add_pooled_event_frame(const std::shared_ptr<const FrameType> &frame) {
     {
-        auto new_frame = std::make_shared<FrameType>(std::move(frame));
         std::lock_guard<std::mutex> lock(last_frame_lock_);
-        last_frame_ = new_frame;
+        last_frame_ = frame;
     }
 
     for (auto &it : cbs_map_) {
-        it.second(*last_frame_);
+        it.second(*frame);
     }
 }
 /// @endcond
@@ -112,6 +112,7 @@ public:
     /// @param timestamp Timestamp to reset the decoder to
     /// @return true if the reset operation could complete, false otherwise.
     /// @note After this call has succeeded, that @ref get_last_timestamp returns @p timestamp
+    /// @note The events pending in event buffer sinks are delivered before the reset
     /// @warning If time shifting is enabled, the @p timestamp must be in the shifted time reference
     /// @warning Additional care may be required regarding the expected content of the data to be decoded
     ///          after this function has been called. Refer to the constraints and limitations of a specific
@@ -128,6 +129,14 @@ public:
     /// @brief Returns true if the decoded events stream can be indexed
     virtual bool is_decoded_event_stream_indexable() const;
 
+    /// @brief Delivers to the event buffer sinks all the events they are still waiting for
+    ///
+    /// Sinks may hold decoded events until their preferred batch size or maximum latency is reached. This function
+    /// is to be called when no more data is to be decoded, e.g. when the stream ends or is stopped, so that those
+    /// events are not lost. It is also called by @ref reset_last_timestamp.
+    /// @sa @ref I_EventDecoder::add_event_buffer_sink
+    void flush_sinks();
+
 protected:
     /// @cond DEV
 
@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_BUFFER_MEMORY_H
+#define METAVISION_HAL_BUFFER_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+namespace Metavision {
+
+/// @brief Kinds of memory backing the buffers of raw data and events
+enum class BufferMemoryType {
+    /// Memory allocated with the global operator new
+    Default,
+    /// Memory mapped with 2 MB pages when available, to reduce the page faults and TLB misses of large buffers. Buffers
+    /// smaller than a huge page, such as USB transfers and file reads with their default sizes, use the default memory
+    HugePages,
+    /// Memory carved by a pool from chunks mapped with huge pages, suited to many smaller buffers such as USB
+    /// transfers, file reads or vectors of events
+    Arena
+};
+
+/// @brief Parses a buffer memory type from its name
+/// @param name Name of the type, among "default", "hugepages" and "arena"
+/// @return The buffer memory type
+/// @throw HalException with error code HalErrorCode::InvalidArgument if the name is unknown
+BufferMemoryType parse_buffer_memory_type(const std::string &name);
+
+/// @brief Gets the buffer memory type to use, which can be overridden by the MV_HAL_BUFFER_MEMORY environment variable
+/// @param default_type Type to use if the environment variable is not set
+/// @return The buffer memory type
+BufferMemoryType get_buffer_memory_type(BufferMemoryType default_type = BufferMemoryType::Default);
+
+/// @brief Gets the process-wide memory resource allocating memory of the given type
+/// @param type Type of memory
+/// @return The memory resource, which is never destroyed
+std::pmr::memory_resource *get_buffer_memory_resource(BufferMemoryType type);
+
+/// @brief Memory resource mapping its allocations with huge pages
+///
+/// Allocations are first mapped with explicit huge pages. If none are reserved by the system, transparent huge pages
+/// are requested for the mapping instead. Allocations smaller than a huge page, unless they are mapped as well, and all
+/// allocations on systems without huge pages, are forwarded to the upstream resource.
+class HugePageMemoryResource : public std::pmr::memory_resource {
+public:
+    /// @brief Size of a huge page, in bytes
+    static constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+    /// @brief Constructor
+    /// @param upstream Resource used for the allocations not mapped with huge pages
+    /// @param map_small_allocations If true, allocations smaller than a huge page are mapped with a whole huge page
+    /// as well, which is suited to the upstream of a pool packing small buffers in its chunks
+    explicit HugePageMemoryResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource(),
+                                    bool map_small_allocations           = false);
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    bool is_mapped(std::size_t bytes, std::size_t alignment) const;
+
+    std::pmr::memory_resource *upstream_;
+    bool map_small_allocations_;
+};
+
+/// @brief Counters of the memory accesses that are costly for large buffers
+///
+/// A value of -1 means that the counter is not available on this system.
+struct MemoryAccessCounters {
+    /// Number of page faults serviced without I/O
+    std::int64_t minor_page_faults = -1;
+    /// Number of page faults that required I/O
+    std::int64_t major_page_faults = -1;
+    /// Number of data TLB load misses
+    std::int64_t dtlb_load_misses = -1;
+};
+
+/// @brief Measures the @ref MemoryAccessCounters of the calling thread since the probe was created
+///
+/// Page faults are read from the resource usage of the thread, TLB misses from the hardware performance counters,
+/// which may be restricted by the system (e.g. by /proc/sys/kernel/perf_event_paranoid).
+class MemoryAccessProbe {
+public:
+    /// @brief Constructor, starting the measurement
+    /// @param include_new_threads If true, the threads created by the calling thread after the probe are measured as
+    /// well, e.g. the threads of a camera: their TLB misses are accounted for once they have exited, and the page
+    /// faults are the ones of the whole process
+    explicit MemoryAccessProbe(bool include_new_threads = false);
+
+    /// @brief Destructor
+    ~MemoryAccessProbe();
+
+    MemoryAccessProbe(const MemoryAccessProbe &)            = delete;
+    MemoryAccessProbe &operator=(const MemoryAccessProbe &) = delete;
+
+    /// @brief Gets the counters accumulated since the probe was created
+    MemoryAccessCounters read() const;
+
+private:
+    bool include_new_threads_;
+    int dtlb_fd_ = -1;
+    MemoryAccessCounters start_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_BUFFER_MEMORY_H
@@ -20,6 +20,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -41,7 +42,10 @@ public:
     using Data = uint8_t;
 
     /// Convenience alias for a default object handling the buffers pool
-    using DefaultBufferPool = SharedObjectPool<std::vector<Data>>;
+    ///
+    /// The buffers take a memory resource, so that their memory can be backed by huge pages or an arena (see
+    /// @ref get_buffer_memory_resource).
+    using DefaultBufferPool = SharedObjectPool<std::pmr::vector<Data>>;
 
     /// Convenience alias to a object type from the default type pool
     using DefaultBufferType = DefaultBufferPool::value_type;
@@ -31,8 +31,17 @@ public:
     /// @param config The configuration to use to read the stream
     /// @param buffer_pool The bufferpool to be used to allocate memory for the data transfer
     FileRawDataProducer(std::unique_ptr<std::istream> stream, uint32_t raw_event_size_bytes,
-                        const RawFileConfig &config,
-                        DataTransfer::DefaultBufferPool buffer_pool = DataTransfer::DefaultBufferPool::make_bounded(4));
+                        const RawFileConfig &config, DataTransfer::DefaultBufferPool buffer_pool);
+
+    /// @brief Reads the input standard @a stream batch by batch according to the input configuration
+    ///
+    /// The buffers are allocated from the type of memory of the configuration.
+    ///
+    /// @param stream The stream to read from
+    /// @param raw_event_size_bytes The size of a RAW event in bytes
+    /// @param config The configuration to use to read the stream
+    FileRawDataProducer(std::unique_ptr<std::istream> stream, uint32_t raw_event_size_bytes,
+                        const RawFileConfig &config);
 
     /// @brief Seeks the target position in the file
     /// @param target_position The target position of the cursor to seek in the file
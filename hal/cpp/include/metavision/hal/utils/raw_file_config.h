@@ -15,6 +15,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "metavision/hal/utils/buffer_memory.h"
+
 namespace Metavision {
 
 /// @brief RAW files configuration's options
@@ -31,6 +33,10 @@ public:
     /// usage
     uint32_t n_read_buffers_ = 3;
 
+    /// Type of memory backing the read buffers, which can be overridden by the MV_HAL_BUFFER_MEMORY environment
+    /// variable. Huge pages reduce the page faults and TLB misses when reading large buffers.
+    BufferMemoryType buffer_memory_type_ = BufferMemoryType::Default;
+
     /// Take the first timer high of the file as origin of time
     bool do_time_shifting_ = true;
 
@@ -94,24 +94,43 @@ void I_EventsStreamDecoder::decode(const RawData *const raw_data_begin, const Ra
     }
 
     // Flush the decoders and call time callbacks
+    timestamp last_ts = get_last_timestamp();
     if (cd_event_forwarder_) {
         cd_event_forwarder_->flush();
+        cd_event_decoder_->flush_sinks(last_ts);
     }
     if (cd_event_vector_forwarder_) {
         cd_event_vector_forwarder_->flush();
+        cd_event_vector_decoder_->flush_sinks(last_ts);
     }
     if (trigger_event_forwarder_) {
         trigger_event_forwarder_->flush();
+        ext_trigger_event_decoder_->flush_sinks(last_ts);
     }
     if (erc_count_event_forwarder_) {
         erc_count_event_forwarder_->flush();
+        erc_count_event_decoder_->flush_sinks(last_ts);
     }
-    timestamp last_ts = get_last_timestamp();
     for (auto it = time_cbs_map_.begin(), it_end = time_cbs_map_.end(); it != it_end; ++it) {
         it->second(last_ts);
     }
 }
 
+void I_EventsStreamDecoder::flush_sinks() {
+    if (cd_event_decoder_) {
+        cd_event_decoder_->flush_sinks();
+    }
+    if (cd_event_vector_decoder_) {
+        cd_event_vector_decoder_->flush_sinks();
+    }
+    if (ext_trigger_event_decoder_) {
+        ext_trigger_event_decoder_->flush_sinks();
+    }
+    if (erc_count_event_decoder_) {
+        erc_count_event_decoder_->flush_sinks();
+    }
+}
+
 void I_EventsStreamDecoder::decode(const DataTransfer::BufferPtr &raw_buffer) {
     decode(raw_buffer.begin(), raw_buffer.end());
 }
@@ -131,6 +150,7 @@ bool I_EventsStreamDecoder::remove_time_callback(size_t callback_id) {
 }
 
 bool I_EventsStreamDecoder::reset_last_timestamp(const timestamp &timestamp) {
+    flush_sinks();
     incomplete_raw_data_.clear();
     return reset_last_timestamp_impl(timestamp);
 }
@@ -0,0 +1,195 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/buffer_memory.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+
+namespace Metavision {
+
+BufferMemoryType parse_buffer_memory_type(const std::string &name) {
+    if (name == "default") {
+        return BufferMemoryType::Default;
+    } else if (name == "hugepages") {
+        return BufferMemoryType::HugePages;
+    } else if (name == "arena") {
+        return BufferMemoryType::Arena;
+    }
+    throw HalException(HalErrorCode::InvalidArgument,
+                       "Unknown buffer memory type " + name + ", expected one of: default, hugepages, arena.");
+}
+
+BufferMemoryType get_buffer_memory_type(BufferMemoryType default_type) {
+    const char *env = getenv("MV_HAL_BUFFER_MEMORY");
+    if (!env || env[0] == '\0') {
+        return default_type;
+    }
+    try {
+        return parse_buffer_memory_type(env);
+    } catch (const HalException &) {
+        MV_HAL_LOG_WARNING() << "Invalid MV_HAL_BUFFER_MEMORY value:" << env << ", using the default memory instead";
+        return default_type;
+    }
+}
+
+std::pmr::memory_resource *get_buffer_memory_resource(BufferMemoryType type) {
+    // The resources are never destroyed, as buffers may be released during the static destruction
+    static auto *huge_page_resource = new HugePageMemoryResource();
+    // The pool packs the buffers up to a huge page in chunks that are all mapped with huge pages, larger ones are
+    // mapped directly
+    static auto *arena_resource = new std::pmr::synchronized_pool_resource(
+        std::pmr::pool_options{0, HugePageMemoryResource::kHugePageSize},
+        new HugePageMemoryResource(std::pmr::new_delete_resource(), true));
+    switch (type) {
+    case BufferMemoryType::HugePages:
+        return huge_page_resource;
+    case BufferMemoryType::Arena:
+        return arena_resource;
+    default:
+        return std::pmr::new_delete_resource();
+    }
+}
+
+HugePageMemoryResource::HugePageMemoryResource(std::pmr::memory_resource *upstream, bool map_small_allocations) :
+    upstream_(upstream), map_small_allocations_(map_small_allocations) {}
+
+bool HugePageMemoryResource::is_mapped(std::size_t bytes, std::size_t alignment) const {
+#ifdef __linux__
+    return (bytes >= kHugePageSize || map_small_allocations_) && alignment <= kHugePageSize;
+#else
+    return false;
+#endif
+}
+
+#ifdef __linux__
+namespace {
+std::size_t huge_page_mapping_size(std::size_t bytes) {
+    return (bytes + HugePageMemoryResource::kHugePageSize - 1) & ~(HugePageMemoryResource::kHugePageSize - 1);
+}
+} // namespace
+#endif
+
+void *HugePageMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+#ifdef __linux__
+    if (is_mapped(bytes, alignment)) {
+        const std::size_t size = huge_page_mapping_size(bytes);
+        void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            return p;
+        }
+
+        // No huge page reserved, fall back to transparent huge pages, which require a mapping aligned on a huge page
+        char *q = static_cast<char *>(
+            mmap(nullptr, size + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (q == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char *aligned = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(q) + kHugePageSize - 1) &
+                                                 ~std::uintptr_t(kHugePageSize - 1));
+        if (aligned != q) {
+            munmap(q, aligned - q);
+        }
+        if (aligned + size != q + size + kHugePageSize) {
+            munmap(aligned + size, (q + size + kHugePageSize) - (aligned + size));
+        }
+        madvise(aligned, size, MADV_HUGEPAGE);
+        return aligned;
+    }
+#endif
+    return upstream_->allocate(bytes, alignment);
+}
+
+void HugePageMemoryResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+#ifdef __linux__
+    if (is_mapped(bytes, alignment)) {
+        munmap(p, huge_page_mapping_size(bytes));
+        return;
+    }
+#endif
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+bool HugePageMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    auto *other_resource = dynamic_cast<const HugePageMemoryResource *>(&other);
+    return other_resource && other_resource->map_small_allocations_ == map_small_allocations_ &&
+           other_resource->upstream_->is_equal(*upstream_);
+}
+
+#ifdef __linux__
+namespace {
+void read_page_faults(MemoryAccessCounters &counters, bool include_new_threads) {
+    struct rusage usage;
+    if (getrusage(include_new_threads ? RUSAGE_SELF : RUSAGE_THREAD, &usage) == 0) {
+        counters.minor_page_faults = usage.ru_minflt;
+        counters.major_page_faults = usage.ru_majflt;
+    }
+}
+
+std::int64_t read_counter(int fd) {
+    std::uint64_t value;
+    if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+        return -1;
+    }
+    return static_cast<std::int64_t>(value);
+}
+} // namespace
+#endif
+
+MemoryAccessProbe::MemoryAccessProbe(bool include_new_threads) : include_new_threads_(include_new_threads) {
+#ifdef __linux__
+    struct perf_event_attr attr = {};
+    attr.size                   = sizeof(attr);
+    attr.type                   = PERF_TYPE_HW_CACHE;
+    attr.config                 = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.inherit        = include_new_threads ? 1 : 0;
+    dtlb_fd_            = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+
+    read_page_faults(start_, include_new_threads_);
+    start_.dtlb_load_misses = read_counter(dtlb_fd_);
+#endif
+}
+
+MemoryAccessProbe::~MemoryAccessProbe() {
+#ifdef __linux__
+    if (dtlb_fd_ >= 0) {
+        close(dtlb_fd_);
+    }
+#endif
+}
+
+MemoryAccessCounters MemoryAccessProbe::read() const {
+    MemoryAccessCounters counters;
+#ifdef __linux__
+    read_page_faults(counters, include_new_threads_);
+    counters.dtlb_load_misses = read_counter(dtlb_fd_);
+#endif
+    auto since_start = [](std::int64_t value, std::int64_t start) { return value < 0 ? value : value - start; };
+    counters.minor_page_faults = since_start(counters.minor_page_faults, start_.minor_page_faults);
+    counters.major_page_faults = since_start(counters.major_page_faults, start_.major_page_faults);
+    counters.dtlb_load_misses  = since_start(counters.dtlb_load_misses, start_.dtlb_load_misses);
+    return counters;
+}
+
+} // namespace Metavision
@@ -40,6 +40,12 @@ FileRawDataProducer::FileRawDataProducer(std::unique_ptr<std::istream> stream, u
     seek_buffer_ = buffer_pool_.acquire();
 }
 
+FileRawDataProducer::FileRawDataProducer(std::unique_ptr<std::istream> stream, uint32_t raw_event_size_bytes,
+                                         const RawFileConfig &config) :
+    FileRawDataProducer(std::move(stream), raw_event_size_bytes, config,
+                        DataTransfer::DefaultBufferPool::make_bounded(
+                            4, get_buffer_memory_resource(get_buffer_memory_type(config.buffer_memory_type_)))) {}
+
 bool FileRawDataProducer::seek(const std::streampos &target_position) {
     // If input position is outside the seek range in the stream
     if (target_position < data_start_pos_ || target_position > data_end_pos_) {
@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/decoders/ehc/ehc_decoder.h"
+#include "metavision/sdk/base/events/raw_event_frame_diff.h"
+#include "metavision/sdk/base/events/raw_event_frame_histo.h"
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int kWidth  = 8;
+constexpr int kHeight = 4;
+
+template<typename T>
+std::vector<uint8_t> make_raw_frame(size_t size, T first_value) {
+    std::vector<uint8_t> raw(size);
+    std::iota(raw.begin(), raw.end(), static_cast<uint8_t>(first_value));
+    return raw;
+}
+
+} // namespace
+
+TEST(EHCDecoder_GTest, should_throw_on_invalid_config) {
+    EXPECT_THROW(Histo3dDecoder(kHeight, kWidth, 4, 5, false), std::invalid_argument);
+    EXPECT_THROW(Diff3dDecoder(kHeight, kWidth, 1), std::invalid_argument);
+}
+
+TEST(EHCDecoder_GTest, should_decode_histo_frames_split_across_buffers) {
+    Histo3dDecoder decoder(kHeight, kWidth, 3, 4, true);
+    ASSERT_EQ(2, decoder.get_raw_event_size_bytes());
+
+    std::vector<std::vector<uint8_t>> frames;
+    decoder.add_event_frame_callback([&](const RawEventFrameHisto &frame) {
+        EXPECT_EQ(kWidth, frame.get_config().width);
+        EXPECT_EQ(kHeight, frame.get_config().height);
+        EXPECT_EQ(3, frame.get_config().channel_bit_size[HistogramChannel::NEGATIVE]);
+        EXPECT_EQ(4, frame.get_config().channel_bit_size[HistogramChannel::POSITIVE]);
+        EXPECT_FALSE(frame.get_config().packed);
+        frames.push_back(frame.get_data());
+    });
+
+    // Two and a half frames, decoded in chunks not aligned on frames
+    const size_t frame_size = 2 * kWidth * kHeight;
+    const auto raw          = make_raw_frame(frame_size * 5 / 2, 0);
+    for (size_t i = 0; i < raw.size(); i += 24) {
+        const auto end = std::min(raw.size(), i + 24);
+        decoder.decode(raw.data() + i, raw.data() + end);
+    }
+
+    ASSERT_EQ(2u, frames.size());
+    EXPECT_EQ(std::vector<uint8_t>(raw.begin(), raw.begin() + frame_size), frames[0]);
+    EXPECT_EQ(std::vector<uint8_t>(raw.begin() + frame_size, raw.begin() + 2 * frame_size), frames[1]);
+    ASSERT_NE(nullptr, decoder.get_last_frame());
+    EXPECT_EQ(frames[1], decoder.get_last_frame()->get_data());
+}
+
+TEST(EHCDecoder_GTest, should_decode_diff_frames) {
+    Diff3dDecoder decoder(kHeight, kWidth, 8);
+
+    std::vector<std::vector<int8_t>> frames;
+    decoder.add_event_frame_callback([&](const RawEventFrameDiff &frame) {
+        EXPECT_EQ(8, frame.get_config().bit_size);
+        frames.push_back(frame.get_data());
+    });
+
+    const auto raw = make_raw_frame(kWidth * kHeight, -16);
+    decoder.decode(raw.data(), raw.data() + raw.size());
+
+    ASSERT_EQ(1u, frames.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        EXPECT_EQ(static_cast<int8_t>(raw[i]), frames[0][i]);
+    }
+}
+
+TEST(EHCDecoder_GTest, should_recycle_released_frames) {
+    Histo3dDecoder decoder(kHeight, kWidth, 4, 4, false);
+
+    std::vector<const uint8_t *> buffers;
+    decoder.add_event_frame_callback(
+        [&](const RawEventFrameHisto &frame) { buffers.push_back(frame.get_data().data()); });
+
+    const auto raw = make_raw_frame(kWidth * kHeight, 0);
+    for (int i = 0; i < 10; ++i) {
+        decoder.decode(raw.data(), raw.data() + raw.size());
+    }
+
+    // Only the last frame is still referenced, so that the buffers of the frames and of the decoder go round
+    ASSERT_EQ(10u, buffers.size());
+    for (size_t i = 3; i < buffers.size(); ++i) {
+        EXPECT_EQ(buffers[i - 3], buffers[i]);
+    }
+
+    // A frame held by the user is not recycled
+    auto held_frame = decoder.get_last_frame();
+    for (int i = 0; i < 10; ++i) {
+        decoder.decode(raw.data(), raw.data() + raw.size());
+        EXPECT_NE(held_frame->get_data().data(), buffers.back());
+    }
+    EXPECT_EQ(raw, held_frame->get_data());
+}
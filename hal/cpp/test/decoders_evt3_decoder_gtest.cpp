@@ -357,6 +357,87 @@ TEST_F(Evt3DecoderTest, should_decode_continue_12_12_4_words) {
                                                       << expected_events;
 }
 
+TEST_F(Evt3DecoderTest, should_not_forward_blacklisted_monitoring_events) {
+    EVT3Decoder blacklist_decoder{false, 100, 100, event_cd_decoder, event_ext_decoder, event_erc_decoder,
+                                  event_monitoring_decoder, {0x0001}};
+
+    auto events = decode_buffer(
+        {
+            time_high(0),
+            raw_event(Evt3EventTypes_4bits::OTHERS, 0x0001),
+            raw_event(Evt3EventTypes_4bits::OTHERS, 0x0002),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x123),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x456),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_4, 0x7),
+            addr_y(1),
+            addr_x(2),
+        },
+        blacklist_decoder, *event_cd_decoder, *event_ext_decoder, *event_erc_decoder, *event_monitoring_decoder);
+
+    const std::vector<EventMonitoring> expected_monitoring_events = {
+        // t, type_id, payload
+        {0, 0x0002, 0x7 << 24 | 0x456 << 12 | 0x123},
+    };
+    const std::vector<EventCD> expected_cd_events = {
+        // x. y, p, t
+        {2, 1, 0, 0},
+    };
+    EXPECT_THAT(std::get<EventMonitoringBuffer>(events), ContainerEq(expected_monitoring_events));
+    EXPECT_THAT(std::get<EventCdBuffer>(events), ContainerEq(expected_cd_events));
+}
+
+TEST_F(Evt3DecoderTest, should_decode_with_cd_decoder_only) {
+    const auto cd_only_decoder = make_evt3_decoder(false, 100, 100, event_cd_decoder);
+
+    auto events = decode_buffer(
+        {
+            time_high(0),
+            addr_y(1),
+            addr_x(2),
+            raw_event(Evt3EventTypes_4bits::EXT_TRIGGER, 0x0101),
+            raw_event(Evt3EventTypes_4bits::OTHERS, uint16_t(Evt3MasterEventTypes::MASTER_IN_CD_EVENT_COUNT)),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x123),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x456),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_4, 0x7),
+            addr_x(3, true),
+        },
+        *cd_only_decoder, *event_cd_decoder, *event_ext_decoder, *event_erc_decoder, *event_monitoring_decoder);
+
+    const std::vector<EventCD> expected_events = {
+        // x. y, p, t
+        {2, 1, 0, 0},
+        {3, 1, 1, 0},
+    };
+    EXPECT_THAT(std::get<EventCdBuffer>(events), ContainerEq(expected_events));
+    EXPECT_TRUE(std::get<EventExtBuffer>(events).empty());
+    EXPECT_TRUE(std::get<EventErcBuffer>(events).empty());
+    EXPECT_TRUE(std::get<EventMonitoringBuffer>(events).empty());
+}
+
+TEST_F(Evt3DecoderTest, should_drop_event_types_compiled_out_of_specialized_decoder) {
+    detail::EVT3Decoder<decoder::evt3::BasicCheckValidator, false, true, false> erc_only_decoder{
+        false, 100, 100, event_cd_decoder, event_ext_decoder, event_erc_decoder, event_monitoring_decoder};
+
+    auto events = decode_buffer(
+        {
+            time_high(0),
+            raw_event(Evt3EventTypes_4bits::EXT_TRIGGER, 0x0101),
+            raw_event(Evt3EventTypes_4bits::OTHERS, uint16_t(Evt3MasterEventTypes::MASTER_IN_CD_EVENT_COUNT)),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x123),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_12, 0x456),
+            raw_event(Evt3EventTypes_4bits::CONTINUED_4, 0x7),
+        },
+        erc_only_decoder, *event_cd_decoder, *event_ext_decoder, *event_erc_decoder, *event_monitoring_decoder);
+
+    const std::vector<EventERCCounter> expected_events = {
+        // t, count,                         output
+        {0, 0x7 << 24 | 0x456 << 12 | 0x123, 0},
+    };
+    EXPECT_THAT(std::get<EventErcBuffer>(events), ContainerEq(expected_events));
+    EXPECT_TRUE(std::get<EventExtBuffer>(events).empty());
+    EXPECT_TRUE(std::get<EventMonitoringBuffer>(events).empty());
+}
+
 using Metavision::DecoderProtocolViolation;
 
 struct Evt3RobustDecoderTest : public ::testing::Test {
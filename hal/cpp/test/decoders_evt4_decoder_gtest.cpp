@@ -12,6 +12,7 @@
 #include "metavision/hal/decoders/base/event_base.h"
 #include "metavision/hal/decoders/evt4/evt4_decoder.h"
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 
 #include <cstdint>
 #include <cstdlib>
@@ -285,6 +286,97 @@ TEST_F(Evt4DecoderTest, should_skip_unknown_type) {
     EXPECT_EQ(events.size(), 2);
 }
 
+TEST_F(Evt4DecoderTest, should_decode_full_event_vects_accross_flushes) {
+    // Enough full vectors to fill the forwarder buffer several times
+    DataBuffer data{time_high(0)};
+    for (std::uint16_t y = 0; y < 40; ++y) {
+        data.push_back(event_cd_vec(64, y, 1, y % 2));
+        data.push_back(event_cd_vec_mask(y % 3 ? 0xFFFFFFFF : 0x80000001));
+    }
+    auto events = decode<EventCdBuffer>(std::move(data));
+
+    std::vector<EventCD> expected_events;
+    for (std::uint16_t y = 0; y < 40; ++y) {
+        for (std::uint16_t off = 0; off < 32; ++off) {
+            if (y % 3 || off == 0 || off == 31) {
+                expected_events.emplace_back(64 + off, y, y % 2, 1);
+            }
+        }
+    }
+
+    EXPECT_THAT(events, ContainerEq(expected_events));
+}
+
+TEST(EVT4VectorizedDecoder, should_construct_evt4_decoder) {
+    EXPECT_NO_THROW((EVT4VectorizedDecoder{false}));
+}
+
+struct Evt4VectorDecoderTest : public ::testing::Test {
+    std::shared_ptr<I_EventDecoder<EventCDVector>> event_cd_decoder = std::make_shared<I_EventDecoder<EventCDVector>>();
+
+    EVT4VectorizedDecoder decoder{false, std::nullopt, std::nullopt, event_cd_decoder};
+
+    std::vector<EventCDVector> decode(DataBuffer &&data) {
+        std::vector<EventCDVector> events;
+        auto cb_id = event_cd_decoder->add_event_buffer_callback(
+            [&](auto beg, auto end) { std::copy(beg, end, std::back_inserter(events)); });
+        decoder.decode(begin(data), end(data));
+        event_cd_decoder->remove_callback(cb_id);
+        return events;
+    }
+};
+
+TEST_F(Evt4VectorDecoderTest, should_decode_basic_evt4_stream) {
+    auto events = decode({
+        time_high(0),
+        event_cd(3, 2, 0, false),
+        event_cd(6, 5, 1, true),
+    });
+
+    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+                                                        {3, 2, false, 1U, 0},
+                                                        {6, 5, true, 1U, 1}};
+
+    EXPECT_THAT(events, ContainerEq(expected_events));
+}
+
+TEST_F(Evt4VectorDecoderTest, should_decode_event_vect) {
+    auto events = decode({
+        time_high(1),
+        event_cd_vec(5, 4, 2, false),
+        event_cd_vec_mask(1 << 7 | 1 << 3 | 1),
+        event_cd_vec(10, 6, 3, true),
+        event_cd_vec_mask(0),
+        event_cd_vec(32, 6, 3, true),
+        event_cd_vec_mask(0xFFFFFFFF),
+    });
+
+    // Empty vectors are dropped
+    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+                                                        {5, 4, false, (1 << 7 | 1 << 3 | 1), (1 << 6) + 2},
+                                                        {32, 6, true, 0xFFFFFFFF, (1 << 6) + 3}};
+
+    EXPECT_THAT(events, ContainerEq(expected_events));
+}
+
+TEST_F(Evt4VectorDecoderTest, should_decode_cd_vec_accross_multiple_calls) {
+    auto events_1 = decode({
+        time_high(0),
+        event_cd_vec(5, 4, 0, false),
+        event_cd_vec_mask(1 << 7 | 1 << 3 | 1),
+        event_cd_vec(10, 6, 0, true),
+    });
+    EXPECT_EQ(events_1.size(), 1);
+
+    auto events_2 = decode({
+        event_cd_vec_mask(1 << 14 | 1 << 10 | 1 << 4),
+    });
+
+    const std::vector<EventCDVector> expected_events_2 = {// base_x, y, polarity, vector_mask, event_timestamp
+                                                          {10, 6, true, (1 << 14 | 1 << 10 | 1 << 4), 0}};
+    EXPECT_THAT(events_2, ContainerEq(expected_events_2));
+}
+
 TEST(UnsafeEVT4Decoder, should_construct_evt4_decoder) {
     EXPECT_NO_THROW((UnsafeEVT4Decoder{false}));
 }
@@ -0,0 +1,181 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "metavision/hal/decoders/evt2/evt2_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/sdk/base/events/event_cd.h"
+
+using namespace Metavision;
+
+namespace {
+
+class RecordingSink : public I_EventDecoder<EventCD>::EventBufferSink {
+public:
+    RecordingSink(size_t batch_size, timestamp max_latency) : batch_size_(batch_size), max_latency_(max_latency) {}
+
+    void on_event_buffer(const EventCD *begin, const EventCD *end) override {
+        batch_sizes_.push_back(std::distance(begin, end));
+        events_.insert(events_.end(), begin, end);
+    }
+
+    size_t get_preferred_batch_size() const override {
+        return batch_size_;
+    }
+
+    timestamp get_max_latency() const override {
+        return max_latency_;
+    }
+
+    std::vector<size_t> batch_sizes_;
+    std::vector<EventCD> events_;
+
+private:
+    const size_t batch_size_;
+    const timestamp max_latency_;
+};
+
+std::vector<EventCD> make_events(size_t n, timestamp t0) {
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n; ++i) {
+        events.emplace_back(i % 640, i % 480, i % 2, t0 + i);
+    }
+    return events;
+}
+
+std::vector<EVT2Decoder::RawEvent> make_evt2_events(size_t n) {
+    std::vector<EVT2Decoder::RawEvent> raw_events(n + 1);
+    raw_events[0].type  = static_cast<EventTypesUnderlying_t>(EVT2EventTypes::EVT_TIME_HIGH);
+    raw_events[0].trail = 1;
+    for (size_t i = 0; i < n; ++i) {
+        auto *ev      = reinterpret_cast<EVT2Event2D *>(&raw_events[i + 1]);
+        ev->type      = static_cast<EventTypesUnderlying_t>(EVT2EventTypes::CD_ON);
+        ev->timestamp = i;
+        ev->x         = i;
+        ev->y         = i;
+    }
+    return raw_events;
+}
+
+} // namespace
+
+TEST(I_EventDecoder_GTest, sink_without_preferences_receives_decoded_batches) {
+    // GIVEN a decoder with a sink having no batch size preference
+    I_EventDecoder<EventCD> decoder;
+    RecordingSink sink(0, 0);
+    decoder.add_event_buffer_sink(sink);
+
+    // WHEN adding buffers of events
+    const auto events = make_events(10, 0);
+    decoder.add_event_buffer(events.data(), events.data() + 4);
+    decoder.add_event_buffer(events.data() + 4, events.data() + 10);
+
+    // THEN the sink receives the buffers as they are
+    EXPECT_EQ(std::vector<size_t>({4, 6}), sink.batch_sizes_);
+    EXPECT_EQ(events, sink.events_);
+}
+
+TEST(I_EventDecoder_GTest, sink_receives_batches_of_preferred_size) {
+    // GIVEN a decoder with a sink asking for batches of 10 events, with a long latency
+    I_EventDecoder<EventCD> decoder;
+    RecordingSink sink(10, 1000);
+    decoder.add_event_buffer_sink(sink);
+
+    // WHEN adding small buffers of events, and flushing before the latency elapsed
+    const auto events = make_events(25, 0);
+    for (size_t i = 0; i < events.size(); i += 4) {
+        decoder.add_event_buffer(events.data() + i, events.data() + std::min(i + 4, events.size()));
+        decoder.flush_sinks(events[i].t);
+    }
+
+    // THEN the events are gathered in batches of at least the preferred size
+    EXPECT_EQ(std::vector<size_t>({12, 12}), sink.batch_sizes_);
+
+    // WHEN removing the sink
+    EXPECT_TRUE(decoder.remove_callback(0));
+    EXPECT_FALSE(decoder.remove_callback(0));
+
+    // THEN the pending events are delivered
+    EXPECT_EQ(std::vector<size_t>({12, 12, 1}), sink.batch_sizes_);
+    EXPECT_EQ(events, sink.events_);
+}
+
+TEST(I_EventDecoder_GTest, sink_receives_incomplete_batch_once_latency_elapsed) {
+    // GIVEN a decoder with a sink asking for large batches, with a latency of 100us
+    I_EventDecoder<EventCD> decoder;
+    RecordingSink sink(1000, 100);
+    decoder.add_event_buffer_sink(sink);
+
+    // WHEN adding a few events and flushing before and after the latency elapsed
+    const auto events = make_events(5, 1000);
+    decoder.add_event_buffer(events.data(), events.data() + events.size());
+    decoder.flush_sinks(1099);
+    EXPECT_TRUE(sink.batch_sizes_.empty());
+    decoder.flush_sinks(1100);
+
+    // THEN the incomplete batch is delivered once the latency elapsed
+    EXPECT_EQ(std::vector<size_t>({5}), sink.batch_sizes_);
+}
+
+TEST(I_EventDecoder_GTest, sink_receives_pending_events_when_all_sinks_are_flushed) {
+    // GIVEN a decoder with a sink asking for large batches, with a long latency
+    I_EventDecoder<EventCD> decoder;
+    RecordingSink sink(1000, 1000);
+    decoder.add_event_buffer_sink(sink);
+
+    // WHEN adding a few events and flushing all the sinks
+    const auto events = make_events(5, 0);
+    decoder.add_event_buffer(events.data(), events.data() + events.size());
+    decoder.flush_sinks(10);
+    EXPECT_TRUE(sink.batch_sizes_.empty());
+    decoder.flush_sinks();
+
+    // THEN the pending events are delivered, whatever the batch size and latency
+    EXPECT_EQ(std::vector<size_t>({5}), sink.batch_sizes_);
+    EXPECT_EQ(events, sink.events_);
+
+    // WHEN flushing again
+    decoder.flush_sinks();
+
+    // THEN nothing more is delivered
+    EXPECT_EQ(std::vector<size_t>({5}), sink.batch_sizes_);
+}
+
+TEST(I_EventDecoder_GTest, stream_decoder_delivers_pending_events_at_end_of_stream) {
+    // GIVEN a stream decoder whose CD events decoder has a sink asking for large batches, with a long latency
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    EVT2Decoder decoder(false, cd_decoder);
+    RecordingSink sink(1000, 1000000);
+    cd_decoder->add_event_buffer_sink(sink);
+
+    // WHEN decoding a few events
+    const auto raw_events = make_evt2_events(3);
+    const auto *raw_begin = reinterpret_cast<const std::uint8_t *>(raw_events.data());
+    decoder.decode(raw_begin, raw_begin + raw_events.size() * sizeof(EVT2Decoder::RawEvent));
+
+    // THEN they are held until the stream decoder flushes the sinks, e.g. when the stream ends
+    EXPECT_TRUE(sink.batch_sizes_.empty());
+    decoder.flush_sinks();
+    ASSERT_EQ(std::vector<size_t>({3}), sink.batch_sizes_);
+    EXPECT_EQ(EventCD(2, 2, 1, 64 + 2), sink.events_.back());
+
+    // WHEN decoding more events and resetting the decoder, e.g. when the stream restarts
+    decoder.decode(raw_begin, raw_begin + raw_events.size() * sizeof(EVT2Decoder::RawEvent));
+    EXPECT_EQ(std::vector<size_t>({3}), sink.batch_sizes_);
+    decoder.reset_last_timestamp(-1);
+
+    // THEN the events decoded before the reset are delivered in a batch of their own
+    EXPECT_EQ(std::vector<size_t>({3, 3}), sink.batch_sizes_);
+}
@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/buffer_memory.h"
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+using namespace Metavision;
+
+TEST(BufferMemory, should_parse_buffer_memory_types) {
+    EXPECT_EQ(BufferMemoryType::Default, parse_buffer_memory_type("default"));
+    EXPECT_EQ(BufferMemoryType::HugePages, parse_buffer_memory_type("hugepages"));
+    EXPECT_EQ(BufferMemoryType::Arena, parse_buffer_memory_type("arena"));
+    EXPECT_THROW(parse_buffer_memory_type("huge"), HalException);
+}
+
+#ifndef _WIN32
+TEST(BufferMemory, should_override_buffer_memory_type_from_environment) {
+    unsetenv("MV_HAL_BUFFER_MEMORY");
+    EXPECT_EQ(BufferMemoryType::Arena, get_buffer_memory_type(BufferMemoryType::Arena));
+
+    setenv("MV_HAL_BUFFER_MEMORY", "hugepages", 1);
+    EXPECT_EQ(BufferMemoryType::HugePages, get_buffer_memory_type(BufferMemoryType::Arena));
+
+    setenv("MV_HAL_BUFFER_MEMORY", "invalid", 1);
+    EXPECT_EQ(BufferMemoryType::Default, get_buffer_memory_type());
+    unsetenv("MV_HAL_BUFFER_MEMORY");
+}
+#endif
+
+TEST(BufferMemory, should_allocate_buffers_from_all_memory_types) {
+    for (auto type : {BufferMemoryType::Default, BufferMemoryType::HugePages, BufferMemoryType::Arena}) {
+        auto pool = DataTransfer::DefaultBufferPool::make_bounded(2, get_buffer_memory_resource(type));
+
+        // Buffers both smaller and larger than a huge page, so that both allocation paths are used
+        for (size_t size : {size_t(4096), 3 * HugePageMemoryResource::kHugePageSize + 1}) {
+            auto buffer = pool.acquire();
+            EXPECT_EQ(get_buffer_memory_resource(type), buffer->get_allocator().resource());
+            buffer->resize(size);
+            std::memset(buffer->data(), 0xA5, buffer->size());
+            EXPECT_EQ(0xA5, (*buffer)[size - 1]);
+        }
+    }
+}
+
+TEST(BufferMemory, should_map_small_allocations_when_requested) {
+    HugePageMemoryResource resource(std::pmr::new_delete_resource(), true);
+
+    // A buffer smaller than a huge page, such as a USB transfer, gets a whole huge page
+    void *p = resource.allocate(128 * 1024);
+#ifdef __linux__
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p) % HugePageMemoryResource::kHugePageSize);
+#endif
+    std::memset(p, 0xA5, 128 * 1024);
+    resource.deallocate(p, 128 * 1024);
+}
+
+namespace {
+// Writes then reads a byte of each page of a buffer larger than what the TLBs can map
+std::int64_t touch_pages(std::vector<char> &buffer) {
+    std::memset(buffer.data(), 1, buffer.size());
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < buffer.size(); i += 4096) {
+        sum += reinterpret_cast<volatile char *>(buffer.data())[i];
+    }
+    return sum;
+}
+} // namespace
+
+TEST(BufferMemory, should_measure_page_faults) {
+    MemoryAccessProbe probe;
+
+    std::vector<char> buffer(16 * 1024 * 1024);
+    touch_pages(buffer);
+
+    const auto counters = probe.read();
+#ifdef __linux__
+    // Touching newly allocated pages triggers page faults
+    EXPECT_GT(counters.minor_page_faults, 0);
+    EXPECT_GE(counters.major_page_faults, 0);
+#else
+    EXPECT_EQ(-1, counters.minor_page_faults);
+    EXPECT_EQ(-1, counters.dtlb_load_misses);
+#endif
+}
+
+TEST(BufferMemory, should_measure_tlb_misses) {
+    MemoryAccessProbe probe;
+    if (probe.read().dtlb_load_misses < 0) {
+        GTEST_SKIP() << "TLB misses are not available on this system (perf_event_open failed)";
+    }
+
+    std::vector<char> buffer(16 * 1024 * 1024);
+    touch_pages(buffer);
+
+    // Reading one byte per page of 16 MiB misses in the first level data TLB
+    EXPECT_GT(probe.read().dtlb_load_misses, 0);
+}
+
+#ifdef __linux__
+TEST(BufferMemory, should_measure_threads_created_after_the_probe) {
+    MemoryAccessProbe probe(true);
+    const auto thread_misses_available = probe.read().dtlb_load_misses >= 0;
+
+    std::thread thread([]() {
+        std::vector<char> buffer(16 * 1024 * 1024);
+        touch_pages(buffer);
+    });
+    thread.join();
+
+    // The page faults of the thread are counted, and so are its TLB misses once it exited
+    const auto counters = probe.read();
+    EXPECT_GE(counters.minor_page_faults, 16 * 1024 * 1024 / 4096);
+    if (thread_misses_available) {
+        EXPECT_GT(counters.dtlb_load_misses, 0);
+    }
+}
+#endif
@@ -0,0 +1,276 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "hal_python_binder.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace {
+
+/// @brief Accumulates the events produced by a CD decoder in native memory and hands them to python in large batches
+///
+/// The decoder callback never touches the GIL: events are appended to a buffer acquired from a pool and the buffer is
+/// queued once it holds @p max_events events or spans @p max_duration_us microseconds. Python retrieves each batch
+/// as a numpy array sharing the memory of the buffer, which is given back to the pool when the array is released.
+class EventCDBatchConsumer {
+public:
+    using Batch    = std::vector<EventCD>;
+    using BatchPtr = SharedObjectPool<Batch>::ptr_type;
+
+    EventCDBatchConsumer(I_EventDecoder<EventCD> &decoder, size_t max_events, timestamp max_duration_us,
+                         uint32_t max_latency_ms, size_t max_pending_batches, size_t pool_size) :
+        decoder_(decoder),
+        max_events_(max_events),
+        max_duration_us_(max_duration_us),
+        max_latency_(max_latency_ms),
+        max_pending_batches_(max_pending_batches),
+        pool_(SharedObjectPool<Batch>::make_unbounded(pool_size)) {
+        if (max_events_ == 0) {
+            throw std::invalid_argument("Invalid batch size: max_events must be strictly positive.");
+        }
+        cb_id_ = decoder_.add_event_buffer_callback(
+            [this](const EventCD *begin, const EventCD *end) { add_events(begin, end); });
+    }
+
+    ~EventCDBatchConsumer() {
+        decoder_.remove_callback(cb_id_);
+        stop();
+    }
+
+    /// @brief Appends decoded events to the batch being filled, queueing it each time it is complete
+    ///
+    /// Events decoded after @ref stop are dropped, so that the iteration ends once the queue is drained.
+    void add_events(const EventCD *begin, const EventCD *end) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            num_dropped_events_ += std::distance(begin, end);
+            return;
+        }
+        while (begin != end) {
+            if (!current_) {
+                current_ = pool_.acquire();
+                current_->clear();
+                current_->reserve(max_events_);
+            }
+
+            const size_t free_slots = max_events_ - current_->size();
+            auto last               = begin + std::min<size_t>(free_slots, std::distance(begin, end));
+            bool complete           = (last - begin) == static_cast<std::ptrdiff_t>(free_slots);
+            if (max_duration_us_ > 0) {
+                const timestamp end_ts = (current_->empty() ? begin->t : current_->front().t) + max_duration_us_;
+                auto split =
+                    std::lower_bound(begin, last, end_ts, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+                if (split != last) {
+                    last     = split;
+                    complete = true;
+                }
+            }
+
+            current_->insert(current_->end(), begin, last);
+            begin = last;
+            if (complete) {
+                queue_current_batch();
+            }
+        }
+    }
+
+    /// @brief Queues the partially filled batch, if any
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_current_batch();
+    }
+
+    /// @brief Flushes the pending events and wakes up the readers, the iteration ends once the queue is drained
+    ///
+    /// The events decoded afterwards are dropped.
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_current_batch();
+        stopped_ = true;
+        cond_.notify_all();
+    }
+
+    /// @brief Waits for a complete batch
+    ///
+    /// When no batch is completed before the timeout, the partially filled batch is returned instead so that the
+    /// latency between decoding and delivery stays bounded.
+    /// @param timeout Maximum wait duration
+    /// @return The next batch, or nullptr if no event was received during the timeout
+    BatchPtr wait_batch(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait_for(lock, timeout, [this] { return !ready_.empty() || stopped_; });
+        if (ready_.empty()) {
+            queue_current_batch();
+        }
+        if (ready_.empty()) {
+            return BatchPtr();
+        }
+        auto batch = std::move(ready_.front());
+        ready_.pop_front();
+        return batch;
+    }
+
+    bool is_done() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stopped_ && ready_.empty() && !current_;
+    }
+
+    size_t get_num_pending_batches() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ready_.size();
+    }
+
+    size_t get_num_dropped_events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_dropped_events_;
+    }
+
+    std::chrono::milliseconds get_max_latency() const {
+        return max_latency_;
+    }
+
+private:
+    // Must be called with mutex_ held
+    void queue_current_batch() {
+        if (!current_ || current_->empty()) {
+            return;
+        }
+        if (max_pending_batches_ > 0 && ready_.size() >= max_pending_batches_) {
+            num_dropped_events_ += ready_.front()->size();
+            ready_.pop_front();
+        }
+        ready_.emplace_back(std::move(current_));
+        current_.reset();
+        cond_.notify_one();
+    }
+
+    I_EventDecoder<EventCD> &decoder_;
+    size_t cb_id_;
+    const size_t max_events_;
+    const timestamp max_duration_us_;
+    const std::chrono::milliseconds max_latency_;
+    const size_t max_pending_batches_;
+
+    SharedObjectPool<Batch> pool_;
+    BatchPtr current_;
+    std::deque<BatchPtr> ready_;
+    size_t num_dropped_events_{0};
+    bool stopped_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+py::array_t<EventCD> to_numpy(EventCDBatchConsumer::BatchPtr batch) {
+    // the capsule holds a reference on the pooled buffer, which is given back to the pool when python releases the
+    // array
+    auto holder = new EventCDBatchConsumer::BatchPtr(std::move(batch));
+    py::capsule capsule(holder, [](void *v) { delete reinterpret_cast<EventCDBatchConsumer::BatchPtr *>(v); });
+    return py::array_t<EventCD>((*holder)->size(), (*holder)->data(), capsule);
+}
+
+py::object get_batch(EventCDBatchConsumer &self, int timeout_ms) {
+    EventCDBatchConsumer::BatchPtr batch;
+    {
+        py::gil_scoped_release release;
+        batch = self.wait_batch(std::chrono::milliseconds(timeout_ms < 0 ? self.get_max_latency().count() :
+                                                                           static_cast<int64_t>(timeout_ms)));
+    }
+    if (!batch) {
+        return py::none();
+    }
+    return to_numpy(std::move(batch));
+}
+
+py::array_t<EventCD> next_batch(EventCDBatchConsumer &self) {
+    while (true) {
+        EventCDBatchConsumer::BatchPtr batch;
+        {
+            py::gil_scoped_release release;
+            batch = self.wait_batch(self.get_max_latency());
+        }
+        if (batch) {
+            return to_numpy(std::move(batch));
+        }
+        if (self.is_done()) {
+            throw py::stop_iteration();
+        }
+        // Gives a chance to KeyboardInterrupt & co to be raised while waiting for events
+        if (PyErr_CheckSignals() != 0) {
+            throw py::error_already_set();
+        }
+    }
+}
+
+} // anonymous namespace
+
+static HALClassPythonBinder<EventCDBatchConsumer> bind(
+    [](auto &module, auto &class_binding) {
+        class_binding
+            .def(py::init<I_EventDecoder<EventCD> &, size_t, timestamp, uint32_t, size_t, size_t>(),
+                 py::keep_alive<1, 2>(), py::arg("decoder"), py::arg("max_events") = 100000,
+                 py::arg("max_duration_us") = 0, py::arg("max_latency_ms") = 100, py::arg("max_pending_batches") = 0,
+                 py::arg("pool_size") = 8,
+                 "Registers a callback on the decoder that accumulates the decoded events in native memory\n"
+                 "\n"
+                 "Args:\n"
+                 "    decoder (I_EventDecoder_EventCD): CD decoder to consume events from\n"
+                 "    max_events (int): maximum number of events in a batch\n"
+                 "    max_duration_us (int): maximum duration of a batch in us, based on the events timestamps\n"
+                 "        (0 to disable)\n"
+                 "    max_latency_ms (int): maximum wall-clock time to wait for a complete batch before handing\n"
+                 "        out the events accumulated so far\n"
+                 "    max_pending_batches (int): maximum number of batches waiting to be consumed, the oldest\n"
+                 "        batch being dropped when exceeded (0 for no limit)\n"
+                 "    pool_size (int): number of batch buffers initially allocated\n")
+            .def("__iter__", [](EventCDBatchConsumer &self) -> EventCDBatchConsumer & { return self; })
+            .def("__next__", &next_batch,
+                 "Waits, with the GIL released, for the next batch of events and returns it as a numpy array\n"
+                 "sharing the memory of the batch. The iteration ends once stop() has been called and all\n"
+                 "pending batches have been consumed.")
+            .def("get", &get_batch, py::arg("timeout_ms") = -1,
+                 "Waits, with the GIL released, for a batch of events\n"
+                 "\n"
+                 "Args:\n"
+                 "    timeout_ms (int): maximum wait duration, max_latency_ms if negative\n"
+                 "\n"
+                 "Returns:\n"
+                 "    A numpy array of EventCD, or None if no event was decoded during the timeout\n")
+            .def("flush", &EventCDBatchConsumer::flush, "Makes the partially filled batch available to the readers.")
+            .def("stop", &EventCDBatchConsumer::stop, py::call_guard<py::gil_scoped_release>(),
+                 "Flushes the pending events and ends the iteration once all batches have been consumed.\n"
+                 "Events decoded afterwards are dropped.")
+            .def("get_num_pending_batches", &EventCDBatchConsumer::get_num_pending_batches,
+                 "Returns the number of complete batches waiting to be consumed.")
+            .def("get_num_dropped_events", &EventCDBatchConsumer::get_num_dropped_events,
+                 "Returns the number of events dropped because max_pending_batches was reached or because they\n"
+                 "were decoded after stop().");
+    },
+    "EventCDBatchConsumer",
+    "Consumes the events of a CD decoder in large batches, handed to python as zero-copy numpy arrays.\n"
+    "\n"
+    "The decoder callback runs without the GIL, so that decoding from another thread (e.g. a data transfer\n"
+    "callback) never contends with python code.");
+
+} // namespace Metavision
@@ -0,0 +1,46 @@
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+import os
+
+import metavision_hal
+
+
+def decode_next_buffer(device):
+    if device.get_i_events_stream().wait_next_buffer() < 0:
+        return False
+    raw_data = device.get_i_events_stream().get_latest_raw_data()
+    device.get_i_events_stream_decoder().decode(raw_data)
+    return True
+
+
+def pytestcase_event_cd_batch_consumer_iteration_ends_after_stop(dataset_dir):
+    """
+    Checks that the iteration ends after stop() and that the events decoded afterwards are dropped
+    """
+    # GIVEN a consumer fed with a few buffers of a recording
+    filename = os.path.join(dataset_dir, "openeb", "gen4_evt2_hand.raw")
+    device = metavision_hal.DeviceDiscovery.open_raw_file(filename)
+    assert device is not None
+    device.get_i_events_stream().start()
+    consumer = metavision_hal.EventCDBatchConsumer(device.get_i_event_cd_decoder(), max_events=1000)
+    for _ in range(5):
+        assert decode_next_buffer(device)
+
+    # WHEN stopping the consumer and decoding more buffers
+    consumer.stop()
+    num_dropped_events = consumer.get_num_dropped_events()
+    while decode_next_buffer(device) and consumer.get_num_dropped_events() == num_dropped_events:
+        pass
+
+    # THEN the iteration only returns the events decoded before stop() and ends
+    num_events = sum(batch.size for batch in consumer)
+    assert num_events > 0
+    assert consumer.get_num_dropped_events() > num_dropped_events
+    assert consumer.get(timeout_ms=0) is None
@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_CONFIG_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_CONFIG_H
+
+#include <cstdint>
+#include <string>
+
+#include "metavision/hal/utils/device_config.h"
+
+namespace Metavision {
+
+/// @brief Settings of the synthetic camera, read from the @ref DeviceConfig used to open it
+///
+/// All the settings can be passed as key/value pairs of the device config, for instance:
+/// @code{.cpp}
+/// DeviceConfig config;
+/// config.set_format("EVT3");
+/// config.set("synthetic_scene", "bursts");
+/// config.set("synthetic_event_rate", 150.);
+/// config.set("synthetic_real_time", false);
+/// auto device = DeviceDiscovery::open("synthetic", config);
+/// @endcode
+struct SyntheticCameraConfig {
+    /// @brief Scene model used to generate the CD events
+    enum class Scene {
+        /// Uniformly distributed background activity
+        Noise,
+        /// A horizontal bar sweeping the sensor top to bottom, its edges generating rows of ON and OFF events
+        MovingBars,
+        /// A rectangular area flickering at 100 Hz in the middle of the sensor
+        Flicker,
+        /// Background activity interrupted every 10 ms by a 1 ms burst of dense rows at the configured rate
+        Bursts
+    };
+
+    static const std::string kSceneKey;
+    static const std::string kEventRateKey;
+    static const std::string kWidthKey;
+    static const std::string kHeightKey;
+    static const std::string kRealTimeKey;
+    static const std::string kSeedKey;
+
+    /// @brief Parses the settings from a device config, using default values for missing keys
+    /// @throw HalException if a value is out of the supported range
+    static SyntheticCameraConfig from_device_config(const DeviceConfig &config);
+
+    /// @brief Returns the description of the supported device config options
+    static DeviceConfigOptionMap get_device_config_options();
+
+    /// @brief Returns the name of the scene, as expected by the device config
+    static std::string to_string(Scene scene);
+
+    /// Encoding format of the generated raw data, either "EVT2" or "EVT3"
+    std::string format = "EVT3";
+
+    Scene scene = Scene::MovingBars;
+
+    /// Event rate in Mev/s (i.e. events per microsecond). For @ref Scene::Bursts, this is the peak rate reached
+    /// during a burst
+    double event_rate = 10.;
+
+    int width  = 1280;
+    int height = 720;
+
+    /// If true, the data is produced at the pace of the sensor time, otherwise as fast as possible
+    bool real_time = true;
+
+    uint32_t seed = 42;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_CONFIG_H
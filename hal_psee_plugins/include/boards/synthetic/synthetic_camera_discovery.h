@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_DISCOVERY_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_DISCOVERY_H
+
+#include <string>
+
+#include "metavision/hal/utils/camera_discovery.h"
+
+namespace Metavision {
+
+/// @brief Discovery of the synthetic camera
+///
+/// The synthetic camera is always available, under the serial @ref SyntheticHWIdentification::kSerial. The scene,
+/// format and rate are selected through the @ref DeviceConfig, see @ref SyntheticCameraConfig.
+class SyntheticCameraDiscovery : public CameraDiscovery {
+public:
+    SerialList list() override;
+    SystemList list_available_sources() override;
+    bool discover(DeviceBuilder &device_builder, const std::string &serial, const DeviceConfig &config) override;
+    bool is_for_local_camera() const override;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_CAMERA_DISCOVERY_H
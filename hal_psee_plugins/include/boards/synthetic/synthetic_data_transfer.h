@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_DATA_TRANSFER_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_DATA_TRANSFER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+#include "boards/synthetic/synthetic_event_encoder.h"
+#include "boards/synthetic/synthetic_scene_generator.h"
+#include "boards/synthetic/synthetic_sensor_state.h"
+
+namespace Metavision {
+
+/// @brief Raw data producer of the synthetic camera
+///
+/// The sensor time is cut in slices; for each slice the scene events are generated, filtered according to the ROI and
+/// ERC settings of the @ref SyntheticSensorState, merged with the loopback trigger events and encoded into one
+/// buffer. In real time mode, the producer sleeps so that buffers are transferred at the pace of the sensor time.
+/// Otherwise, it is only paced by the consumer: buffers come from a bounded pool, so that the producer waits for one to
+/// be released when the consumer is late, instead of piling up generated data.
+class SyntheticDataTransfer : public DataTransfer::RawDataProducer {
+public:
+    /// Number of buffers in the pool, i.e. maximum number of transferred buffers that are not yet released
+    static constexpr size_t kBufferPoolSize = 4;
+
+    SyntheticDataTransfer(const SyntheticCameraConfig &config, const std::shared_ptr<SyntheticSensorState> &state);
+
+    /// @brief Encodes the slice of sensor time [@p t_begin, @p t_end) and appends it to @p out
+    ///
+    /// This is the work done by the streaming thread for each buffer, exposed to be usable without a device.
+    void produce(timestamp t_begin, timestamp t_end, DataTransfer::DefaultBufferType &out);
+
+    /// @brief Returns the duration of sensor time covered by each transferred buffer, in us
+    timestamp get_slice_duration() const;
+
+private:
+    void run_impl(const DataTransfer &data_transfer) override final;
+
+    void refresh_settings();
+    void apply_roi();
+    void apply_erc(timestamp t_begin, timestamp t_end);
+    void add_triggers(timestamp t_begin, timestamp t_end);
+
+    DataTransfer::DefaultBufferPool buffer_pool_;
+    const SyntheticCameraConfig config_;
+    const timestamp slice_us_;
+    std::shared_ptr<SyntheticSensorState> state_;
+    SyntheticSceneGenerator generator_;
+    std::unique_ptr<SyntheticEventEncoder> encoder_;
+    timestamp current_time_ = 0;
+
+    // Local copy of the sensor settings, refreshed when the state version changes
+    uint64_t settings_version_ = static_cast<uint64_t>(-1);
+    SyntheticSensorState::Settings settings_;
+    std::vector<uint8_t> pixel_mask_;
+
+    std::vector<EventCD> events_;
+    std::vector<EventExtTrigger> triggers_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_DATA_TRANSFER_H
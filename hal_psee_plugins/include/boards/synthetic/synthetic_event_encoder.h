@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_EVENT_ENCODER_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_EVENT_ENCODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Streaming encoder appending events to a raw data buffer
+///
+/// The encoder keeps the time base (and, for EVT3, the address) state across calls, so that the buffers produced by
+/// consecutive calls form a single valid stream. Events must be passed in increasing timestamp order.
+class SyntheticEventEncoder {
+public:
+    virtual ~SyntheticEventEncoder() = default;
+
+    /// @brief Creates the encoder for the format named @p format ("EVT2" or "EVT3")
+    /// @param format Name of the format to encode to
+    /// @param width Width of the sensor the events are generated for
+    /// @throw HalException if the format is not supported
+    static std::unique_ptr<SyntheticEventEncoder> make(const std::string &format, int width);
+
+    /// @brief Appends the encoding of the CD events in [@p begin, @p end) to @p out
+    virtual void encode(const EventCD *begin, const EventCD *end, DataTransfer::DefaultBufferType &out) = 0;
+
+    /// @brief Appends the encoding of a trigger event to @p out
+    virtual void encode(const EventExtTrigger &ev, DataTransfer::DefaultBufferType &out) = 0;
+
+    /// @brief Appends the time base events needed for the decoder to reach the timestamp @p t
+    ///
+    /// As a sensor does, the time high events are emitted even when there is no activity, so that the time keeps
+    /// flowing downstream.
+    virtual void advance_time(timestamp t, DataTransfer::DefaultBufferType &out) = 0;
+};
+
+/// @brief Encoder for the EVT2 format
+class SyntheticEvt2Encoder : public SyntheticEventEncoder {
+public:
+    void encode(const EventCD *begin, const EventCD *end, DataTransfer::DefaultBufferType &out) override;
+    void encode(const EventExtTrigger &ev, DataTransfer::DefaultBufferType &out) override;
+    void advance_time(timestamp t, DataTransfer::DefaultBufferType &out) override;
+
+private:
+    uint32_t *write_time_high(timestamp t, uint32_t *w);
+
+    timestamp last_time_high_ = -1;
+};
+
+/// @brief Encoder for the EVT3 format
+///
+/// Runs of events sharing a timestamp, a row and a polarity are packed into VECT_12/VECT_12/VECT_8 words. As the
+/// decoder rejects vectors overflowing the sensor, the events of the last 31 columns are always sent one by one.
+class SyntheticEvt3Encoder : public SyntheticEventEncoder {
+public:
+    explicit SyntheticEvt3Encoder(int width);
+
+    void encode(const EventCD *begin, const EventCD *end, DataTransfer::DefaultBufferType &out) override;
+    void encode(const EventExtTrigger &ev, DataTransfer::DefaultBufferType &out) override;
+    void advance_time(timestamp t, DataTransfer::DefaultBufferType &out) override;
+
+private:
+    uint16_t *write_time(timestamp t, uint16_t *w);
+
+    const int width_;
+    timestamp last_time_high_ = -1;
+    timestamp last_time_low_  = -1;
+    int last_y_               = -1;
+    // Abscissa and polarity the decoder will assign to the next vector, negative if unknown
+    int next_vect_x_ = -1;
+    int vect_p_      = -1;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_EVENT_ENCODER_H
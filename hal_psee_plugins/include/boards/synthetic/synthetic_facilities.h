@@ -0,0 +1,139 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_FACILITIES_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_FACILITIES_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/facilities/i_erc_module.h"
+#include "metavision/hal/facilities/i_ll_biases.h"
+#include "metavision/hal/facilities/i_roi.h"
+#include "metavision/hal/facilities/i_trigger_in.h"
+#include "metavision/hal/facilities/i_trigger_out.h"
+#include "metavision/hal/utils/device_control.h"
+#include "boards/synthetic/synthetic_sensor_state.h"
+
+namespace Metavision {
+
+/// @brief Biases of the synthetic camera
+///
+/// Mimics the relative biases of an IMX636 sensor. Values are only stored, they have no effect on the scene.
+class SyntheticLLBiases : public I_LL_Biases {
+public:
+    SyntheticLLBiases(const DeviceConfig &device_config, const std::shared_ptr<SyntheticSensorState> &state);
+
+    std::map<std::string, int> get_all_biases() const override;
+
+private:
+    bool set_impl(const std::string &bias_name, int bias_value) override;
+    int get_impl(const std::string &bias_name) const override;
+    bool get_bias_info_impl(const std::string &bias_name, LL_Bias_Info &bias_info) const override;
+
+    std::shared_ptr<SyntheticSensorState> state_;
+    std::map<std::string, LL_Bias_Info> biases_info_;
+};
+
+/// @brief Event rate controller of the synthetic camera
+///
+/// When enabled, events exceeding the event count of a counting window are dropped, evenly across the window
+class SyntheticErcModule : public I_ErcModule {
+public:
+    SyntheticErcModule(const std::shared_ptr<SyntheticSensorState> &state);
+
+    bool enable(bool b) override;
+    bool is_enabled() const override;
+    uint32_t get_count_period() const override;
+    bool set_cd_event_count(uint32_t event_count) override;
+    uint32_t get_min_supported_cd_event_count() const override;
+    uint32_t get_max_supported_cd_event_count() const override;
+    uint32_t get_cd_event_count() const override;
+    void erc_from_file(const std::string &) override;
+
+private:
+    std::shared_ptr<SyntheticSensorState> state_;
+};
+
+/// @brief Region of interest of the synthetic camera, applied on the generated events
+class SyntheticROI : public I_ROI {
+public:
+    SyntheticROI(const std::shared_ptr<SyntheticSensorState> &state);
+
+    bool enable(bool state) override;
+    bool is_enabled() const override;
+    bool set_mode(const Mode &mode) override;
+    Mode get_mode() const override;
+    size_t get_max_supported_windows_count() const override;
+    std::vector<Window> get_windows() const override;
+    bool get_lines(std::vector<bool> &cols, std::vector<bool> &rows) const override;
+    bool set_lines(const std::vector<bool> &cols, const std::vector<bool> &rows) override;
+
+private:
+    bool set_windows_impl(const std::vector<Window> &windows) override;
+
+    std::shared_ptr<SyntheticSensorState> state_;
+};
+
+/// @brief Trigger inputs of the synthetic camera
+///
+/// Only the loopback channel receives a signal, the one generated by @ref SyntheticTriggerOut
+class SyntheticTriggerIn : public I_TriggerIn {
+public:
+    SyntheticTriggerIn(const std::shared_ptr<SyntheticSensorState> &state);
+
+    bool enable(const Channel &channel) override;
+    bool disable(const Channel &channel) override;
+    bool is_enabled(const Channel &channel) const override;
+    std::map<Channel, short> get_available_channels() const override;
+
+private:
+    std::shared_ptr<SyntheticSensorState> state_;
+};
+
+/// @brief Trigger output of the synthetic camera
+class SyntheticTriggerOut : public I_TriggerOut {
+public:
+    SyntheticTriggerOut(const std::shared_ptr<SyntheticSensorState> &state);
+
+    uint32_t get_period() const override;
+    bool set_period(uint32_t period_us) override;
+    double get_duty_cycle() const override;
+    bool set_duty_cycle(double period_ratio) override;
+    bool enable() override;
+    bool disable() override;
+    bool is_enabled() const override;
+
+private:
+    std::shared_ptr<SyntheticSensorState> state_;
+};
+
+/// @brief Device control of the synthetic camera
+///
+/// As for a real sensor, the trigger inputs are disabled when the streaming stops
+class SyntheticDeviceControl : public DeviceControl {
+public:
+    SyntheticDeviceControl(const std::shared_ptr<SyntheticSensorState> &state);
+
+    void reset() override;
+    void start() override;
+    void stop() override;
+
+private:
+    std::shared_ptr<SyntheticSensorState> state_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_FACILITIES_H
@@ -0,0 +1,49 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_HW_IDENTIFICATION_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_HW_IDENTIFICATION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+
+namespace Metavision {
+
+class SyntheticHWIdentification : public I_HW_Identification {
+public:
+    static const std::string kSerial;
+
+    SyntheticHWIdentification(const std::shared_ptr<I_PluginSoftwareInfo> &plugin_sw_info,
+                              const SyntheticCameraConfig &config);
+
+    std::string get_serial() const override;
+    SensorInfo get_sensor_info() const override;
+    std::vector<std::string> get_available_data_encoding_formats() const override;
+    std::string get_current_data_encoding_format() const override;
+    std::string get_integrator() const override;
+    std::string get_connection_type() const override;
+
+protected:
+    DeviceConfigOptionMap get_device_config_options_impl() const override;
+
+private:
+    RawFileHeader get_header_impl() const override;
+
+    SyntheticCameraConfig config_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_HW_IDENTIFICATION_H
@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SCENE_GENERATOR_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SCENE_GENERATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+
+namespace Metavision {
+
+/// @brief Generates the CD events of the synthetic camera's scene
+///
+/// Events are produced in increasing timestamp order. Within a timestamp, events sharing a row and a polarity are
+/// emitted as runs of increasing abscissa whenever the scene allows it, so that the EVT3 encoder can pack them into
+/// vectors like a real sensor readout would.
+class SyntheticSceneGenerator {
+public:
+    SyntheticSceneGenerator(const SyntheticCameraConfig &config);
+
+    /// @brief Appends the events with a timestamp in [@p t_begin, @p t_end) to @p events
+    /// @note Consecutive calls are expected to cover contiguous time ranges
+    void generate(timestamp t_begin, timestamp t_end, std::vector<EventCD> &events);
+
+private:
+    uint64_t next_random();
+    uint32_t random_below(uint32_t bound);
+
+    // Returns the scene's instantaneous event rate, in events per us
+    double rate_at(timestamp t) const;
+
+    void add_noise(timestamp t, uint32_t n, std::vector<EventCD> &events);
+    void add_moving_bars(timestamp t, uint32_t n, std::vector<EventCD> &events);
+    void add_flicker(timestamp t, uint32_t n, std::vector<EventCD> &events);
+    void add_bursts(timestamp t, uint32_t n, std::vector<EventCD> &events);
+    void add_rows(unsigned short y, short p, timestamp t, uint32_t n, std::vector<EventCD> &events);
+    void add_row_run(unsigned short y, short p, timestamp t, uint32_t n, std::vector<EventCD> &events);
+
+    const SyntheticCameraConfig::Scene scene_;
+    const double rate_;
+    const int width_, height_;
+    uint64_t rng_state_;
+    double pending_events_ = 0.;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SCENE_GENERATOR_H
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SENSOR_STATE_H
+#define METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SENSOR_STATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/facilities/i_roi.h"
+#include "metavision/hal/facilities/i_trigger_in.h"
+
+namespace Metavision {
+
+/// @brief In-memory "registers" of the synthetic sensor
+///
+/// The facilities of the synthetic camera write into this state from the user thread, while the data transfer reads
+/// it from the streaming thread. Every update bumps a version number, so that the streaming thread only has to take
+/// the lock and copy the settings when something actually changed.
+class SyntheticSensorState {
+public:
+    struct Settings {
+        std::map<std::string, int> biases;
+
+        bool erc_enabled         = false;
+        uint32_t erc_event_count = 0;
+
+        bool roi_enabled     = false;
+        I_ROI::Mode roi_mode = I_ROI::Mode::ROI;
+        bool roi_from_lines  = false;
+        std::vector<I_ROI::Window> roi_windows;
+        std::vector<bool> roi_cols, roi_rows;
+
+        std::map<I_TriggerIn::Channel, bool> trigger_in_enabled;
+
+        bool trigger_out_enabled       = false;
+        uint32_t trigger_out_period_us = 100;
+        double trigger_out_duty_cycle  = 0.5;
+    };
+
+    /// Duration of the ERC counting window, in us
+    static constexpr uint32_t kErcCountPeriodUs = 1000;
+
+    /// Event id of the trigger channels, as found in the raw data
+    static constexpr short kTriggerMainId     = 0;
+    static constexpr short kTriggerLoopbackId = 6;
+
+    SyntheticSensorState(int width, int height) : width_(width), height_(height) {}
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /// @brief Returns a copy of the current settings
+    Settings get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return settings_;
+    }
+
+    /// @brief Applies @p f on the settings, and publishes the update
+    template<typename F>
+    void update(F &&f) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        f(settings_);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief Returns a number that changes every time the settings are updated
+    uint64_t version() const {
+        return version_.load(std::memory_order_acquire);
+    }
+
+private:
+    const int width_, height_;
+    mutable std::mutex mutex_;
+    Settings settings_;
+    std::atomic<uint64_t> version_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_PLUGINS_SYNTHETIC_SENSOR_STATE_H
@@ -26,6 +26,9 @@ class DeviceBuilder;
  * I_EventsStreamDecoder, and nullptr if only other types of decoders were registered. In both case, raw_size_bytes
  * will be set. If the format has a geometry, the I_Geometry facility will also be created.
  * If the provided fromat is not handled, the function will throw.
+ * For EVT3, the boolean config keys evt3_ext_trigger_events, evt3_erc_counter_events and evt3_monitoring_events (true
+ * by default) select the event types the device emits: no decoder is created for the other ones, and the decoding of
+ * these types is compiled out of the EVT3 decoder.
  */
 std::shared_ptr<I_EventsStreamDecoder> make_decoder(DeviceBuilder &, const StreamFormat &, size_t &raw_size_bytes,
                                                     bool do_time_shifting, const Metavision::DeviceConfig &config = Metavision::DeviceConfig{});
@@ -13,6 +13,7 @@
 #define METAVISION_HAL_PSEE_LIBUSB_DATA_TRANSFER_H
 
 #include <memory>
+#include <memory_resource>
 #include "metavision/psee_hw_layer/boards/utils/psee_libusb.h"
 
 #include "metavision/hal/utils/data_transfer.h"
@@ -39,6 +40,7 @@ private:
     void run_transfers(const DataTransfer &data_transfer);
 
     DataTransfer::DefaultBufferPool buffer_pool_;
+    std::pmr::memory_resource *memory_resource_; ///< Backs the buffers allocated once the pool is exhausted
     std::shared_ptr<LibUSBDevice> dev_;
     EpId bEpCommAddress_;
 
@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+
+namespace Metavision {
+namespace {
+
+// Coordinates are encoded on 11 bits in both EVT2 and EVT3
+constexpr int kMaxDimension = 2048;
+
+const std::vector<std::pair<SyntheticCameraConfig::Scene, std::string>> kSceneNames = {
+    {SyntheticCameraConfig::Scene::Noise, "noise"},
+    {SyntheticCameraConfig::Scene::MovingBars, "moving_bars"},
+    {SyntheticCameraConfig::Scene::Flicker, "flicker"},
+    {SyntheticCameraConfig::Scene::Bursts, "bursts"},
+};
+
+const std::vector<std::string> kFormats = {"EVT2", "EVT3"};
+
+} // namespace
+
+const std::string SyntheticCameraConfig::kSceneKey     = "synthetic_scene";
+const std::string SyntheticCameraConfig::kEventRateKey = "synthetic_event_rate";
+const std::string SyntheticCameraConfig::kWidthKey     = "synthetic_width";
+const std::string SyntheticCameraConfig::kHeightKey    = "synthetic_height";
+const std::string SyntheticCameraConfig::kRealTimeKey  = "synthetic_real_time";
+const std::string SyntheticCameraConfig::kSeedKey      = "synthetic_seed";
+
+std::string SyntheticCameraConfig::to_string(Scene scene) {
+    for (const auto &p : kSceneNames) {
+        if (p.first == scene) {
+            return p.second;
+        }
+    }
+    return "";
+}
+
+SyntheticCameraConfig SyntheticCameraConfig::from_device_config(const DeviceConfig &device_config) {
+    SyntheticCameraConfig config;
+
+    const std::string format = device_config.format();
+    if (!format.empty()) {
+        if (format != "EVT2" && format != "EVT3") {
+            throw HalException(HalErrorCode::UnsupportedValue,
+                               "Synthetic camera does not support the format " + format + ", use EVT2 or EVT3");
+        }
+        config.format = format;
+    }
+
+    const std::string scene = device_config.get<std::string>(kSceneKey, to_string(config.scene));
+    bool found_scene        = false;
+    for (const auto &p : kSceneNames) {
+        if (p.second == scene) {
+            config.scene = p.first;
+            found_scene  = true;
+        }
+    }
+    if (!found_scene) {
+        throw HalException(HalErrorCode::UnsupportedValue, "Unknown synthetic scene " + scene);
+    }
+
+    config.event_rate = device_config.get<double>(kEventRateKey, config.event_rate);
+    config.width      = device_config.get<int>(kWidthKey, config.width);
+    config.height     = device_config.get<int>(kHeightKey, config.height);
+    config.real_time  = device_config.get<bool>(kRealTimeKey, config.real_time);
+    config.seed       = device_config.get<uint32_t>(kSeedKey, config.seed);
+
+    if (!(config.event_rate > 0.)) {
+        throw HalException(HalErrorCode::ValueOutOfRange, "Synthetic event rate must be strictly positive");
+    }
+    if (config.width <= 0 || config.width > kMaxDimension || config.height <= 0 || config.height > kMaxDimension) {
+        throw HalException(HalErrorCode::ValueOutOfRange,
+                           "Synthetic sensor dimensions must be in [1, " + std::to_string(kMaxDimension) + "]");
+    }
+
+    return config;
+}
+
+DeviceConfigOptionMap SyntheticCameraConfig::get_device_config_options() {
+    const SyntheticCameraConfig defaults;
+
+    std::vector<std::string> scenes;
+    for (const auto &p : kSceneNames) {
+        scenes.push_back(p.second);
+    }
+
+    return {
+        {DeviceConfig::get_format_key(), DeviceConfigOption(kFormats, defaults.format)},
+        {kSceneKey, DeviceConfigOption(scenes, to_string(defaults.scene))},
+        {kEventRateKey, DeviceConfigOption(0.001, 1000., defaults.event_rate)},
+        {kWidthKey, DeviceConfigOption(1, kMaxDimension, defaults.width)},
+        {kHeightKey, DeviceConfigOption(1, kMaxDimension, defaults.height)},
+        {kRealTimeKey, DeviceConfigOption(defaults.real_time)},
+        {kSeedKey, DeviceConfigOption(0, std::numeric_limits<int>::max(), static_cast<int>(defaults.seed))},
+    };
+}
+
+} // namespace Metavision
@@ -0,0 +1,77 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/psee_hw_layer/utils/psee_format.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+#include "boards/synthetic/synthetic_camera_discovery.h"
+#include "boards/synthetic/synthetic_data_transfer.h"
+#include "boards/synthetic/synthetic_facilities.h"
+#include "boards/synthetic/synthetic_hw_identification.h"
+#include "boards/synthetic/synthetic_sensor_state.h"
+#include "utils/make_decoder.h"
+
+namespace Metavision {
+
+CameraDiscovery::SerialList SyntheticCameraDiscovery::list() {
+    return {SyntheticHWIdentification::kSerial};
+}
+
+CameraDiscovery::SystemList SyntheticCameraDiscovery::list_available_sources() {
+    return {{SyntheticHWIdentification::kSerial, ConnectionType::PROPRIETARY_LINK}};
+}
+
+bool SyntheticCameraDiscovery::discover(DeviceBuilder &device_builder, const std::string &serial,
+                                        const DeviceConfig &config) {
+    if (!(serial.empty() || serial == SyntheticHWIdentification::kSerial)) {
+        return false;
+    }
+
+    try {
+        const auto synthetic_config = SyntheticCameraConfig::from_device_config(config);
+        auto state = std::make_shared<SyntheticSensorState>(synthetic_config.width, synthetic_config.height);
+
+        auto hw_identification = device_builder.add_facility(
+            std::make_unique<SyntheticHWIdentification>(device_builder.get_plugin_software_info(), synthetic_config));
+
+        // The synthetic sensor never emits monitoring events
+        DeviceConfig decoder_config(config);
+        decoder_config.set("evt3_monitoring_events", false);
+        size_t raw_size_bytes = 0;
+        auto decoder          = make_decoder(device_builder,
+                                             StreamFormat(hw_identification->get_current_data_encoding_format()),
+                                             raw_size_bytes, false, decoder_config);
+
+        device_builder.add_facility(std::make_unique<SyntheticLLBiases>(config, state));
+        device_builder.add_facility(std::make_unique<SyntheticErcModule>(state));
+        device_builder.add_facility(std::make_unique<SyntheticROI>(state));
+        device_builder.add_facility(std::make_unique<SyntheticTriggerIn>(state));
+        device_builder.add_facility(std::make_unique<SyntheticTriggerOut>(state));
+        device_builder.add_facility(std::make_unique<I_EventsStream>(
+            std::make_unique<SyntheticDataTransfer>(synthetic_config, state), hw_identification, decoder,
+            std::make_shared<SyntheticDeviceControl>(state)));
+    } catch (std::exception &e) {
+        MV_HAL_LOG_ERROR() << "Failed to build the synthetic camera:" << e.what();
+        return false;
+    }
+    return true;
+}
+
+bool SyntheticCameraDiscovery::is_for_local_camera() const {
+    return true;
+}
+
+} // namespace Metavision
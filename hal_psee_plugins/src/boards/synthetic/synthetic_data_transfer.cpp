@@ -0,0 +1,180 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "metavision/sdk/base/utils/get_time.h"
+#include "boards/synthetic/synthetic_data_transfer.h"
+
+namespace Metavision {
+namespace {
+
+timestamp compute_slice_duration(double event_rate) {
+    // Aims at ~64k events per buffer, while keeping the latency reasonable in real time mode. Slices are a multiple of
+    // the ERC counting period, so that ERC windows never straddle two slices
+    constexpr timestamp kPeriod = SyntheticSensorState::kErcCountPeriodUs;
+    const auto duration         = static_cast<timestamp>(65536 / event_rate) / kPeriod * kPeriod;
+    return std::min<timestamp>(std::max<timestamp>(duration, kPeriod), 10 * kPeriod);
+}
+
+} // namespace
+
+SyntheticDataTransfer::SyntheticDataTransfer(const SyntheticCameraConfig &config,
+                                             const std::shared_ptr<SyntheticSensorState> &state) :
+    buffer_pool_(DataTransfer::DefaultBufferPool::make_bounded(kBufferPoolSize)),
+    config_(config),
+    slice_us_(compute_slice_duration(config.event_rate)),
+    state_(state),
+    generator_(config),
+    encoder_(SyntheticEventEncoder::make(config.format, config.width)) {}
+
+timestamp SyntheticDataTransfer::get_slice_duration() const {
+    return slice_us_;
+}
+
+void SyntheticDataTransfer::run_impl(const DataTransfer &data_transfer) {
+    const timestamp time_start = current_time_;
+    const uint64_t clock_start = get_system_time_us();
+    while (!data_transfer.should_stop()) {
+        auto buffer = buffer_pool_.acquire();
+        buffer->clear();
+        produce(current_time_, current_time_ + slice_us_, *buffer);
+        current_time_ += slice_us_;
+
+        data_transfer.transfer_data(buffer);
+
+        if (config_.real_time) {
+            const uint64_t clock_now      = get_system_time_us();
+            const uint64_t clock_expected = clock_start + (current_time_ - time_start);
+            if (clock_expected > clock_now) {
+                std::this_thread::sleep_for(std::chrono::microseconds(clock_expected - clock_now));
+            }
+        }
+    }
+}
+
+void SyntheticDataTransfer::produce(timestamp t_begin, timestamp t_end, DataTransfer::DefaultBufferType &out) {
+    refresh_settings();
+
+    events_.clear();
+    generator_.generate(t_begin, t_end, events_);
+    if (settings_.roi_enabled) {
+        apply_roi();
+    }
+    if (settings_.erc_enabled) {
+        apply_erc(t_begin, t_end);
+    }
+
+    triggers_.clear();
+    add_triggers(t_begin, t_end);
+
+    // Both lists are sorted by timestamp, triggers are inserted before the CD events sharing their timestamp
+    const EventCD *it = events_.data(), *end = events_.data() + events_.size();
+    for (const auto &trigger : triggers_) {
+        const EventCD *next =
+            std::lower_bound(it, end, trigger.t, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        encoder_->encode(it, next, out);
+        encoder_->encode(trigger, out);
+        it = next;
+    }
+    encoder_->encode(it, end, out);
+    encoder_->advance_time(t_end - 1, out);
+}
+
+void SyntheticDataTransfer::refresh_settings() {
+    const uint64_t version = state_->version();
+    if (version == settings_version_) {
+        return;
+    }
+    settings_version_ = version;
+    settings_         = state_->get();
+
+    if (!settings_.roi_enabled) {
+        return;
+    }
+    const int width = state_->width(), height = state_->height();
+    const bool roi  = settings_.roi_mode == I_ROI::Mode::ROI;
+    pixel_mask_.assign(width * height, roi ? 0 : 1);
+    if (settings_.roi_from_lines) {
+        // See I_ROI::set_lines: in ROI mode a pixel is enabled if both its row and column are, in RONI mode if
+        // either of them is
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const bool col             = settings_.roi_cols[x], row = settings_.roi_rows[y];
+                pixel_mask_[y * width + x] = roi ? (col && row) : (col || row);
+            }
+        }
+    } else {
+        // Windows enable the pixels they cover in ROI mode, and disable them in RONI mode
+        for (const auto &window : settings_.roi_windows) {
+            const int x_end = std::min(width, window.x + window.width);
+            const int y_end = std::min(height, window.y + window.height);
+            for (int y = std::max(0, window.y); y < y_end; ++y) {
+                for (int x = std::max(0, window.x); x < x_end; ++x) {
+                    pixel_mask_[y * width + x] = roi ? 1 : 0;
+                }
+            }
+        }
+    }
+}
+
+void SyntheticDataTransfer::apply_roi() {
+    const int width = state_->width();
+    events_.erase(std::remove_if(events_.begin(), events_.end(),
+                                 [&](const EventCD &ev) { return !pixel_mask_[ev.y * width + ev.x]; }),
+                  events_.end());
+}
+
+void SyntheticDataTransfer::apply_erc(timestamp t_begin, timestamp t_end) {
+    // In each counting window exceeding the budget, the events to keep are evenly spread across the window
+    const uint64_t budget = settings_.erc_event_count;
+    auto write            = events_.begin();
+    auto read             = events_.begin();
+    for (timestamp t = t_begin; t < t_end; t += SyntheticSensorState::kErcCountPeriodUs) {
+        const auto window_end = std::lower_bound(read, events_.end(), t + SyntheticSensorState::kErcCountPeriodUs,
+                                                 [](const EventCD &ev, timestamp ts) { return ev.t < ts; });
+        const uint64_t count  = std::distance(read, window_end);
+        for (uint64_t i = 0; i < count; ++i, ++read) {
+            if (count <= budget || (i + 1) * budget / count > i * budget / count) {
+                *write++ = *read;
+            }
+        }
+    }
+    events_.erase(write, events_.end());
+}
+
+void SyntheticDataTransfer::add_triggers(timestamp t_begin, timestamp t_end) {
+    if (!settings_.trigger_out_enabled) {
+        return;
+    }
+    auto it = settings_.trigger_in_enabled.find(I_TriggerIn::Channel::Loopback);
+    if (it == settings_.trigger_in_enabled.end() || !it->second) {
+        return;
+    }
+
+    const timestamp period = settings_.trigger_out_period_us;
+    const timestamp high   = std::min<timestamp>(
+        std::max<timestamp>(std::llround(settings_.trigger_out_duty_cycle * period), 1), period - 1);
+    for (timestamp rise = (t_begin / period) * period - period; rise < t_end; rise += period) {
+        if (rise >= t_begin) {
+            triggers_.emplace_back(1, rise, SyntheticSensorState::kTriggerLoopbackId);
+        }
+        const timestamp fall = rise + high;
+        if (fall >= t_begin && fall < t_end) {
+            triggers_.emplace_back(0, fall, SyntheticSensorState::kTriggerLoopbackId);
+        }
+    }
+}
+
+} // namespace Metavision
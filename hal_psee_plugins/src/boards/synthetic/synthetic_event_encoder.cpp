@@ -0,0 +1,189 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/decoders/evt2/evt2_event_types.h"
+#include "metavision/hal/decoders/evt3/evt3_event_types.h"
+#include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "boards/synthetic/synthetic_event_encoder.h"
+
+namespace Metavision {
+namespace {
+
+// Grows out by the maximum number of words that may be written and returns where to write them. The buffer is
+// shrunk back to the words actually written by release_words.
+template<typename Word>
+Word *reserve_words(DataTransfer::DefaultBufferType &out, size_t max_words) {
+    const size_t size = out.size();
+    out.resize(size + max_words * sizeof(Word));
+    return reinterpret_cast<Word *>(out.data() + size);
+}
+
+template<typename Word>
+void release_words(DataTransfer::DefaultBufferType &out, const Word *end) {
+    out.resize(reinterpret_cast<const uint8_t *>(end) - out.data());
+}
+
+constexpr uint16_t evt3_word(Evt3EventTypes_4bits type, uint16_t content) {
+    return static_cast<uint16_t>(static_cast<uint16_t>(type) << 12 | content);
+}
+
+} // namespace
+
+std::unique_ptr<SyntheticEventEncoder> SyntheticEventEncoder::make(const std::string &format, int width) {
+    if (format == "EVT2") {
+        return std::make_unique<SyntheticEvt2Encoder>();
+    } else if (format == "EVT3") {
+        return std::make_unique<SyntheticEvt3Encoder>(width);
+    }
+    throw HalException(HalErrorCode::UnsupportedValue, "No synthetic encoder for format " + format);
+}
+
+uint32_t *SyntheticEvt2Encoder::write_time_high(timestamp t, uint32_t *w) {
+    const timestamp time_high = t >> EVT2EventsTimeStampBits;
+    if (time_high != last_time_high_) {
+        EVT2RawEvent raw_evt{0};
+        raw_evt.th.type = static_cast<uint8_t>(EVT2EventTypes::EVT_TIME_HIGH);
+        raw_evt.th.ts   = time_high;
+        *w++            = raw_evt.raw;
+        last_time_high_ = time_high;
+    }
+    return w;
+}
+
+void SyntheticEvt2Encoder::encode(const EventCD *begin, const EventCD *end, DataTransfer::DefaultBufferType &out) {
+    uint32_t *w = reserve_words<uint32_t>(out, 2 * (end - begin));
+    for (auto ev = begin; ev != end; ++ev) {
+        w = write_time_high(ev->t, w);
+        EVT2RawEvent raw_evt{0};
+        raw_evt.cd.type      = static_cast<uint8_t>(ev->p ? EVT2EventTypes::CD_ON : EVT2EventTypes::CD_OFF);
+        raw_evt.cd.timestamp = ev->t;
+        raw_evt.cd.x         = ev->x;
+        raw_evt.cd.y         = ev->y;
+        *w++                 = raw_evt.raw;
+    }
+    release_words(out, w);
+}
+
+void SyntheticEvt2Encoder::encode(const EventExtTrigger &ev, DataTransfer::DefaultBufferType &out) {
+    uint32_t *w = reserve_words<uint32_t>(out, 2);
+    w           = write_time_high(ev.t, w);
+    EVT2RawEvent raw_evt{0};
+    raw_evt.trig.type      = static_cast<uint8_t>(EVT2EventTypes::EXT_TRIGGER);
+    raw_evt.trig.timestamp = ev.t;
+    raw_evt.trig.id        = ev.id;
+    raw_evt.trig.value     = ev.p;
+    *w++                   = raw_evt.raw;
+    release_words(out, w);
+}
+
+void SyntheticEvt2Encoder::advance_time(timestamp t, DataTransfer::DefaultBufferType &out) {
+    const timestamp time_high = t >> EVT2EventsTimeStampBits;
+    if (last_time_high_ < 0) {
+        release_words(out, write_time_high(t, reserve_words<uint32_t>(out, 1)));
+        return;
+    }
+    if (time_high <= last_time_high_) {
+        return;
+    }
+    uint32_t *w = reserve_words<uint32_t>(out, time_high - last_time_high_);
+    while (last_time_high_ < time_high) {
+        w = write_time_high((last_time_high_ + 1) << EVT2EventsTimeStampBits, w);
+    }
+    release_words(out, w);
+}
+
+SyntheticEvt3Encoder::SyntheticEvt3Encoder(int width) : width_(width) {}
+
+uint16_t *SyntheticEvt3Encoder::write_time(timestamp t, uint16_t *w) {
+    const timestamp time_high = t >> 12;
+    if (time_high != last_time_high_) {
+        *w++            = evt3_word(Evt3EventTypes_4bits::EVT_TIME_HIGH, time_high & 0xFFF);
+        last_time_high_ = time_high;
+        // The decoder clears the time low on a new time high, it has to be sent again
+        last_time_low_ = -1;
+    }
+    const timestamp time_low = t & 0xFFF;
+    if (time_low != last_time_low_) {
+        *w++           = evt3_word(Evt3EventTypes_4bits::EVT_TIME_LOW, time_low);
+        last_time_low_ = time_low;
+    }
+    return w;
+}
+
+void SyntheticEvt3Encoder::encode(const EventCD *begin, const EventCD *end, DataTransfer::DefaultBufferType &out) {
+    // At worst, each event needs a time high, a time low, a row and a column word
+    uint16_t *w = reserve_words<uint16_t>(out, 4 * (end - begin));
+    for (const EventCD *ev = begin; ev != end;) {
+        w = write_time(ev->t, w);
+        if (ev->y != last_y_) {
+            *w++    = evt3_word(Evt3EventTypes_4bits::EVT_ADDR_Y, ev->y);
+            last_y_ = ev->y;
+        }
+
+        // Collects the following events that fit in a vector starting at ev
+        const EventCD *run_end = ev + 1;
+        uint32_t mask          = 1;
+        while (run_end != end && run_end->t == ev->t && run_end->y == ev->y && run_end->p == ev->p &&
+               run_end->x > (run_end - 1)->x && run_end->x < ev->x + 32) {
+            mask |= 1u << (run_end->x - ev->x);
+            ++run_end;
+        }
+
+        // A vector costs 3 words, plus one if the decoder's vector base has to be moved
+        const auto n          = run_end - ev;
+        const bool has_base_x = ev->x == next_vect_x_ && ev->p == vect_p_;
+        const bool fits       = ev->x + 32 <= width_;
+        if (fits && (n > 3 || (n == 3 && has_base_x))) {
+            if (!has_base_x) {
+                *w++ = evt3_word(Evt3EventTypes_4bits::VECT_BASE_X, static_cast<uint16_t>(ev->p << 11 | ev->x));
+            }
+            *w++         = evt3_word(Evt3EventTypes_4bits::VECT_12, mask & 0xFFF);
+            *w++         = evt3_word(Evt3EventTypes_4bits::VECT_12, (mask >> 12) & 0xFFF);
+            *w++         = evt3_word(Evt3EventTypes_4bits::VECT_8, mask >> 24);
+            next_vect_x_ = ev->x + 32;
+            vect_p_      = ev->p;
+        } else {
+            for (const EventCD *e = ev; e != run_end; ++e) {
+                *w++ = evt3_word(Evt3EventTypes_4bits::EVT_ADDR_X, static_cast<uint16_t>(e->p << 11 | e->x));
+            }
+        }
+        ev = run_end;
+    }
+    release_words(out, w);
+}
+
+void SyntheticEvt3Encoder::encode(const EventExtTrigger &ev, DataTransfer::DefaultBufferType &out) {
+    uint16_t *w = reserve_words<uint16_t>(out, 3);
+    w           = write_time(ev.t, w);
+    *w++        = evt3_word(Evt3EventTypes_4bits::EXT_TRIGGER, static_cast<uint16_t>((ev.id & 0xF) << 8 | ev.p));
+    release_words(out, w);
+}
+
+void SyntheticEvt3Encoder::advance_time(timestamp t, DataTransfer::DefaultBufferType &out) {
+    // Only time high events are needed, the decoder resets the time low on each of them
+    const timestamp time_high = t >> 12;
+    if (last_time_high_ < 0) {
+        release_words(out, write_time(t, reserve_words<uint16_t>(out, 2)));
+        return;
+    }
+    if (time_high <= last_time_high_) {
+        return;
+    }
+    uint16_t *w = reserve_words<uint16_t>(out, time_high - last_time_high_);
+    while (last_time_high_ < time_high) {
+        *w++ = evt3_word(Evt3EventTypes_4bits::EVT_TIME_HIGH, ++last_time_high_ & 0xFFF);
+    }
+    last_time_low_ = -1;
+    release_words(out, w);
+}
+
+} // namespace Metavision
@@ -0,0 +1,261 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/psee_hw_layer/devices/imx636/imx636_ll_biases.h"
+#include "boards/synthetic/synthetic_facilities.h"
+#include "utils/psee_hal_utils.h"
+
+namespace Metavision {
+
+#include "devices/imx636/imx636_bias_settings.h"
+#include "devices/imx636/imx636_bias_settings_iterator.h"
+
+SyntheticLLBiases::SyntheticLLBiases(const DeviceConfig &device_config,
+                                     const std::shared_ptr<SyntheticSensorState> &state) :
+    I_LL_Biases(device_config), state_(state) {
+    for (const auto &bias_setting : bias_settings) {
+        biases_info_.emplace(bias_setting.name,
+                             LL_Bias_Info(bias_setting.min_allowed_offset, bias_setting.max_allowed_offset,
+                                          bias_setting.min_recommended_offset, bias_setting.max_recommended_offset,
+                                          get_bias_description(bias_setting.name), bias_setting.modifiable,
+                                          get_bias_category(bias_setting.name)));
+    }
+    state_->update([this](SyntheticSensorState::Settings &settings) {
+        for (const auto &p : biases_info_) {
+            settings.biases[p.first] = 0;
+        }
+    });
+}
+
+std::map<std::string, int> SyntheticLLBiases::get_all_biases() const {
+    return state_->get().biases;
+}
+
+bool SyntheticLLBiases::set_impl(const std::string &bias_name, int bias_value) {
+    if (biases_info_.count(bias_name) == 0) {
+        return false;
+    }
+    state_->update([&](SyntheticSensorState::Settings &settings) { settings.biases[bias_name] = bias_value; });
+    return true;
+}
+
+int SyntheticLLBiases::get_impl(const std::string &bias_name) const {
+    const auto biases = state_->get().biases;
+    auto it           = biases.find(bias_name);
+    return it == biases.end() ? -1 : it->second;
+}
+
+bool SyntheticLLBiases::get_bias_info_impl(const std::string &bias_name, LL_Bias_Info &bias_info) const {
+    auto it = biases_info_.find(bias_name);
+    if (it == biases_info_.end()) {
+        return false;
+    }
+    bias_info = it->second;
+    return true;
+}
+
+SyntheticErcModule::SyntheticErcModule(const std::shared_ptr<SyntheticSensorState> &state) : state_(state) {
+    // Defaults to 20 Mev/s, as most Prophesee sensors
+    set_cd_event_count(20 * SyntheticSensorState::kErcCountPeriodUs);
+}
+
+bool SyntheticErcModule::enable(bool b) {
+    state_->update([b](SyntheticSensorState::Settings &settings) { settings.erc_enabled = b; });
+    return true;
+}
+
+bool SyntheticErcModule::is_enabled() const {
+    return state_->get().erc_enabled;
+}
+
+uint32_t SyntheticErcModule::get_count_period() const {
+    return SyntheticSensorState::kErcCountPeriodUs;
+}
+
+bool SyntheticErcModule::set_cd_event_count(uint32_t event_count) {
+    if (event_count > get_max_supported_cd_event_count()) {
+        return false;
+    }
+    state_->update([event_count](SyntheticSensorState::Settings &settings) { settings.erc_event_count = event_count; });
+    return true;
+}
+
+uint32_t SyntheticErcModule::get_min_supported_cd_event_count() const {
+    return 0;
+}
+
+uint32_t SyntheticErcModule::get_max_supported_cd_event_count() const {
+    // 1 Gev/s
+    return 1000 * SyntheticSensorState::kErcCountPeriodUs;
+}
+
+uint32_t SyntheticErcModule::get_cd_event_count() const {
+    return state_->get().erc_event_count;
+}
+
+void SyntheticErcModule::erc_from_file(const std::string &) {
+    MV_HAL_LOG_WARNING() << "Synthetic camera ERC can not be configured from a file";
+}
+
+SyntheticROI::SyntheticROI(const std::shared_ptr<SyntheticSensorState> &state) : state_(state) {}
+
+bool SyntheticROI::enable(bool state) {
+    state_->update([state](SyntheticSensorState::Settings &settings) { settings.roi_enabled = state; });
+    return true;
+}
+
+bool SyntheticROI::is_enabled() const {
+    return state_->get().roi_enabled;
+}
+
+bool SyntheticROI::set_mode(const Mode &mode) {
+    state_->update([mode](SyntheticSensorState::Settings &settings) { settings.roi_mode = mode; });
+    return true;
+}
+
+I_ROI::Mode SyntheticROI::get_mode() const {
+    return state_->get().roi_mode;
+}
+
+size_t SyntheticROI::get_max_supported_windows_count() const {
+    return 8;
+}
+
+bool SyntheticROI::set_windows_impl(const std::vector<Window> &windows) {
+    state_->update([&windows](SyntheticSensorState::Settings &settings) {
+        settings.roi_windows    = windows;
+        settings.roi_from_lines = false;
+    });
+    return true;
+}
+
+std::vector<I_ROI::Window> SyntheticROI::get_windows() const {
+    const auto settings = state_->get();
+    return settings.roi_from_lines ? std::vector<Window>() : settings.roi_windows;
+}
+
+bool SyntheticROI::get_lines(std::vector<bool> &cols, std::vector<bool> &rows) const {
+    const auto settings = state_->get();
+    if (!settings.roi_from_lines) {
+        return false;
+    }
+    cols = settings.roi_cols;
+    rows = settings.roi_rows;
+    return true;
+}
+
+bool SyntheticROI::set_lines(const std::vector<bool> &cols, const std::vector<bool> &rows) {
+    if (cols.size() != static_cast<size_t>(state_->width()) || rows.size() != static_cast<size_t>(state_->height())) {
+        return false;
+    }
+    state_->update([&](SyntheticSensorState::Settings &settings) {
+        settings.roi_cols       = cols;
+        settings.roi_rows       = rows;
+        settings.roi_from_lines = true;
+    });
+    return true;
+}
+
+SyntheticTriggerIn::SyntheticTriggerIn(const std::shared_ptr<SyntheticSensorState> &state) : state_(state) {}
+
+bool SyntheticTriggerIn::enable(const Channel &channel) {
+    if (get_available_channels().count(channel) == 0) {
+        return false;
+    }
+    state_->update(
+        [&channel](SyntheticSensorState::Settings &settings) { settings.trigger_in_enabled[channel] = true; });
+    return true;
+}
+
+bool SyntheticTriggerIn::disable(const Channel &channel) {
+    if (get_available_channels().count(channel) == 0) {
+        return false;
+    }
+    state_->update(
+        [&channel](SyntheticSensorState::Settings &settings) { settings.trigger_in_enabled[channel] = false; });
+    return true;
+}
+
+bool SyntheticTriggerIn::is_enabled(const Channel &channel) const {
+    const auto settings = state_->get();
+    auto it             = settings.trigger_in_enabled.find(channel);
+    return it != settings.trigger_in_enabled.end() && it->second;
+}
+
+std::map<I_TriggerIn::Channel, short> SyntheticTriggerIn::get_available_channels() const {
+    return {{Channel::Main, SyntheticSensorState::kTriggerMainId},
+            {Channel::Loopback, SyntheticSensorState::kTriggerLoopbackId}};
+}
+
+SyntheticTriggerOut::SyntheticTriggerOut(const std::shared_ptr<SyntheticSensorState> &state) : state_(state) {}
+
+uint32_t SyntheticTriggerOut::get_period() const {
+    return state_->get().trigger_out_period_us;
+}
+
+bool SyntheticTriggerOut::set_period(uint32_t period_us) {
+    // Both the high and low levels must last at least 1 us
+    if (period_us < 2) {
+        return false;
+    }
+    state_->update([period_us](SyntheticSensorState::Settings &settings) {
+        settings.trigger_out_period_us = period_us;
+    });
+    return true;
+}
+
+double SyntheticTriggerOut::get_duty_cycle() const {
+    return state_->get().trigger_out_duty_cycle;
+}
+
+bool SyntheticTriggerOut::set_duty_cycle(double period_ratio) {
+    if (period_ratio <= 0. || period_ratio >= 1.) {
+        return false;
+    }
+    state_->update([period_ratio](SyntheticSensorState::Settings &settings) {
+        settings.trigger_out_duty_cycle = period_ratio;
+    });
+    return true;
+}
+
+bool SyntheticTriggerOut::enable() {
+    state_->update([](SyntheticSensorState::Settings &settings) { settings.trigger_out_enabled = true; });
+    return true;
+}
+
+bool SyntheticTriggerOut::disable() {
+    state_->update([](SyntheticSensorState::Settings &settings) { settings.trigger_out_enabled = false; });
+    return true;
+}
+
+bool SyntheticTriggerOut::is_enabled() const {
+    return state_->get().trigger_out_enabled;
+}
+
+SyntheticDeviceControl::SyntheticDeviceControl(const std::shared_ptr<SyntheticSensorState> &state) : state_(state) {}
+
+void SyntheticDeviceControl::reset() {}
+
+void SyntheticDeviceControl::start() {}
+
+void SyntheticDeviceControl::stop() {
+    state_->update([](SyntheticSensorState::Settings &settings) {
+        for (auto &p : settings.trigger_in_enabled) {
+            p.second = false;
+        }
+    });
+}
+
+} // namespace Metavision
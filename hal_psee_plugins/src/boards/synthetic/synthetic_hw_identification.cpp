@@ -0,0 +1,62 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/psee_hw_layer/boards/rawfile/psee_raw_file_header.h"
+#include "metavision/psee_hw_layer/utils/psee_format.h"
+#include "boards/synthetic/synthetic_hw_identification.h"
+#include "plugin/psee_plugin.h"
+
+namespace Metavision {
+
+const std::string SyntheticHWIdentification::kSerial = "synthetic";
+
+SyntheticHWIdentification::SyntheticHWIdentification(const std::shared_ptr<I_PluginSoftwareInfo> &plugin_sw_info,
+                                                     const SyntheticCameraConfig &config) :
+    I_HW_Identification(plugin_sw_info), config_(config) {}
+
+std::string SyntheticHWIdentification::get_serial() const {
+    return kSerial;
+}
+
+I_HW_Identification::SensorInfo SyntheticHWIdentification::get_sensor_info() const {
+    return SensorInfo(0, 0, "Synthetic");
+}
+
+std::vector<std::string> SyntheticHWIdentification::get_available_data_encoding_formats() const {
+    return {"EVT2", "EVT3"};
+}
+
+std::string SyntheticHWIdentification::get_current_data_encoding_format() const {
+    StreamFormat format(config_.format);
+    format["width"]  = std::to_string(config_.width);
+    format["height"] = std::to_string(config_.height);
+    return format.to_string();
+}
+
+std::string SyntheticHWIdentification::get_integrator() const {
+    return get_psee_plugin_integrator_name();
+}
+
+std::string SyntheticHWIdentification::get_connection_type() const {
+    return "Synthetic";
+}
+
+DeviceConfigOptionMap SyntheticHWIdentification::get_device_config_options_impl() const {
+    return SyntheticCameraConfig::get_device_config_options();
+}
+
+RawFileHeader SyntheticHWIdentification::get_header_impl() const {
+    PseeRawFileHeader header(*this, StreamFormat(get_current_data_encoding_format()));
+    header.set_field("synthetic_scene", SyntheticCameraConfig::to_string(config_.scene));
+    return header;
+}
+
+} // namespace Metavision
@@ -0,0 +1,155 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "boards/synthetic/synthetic_scene_generator.h"
+
+namespace Metavision {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Time for a moving bar to sweep the whole sensor
+constexpr timestamp kBarSweepUs = 500000;
+
+// 100 Hz flicker
+constexpr timestamp kFlickerPeriodUs = 10000;
+
+// 1 ms bursts every 10 ms, with a background activity of 1% of the peak rate in between
+constexpr timestamp kBurstPeriodUs        = 10000;
+constexpr timestamp kBurstDurationUs      = 1000;
+constexpr double kBurstBackgroundFraction = 0.01;
+
+} // namespace
+
+SyntheticSceneGenerator::SyntheticSceneGenerator(const SyntheticCameraConfig &config) :
+    scene_(config.scene),
+    rate_(config.event_rate),
+    width_(config.width),
+    height_(config.height),
+    rng_state_(config.seed) {}
+
+uint64_t SyntheticSceneGenerator::next_random() {
+    // splitmix64: a few cycles per call and good enough statistical properties for scene generation
+    uint64_t z = (rng_state_ += 0x9E3779B97F4A7C15ull);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+uint32_t SyntheticSceneGenerator::random_below(uint32_t bound) {
+    return static_cast<uint32_t>(((next_random() >> 32) * bound) >> 32);
+}
+
+double SyntheticSceneGenerator::rate_at(timestamp t) const {
+    switch (scene_) {
+    case SyntheticCameraConfig::Scene::Flicker:
+        // The event rate follows the derivative of the illumination, scaled so that the mean rate is rate_
+        return rate_ * (kPi / 2) * std::abs(std::cos(2 * kPi * (t % kFlickerPeriodUs) / kFlickerPeriodUs));
+    case SyntheticCameraConfig::Scene::Bursts:
+        return (t % kBurstPeriodUs) < kBurstDurationUs ? rate_ : rate_ * kBurstBackgroundFraction;
+    default:
+        return rate_;
+    }
+}
+
+void SyntheticSceneGenerator::generate(timestamp t_begin, timestamp t_end, std::vector<EventCD> &events) {
+    for (timestamp t = t_begin; t < t_end; ++t) {
+        pending_events_ += rate_at(t);
+        if (pending_events_ < 1.) {
+            continue;
+        }
+        const uint32_t n = static_cast<uint32_t>(pending_events_);
+        pending_events_ -= n;
+
+        switch (scene_) {
+        case SyntheticCameraConfig::Scene::Noise:
+            add_noise(t, n, events);
+            break;
+        case SyntheticCameraConfig::Scene::MovingBars:
+            add_moving_bars(t, n, events);
+            break;
+        case SyntheticCameraConfig::Scene::Flicker:
+            add_flicker(t, n, events);
+            break;
+        case SyntheticCameraConfig::Scene::Bursts:
+            add_bursts(t, n, events);
+            break;
+        }
+    }
+}
+
+void SyntheticSceneGenerator::add_noise(timestamp t, uint32_t n, std::vector<EventCD> &events) {
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint64_t r = next_random();
+        const auto x     = static_cast<unsigned short>(((r & 0xFFFFFFFF) * width_) >> 32);
+        const auto y     = static_cast<unsigned short>(((r >> 32) * height_) >> 32);
+        events.emplace_back(x, y, static_cast<short>(r & 1), t);
+    }
+}
+
+void SyntheticSceneGenerator::add_moving_bars(timestamp t, uint32_t n, std::vector<EventCD> &events) {
+    // The leading edge of the bar turns pixels ON, its trailing edge turns them back OFF
+    const int thickness = std::max(1, height_ / 8);
+    const int y_lead    = static_cast<int>((t % kBarSweepUs) * height_ / kBarSweepUs);
+    const int y_trail   = (y_lead + height_ - thickness) % height_;
+    add_rows(static_cast<unsigned short>(y_lead), 1, t, (n + 1) / 2, events);
+    add_rows(static_cast<unsigned short>(y_trail), 0, t, n / 2, events);
+}
+
+void SyntheticSceneGenerator::add_flicker(timestamp t, uint32_t n, std::vector<EventCD> &events) {
+    const short p = std::cos(2 * kPi * (t % kFlickerPeriodUs) / kFlickerPeriodUs) > 0 ? 1 : 0;
+    const int x0  = width_ / 4, y0 = height_ / 4;
+    const int w   = std::max(1, width_ / 2), h = std::max(1, height_ / 2);
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint64_t r = next_random();
+        const auto x     = static_cast<unsigned short>(x0 + (((r & 0xFFFFFFFF) * w) >> 32));
+        const auto y     = static_cast<unsigned short>(y0 + (((r >> 32) * h) >> 32));
+        events.emplace_back(x, y, p, t);
+    }
+}
+
+void SyntheticSceneGenerator::add_bursts(timestamp t, uint32_t n, std::vector<EventCD> &events) {
+    if ((t % kBurstPeriodUs) >= kBurstDurationUs) {
+        add_noise(t, n, events);
+        return;
+    }
+    // During a burst, whole segments of rows fire at once
+    while (n > 0) {
+        const uint32_t k = std::min<uint32_t>(n, width_);
+        add_row_run(static_cast<unsigned short>(random_below(height_)), static_cast<short>(next_random() & 1), t, k,
+                    events);
+        n -= k;
+    }
+}
+
+void SyntheticSceneGenerator::add_rows(unsigned short y, short p, timestamp t, uint32_t n,
+                                       std::vector<EventCD> &events) {
+    // Spreads the events over the rows below y when there are more events than pixels in a row
+    while (n > 0) {
+        const uint32_t k = std::min<uint32_t>(n, width_);
+        add_row_run(y, p, t, k, events);
+        y = static_cast<unsigned short>((y + 1) % height_);
+        n -= k;
+    }
+}
+
+void SyntheticSceneGenerator::add_row_run(unsigned short y, short p, timestamp t, uint32_t n,
+                                          std::vector<EventCD> &events) {
+    const uint32_t x0 = random_below(width_ - n + 1);
+    for (uint32_t x = x0; x < x0 + n; ++x) {
+        events.emplace_back(static_cast<unsigned short>(x), y, p, t);
+    }
+}
+
+} // namespace Metavision
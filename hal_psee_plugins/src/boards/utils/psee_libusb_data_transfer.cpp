@@ -22,6 +22,7 @@
 #define WIN_CALLBACK_DECL
 #endif
 
+#include "metavision/hal/utils/buffer_memory.h"
 #include "metavision/hal/utils/data_transfer.h"
 #include "metavision/hal/utils/hal_connection_exception.h"
 #include "metavision/hal/utils/hal_log.h"
@@ -127,15 +128,16 @@ const size_t PseeLibUSBDataTransfer::async_transfer_num_ = get_async_transfer_nu
 const unsigned int PseeLibUSBDataTransfer::timeout_      = static_cast<unsigned int>(get_time_out());
 
 DataTransfer::DefaultBufferPool PseeLibUSBDataTransfer::make_buffer_pool(size_t default_pool_byte_size) {
-    auto pool =
-        DataTransfer::DefaultBufferPool::make_unbounded(PseeLibUSBDataTransfer::async_transfer_num_, get_packet_size());
+    auto *memory_resource = get_buffer_memory_resource(get_buffer_memory_type());
+    auto pool             = DataTransfer::DefaultBufferPool::make_unbounded(PseeLibUSBDataTransfer::async_transfer_num_,
+                                                                            get_packet_size(), memory_resource);
 
     auto buffer_pool_byte_size =
         get_envar_or_default("MV_PSEE_PLUGIN_DATA_TRANSFER_BUFFER_POOL_BYTE_SIZE", default_pool_byte_size);
     if (buffer_pool_byte_size) {
         auto num_obj_pool = buffer_pool_byte_size / packet_size_;
         MV_HAL_LOG_INFO() << "Creating Fixed size data pool of : " << num_obj_pool << "x" << packet_size_ << "B";
-        pool = DataTransfer::DefaultBufferPool::make_bounded(num_obj_pool, packet_size_);
+        pool = DataTransfer::DefaultBufferPool::make_bounded(num_obj_pool, packet_size_, memory_resource);
     }
 
     return pool;
@@ -144,7 +146,11 @@ DataTransfer::DefaultBufferPool PseeLibUSBDataTransfer::make_buffer_pool(size_t
 PseeLibUSBDataTransfer::PseeLibUSBDataTransfer(const std::shared_ptr<LibUSBDevice> dev, EpId endpoint,
                                                uint32_t raw_event_size_bytes,
                                                const DataTransfer::DefaultBufferPool &buffer_pool) :
-    buffer_pool_(buffer_pool), dev_(dev), bEpCommAddress_(endpoint), vtransfer_(async_transfer_num_) {}
+    buffer_pool_(buffer_pool),
+    memory_resource_(get_buffer_memory_resource(get_buffer_memory_type())),
+    dev_(dev),
+    bEpCommAddress_(endpoint),
+    vtransfer_(async_transfer_num_) {}
 
 PseeLibUSBDataTransfer::~PseeLibUSBDataTransfer() {
     // Nothing to do, just need the definition of ~AsyncTransfer where this destructor is
@@ -160,7 +166,7 @@ void PseeLibUSBDataTransfer::start_impl() {
     auto shift   = timeout_ / async_transfer_num_;
     // Queue transfers on host side
     for (auto &transfer : vtransfer_) {
-        auto buffer = buffer_pool_.acquire();
+        auto buffer = buffer_pool_.acquire(packet_size_, memory_resource_);
         buffer->resize(packet_size_);
         transfer.prepare(dev_, bEpCommAddress_, std::move(buffer), timeout);
         transfer.submit();
@@ -220,7 +226,7 @@ void PseeLibUSBDataTransfer::run_transfers(const DataTransfer &data_producer) {
             // Pass the data and get a new buffer
             data_producer.transfer_data(transfer.get_buf());
             // Ensure the buffer can receive a transfer
-            auto buff = buffer_pool_.acquire();
+            auto buff = buffer_pool_.acquire(packet_size_, memory_resource_);
             buff->resize(packet_size_);
             // Attach it to the transfer
             transfer.prepare(dev_, bEpCommAddress_, std::move(buff), timeout_);
@@ -145,7 +145,7 @@ bool TzDeviceBuilder::build_devices(std::shared_ptr<TzLibUSBBoardCommand> cmd,
     try {
         size_t raw_size_bytes = 0;
         auto format           = devices[0]->get_output_format();
-        auto decoder          = make_decoder(device_builder, format, raw_size_bytes, false);
+        auto decoder          = make_decoder(device_builder, format, raw_size_bytes, false, config);
         device_builder.add_facility(std::make_unique<Metavision::I_EventsStream>(
             cmd->build_raw_data_producer(raw_size_bytes), hw_identification, decoder, ctrl));
     } catch (std::exception &e) { MV_HAL_LOG_WARNING() << "System can't stream:" << e.what(); }
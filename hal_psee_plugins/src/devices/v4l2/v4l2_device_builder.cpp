@@ -45,7 +45,7 @@ bool V4L2DeviceBuilder::build_device(std::shared_ptr<BoardCommand> cmd, DeviceBu
     try {
         size_t raw_size_bytes = 0;
         auto format           = StreamFormat(hw_identification->get_current_data_encoding_format());
-        auto decoder          = make_decoder(device_builder, format, raw_size_bytes, false);
+        auto decoder          = make_decoder(device_builder, format, raw_size_bytes, false, config);
         device_builder.add_facility(std::make_unique<I_EventsStream>(v4l2cmd->build_raw_data_producer(raw_size_bytes),
                                                                      hw_identification, decoder, ctrl));
     } catch (std::exception &e) { MV_HAL_LOG_WARNING() << "System can't stream:" << e.what(); }
@@ -0,0 +1,24 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+#include <memory>
+
+#include "metavision/hal/plugin/plugin.h"
+#include "metavision/hal/plugin/plugin_entrypoint.h"
+#include "boards/synthetic/synthetic_camera_discovery.h"
+#include "plugin/psee_plugin.h"
+
+using namespace Metavision;
+
+void initialize_plugin(void *plugin_ptr) {
+    Plugin &plugin = plugin_cast(plugin_ptr);
+    initialize_psee_plugin(plugin);
+    plugin.add_camera_discovery(std::make_unique<SyntheticCameraDiscovery>());
+}
@@ -75,20 +75,40 @@ std::shared_ptr<I_EventsStreamDecoder> make_decoder(DeviceBuilder &device_builde
 
     raw_size_bytes = 0;
     if (format.name() == "EVT4") {
-        auto cd_decoder           = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCD>>());
         auto ext_trig_decoder     = device_builder.add_facility(std::make_unique<I_EventDecoder<EventExtTrigger>>());
         auto erc_count_ev_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventERCCounter>>());
 
-        decoder = device_builder.add_facility(make_evt4_decoder(do_time_shifting, i_geometry->get_width(),
-                                                                i_geometry->get_height(), cd_decoder, ext_trig_decoder,
-                                                                erc_count_ev_decoder));
+        if (config.get<bool>("evt4_keep_vectors")) {
+            auto cd_vector_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCDVector>>());
+
+            decoder = device_builder.add_facility(std::make_unique<EVT4VectorizedDecoder>(
+                do_time_shifting, i_geometry->get_width(), i_geometry->get_height(), cd_vector_decoder,
+                ext_trig_decoder, erc_count_ev_decoder));
+        } else {
+            auto cd_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCD>>());
+
+            decoder = device_builder.add_facility(make_evt4_decoder(do_time_shifting, i_geometry->get_width(),
+                                                                    i_geometry->get_height(), cd_decoder,
+                                                                    ext_trig_decoder, erc_count_ev_decoder));
+        }
 
         raw_size_bytes = decoder->get_raw_event_size_bytes();
     } else if (format.name() == "EVT3") {
-        auto cd_decoder           = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCD>>());
-        auto ext_trig_decoder     = device_builder.add_facility(std::make_unique<I_EventDecoder<EventExtTrigger>>());
-        auto erc_count_ev_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventERCCounter>>());
-        auto monitoring_ev_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventMonitoring>>());
+        // Decoders are only created for the event types the device emits, so that make_evt3_decoder instantiates a
+        // decoder where the decoding of the other types is compiled out
+        auto cd_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCD>>());
+        std::shared_ptr<I_EventDecoder<EventExtTrigger>> ext_trig_decoder;
+        std::shared_ptr<I_EventDecoder<EventERCCounter>> erc_count_ev_decoder;
+        std::shared_ptr<I_EventDecoder<EventMonitoring>> monitoring_ev_decoder;
+        if (config.get<bool>("evt3_ext_trigger_events", true)) {
+            ext_trig_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventExtTrigger>>());
+        }
+        if (config.get<bool>("evt3_erc_counter_events", true)) {
+            erc_count_ev_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventERCCounter>>());
+        }
+        if (config.get<bool>("evt3_monitoring_events", true)) {
+            monitoring_ev_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventMonitoring>>());
+        }
 
         decoder = device_builder.add_facility(
             make_evt3_decoder(do_time_shifting, i_geometry->get_height(), i_geometry->get_width(), cd_decoder,
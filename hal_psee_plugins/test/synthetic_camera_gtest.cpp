@@ -0,0 +1,274 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_custom.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_erc_module.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/facilities/i_geometry.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_ll_biases.h"
+#include "metavision/hal/facilities/i_roi.h"
+#include "metavision/hal/facilities/i_trigger_in.h"
+#include "metavision/hal/facilities/i_trigger_out.h"
+#include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "boards/synthetic/synthetic_camera_config.h"
+#include "boards/synthetic/synthetic_camera_discovery.h"
+#include "boards/synthetic/synthetic_data_transfer.h"
+#include "boards/synthetic/synthetic_scene_generator.h"
+#include "device_builder_maker.h"
+
+using namespace Metavision;
+
+namespace {
+
+struct StreamedData {
+    std::vector<EventCD> cds;
+    std::vector<EventExtTrigger> triggers;
+    size_t raw_bytes = 0;
+};
+
+std::unique_ptr<Device> open_synthetic(const DeviceConfig &config) {
+    DeviceBuilder device_builder = make_device_builder();
+    SyntheticCameraDiscovery discovery;
+    if (!discovery.discover(device_builder, "", config)) {
+        return nullptr;
+    }
+    return device_builder();
+}
+
+DeviceConfig make_config(const std::string &format, const std::string &scene, double event_rate) {
+    DeviceConfig config;
+    config.set_format(format);
+    config.set(SyntheticCameraConfig::kSceneKey, scene);
+    config.set(SyntheticCameraConfig::kEventRateKey, event_rate);
+    config.set(SyntheticCameraConfig::kRealTimeKey, false);
+    return config;
+}
+
+// Streams and decodes the first `duration` us of sensor time
+StreamedData stream(Device &device, timestamp duration) {
+    StreamedData data;
+    auto decoder = device.get_facility<I_EventsStreamDecoder>();
+    device.get_facility<I_EventDecoder<EventCD>>()->add_event_buffer_callback(
+        [&](const EventCD *begin, const EventCD *end) { data.cds.insert(data.cds.end(), begin, end); });
+    device.get_facility<I_EventDecoder<EventExtTrigger>>()->add_event_buffer_callback(
+        [&](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            data.triggers.insert(data.triggers.end(), begin, end);
+        });
+
+    auto events_stream = device.get_facility<I_EventsStream>();
+    events_stream->start();
+    while (decoder->get_last_timestamp() < duration && events_stream->wait_next_buffer() > 0) {
+        auto buffer = events_stream->get_latest_raw_data();
+        data.raw_bytes += buffer.size();
+        decoder->decode(buffer);
+    }
+    events_stream->stop();
+
+    data.cds.erase(std::find_if(data.cds.begin(), data.cds.end(), [&](const auto &ev) { return ev.t >= duration; }),
+                   data.cds.end());
+    data.triggers.erase(std::find_if(data.triggers.begin(), data.triggers.end(),
+                                     [&](const auto &ev) { return ev.t >= duration; }),
+                        data.triggers.end());
+    return data;
+}
+
+} // namespace
+
+class SyntheticCamera_GTest : public ::testing::TestWithParam<std::tuple<std::string, std::string>> {};
+
+TEST_P(SyntheticCamera_GTest, decoded_stream_matches_scene) {
+    const auto config = make_config(std::get<0>(GetParam()), std::get<1>(GetParam()), 20.);
+    auto device       = open_synthetic(config);
+    ASSERT_NE(nullptr, device);
+
+    const timestamp duration = 25000;
+    const auto data          = stream(*device, duration);
+
+    std::vector<EventCD> expected;
+    SyntheticSceneGenerator generator(SyntheticCameraConfig::from_device_config(config));
+    generator.generate(0, duration, expected);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(expected.size(), data.cds.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].x, data.cds[i].x) << "at index " << i;
+        ASSERT_EQ(expected[i].y, data.cds[i].y) << "at index " << i;
+        ASSERT_EQ(expected[i].p, data.cds[i].p) << "at index " << i;
+        ASSERT_EQ(expected[i].t, data.cds[i].t) << "at index " << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(SyntheticCameraScenes, SyntheticCamera_GTest,
+                        ::testing::Combine(::testing::Values("EVT2", "EVT3"),
+                                           ::testing::Values("noise", "moving_bars", "flicker", "bursts")));
+
+TEST(SyntheticCameraFacilities_GTest, exposes_facilities_and_geometry) {
+    DeviceConfig config;
+    config.set(SyntheticCameraConfig::kWidthKey, 640);
+    config.set(SyntheticCameraConfig::kHeightKey, 480);
+    auto device = open_synthetic(config);
+    ASSERT_NE(nullptr, device);
+
+    EXPECT_EQ(640, device->get_facility<I_Geometry>()->get_width());
+    EXPECT_EQ(480, device->get_facility<I_Geometry>()->get_height());
+    EXPECT_NE(nullptr, device->get_facility<I_LL_Biases>());
+    EXPECT_NE(nullptr, device->get_facility<I_ErcModule>());
+    EXPECT_NE(nullptr, device->get_facility<I_ROI>());
+    EXPECT_NE(nullptr, device->get_facility<I_TriggerIn>());
+    EXPECT_NE(nullptr, device->get_facility<I_TriggerOut>());
+
+    auto hw_identification = device->get_facility<I_HW_Identification>();
+    EXPECT_EQ("synthetic", hw_identification->get_serial());
+    EXPECT_EQ("EVT3", hw_identification->get_header().get_field("format").substr(0, 4));
+    const auto options = hw_identification->get_device_config_options();
+    EXPECT_EQ(1, options.count(SyntheticCameraConfig::kSceneKey));
+    EXPECT_EQ(1, options.count(SyntheticCameraConfig::kEventRateKey));
+
+    auto biases = device->get_facility<I_LL_Biases>();
+    EXPECT_TRUE(biases->set("bias_diff_on", 20));
+    EXPECT_EQ(20, biases->get("bias_diff_on"));
+    EXPECT_THROW(biases->set("bias_unknown", 20), HalException);
+}
+
+TEST(SyntheticCameraFacilities_GTest, rejects_unsupported_config) {
+    DeviceConfig config;
+    config.set_format("EVT21");
+    EXPECT_EQ(nullptr, open_synthetic(config));
+
+    config = DeviceConfig();
+    config.set(SyntheticCameraConfig::kSceneKey, "fireworks");
+    EXPECT_EQ(nullptr, open_synthetic(config));
+
+    config = DeviceConfig();
+    config.set(SyntheticCameraConfig::kWidthKey, 4096);
+    EXPECT_EQ(nullptr, open_synthetic(config));
+}
+
+TEST(SyntheticCameraFacilities_GTest, bursts_are_packed_in_evt3_vectors) {
+    auto device = open_synthetic(make_config("EVT3", "bursts", 150.));
+    ASSERT_NE(nullptr, device);
+
+    const auto data = stream(*device, 20000);
+    // 2 bursts of 1 ms at 150 Mev/s
+    EXPECT_GT(data.cds.size(), 300000u);
+    // Rows of events are sent 32 at a time in 3 or 4 words of 2 bytes
+    EXPECT_LT(data.raw_bytes, data.cds.size());
+}
+
+TEST(SyntheticCameraFacilities_GTest, roi_filters_events) {
+    auto device = open_synthetic(make_config("EVT3", "noise", 20.));
+    ASSERT_NE(nullptr, device);
+
+    auto roi = device->get_facility<I_ROI>();
+    const I_ROI::Window window(100, 50, 200, 100);
+    ASSERT_TRUE(roi->set_window(window));
+    ASSERT_TRUE(roi->enable(true));
+
+    const auto data = stream(*device, 10000);
+    ASSERT_FALSE(data.cds.empty());
+    for (const auto &ev : data.cds) {
+        ASSERT_TRUE(ev.x >= window.x && ev.x < window.x + window.width && ev.y >= window.y &&
+                    ev.y < window.y + window.height);
+    }
+}
+
+TEST(SyntheticCameraFacilities_GTest, erc_caps_event_count) {
+    auto device = open_synthetic(make_config("EVT2", "noise", 20.));
+    ASSERT_NE(nullptr, device);
+
+    auto erc = device->get_facility<I_ErcModule>();
+    ASSERT_TRUE(erc->set_cd_event_count(1000));
+    ASSERT_TRUE(erc->enable(true));
+
+    const timestamp duration = 10000;
+    const auto data          = stream(*device, duration);
+    const timestamp period   = erc->get_count_period();
+    for (timestamp t = 0; t < duration; t += period) {
+        const auto count = std::count_if(data.cds.begin(), data.cds.end(),
+                                         [&](const auto &ev) { return ev.t >= t && ev.t < t + period; });
+        EXPECT_EQ(1000, count);
+    }
+}
+
+TEST(SyntheticCameraFacilities_GTest, trigger_out_loops_back_to_trigger_in) {
+    for (const std::string format : {"EVT2", "EVT3"}) {
+        auto device = open_synthetic(make_config(format, "noise", 1.));
+        ASSERT_NE(nullptr, device);
+
+        auto trigger_out = device->get_facility<I_TriggerOut>();
+        ASSERT_TRUE(trigger_out->set_period(1000));
+        ASSERT_TRUE(trigger_out->set_duty_cycle(0.25));
+        ASSERT_TRUE(trigger_out->enable());
+        auto trigger_in = device->get_facility<I_TriggerIn>();
+        ASSERT_TRUE(trigger_in->enable(I_TriggerIn::Channel::Loopback));
+        const short id = trigger_in->get_available_channels()[I_TriggerIn::Channel::Loopback];
+
+        const auto data = stream(*device, 10000);
+        ASSERT_EQ(20u, data.triggers.size()) << format;
+        for (size_t i = 0; i < data.triggers.size(); ++i) {
+            EXPECT_EQ(i % 2 == 0 ? 1 : 0, data.triggers[i].p);
+            EXPECT_EQ((i / 2) * 1000 + (i % 2) * 250, data.triggers[i].t);
+            EXPECT_EQ(id, data.triggers[i].id);
+        }
+    }
+}
+
+TEST(SyntheticCameraFacilities_GTest, time_flows_without_events) {
+    for (const std::string format : {"EVT2", "EVT3"}) {
+        auto device = open_synthetic(make_config(format, "noise", 0.001));
+        ASSERT_NE(nullptr, device);
+
+        // At 1 kev/s, about 10 events are expected in 10 ms, but the decoder must reach the end of the stream anyway
+        const auto data = stream(*device, 10000);
+        EXPECT_NEAR(10, data.cds.size(), 1) << format;
+    }
+}
+
+TEST(SyntheticCameraFacilities_GTest, slow_consumer_bounds_live_buffers) {
+    // GIVEN a camera streaming as fast as possible and a consumer holding all the buffers it gets
+    auto device = open_synthetic(make_config("EVT3", "bursts", 100.));
+    ASSERT_NE(nullptr, device);
+    auto events_stream = device->get_facility<I_EventsStream>();
+    events_stream->start();
+
+    // WHEN the consumer is late
+    std::vector<DataTransfer::BufferPtr> held_buffers;
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        while (events_stream->poll_buffer() > 0) {
+            held_buffers.push_back(events_stream->get_latest_raw_data());
+        }
+    }
+
+    // THEN the producer waits for buffers to be released instead of generating more data
+    EXPECT_FALSE(held_buffers.empty());
+    EXPECT_LE(held_buffers.size(), SyntheticDataTransfer::kBufferPoolSize);
+
+    // AND streaming resumes once they are released
+    held_buffers.clear();
+    EXPECT_EQ(1, events_stream->wait_next_buffer());
+    events_stream->stop();
+}
@@ -16,7 +16,6 @@
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
-#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -32,6 +31,7 @@
 #include <metavision/hal/facilities/i_ll_biases.h>
 #include <metavision/sdk/core/algorithms/event_buffer_reslicer_algorithm.h>
 #include <metavision/sdk/core/algorithms/on_demand_frame_generation_algorithm.h>
+#include <metavision/sdk/core/utils/triple_buffer.h>
 #include <metavision/sdk/stream/camera.h>
 #include <metavision/sdk/ui/utils/event_loop.h>
 
@@ -53,8 +53,8 @@ struct AppState {
     std::unique_ptr<Metavision::EventBufferReslicerAlgorithm> reslicer;
     Metavision::I_LL_Biases *biases = nullptr;
 
-    std::mutex frame_mutex;
-    cv::Mat latest_frame;
+    // Frames are generated in the camera thread and displayed in the main one
+    Metavision::TripleBuffer<cv::Mat> frames;
 
     std::atomic<bool> desired_camera_on{false};
     std::atomic<bool> capture_requested{false};
@@ -228,7 +228,6 @@ bool start_camera(AppState &app, std::vector<BiasControl> &controls, const std::
 
     const int width = app.camera->geometry().get_width();
     const int height = app.camera->geometry().get_height();
-    app.latest_frame = cv::Mat(height, width, CV_8UC3, cv::Scalar(0, 0, 0));
 
     constexpr uint32_t kAccumulationTimeUs = 50000;
     constexpr int kSlicePeriodUs = 30000;
@@ -242,11 +241,11 @@ bool start_camera(AppState &app, std::vector<BiasControl> &controls, const std::
     app.reslicer->set_on_new_slice_callback([&app](
                                                Metavision::EventBufferReslicerAlgorithm::ConditionStatus,
                                                Metavision::timestamp ts, std::size_t) {
-        std::lock_guard<std::mutex> lock(app.frame_mutex);
         if (!app.frame_generator) {
             return;
         }
-        app.frame_generator->generate(ts, app.latest_frame);
+        app.frame_generator->generate(ts, app.frames.write_buffer());
+        app.frames.publish();
     });
 
     auto reslicer_ev_callback = [&app](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
@@ -289,14 +288,11 @@ void stop_camera(AppState &app) {
 }
 
 void capture_image(AppState &app) {
-    cv::Mat frame_copy;
-    {
-        std::lock_guard<std::mutex> lock(app.frame_mutex);
-        if (app.latest_frame.empty()) {
-            std::cout << "No frame available to capture." << std::endl;
-            return;
-        }
-        frame_copy = app.latest_frame.clone();
+    // The displayed frame is owned by the main thread, it can be saved without copy
+    const cv::Mat &frame = app.frames.read_buffer();
+    if (frame.empty()) {
+        std::cout << "No frame available to capture." << std::endl;
+        return;
     }
 
     std::filesystem::path capture_dir = std::filesystem::path(".") / "captures";
@@ -309,7 +305,7 @@ void capture_image(AppState &app) {
 
     auto filename = make_capture_filename();
     auto output_path = capture_dir / filename;
-    if (!cv::imwrite(output_path.string(), frame_copy)) {
+    if (!cv::imwrite(output_path.string(), frame)) {
         std::cerr << "Failed to save capture to " << output_path.string() << std::endl;
         return;
     }
@@ -499,9 +495,8 @@ int main() {
             capture_image(app);
         }
 
-        if (!app.latest_frame.empty()) {
-            std::lock_guard<std::mutex> lock(app.frame_mutex);
-            cv::imshow(display_window, app.latest_frame);
+        if (app.frames.update() && !app.frames.read_buffer().empty()) {
+            cv::imshow(display_window, app.frames.read_buffer());
         }
 
         int key = cv::waitKey(1);
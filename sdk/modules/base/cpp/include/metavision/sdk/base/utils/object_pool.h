@@ -12,13 +12,18 @@
 #ifndef METAVISION_SDK_BASE_OBJECT_POOL_H
 #define METAVISION_SDK_BASE_OBJECT_POOL_H
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <stack>
 #include <stdexcept>
 #include <type_traits>
 
+#include "metavision/sdk/base/utils/detail/bitinstructions.h"
+
 namespace Metavision {
 
 /// @brief Class that creates a reusable pool of heap allocated objects
@@ -30,6 +35,9 @@ namespace Metavision {
 /// The smart pointers are given a custom deleter, which automatically adds the object
 /// back to the pool upon destruction.
 ///
+/// The available objects are kept in a lock-free stack, so that neither @ref acquire nor the release of an object
+/// takes a lock, unless a bounded pool is exhausted and @ref acquire has to wait for an object to be released.
+///
 /// @tparam T the type of object stored
 /// @tparam acquire_shared_ptr if true, the object are wrapped by a @a std::shared_ptr, otherwise
 /// a std::unique_ptr is returned instead
@@ -87,6 +95,19 @@ public:
         return ObjectPool(num_initial_objects, true, std::forward<Args>(args)...);
     }
 
+    /// @brief Creates an object pool with limited number of objects, allocated when first acquired
+    ///
+    /// Contrary to @ref make_bounded, the objects are allocated by the thread acquiring them, so that their memory is
+    /// first touched, and placed on the NUMA node of this thread, rather than the one creating the pool.
+    ///
+    /// @param max_num_objects Maximum number of objects allocated by the pool
+    /// @param args The arguments copied to the object constructor during allocation
+    /// @return An object pool with bounded memory
+    template<typename... Args>
+    static ObjectPool<T, acquire_shared_ptr> make_bounded_lazy(size_t max_num_objects, Args &&...args) {
+        return ObjectPool(max_num_objects, std::function<T *()>([args...]() { return new T(args...); }));
+    }
+
     /// @brief Creates an object pool with expendable memory usage
     ///
     /// A pool with unbounded memory will allocate a new object when all objects in the pool are already used
@@ -169,6 +190,101 @@ private:
     ObjectPool(size_t num_initial_objects, bool bounded_memory, Args &&...args) :
         impl_(new Impl(num_initial_objects, bounded_memory, std::forward<Args>(args)...)) {}
 
+    /// @brief Constructor of a bounded pool allocating its objects on demand
+    ObjectPool(size_t max_num_objects, std::function<T *()> &&make_object) :
+        impl_(new Impl(max_num_objects, std::move(make_object))) {}
+
+    /// @brief Node of the lock-free stacks of objects
+    struct Node {
+        T *object = nullptr;
+        std::atomic<std::uint32_t> next{0};
+    };
+
+    /// @brief Storage of the nodes, whose addresses remain stable until the pool is destroyed
+    ///
+    /// The nodes are referred to by their index, the chunk @a k holding the (kFirstChunkSize << k) nodes following
+    /// the ones of the previous chunks.
+    class NodeStorage {
+    public:
+        static constexpr std::uint32_t kNoNode = 0xFFFFFFFF;
+
+        ~NodeStorage() {
+            for (auto &chunk : chunks_) {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        Node &operator[](std::uint32_t idx) const {
+            const std::uint32_t v = idx + kFirstChunkSize;
+            const std::uint32_t k = 31 - clz_not_zero(v) - kFirstChunkSizeLog2;
+            return chunks_[k].load(std::memory_order_acquire)[v - (kFirstChunkSize << k)];
+        }
+
+        /// @brief Allocates a new node, which is never released before the storage
+        std::uint32_t allocate() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const std::uint32_t idx = num_nodes_;
+            const std::uint32_t v   = idx + kFirstChunkSize;
+            const std::uint32_t k   = 31 - clz_not_zero(v) - kFirstChunkSizeLog2;
+            if (k >= kNumChunks) {
+                throw std::bad_alloc();
+            }
+            if (v == (kFirstChunkSize << k)) {
+                chunks_[k].store(new Node[kFirstChunkSize << k], std::memory_order_release);
+            }
+            ++num_nodes_;
+            return idx;
+        }
+
+    private:
+        static constexpr std::uint32_t kFirstChunkSizeLog2 = 6;
+        static constexpr std::uint32_t kFirstChunkSize     = 1 << kFirstChunkSizeLog2;
+        static constexpr std::uint32_t kNumChunks          = 25;
+
+        std::array<std::atomic<Node *>, kNumChunks> chunks_{};
+        std::uint32_t num_nodes_{0};
+        std::mutex mutex_;
+    };
+
+    /// @brief Lock-free (Treiber) stack of nodes
+    ///
+    /// The head packs the index of the top node with a counter incremented by each operation, which prevents a
+    /// pop from succeeding if the stack has been modified since its head was read (ABA problem).
+    class NodeStack {
+    public:
+        void push(NodeStorage &nodes, std::uint32_t idx) {
+            std::uint64_t head = head_.load(std::memory_order_relaxed);
+            do {
+                nodes[idx].next.store(top(head), std::memory_order_relaxed);
+            } while (!head_.compare_exchange_weak(head, pack(idx, head), std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed));
+        }
+
+        bool pop(NodeStorage &nodes, std::uint32_t &idx) {
+            std::uint64_t head = head_.load(std::memory_order_seq_cst);
+            while (top(head) != NodeStorage::kNoNode) {
+                const std::uint32_t next = nodes[top(head)].next.load(std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, pack(next, head), std::memory_order_seq_cst,
+                                                std::memory_order_seq_cst)) {
+                    idx = top(head);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        static std::uint32_t top(std::uint64_t head) {
+            return static_cast<std::uint32_t>(head);
+        }
+
+        static std::uint64_t pack(std::uint32_t idx, std::uint64_t prev_head) {
+            return (((prev_head >> 32) + 1) << 32) | idx;
+        }
+
+        std::atomic<std::uint64_t> head_{NodeStorage::kNoNode};
+    };
+
     /// @brief Implementation of the object pool in a separate object
     ///
     /// This is defined to make movable and move assignable the object pool.
@@ -181,16 +297,41 @@ private:
                     "Failed to allocate memory for the bounded object pool: pool's size can not be 0.");
             }
             for (size_t i = 0; i < num_initial_objects; ++i) {
-                pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+                add(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+            }
+        }
+
+        /// @brief Constructor of a bounded pool allocating its objects on demand
+        Impl(size_t max_num_objects, std::function<T *()> &&make_object) :
+            bounded_memory_(true), make_object_(std::move(make_object)), num_lazy_objects_(max_num_objects) {
+            if (max_num_objects == 0) {
+                throw std::invalid_argument(
+                    "Failed to allocate memory for the bounded object pool: pool's size can not be 0.");
+            }
+        }
+
+        ~Impl() {
+            std::uint32_t idx;
+            while (available_.pop(nodes_, idx)) {
+                std::default_delete<T>{}(nodes_[idx].object);
             }
         }
 
         /// @brief Adds an object to the pool
         /// @param t A unique_ptr storing the object
         void add(std::unique_ptr<T> t) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            pool_.push(std::move(t));
-            if (bounded_memory_) {
+            std::uint32_t idx;
+            if (!spare_.pop(nodes_, idx)) {
+                idx = nodes_.allocate();
+            }
+            nodes_[idx].object = t.release();
+            available_.push(nodes_, idx);
+            size_.fetch_add(1, std::memory_order_relaxed);
+
+            // The push and this load are sequentially consistent with the ones of a waiting acquire, so that either
+            // the waiter sees the object or the object is followed by a notification
+            if (bounded_memory_ && num_waiters_.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
                 cond_.notify_all();
             }
         }
@@ -201,14 +342,14 @@ private:
         /// @return the number of newly allocated object in the pool
         template<typename... Args>
         size_t arrange(size_t size, Args &&...args) {
-            if (bounded_memory_ || size <= pool_.size()) {
+            if (bounded_memory_) {
                 return 0;
             }
 
-            std::unique_lock<std::mutex> lock(mutex_);
-            size_t nb_allocated_obj = size - pool_.size();
-            while (pool_.size() < size) {
-                pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+            size_t nb_allocated_obj = 0;
+            while (this->size() < size) {
+                add(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+                ++nb_allocated_obj;
             }
 
             return nb_allocated_obj;
@@ -219,31 +360,30 @@ private:
         /// @return A unique or shared pointer to the allocated object
         template<typename... Args>
         ptr_type acquire(Args &&...args) {
-            std::unique_lock<std::mutex> lock(mutex_);
-            if (pool_.empty()) {
+            T *object = try_acquire();
+            if (!object) {
                 if (bounded_memory_) {
-                    cond_.wait(lock, [this] { return !pool_.empty(); });
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    num_waiters_.fetch_add(1, std::memory_order_seq_cst);
+                    cond_.wait(lock, [this, &object] { return (object = try_acquire()) != nullptr; });
+                    num_waiters_.fetch_sub(1, std::memory_order_relaxed);
                 } else {
-                    pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+                    object = new T(std::forward<Args>(args)...);
                 }
             }
-            ptr_type tmp(pool_.top().release(), Deleter{this->shared_from_this()});
-            pool_.pop();
-            return tmp;
+            return ptr_type(object, Deleter{this->shared_from_this()});
         }
 
         /// @brief Checks if the pool is empty
         /// @return true if the pool is empty, false if the pool contains an object ready to be re-used
         bool empty() const {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return pool_.empty();
+            return size() == 0;
         }
 
         /// @brief Gets the number of objects in the pool
         /// @return The number of previously allocated and ready to-reuse objects in the pool
         size_t size() const {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return pool_.size();
+            return size_.load(std::memory_order_relaxed);
         }
 
         /// @brief Checks the memory pool type i.e. bounded or unbounded
@@ -252,10 +392,44 @@ private:
             return bounded_memory_;
         }
 
-        mutable std::mutex mutex_;
-        mutable std::condition_variable cond_;
-        std::stack<std::unique_ptr<T>> pool_;
-        bool bounded_memory_{false};
+    private:
+        // Pops an available object, or allocates one if the pool still can, returns nullptr otherwise
+        T *try_acquire() {
+            std::uint32_t idx;
+            if (available_.pop(nodes_, idx)) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                T *object = nodes_[idx].object;
+                spare_.push(nodes_, idx);
+                return object;
+            }
+            if (make_object_) {
+                size_t n = num_lazy_objects_.load(std::memory_order_relaxed);
+                while (n > 0) {
+                    if (num_lazy_objects_.compare_exchange_weak(n, n - 1, std::memory_order_relaxed)) {
+                        try {
+                            return make_object_();
+                        } catch (...) {
+                            num_lazy_objects_.fetch_add(1, std::memory_order_relaxed);
+                            throw;
+                        }
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        NodeStorage nodes_;
+        // Stacks of the nodes holding an available object, and of the ones free to hold a released object, on
+        // their own cache lines as they are modified by both the producer and consumer threads
+        alignas(64) NodeStack available_;
+        alignas(64) NodeStack spare_;
+        alignas(64) std::atomic<size_t> size_{0};
+        std::atomic<int> num_waiters_{0};
+        const bool bounded_memory_{false};
+        std::function<T *()> make_object_;
+        std::atomic<size_t> num_lazy_objects_{0};
+        std::mutex mutex_;
+        std::condition_variable cond_;
     };
 
     std::shared_ptr<Impl> impl_;
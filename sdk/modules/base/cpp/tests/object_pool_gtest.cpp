@@ -10,10 +10,12 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "metavision/sdk/base/utils/object_pool.h"
 
@@ -313,3 +315,69 @@ TEST(ObjectPool_GTest, should_not_arrange_on_bounded_pool) {
     EXPECT_EQ(obj_pool.arrange(100), 0);
     EXPECT_EQ(obj_pool.size(), 10);
 }
+
+TEST(ObjectPool_GTest, bounded_lazy_allocates_objects_on_acquire) {
+    // WHEN creating a bounded pool allocating its objects on demand
+    auto pool = Metavision::ObjectPool<std::vector<int>>::make_bounded_lazy(2, 5, 3);
+
+    // THEN no object is allocated yet
+    EXPECT_TRUE(pool.is_bounded());
+    EXPECT_EQ(0, pool.size());
+
+    // WHEN acquiring objects up to the bound
+    auto object1 = pool.acquire();
+    auto object2 = pool.acquire();
+
+    // THEN the objects are allocated with the forwarded parameters
+    EXPECT_EQ(std::vector<int>(5, 3), *object1);
+    EXPECT_EQ(std::vector<int>(5, 3), *object2);
+
+    // WHEN waiting for an object while one is released from another thread
+    auto *released = object1.get();
+    std::thread releaser([&object1]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        object1.reset();
+    });
+    auto object3 = pool.acquire();
+    releaser.join();
+
+    // THEN the released object is reused instead of allocating a new one
+    EXPECT_EQ(released, object3.get());
+    EXPECT_EQ(0, pool.size());
+}
+
+TEST(ObjectPool_GTest, bounded_concurrent_acquire_and_release) {
+    // GIVEN a small bounded pool shared by several threads
+    constexpr int kNumObjects = 4, kNumThreads = 8, kNumIterations = 5000;
+    auto pool = Metavision::SharedObjectPool<int>::make_bounded(kNumObjects, 0);
+    std::atomic<int> num_in_use{0}, max_in_use{0};
+
+    // WHEN the threads acquire and release objects concurrently
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < kNumIterations; ++j) {
+                auto object = pool.acquire();
+                const int n = ++num_in_use;
+                int max     = max_in_use;
+                while (n > max && !max_in_use.compare_exchange_weak(max, n)) {}
+                ++(*object);
+                --num_in_use;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN no more objects than the bound are used at the same time, and they are all back in the pool
+    EXPECT_LE(max_in_use, kNumObjects);
+    EXPECT_EQ(kNumObjects, pool.size());
+    int total = 0;
+    std::vector<Metavision::SharedObjectPool<int>::ptr_type> objects;
+    for (int i = 0; i < kNumObjects; ++i) {
+        objects.push_back(pool.acquire());
+        total += *objects.back();
+    }
+    EXPECT_EQ(kNumThreads * kNumIterations, total);
+}
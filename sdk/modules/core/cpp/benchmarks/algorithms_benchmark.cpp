@@ -0,0 +1,478 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_algorithm.h"
+#include "metavision/sdk/core/algorithms/contrast_map_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/event_buffer_reslicer_algorithm.h"
+#include "metavision/sdk/core/algorithms/event_rescaler_algorithm.h"
+#include "metavision/sdk/core/algorithms/events_integration_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_y_algorithm.h"
+#include "metavision/sdk/core/algorithms/on_demand_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_inverter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_mask_algorithm.h"
+#include "metavision/sdk/core/algorithms/rotate_events_algorithm.h"
+#include "metavision/sdk/core/algorithms/time_decay_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/transpose_events_algorithm.h"
+#include "metavision/sdk/core/preprocessors/diff_processor.h"
+#include "metavision/sdk/core/preprocessors/event_cube_processor.h"
+#include "metavision/sdk/core/preprocessors/event_preprocessor.h"
+#include "metavision/sdk/core/preprocessors/hardware_diff_processor.h"
+#include "metavision/sdk/core/preprocessors/hardware_histo_processor.h"
+#include "metavision/sdk/core/preprocessors/histo_processor.h"
+#include "metavision/sdk/core/preprocessors/tensor.h"
+#include "metavision/sdk/core/preprocessors/time_surface_processor.h"
+#include "baseline_comparison.h"
+#include "synthetic_cd_streams.h"
+
+using namespace Metavision;
+using namespace Metavision::benchmarks;
+
+namespace {
+
+// Size of the buffers of events handed to the algorithms, in the range of what the decoders produce
+constexpr std::size_t kBufferSize = 4096;
+
+// Period of the frames generated by the algorithms and duration of the slices processed by the preprocessors
+constexpr timestamp kFramePeriodUs = 10000;
+
+// Counter compared to the baseline, lower is better
+const std::string kComparedCounter = "ns/event";
+
+struct Resolution {
+    int width;
+    int height;
+};
+
+const std::vector<Resolution> kResolutions = {{320, 320}, {640, 480}, {1280, 720}};
+
+using EventStream        = std::vector<EventCD>;
+using EventPreprocessorT = EventPreprocessor<const EventCD *>;
+
+/// @brief Returns the synthetic stream of the given parameters, generating it on first use
+std::shared_ptr<const EventStream> get_stream(const StreamParams &params) {
+    static std::map<std::tuple<EventDistribution, int, int>, std::shared_ptr<const EventStream>> cache;
+
+    auto &stream = cache[std::make_tuple(params.distribution, params.width, params.height)];
+    if (!stream) {
+        stream = std::make_shared<const EventStream>(generate_events(params));
+    }
+    return stream;
+}
+
+/// @brief Calls @p f on the successive buffers of events of a stream
+template<typename F>
+void for_each_buffer(const EventStream &events, F &&f) {
+    const auto *const end = events.data() + events.size();
+    for (const auto *it = events.data(); it != end;) {
+        const auto *const buffer_end = it + std::min<std::size_t>(kBufferSize, end - it);
+        f(it, buffer_end);
+        it = buffer_end;
+    }
+}
+
+/// @brief Sets the counters shared by all the benchmarks
+/// @param num_outputs Number of outputs (frames, slices...) produced per iteration, reported as a rate if
+/// @p output_counter is not empty
+void set_counters(benchmark::State &state, std::size_t num_events, std::size_t num_outputs = 0,
+                  const std::string &output_counter = std::string()) {
+    using Counter = benchmark::Counter;
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * num_events));
+    state.counters["events"]         = static_cast<double>(num_events);
+    state.counters["Mev/s"]          = Counter(num_events * 1e-6, Counter::kIsIterationInvariantRate);
+    state.counters[kComparedCounter] =
+        Counter(num_events * 1e-9, Counter::kIsIterationInvariantRate | Counter::kInvert);
+    if (!output_counter.empty()) {
+        state.counters[output_counter] = Counter(static_cast<double>(num_outputs), Counter::kIsIterationInvariantRate);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Frame generation
+
+/// @brief Processes the events by buffers and generates a frame every kFramePeriodUs, as a display loop would do
+/// @param make Function creating a new instance of the algorithm, called at each iteration so that it always sees a
+/// consistent stream
+/// @param generate Function generating a frame with the algorithm, at a given timestamp
+template<typename MakeAlgorithm, typename Generate>
+void process_and_generate(benchmark::State &state, const EventStream &events, MakeAlgorithm make,
+                          Generate generate) {
+    decltype(make()) algo;
+    std::size_t num_frames = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.reset();
+        algo = make();
+        state.ResumeTiming();
+
+        num_frames              = 0;
+        timestamp next_frame_ts = kFramePeriodUs;
+        for_each_buffer(events, [&](const EventCD *begin, const EventCD *end) {
+            algo->process_events(begin, end);
+            for (; std::prev(end)->t >= next_frame_ts; next_frame_ts += kFramePeriodUs) {
+                generate(*algo, next_frame_ts);
+                ++num_frames;
+            }
+        });
+    }
+    set_counters(state, events.size(), num_frames, "frames/s");
+}
+
+void periodic_frame_generation(benchmark::State &state, const EventStream &events, int width, int height) {
+    std::unique_ptr<PeriodicFrameGenerationAlgorithm> algo;
+    std::size_t num_frames = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.reset();
+        algo = std::make_unique<PeriodicFrameGenerationAlgorithm>(width, height, kFramePeriodUs);
+        algo->set_output_callback([&](timestamp, cv::Mat &frame) {
+            benchmark::DoNotOptimize(frame.data);
+            ++num_frames;
+        });
+        num_frames = 0;
+        state.ResumeTiming();
+
+        for_each_buffer(events, [&](const EventCD *begin, const EventCD *end) { algo->process_events(begin, end); });
+    }
+    set_counters(state, events.size(), num_frames, "frames/s");
+}
+
+void on_demand_frame_generation(benchmark::State &state, const EventStream &events, int width, int height) {
+    cv::Mat frame;
+    process_and_generate(
+        state, events,
+        [&]() { return std::make_unique<OnDemandFrameGenerationAlgorithm>(width, height, kFramePeriodUs); },
+        [&](OnDemandFrameGenerationAlgorithm &algo, timestamp ts) { algo.generate(ts, frame); });
+}
+
+void time_decay_frame_generation(benchmark::State &state, const EventStream &events, int width, int height) {
+    cv::Mat frame;
+    process_and_generate(
+        state, events,
+        [&]() {
+            return std::make_unique<TimeDecayFrameGenerationAlgorithm>(width, height, kFramePeriodUs,
+                                                                       ColorPalette::Dark);
+        },
+        [&](TimeDecayFrameGenerationAlgorithm &algo, timestamp) { algo.generate(frame); });
+}
+
+void events_integration(benchmark::State &state, const EventStream &events, int width, int height) {
+    cv::Mat frame;
+    process_and_generate(
+        state, events, [&]() { return std::make_unique<EventsIntegrationAlgorithm>(width, height); },
+        [&](EventsIntegrationAlgorithm &algo, timestamp) { algo.generate(frame); });
+}
+
+void contrast_map_generation(benchmark::State &state, const EventStream &events, int width, int height) {
+    cv::Mat_<float> contrast_map;
+    process_and_generate(
+        state, events, [&]() { return std::make_unique<ContrastMapGenerationAlgorithm>(width, height); },
+        [&](ContrastMapGenerationAlgorithm &algo, timestamp) { algo.generate(contrast_map); });
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Slicing
+
+void adaptive_rate_events_splitting(benchmark::State &state, const EventStream &events, int width, int height) {
+    std::unique_ptr<AdaptiveRateEventsSplitterAlgorithm> algo;
+    std::vector<EventCD> slice;
+    std::size_t num_slices = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.reset();
+        algo = std::make_unique<AdaptiveRateEventsSplitterAlgorithm>(height, width);
+        state.ResumeTiming();
+
+        num_slices = 0;
+        for_each_buffer(events, [&](const EventCD *begin, const EventCD *end) {
+            if (algo->process_events(begin, end)) {
+                algo->retrieve_events(slice);
+                ++num_slices;
+            }
+        });
+    }
+    set_counters(state, events.size(), num_slices, "slices/s");
+}
+
+void event_buffer_reslicing(benchmark::State &state, const EventStream &events,
+                            const EventBufferReslicerAlgorithm::Condition &condition) {
+    std::unique_ptr<EventBufferReslicerAlgorithm> algo;
+    std::size_t num_slices = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.reset();
+        algo = std::make_unique<EventBufferReslicerAlgorithm>(
+            [&](EventBufferReslicerAlgorithm::ConditionStatus, timestamp, std::size_t) { ++num_slices; }, condition);
+        num_slices = 0;
+        state.ResumeTiming();
+
+        for_each_buffer(events, [&](const EventCD *begin, const EventCD *end) {
+            algo->process_events(begin, end, [](const EventCD *slice_begin, const EventCD *slice_end) {
+                benchmark::DoNotOptimize(slice_begin);
+                benchmark::DoNotOptimize(slice_end);
+            });
+        });
+    }
+    set_counters(state, events.size(), num_slices, "slices/s");
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Filters
+
+/// @brief Filters the events by buffers into a reused output buffer, as the pipelines of the samples do
+template<typename Filter>
+void filter_events(benchmark::State &state, const EventStream &events, Filter filter) {
+    std::vector<EventCD> output;
+    output.reserve(kBufferSize);
+    for (auto _ : state) {
+        for_each_buffer(events, [&](const EventCD *begin, const EventCD *end) {
+            output.clear();
+            filter.process_events(begin, end, std::back_inserter(output));
+            benchmark::DoNotOptimize(output.data());
+        });
+    }
+    set_counters(state, events.size());
+}
+
+cv::Mat make_centered_roi_mask(int width, int height) {
+    cv::Mat mask(height, width, CV_64F, cv::Scalar(0));
+    mask(cv::Rect(width / 4, height / 4, width / 2, height / 2)).setTo(cv::Scalar(1));
+    return mask;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Preprocessors
+
+/// @brief Processes the stream by slices of kFramePeriodUs, each one into a cleared tensor, as an inference pipeline
+/// would do
+void preprocess_events(benchmark::State &state, const EventStream &events, const EventPreprocessorT &processor) {
+    const auto *const end = events.data() + events.size();
+    std::vector<const EventCD *> slice_bounds = {events.data()};
+    for (timestamp ts = kFramePeriodUs; slice_bounds.back() != end; ts += kFramePeriodUs) {
+        slice_bounds.push_back(std::lower_bound(slice_bounds.back(), end, ts,
+                                                [](const EventCD &ev, timestamp t) { return ev.t < t; }));
+    }
+    const auto num_slices = slice_bounds.size() - 1;
+
+    Tensor tensor(processor.get_output_shape(), processor.get_output_type());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < num_slices; ++i) {
+            tensor.set_to(0);
+            processor.process_events(i * kFramePeriodUs, slice_bounds[i], slice_bounds[i + 1], tensor);
+        }
+        benchmark::DoNotOptimize(tensor.data());
+    }
+    set_counters(state, events.size(), num_slices, "frames/s");
+}
+
+using PreprocessorFactory = std::function<std::unique_ptr<EventPreprocessorT>(int width, int height)>;
+
+template<typename Processor, typename... Args>
+PreprocessorFactory make_preprocessor_factory(Args... args) {
+    return [=](int width, int height) { return std::make_unique<Processor>(width, height, args...); };
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Registration
+
+using AlgorithmBenchmark = std::function<void(benchmark::State &, const EventStream &, int width, int height)>;
+
+struct AlgorithmSpec {
+    std::string name;
+    AlgorithmBenchmark run;
+};
+
+template<typename MakeFilter>
+AlgorithmSpec make_filter_spec(const std::string &name, MakeFilter make_filter) {
+    return {name, [make_filter](benchmark::State &state, const EventStream &events, int width, int height) {
+                filter_events(state, events, make_filter(width, height));
+            }};
+}
+
+AlgorithmSpec make_reslicer_spec(const std::string &name, const EventBufferReslicerAlgorithm::Condition &condition) {
+    return {name, [condition](benchmark::State &state, const EventStream &events, int, int) {
+                event_buffer_reslicing(state, events, condition);
+            }};
+}
+
+AlgorithmSpec make_preprocessor_spec(const std::string &name, const PreprocessorFactory &make_processor) {
+    return {name, [make_processor](benchmark::State &state, const EventStream &events, int width, int height) {
+                const auto processor = make_processor(width, height);
+                preprocess_events(state, events, *processor);
+            }};
+}
+
+std::vector<AlgorithmSpec> algorithm_specs() {
+    using Condition = EventBufferReslicerAlgorithm::Condition;
+    return {
+        {"PeriodicFrameGenerationAlgorithm", periodic_frame_generation},
+        {"OnDemandFrameGenerationAlgorithm", on_demand_frame_generation},
+        {"TimeDecayFrameGenerationAlgorithm", time_decay_frame_generation},
+        {"EventsIntegrationAlgorithm", events_integration},
+        {"ContrastMapGenerationAlgorithm", contrast_map_generation},
+        {"AdaptiveRateEventsSplitterAlgorithm", adaptive_rate_events_splitting},
+        make_reslicer_spec("EventBufferReslicerAlgorithm/n_us:10000", Condition::make_n_us(kFramePeriodUs)),
+        make_reslicer_spec("EventBufferReslicerAlgorithm/n_events:100000", Condition::make_n_events(100000)),
+        make_reslicer_spec("EventBufferReslicerAlgorithm/mixed:10000:100000",
+                           Condition::make_mixed(kFramePeriodUs, 100000)),
+        make_filter_spec("RoiFilterAlgorithm",
+                         [](int w, int h) { return RoiFilterAlgorithm(w / 4, h / 4, 3 * w / 4, 3 * h / 4); }),
+        make_filter_spec("RoiMaskAlgorithm",
+                         [](int w, int h) { return RoiMaskAlgorithm(make_centered_roi_mask(w, h)); }),
+        make_filter_spec("PolarityFilterAlgorithm", [](int, int) { return PolarityFilterAlgorithm(1); }),
+        make_filter_spec("PolarityInverterAlgorithm", [](int, int) { return PolarityInverterAlgorithm(); }),
+        make_filter_spec("FlipXAlgorithm", [](int w, int) { return FlipXAlgorithm(w - 1); }),
+        make_filter_spec("FlipYAlgorithm", [](int, int h) { return FlipYAlgorithm(h - 1); }),
+        make_filter_spec("RotateEventsAlgorithm",
+                         [](int w, int h) { return RotateEventsAlgorithm(w - 1, h - 1, M_PI / 4); }),
+        make_filter_spec("TransposeEventsAlgorithm", [](int, int) { return TransposeEventsAlgorithm(); }),
+        make_filter_spec("EventRescalerAlgorithm", [](int, int) { return EventRescalerAlgorithm(0.5f, 0.5f); }),
+        make_preprocessor_spec("DiffProcessor", make_preprocessor_factory<DiffProcessor<const EventCD *>>(5.f, 1.f)),
+        make_preprocessor_spec("HistoProcessor",
+                               make_preprocessor_factory<HistoProcessor<const EventCD *>>(5.f, 1.f, true)),
+        make_preprocessor_spec("EventCubeProcessor", [](int w, int h) {
+            return std::make_unique<EventCubeProcessor<const EventCD *>>(kFramePeriodUs, w, h, 5, true, 255.f, 1.f);
+        }),
+        make_preprocessor_spec(
+            "HardwareDiffProcessor",
+            make_preprocessor_factory<HardwareDiffProcessor<const EventCD *>>(int8_t(-128), int8_t(127), true)),
+        make_preprocessor_spec(
+            "HardwareHistoProcessor",
+            make_preprocessor_factory<HardwareHistoProcessor<const EventCD *>>(uint8_t(255), uint8_t(255))),
+        make_preprocessor_spec("TimeSurfaceProcessor<1>",
+                               make_preprocessor_factory<TimeSurfaceProcessor<const EventCD *, 1>>()),
+        make_preprocessor_spec("TimeSurfaceProcessor<2>",
+                               make_preprocessor_factory<TimeSurfaceProcessor<const EventCD *, 2>>()),
+    };
+}
+
+void register_benchmarks(std::size_t num_events, double events_per_us) {
+    const EventDistribution distributions[] = {EventDistribution::UniformNoise, EventDistribution::MovingEdges,
+                                               EventDistribution::Flicker};
+
+    for (const auto &spec : algorithm_specs()) {
+        for (const auto distribution : distributions) {
+            for (const auto &resolution : kResolutions) {
+                StreamParams params;
+                params.distribution  = distribution;
+                params.num_events    = num_events;
+                params.events_per_us = events_per_us;
+                params.width         = resolution.width;
+                params.height        = resolution.height;
+
+                std::ostringstream name;
+                name << spec.name << "/" << to_string(distribution) << "/" << resolution.width << "x"
+                     << resolution.height;
+                benchmark::RegisterBenchmark(name.str().c_str(), [spec, params](benchmark::State &state) {
+                    spec.run(state, *get_stream(params), params.width, params.height);
+                })->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+}
+
+void print_usage(const char *program) {
+    std::cerr << "Usage: " << program << " [benchmark options] [options]" << std::endl
+              << std::endl
+              << "  --num_events=<n>              Number of events in each synthetic stream (default 1048576)"
+              << std::endl
+              << "  --events_per_us=<r>           Event rate of the synthetic streams (default 10)" << std::endl
+              << "  --baseline=<path>             Compares the results to the ones of a previous run, saved with"
+              << std::endl
+              << "                                --benchmark_out=<path> --benchmark_out_format=json" << std::endl
+              << "  --regression_threshold=<p>    Increase of " << kComparedCounter
+              << ", in percent, beyond which a benchmark is considered" << std::endl
+              << "                                as regressing (default 5). The program fails if any benchmark "
+              << "regresses." << std::endl
+              << std::endl
+              << "Use --benchmark_out=<file> --benchmark_out_format=json to get machine-readable results."
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    benchmark::Initialize(&argc, argv);
+
+    std::size_t num_events      = 1 << 20;
+    double events_per_us        = 10.;
+    double regression_threshold = 5.;
+    std::string baseline_path;
+    CounterResults baseline;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto sep        = arg.find('=');
+            const auto key        = arg.substr(0, sep);
+            const auto value      = sep == std::string::npos ? std::string() : arg.substr(sep + 1);
+            if (key == "--num_events" && !value.empty()) {
+                num_events = std::stoull(value);
+            } else if (key == "--events_per_us" && !value.empty()) {
+                events_per_us = std::stod(value);
+            } else if (key == "--baseline" && !value.empty()) {
+                baseline_path = value;
+            } else if (key == "--regression_threshold" && !value.empty()) {
+                regression_threshold = std::stod(value);
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+
+        // The baseline is loaded first, not to run the benchmarks for nothing if it is invalid
+        if (!baseline_path.empty()) {
+            baseline = load_baseline(baseline_path, kComparedCounter);
+        }
+        register_benchmarks(num_events, events_per_us);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    benchmark::AddCustomContext("synthetic_stream_num_events", std::to_string(num_events));
+    benchmark::AddCustomContext("synthetic_stream_events_per_us", std::to_string(events_per_us));
+    benchmark::AddCustomContext("buffer_size", std::to_string(kBufferSize));
+    benchmark::AddCustomContext("frame_period_us", std::to_string(kFramePeriodUs));
+
+    std::size_t num_regressions = 0;
+    if (baseline_path.empty()) {
+        benchmark::RunSpecifiedBenchmarks();
+    } else {
+        RecordingConsoleReporter reporter(kComparedCounter);
+        benchmark::RunSpecifiedBenchmarks(&reporter);
+        std::cout << std::endl << "Comparison of " << kComparedCounter << " to " << baseline_path << ":";
+        num_regressions = compare_to_baseline(reporter.results(), baseline, regression_threshold, std::cout);
+        std::cout << std::endl << num_regressions << " benchmark(s) regressing by more than " << regression_threshold
+                  << "%" << std::endl;
+    }
+    benchmark::Shutdown();
+    return num_regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "baseline_comparison.h"
+
+namespace Metavision {
+namespace benchmarks {
+
+void CounterSamples::add_run(double value) {
+    runs_.push_back(value);
+}
+
+void CounterSamples::set_median(double value) {
+    median_     = value;
+    has_median_ = true;
+}
+
+double CounterSamples::value() const {
+    if (has_median_ || runs_.empty()) {
+        return median_;
+    }
+    auto sorted = runs_;
+    std::sort(sorted.begin(), sorted.end());
+    const auto n = sorted.size();
+    return n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+RecordingConsoleReporter::RecordingConsoleReporter(const std::string &counter) : counter_(counter) {}
+
+void RecordingConsoleReporter::ReportRuns(const std::vector<Run> &runs) {
+    ConsoleReporter::ReportRuns(runs);
+
+    // The benchmarks that failed don't set their counters
+    for (const auto &run : runs) {
+        const auto it = run.counters.find(counter_);
+        if (it == run.counters.end()) {
+            continue;
+        }
+        auto &samples = results_[run.run_name.str()];
+        if (run.run_type == Run::RT_Iteration) {
+            samples.add_run(it->second.value);
+        } else if (run.aggregate_name == "median") {
+            samples.set_median(it->second.value);
+        }
+    }
+}
+
+const CounterResults &RecordingConsoleReporter::results() const {
+    return results_;
+}
+
+CounterResults load_baseline(const std::string &path, const std::string &counter) {
+    boost::property_tree::ptree root;
+    try {
+        boost::property_tree::read_json(path, root);
+    } catch (const boost::property_tree::json_parser_error &e) {
+        throw std::runtime_error("Unable to read benchmark results from " + path + ": " + e.what());
+    }
+
+    const auto benchmarks = root.get_child_optional("benchmarks");
+    if (!benchmarks) {
+        throw std::runtime_error(path + " is not a benchmark output, it has no \"benchmarks\" entry");
+    }
+
+    // The names of the counters may contain dots, the default path separator
+    const boost::property_tree::ptree::path_type counter_path(counter, '\0');
+    CounterResults results;
+    for (const auto &entry : *benchmarks) {
+        const auto &benchmark = entry.second;
+        const auto value      = benchmark.get_optional<double>(counter_path);
+        if (!value) {
+            continue;
+        }
+        auto &samples = results[benchmark.get<std::string>("run_name", benchmark.get<std::string>("name"))];
+        if (benchmark.get<std::string>("run_type", "iteration") == "iteration") {
+            samples.add_run(*value);
+        } else if (benchmark.get<std::string>("aggregate_name", "") == "median") {
+            samples.set_median(*value);
+        }
+    }
+    return results;
+}
+
+std::size_t compare_to_baseline(const CounterResults &current, const CounterResults &baseline,
+                                double regression_threshold_percent, std::ostream &os) {
+    std::size_t name_width = 9;
+    for (const auto &result : current) {
+        name_width = std::max(name_width, result.first.size());
+    }
+
+    os << std::endl
+       << std::left << std::setw(name_width) << "Benchmark" << std::right << std::setw(14) << "Baseline"
+       << std::setw(14) << "Current" << std::setw(10) << "Change" << std::endl
+       << std::string(name_width + 38, '-') << std::endl;
+
+    const auto flags            = os.flags();
+    const auto precision        = os.precision();
+    std::size_t num_regressions = 0;
+    os << std::fixed << std::setprecision(3);
+    for (const auto &result : current) {
+        const auto it = baseline.find(result.first);
+        os << std::left << std::setw(name_width) << result.first << std::right;
+        if (it == baseline.end()) {
+            os << std::setw(14) << "-" << std::setw(14) << result.second.value() << std::setw(10) << "new" << std::endl;
+            continue;
+        }
+
+        const auto baseline_value = it->second.value();
+        const auto current_value  = result.second.value();
+        const auto change_percent = baseline_value > 0 ? 100. * (current_value - baseline_value) / baseline_value : 0.;
+        const bool regression     = change_percent > regression_threshold_percent;
+        num_regressions += regression ? 1 : 0;
+        os << std::setw(14) << baseline_value << std::setw(14) << current_value << std::showpos << std::setprecision(1)
+           << std::setw(9) << change_percent << "%" << std::noshowpos << std::setprecision(3)
+           << (regression ? "  REGRESSION" : "") << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return num_regressions;
+}
+
+} // namespace benchmarks
+} // namespace Metavision
@@ -0,0 +1,75 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_BENCHMARKS_BASELINE_COMPARISON_H
+#define METAVISION_SDK_CORE_BENCHMARKS_BASELINE_COMPARISON_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace Metavision {
+namespace benchmarks {
+
+/// @brief Values of a counter measured by the runs of a benchmark
+///
+/// When the benchmarks are repeated, the median aggregate computed by the library is used, otherwise the median of the
+/// values of the runs.
+class CounterSamples {
+public:
+    void add_run(double value);
+    void set_median(double value);
+    double value() const;
+
+private:
+    std::vector<double> runs_;
+    double median_   = 0.;
+    bool has_median_ = false;
+};
+
+/// @brief Values of a counter, indexed by benchmark name
+using CounterResults = std::map<std::string, CounterSamples>;
+
+/// @brief Console reporter also recording the values of a counter, so that they can be compared to a baseline
+class RecordingConsoleReporter : public benchmark::ConsoleReporter {
+public:
+    /// @brief Constructor
+    /// @param counter Name of the counter to record, the benchmarks without it are ignored
+    explicit RecordingConsoleReporter(const std::string &counter);
+
+    void ReportRuns(const std::vector<Run> &runs) override;
+
+    const CounterResults &results() const;
+
+private:
+    const std::string counter_;
+    CounterResults results_;
+};
+
+/// @brief Loads the values of a counter from a file written with --benchmark_out_format=json
+/// @throw std::runtime_error If the file can't be read or isn't a valid benchmark output
+CounterResults load_baseline(const std::string &path, const std::string &counter);
+
+/// @brief Compares the values of a counter to a baseline, considering that lower values are better
+/// @param current Results of the current run
+/// @param baseline Results of the baseline run
+/// @param regression_threshold_percent Increase of the value beyond which a benchmark is considered as regressing
+/// @param os Stream where the comparison table is printed
+/// @return The number of regressing benchmarks
+std::size_t compare_to_baseline(const CounterResults &current, const CounterResults &baseline,
+                                double regression_threshold_percent, std::ostream &os);
+
+} // namespace benchmarks
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_BENCHMARKS_BASELINE_COMPARISON_H
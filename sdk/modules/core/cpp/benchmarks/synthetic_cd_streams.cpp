@@ -0,0 +1,110 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "synthetic_cd_streams.h"
+
+namespace Metavision {
+namespace benchmarks {
+
+namespace {
+
+// Ratio of the events that are background noise, in percent, for the structured distributions
+constexpr std::uint32_t kNoisePercent = 10;
+
+// Moving edges: half of the edges are vertical and move horizontally, the others are horizontal and move vertically
+constexpr int kNumEdges          = 4;
+constexpr int kEdgeThickness     = 3;
+constexpr timestamp kEdgeSweepUs = 200000;
+
+// Flickering regions, as e.g. LEDs or lights powered by the mains
+constexpr int kNumFlickerSources        = 8;
+constexpr int kFlickerSourceSizeRatio   = 24;
+constexpr timestamp kMinFlickerPeriodUs = 5000;
+constexpr timestamp kMaxFlickerPeriodUs = 20000;
+
+struct FlickerSource {
+    int x, y, width, height;
+    timestamp period;
+};
+
+} // anonymous namespace
+
+std::string to_string(EventDistribution distribution) {
+    switch (distribution) {
+    case EventDistribution::UniformNoise:
+        return "uniform_noise";
+    case EventDistribution::MovingEdges:
+        return "moving_edges";
+    case EventDistribution::Flicker:
+        return "flicker";
+    }
+    return "unknown";
+}
+
+std::vector<EventCD> generate_events(const StreamParams &params) {
+    if (params.width <= 0 || params.height <= 0 || params.events_per_us <= 0) {
+        throw std::invalid_argument("Invalid synthetic stream parameters");
+    }
+
+    // Only the raw output of the engine is used, the distributions of the standard library being implementation
+    // defined
+    std::mt19937 mt(params.seed);
+    const auto w = static_cast<std::uint32_t>(params.width);
+    const auto h = static_cast<std::uint32_t>(params.height);
+
+    std::vector<FlickerSource> sources;
+    for (int i = 0; i < kNumFlickerSources; ++i) {
+        FlickerSource source;
+        source.width  = std::max(1, params.width / kFlickerSourceSizeRatio);
+        source.height = std::max(1, params.height / kFlickerSourceSizeRatio);
+        source.x      = mt() % (w - source.width + 1);
+        source.y      = mt() % (h - source.height + 1);
+        source.period = kMinFlickerPeriodUs + mt() % (kMaxFlickerPeriodUs - kMinFlickerPeriodUs + 1);
+        sources.push_back(source);
+    }
+
+    std::vector<EventCD> events;
+    events.reserve(params.num_events);
+    for (std::size_t i = 0; i < params.num_events; ++i) {
+        const auto t    = static_cast<timestamp>(i / params.events_per_us);
+        std::uint32_t x = mt() % w;
+        std::uint32_t y = mt() % h;
+        short p         = mt() & 1;
+
+        if (params.distribution == EventDistribution::MovingEdges && mt() % 100 >= kNoisePercent) {
+            // Even edges are the leading edges of objects, generating positive events, odd ones the trailing edges
+            const auto edge     = mt() % kNumEdges;
+            const auto offset   = mt() % kEdgeThickness;
+            const auto progress = (t + edge * kEdgeSweepUs / kNumEdges) % kEdgeSweepUs;
+            if (edge % 2 == 0) {
+                x = (progress * w / kEdgeSweepUs + offset) % w;
+            } else {
+                y = (progress * h / kEdgeSweepUs + offset) % h;
+            }
+            p = (edge / 2) % 2 == 0 ? 1 : 0;
+        } else if (params.distribution == EventDistribution::Flicker && mt() % 100 >= kNoisePercent) {
+            // Sources switch on during the first half of their period, and off during the second one
+            const auto &source = sources[mt() % kNumFlickerSources];
+            x                  = source.x + mt() % source.width;
+            y                  = source.y + mt() % source.height;
+            p                  = t % source.period < source.period / 2 ? 1 : 0;
+        }
+        events.emplace_back(static_cast<unsigned short>(x), static_cast<unsigned short>(y), p, t);
+    }
+    return events;
+}
+
+} // namespace benchmarks
+} // namespace Metavision
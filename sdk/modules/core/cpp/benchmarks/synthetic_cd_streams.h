@@ -0,0 +1,53 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_BENCHMARKS_SYNTHETIC_CD_STREAMS_H
+#define METAVISION_SDK_CORE_BENCHMARKS_SYNTHETIC_CD_STREAMS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+
+namespace Metavision {
+namespace benchmarks {
+
+/// @brief Spatio-temporal distributions of the synthetic streams used to benchmark the algorithms
+enum class EventDistribution {
+    UniformNoise, ///< Events uniformly distributed over the sensor, with random polarities
+    MovingEdges,  ///< Vertical and horizontal edges sweeping the sensor, over a low background noise
+    Flicker,      ///< Small regions flickering at different frequencies, over a low background noise
+};
+
+/// @brief Returns the name of a distribution, as used in the benchmark names
+std::string to_string(EventDistribution distribution);
+
+/// @brief Parameters of a synthetic stream
+struct StreamParams {
+    EventDistribution distribution = EventDistribution::UniformNoise;
+    /// Number of events in the stream
+    std::size_t num_events = 1 << 20;
+    /// Event rate, in events per microsecond
+    double events_per_us = 10.;
+    int width            = 1280;
+    int height           = 720;
+    /// Seed of the random generator, streams generated with the same parameters are identical
+    std::uint32_t seed = 42;
+};
+
+/// @brief Generates the events of a synthetic stream, sorted by timestamp
+std::vector<EventCD> generate_events(const StreamParams &params);
+
+} // namespace benchmarks
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_BENCHMARKS_SYNTHETIC_CD_STREAMS_H
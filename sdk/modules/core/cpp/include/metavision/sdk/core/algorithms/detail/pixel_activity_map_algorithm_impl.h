@@ -0,0 +1,32 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_IMPL_H
+
+namespace Metavision {
+
+template<typename InputIt>
+void PixelActivityMapAlgorithm::process_events(InputIt it_begin, InputIt it_end) {
+    std::uint16_t *counts = counts_.data();
+    for (auto it = it_begin; it != it_end; ++it) {
+        if (decay_period_ > 0 && it->t >= next_decay_time_) {
+            decay(it->t);
+        }
+        // branchless saturating increment
+        std::uint16_t &count = counts[index_of_x_[it->x] + index_of_y_[it->y]];
+        count += (count != std::numeric_limits<std::uint16_t>::max());
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_IMPL_H
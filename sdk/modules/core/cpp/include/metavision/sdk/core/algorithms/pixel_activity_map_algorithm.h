@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_H
+#define METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <opencv2/core/core.hpp>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class that counts the events of each pixel to monitor the activity of the sensor
+///
+/// Counts are stored on 16 bits and saturate. They are laid out by tiles of 8x8 pixels, so that the counters updated
+/// by events close to each other share the same cache lines. Optionally, all the counts are periodically halved, so
+/// that the map reflects the recent activity and can be kept running indefinitely.
+///
+/// Hot pixels, i.e. pixels whose count is much higher than the average one, and dead pixels, i.e. pixels with no or
+/// very few events, as well as heat maps and pixel masks can be generated at any time from the counts.
+class PixelActivityMapAlgorithm {
+public:
+    /// @brief Statistics of the counts of the pixels
+    struct Statistics {
+        double mean         = 0.; ///< Mean count of the pixels
+        double stddev       = 0.; ///< Standard deviation of the counts of the pixels
+        std::uint16_t max   = 0;  ///< Max count of the pixels
+        std::uint64_t total = 0;  ///< Sum of the counts of the pixels
+    };
+
+    /// @brief Constructor
+    /// @param width Width of the sensor
+    /// @param height Height of the sensor
+    /// @param decay_period Period after which the counts are halved, in us. If 0, counts are never decayed
+    /// @throw std::invalid_argument if the sensor size or the decay period is invalid
+    PixelActivityMapAlgorithm(int width, int height, timestamp decay_period = 0);
+
+    /// @brief Updates the counts with events
+    /// @tparam InputIt Read-only input event iterator type. Works for iterators over buffers of @ref EventCD
+    /// or equivalent
+    /// @param it_begin Iterator to the first event
+    /// @param it_end Iterator to the past-the-end event
+    /// @note Events must be sorted by timestamp and located inside the sensor
+    template<typename InputIt>
+    void process_events(InputIt it_begin, InputIt it_end);
+
+    /// @brief Resets all the counts
+    void reset();
+
+    /// @brief Computes the statistics of the counts of the pixels
+    Statistics get_statistics() const;
+
+    /// @brief Gets the count of a pixel
+    /// @param x X coordinate of the pixel
+    /// @param y Y coordinate of the pixel
+    std::uint16_t get_count(int x, int y) const;
+
+    /// @brief Gets the counts of all the pixels
+    /// @param counts Counts of the pixels, as a (height x width) map
+    void get_counts(cv::Mat_<std::uint16_t> &counts) const;
+
+    /// @brief Generates a heat map of the counts, scaled so that the max count is 255
+    /// @param heat_map Heat map, as a (height x width) map
+    void generate_heat_map(cv::Mat_<std::uint8_t> &heat_map) const;
+
+    /// @brief Gets the pixels whose count is higher than a threshold
+    /// @param pixels Hot pixels, sorted by tile
+    /// @param num_stddev Number of standard deviations above the mean count from which a pixel is considered hot
+    /// @param min_count Minimum count for a pixel to be considered hot
+    void get_hot_pixels(std::vector<cv::Point> &pixels, float num_stddev = 3.f, std::uint16_t min_count = 1) const;
+
+    /// @brief Gets the pixels whose count is lower than or equal to a threshold
+    /// @param pixels Dead pixels, sorted by row
+    /// @param max_count Maximum count for a pixel to be considered dead
+    void get_dead_pixels(std::vector<cv::Point> &pixels, std::uint16_t max_count = 0) const;
+
+    /// @brief Generates a mask of the pixels that are not hot
+    ///
+    /// The mask can be used with the @ref RoiMaskAlgorithm to filter out the events of the hot pixels
+    /// @param mask Mask, as a (height x width) map of 1 for the pixels to keep and 0 for the hot ones
+    /// @param num_stddev Number of standard deviations above the mean count from which a pixel is considered hot
+    /// @param min_count Minimum count for a pixel to be considered hot
+    void generate_pixel_mask(cv::Mat_<double> &mask, float num_stddev = 3.f, std::uint16_t min_count = 1) const;
+
+private:
+    static constexpr int kTileShift = 3;
+    static constexpr int kTileSide  = 1 << kTileShift;
+    static constexpr int kTileSize  = kTileSide * kTileSide;
+
+    void decay(timestamp t);
+    std::uint16_t get_hot_threshold(float num_stddev, std::uint16_t min_count) const;
+    cv::Point get_pixel(std::size_t index) const;
+
+    const int width_, height_, tile_columns_;
+    const timestamp decay_period_;
+    timestamp next_decay_time_ = -1;
+    std::vector<std::uint32_t> index_of_x_, index_of_y_;
+    std::vector<std::uint16_t> counts_;
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/pixel_activity_map_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_PIXEL_ACTIVITY_MAP_ALGORITHM_H
@@ -29,7 +29,7 @@ template<typename InputIt>
 void HardwareDiffProcessor<InputIt>::process_events(InputIt begin, InputIt end, RawEventFrameDiff &diff) const {
     Tensor wrapper(this->output_tensor_shape_, this->output_tensor_type_,
                    reinterpret_cast<std::byte *>(diff.get_data().data()), false);
-    process_events(begin, end, wrapper);
+    process_events(0, begin, end, wrapper);
 }
 
 template<typename InputIt>
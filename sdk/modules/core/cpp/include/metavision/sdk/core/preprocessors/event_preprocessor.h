@@ -48,6 +48,8 @@ public:
     /// @warning The tensor needs to have its memory already allocated, which can be done thanks to the class @ref
     /// get_output_shape and
     /// @ref get_output_type methods and the Tensor method @ref Tensor::create.
+    /// @note This method doesn't modify the preprocessor, so it can be called concurrently from several threads as long
+    /// as each call updates a distinct tensor
     void process_events(const timestamp cur_frame_start_ts, InputIt begin, InputIt end, Tensor &tensor) const;
 
 protected:
@@ -13,7 +13,11 @@
 #define METAVISION_SDK_CORE_CALLBACK_MANAGER_H
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -21,63 +25,285 @@
 
 namespace Metavision {
 
+namespace detail {
+
+/// @brief Dispatch of a callback manager in progress on the calling thread
+struct CallbackDispatchFrame {
+    const void *manager;
+    CallbackDispatchFrame *prev;
+};
+
+/// @brief Returns the innermost callback dispatch in progress on the calling thread
+inline CallbackDispatchFrame *&callback_dispatch_frames() {
+    static thread_local CallbackDispatchFrame *frames = nullptr;
+    return frames;
+}
+
+/// @brief Checks whether the calling thread is dispatching the callbacks of a manager
+inline bool is_dispatching_callbacks(const void *manager) {
+    for (auto frame = callback_dispatch_frames(); frame; frame = frame->prev) {
+        if (frame->manager == manager) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace detail
+
+/// @brief Registry of callbacks dispatched from a producer thread
+///
+/// The registered callbacks are published as an immutable snapshot, so that dispatching neither copies the callbacks
+/// nor takes a lock. Adding or removing a callback publishes a new snapshot and waits for the dispatches still using
+/// the previous one to return: once @ref remove_callback has returned, the removed callback is not called anymore.
+/// When called from one of the manager's own callbacks, the update does not wait for the dispatch in progress, and the
+/// previous snapshot is reclaimed once it is over.
+/// @warning A callback must not block waiting for a thread that is adding or removing a callback of the same manager
 template<class EventsCallback, typename TagType = uint8_t>
 class CallbackManager {
+    using Callbacks = std::vector<EventsCallback>;
+
 public:
+    /// @brief Read-side view on the callbacks registered when it was created
+    ///
+    /// The callbacks of the view stay valid until it is destroyed, even if they are removed from the manager in the
+    /// meantime.
+    class CallbacksView {
+    public:
+        using const_iterator = typename Callbacks::const_iterator;
+
+        CallbacksView(const CallbacksView &)            = delete;
+        CallbacksView &operator=(const CallbacksView &) = delete;
+
+        ~CallbacksView() {
+            detail::callback_dispatch_frames() = frame_.prev;
+            if (readers_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+                manager_.num_waiters_.load(std::memory_order_seq_cst) != 0) {
+                manager_.notify_waiters();
+            }
+            if (manager_.num_retired_cbs_.load(std::memory_order_relaxed) != 0 &&
+                !detail::is_dispatching_callbacks(&manager_)) {
+                manager_.try_reclaim_retired_cbs();
+            }
+        }
+
+        const_iterator begin() const {
+            return cbs_->begin();
+        }
+
+        const_iterator end() const {
+            return cbs_->end();
+        }
+
+        size_t size() const {
+            return cbs_->size();
+        }
+
+        bool empty() const {
+            return cbs_->empty();
+        }
+
+    private:
+        friend class CallbackManager;
+
+        explicit CallbacksView(const CallbackManager &manager) :
+            manager_(manager),
+            readers_(manager.readers_[manager.epoch_.load(std::memory_order_acquire) & 1]),
+            frame_{&manager, detail::callback_dispatch_frames()} {
+            // The reader is registered before loading the snapshot, so that an update publishing a new snapshot
+            // either sees it and waits for it, or is seen by the load
+            readers_.fetch_add(1, std::memory_order_seq_cst);
+            cbs_                               = manager.cbs_.load(std::memory_order_seq_cst);
+            detail::callback_dispatch_frames() = &frame_;
+        }
+
+        const CallbackManager &manager_;
+        std::atomic<int> &readers_;
+        detail::CallbackDispatchFrame frame_;
+        const Callbacks *cbs_;
+    };
+
     CallbackManager(IndexManager &index_manager) : index_manager_(index_manager) {}
 
     CallbackManager(IndexManager &index_manager, uint8_t tag_id) : index_manager_(index_manager), tag_id_(tag_id) {}
 
-    virtual ~CallbackManager() {}
+    virtual ~CallbackManager() {
+        delete cbs_.load(std::memory_order_relaxed);
+    }
 
+    /// @brief Adds a callback
+    ///
+    /// Unless called from a callback of this manager, waits for the dispatches using the previous callbacks to return.
+    /// @param cb Callback to add
+    /// @return ID of the added callback
+    /// @sa @ref remove_callback
     size_t add_callback(const EventsCallback &cb) {
-        std::unique_lock<std::mutex> lock(cbs_mutex_);
-        auto idx = index_manager_.index_generator_.get_next_index();
-        index_manager_.counter_map_.tag(tag_id_);
-        cbs_map_[idx]  = cb;
-        cbs_vec_dirty_ = true;
+        size_t idx;
+        uint64_t retired_flips;
+        {
+            std::unique_lock<std::mutex> lock(cbs_mutex_);
+            idx = index_manager_.index_generator_.get_next_index();
+            index_manager_.counter_map_.tag(tag_id_);
+            cbs_map_[idx] = cb;
+            retired_flips = publish_cbs();
+        }
+        wait_for_readers(retired_flips);
         return idx;
     }
 
+    /// @brief Removes a callback
+    ///
+    /// Unless called from a callback of this manager, blocks until the dispatches that may still call the removed
+    /// callback have returned, so that it is not called anymore once this method returns. The calling thread sleeps
+    /// while waiting, it does not spin.
+    /// @param callback_id ID of the callback to remove
+    /// @return true if the callback has been removed, false if it was not registered
+    /// @warning Must not be called while holding a lock that a callback of this manager may take: the dispatch in
+    /// progress would then never return
     bool remove_callback(size_t callback_id) {
-        std::unique_lock<std::mutex> lock(cbs_mutex_);
-        auto it = cbs_map_.find(callback_id);
-        if (it != cbs_map_.end()) {
+        uint64_t retired_flips;
+        {
+            std::unique_lock<std::mutex> lock(cbs_mutex_);
+            auto it = cbs_map_.find(callback_id);
+            if (it == cbs_map_.end()) {
+                return false;
+            }
             cbs_map_.erase(it);
             index_manager_.counter_map_.untag(tag_id_);
-            cbs_vec_dirty_ = true;
-            return true;
+            retired_flips = publish_cbs();
         }
-        return false;
+        wait_for_readers(retired_flips);
+        return true;
     }
 
-    const std::vector<EventsCallback> &get_cbs() const {
-        if (cbs_vec_dirty_) {
-            std::unique_lock<std::mutex> lock(cbs_mutex_);
-            cbs_vec_.clear();
-            for (auto &&p : cbs_map_) {
-                cbs_vec_.push_back(p.second);
-            }
-            cbs_vec_dirty_ = false;
-        }
-        return cbs_vec_;
+    /// @brief Gets a view on the registered callbacks
+    /// @warning The view must not outlive the current scope, as updates of the callbacks wait for it to be destroyed
+    CallbacksView get_cbs() const {
+        return CallbacksView(*this);
     }
 
     template<typename... Args>
     void operator()(Args &&...params) {
-        auto cbs = get_cbs();
+        const auto cbs = get_cbs();
 
         for (auto &cb : cbs)
             cb(std::forward<Args>(params)...);
     }
 
 private:
+    struct RetiredCallbacks {
+        std::unique_ptr<const Callbacks> cbs;
+        // Number of epoch flips started when the snapshot was retired
+        uint64_t flips;
+    };
+
+    // Publishes a snapshot of the registered callbacks and returns the number of epoch flips started when the previous
+    // one was retired. Must be called with cbs_mutex_ held
+    uint64_t publish_cbs() {
+        std::unique_ptr<Callbacks> cbs(new Callbacks());
+        cbs->reserve(cbs_map_.size());
+        for (auto &&p : cbs_map_) {
+            cbs->push_back(p.second);
+        }
+        std::unique_ptr<const Callbacks> retired(cbs_.exchange(cbs.release(), std::memory_order_seq_cst));
+        const auto flips = started_flips_.load(std::memory_order_seq_cst);
+        retired_cbs_.push_back({std::move(retired), flips});
+        num_retired_cbs_.store(retired_cbs_.size(), std::memory_order_relaxed);
+        return flips;
+    }
+
+    // Waits for the dispatches that may use a snapshot retired after retired_flips epoch flips were started, without
+    // holding cbs_mutex_ so that the callbacks of these dispatches can update the manager
+    void wait_for_readers(uint64_t retired_flips) {
+        if (detail::is_dispatching_callbacks(this)) {
+            // Called from a callback, which would wait for its own dispatch to return: the retired snapshots are
+            // reclaimed once the dispatch is over
+            return;
+        }
+        std::lock_guard<std::mutex> lock(flips_mutex_);
+        while (completed_flips_ < retired_flips + 2) {
+            flip_epoch(true);
+        }
+        reclaim_retired_cbs();
+    }
+
+    // Called at the end of a dispatch, when some retired snapshots have not been reclaimed yet
+    void try_reclaim_retired_cbs() const {
+        std::unique_lock<std::mutex> lock(flips_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return;
+        }
+        for (int i = 0; i < 2 && flip_epoch(false); ++i) {}
+        reclaim_retired_cbs();
+    }
+
+    // Directs new readers to the other counter and waits for the previous one to drain, so that a continuous flow of
+    // dispatches can't delay the update indefinitely. A snapshot retired before two flips were started can't be used by
+    // any reader once they have both completed. Must be called with flips_mutex_ held
+    bool flip_epoch(bool wait) const {
+        if (!flip_pending_) {
+            started_flips_.fetch_add(1, std::memory_order_seq_cst);
+            draining_readers_ = epoch_.fetch_add(1, std::memory_order_seq_cst) & 1;
+            flip_pending_     = true;
+        }
+        if (readers_[draining_readers_].load(std::memory_order_seq_cst) != 0) {
+            if (!wait) {
+                return false;
+            }
+            // The last reader leaving the counter notifies if it sees a waiter, which is registered before the
+            // counter is checked again so that the notification can't be missed
+            num_waiters_.fetch_add(1, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(waiters_mutex_);
+                waiters_cond_.wait(lock, [this]() {
+                    return readers_[draining_readers_].load(std::memory_order_seq_cst) == 0;
+                });
+            }
+            num_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        flip_pending_ = false;
+        ++completed_flips_;
+        return true;
+    }
+
+    // Called by the last reader leaving a counter while an update waits for a counter to drain
+    void notify_waiters() const {
+        std::lock_guard<std::mutex> lock(waiters_mutex_);
+        waiters_cond_.notify_all();
+    }
+
+    // Must be called with flips_mutex_ held
+    void reclaim_retired_cbs() const {
+        std::unique_lock<std::mutex> lock(cbs_mutex_);
+        auto it = retired_cbs_.begin();
+        while (it != retired_cbs_.end() && it->flips + 2 <= completed_flips_) {
+            ++it;
+        }
+        retired_cbs_.erase(retired_cbs_.begin(), it);
+        num_retired_cbs_.store(retired_cbs_.size(), std::memory_order_relaxed);
+    }
+
     IndexManager &index_manager_;
     TagType tag_id_ = std::numeric_limits<TagType>::max();
     mutable std::mutex cbs_mutex_;
-    mutable std::atomic<bool> cbs_vec_dirty_{false};
     std::map<size_t, EventsCallback> cbs_map_;
-    mutable std::vector<EventsCallback> cbs_vec_;
+    std::atomic<const Callbacks *> cbs_{new Callbacks()};
+    mutable std::deque<RetiredCallbacks> retired_cbs_;
+    mutable std::atomic<size_t> num_retired_cbs_{0};
+
+    // Grace periods of the retired snapshots, flips_mutex_ is never taken while holding cbs_mutex_
+    mutable std::mutex flips_mutex_;
+    mutable std::atomic<uint64_t> started_flips_{0};
+    mutable uint64_t completed_flips_      = 0;
+    mutable bool flip_pending_             = false;
+    mutable unsigned int draining_readers_ = 0;
+    mutable std::atomic<unsigned int> epoch_{0};
+    mutable std::atomic<int> readers_[2] = {{0}, {0}};
+
+    // Wake up of the updates waiting for a counter of readers to drain
+    mutable std::mutex waiters_mutex_;
+    mutable std::condition_variable waiters_cond_;
+    mutable std::atomic<int> num_waiters_{0};
 };
 
 } // namespace Metavision
@@ -12,9 +12,12 @@
 #ifndef METAVISION_SDK_CORE_CV_VIDEO_RECORDER_H
 #define METAVISION_SDK_CORE_CV_VIDEO_RECORDER_H
 
+#include <chrono>
 #include <filesystem>
+#include <mutex>
 #include <opencv2/videoio.hpp>
 
+#include "metavision/sdk/core/utils/concurrent_queue.h"
 #include "metavision/sdk/core/utils/threaded_process.h"
 #include "metavision/sdk/core/utils/video_writer.h"
 #include "metavision/sdk/base/utils/object_pool.h"
@@ -22,11 +25,45 @@
 namespace Metavision {
 
 /// @brief A simple threaded video recorder using OpenCV routines
+///
+/// Frames passed to @ref write are copied into a fixed number of preallocated frame slots, then encoded in a dedicated
+/// thread. The memory used by the recorder is thus bounded, whatever the speed of the encoder.
 class CvVideoRecorder {
 public:
+    /// @brief Behavior of @ref write when all the frame slots are in use
+    enum class OverflowPolicy {
+        Block,     ///< Waits for the encoder to release a frame slot
+        DropOldest ///< Drops the oldest frame not yet encoded to reuse its slot
+    };
+
+    /// @brief Parameters of the recording pipeline
+    struct Parameters {
+        /// Number of preallocated frame slots, i.e. maximum number of frames waiting to be or being encoded
+        size_t num_frame_slots = 16;
+
+        /// Behavior of @ref write when all the frame slots are in use
+        OverflowPolicy overflow_policy = OverflowPolicy::Block;
+
+        /// Number of threads encoding each frame, when the codec supports it (MJPEG). A negative value lets the
+        /// encoder pick one thread per core
+        int num_encoding_threads = -1;
+    };
+
+    /// @brief Statistics of the recording pipeline
+    struct Statistics {
+        size_t num_queued_frames{0};  ///< Number of frames currently waiting to be encoded
+        size_t num_written_frames{0}; ///< Number of frames encoded since @ref start
+        size_t num_dropped_frames{0}; ///< Number of frames dropped since @ref start
+        std::chrono::microseconds mean_latency{0}; ///< Mean duration between @ref write and the end of the encoding
+        std::chrono::microseconds max_latency{0};  ///< Max duration between @ref write and the end of the encoding
+    };
+
     CvVideoRecorder(const std::filesystem::path &output_video_file, const int fourcc, const uint32_t fps,
                     const cv::Size &size, bool colored);
 
+    CvVideoRecorder(const std::filesystem::path &output_video_file, const int fourcc, const uint32_t fps,
+                    const cv::Size &size, bool colored, const Parameters &params);
+
     /// @brief Records all remaining frames then destroys the object
     ~CvVideoRecorder();
 
@@ -42,18 +79,36 @@ public:
 
     /// @brief Pushes the input frame for writing.
     ///
-    /// This method does nothing if the recorder thread is not active
+    /// This method does nothing if the recorder thread is not active. When all the frame slots are in use, it either
+    /// waits for the encoder or drops the oldest pending frame, according to the overflow policy.
     void write(cv::Mat &data);
 
     /// @brief Returns if the recording thread is ongoing.
     bool is_recording();
 
+    /// @brief Returns the statistics of the recording pipeline
+    Statistics get_statistics() const;
+
 private:
+    using DataPool = SharedObjectPool<cv::Mat>;
+
+    struct PendingFrame {
+        DataPool::ptr_type frame;
+        std::chrono::steady_clock::time_point write_time;
+    };
+
+    bool encode_next_frame();
+
     VideoWriter writer_;
+    const Parameters params_;
 
-    using DataPool = SharedObjectPool<cv::Mat>;
     DataPool data_to_write_pool_;
+    ConcurrentQueue<PendingFrame> data_to_write_queue_;
     ThreadedProcess recorder_thread_;
+
+    mutable std::mutex stats_mutex_;
+    Statistics stats_;
+    std::chrono::microseconds total_latency_{0};
 };
 
 } // namespace Metavision
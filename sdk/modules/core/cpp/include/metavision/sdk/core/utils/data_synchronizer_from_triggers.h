@@ -12,11 +12,14 @@
 #ifndef METAVISION_SDK_CORE_DATA_SYNCHRONIZER_FROM_TRIGGERS_H
 #define METAVISION_SDK_CORE_DATA_SYNCHRONIZER_FROM_TRIGGERS_H
 
+#include <atomic>
 #include <stdexcept>
-#include <deque>
 #include <condition_variable>
 #include <cmath>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/base/utils/timestamp.h"
@@ -48,7 +51,16 @@ namespace Metavision {
 /// Only one polarity is used for the synchronization (i.e. up or down, chosen by the user) as it is
 /// considered that each external data generates a pair of triggers (i.e. one data for two triggers).
 ///
-/// The synchronization routines are blocking and thread safe.
+/// The synchronization routines are thread safe, provided that triggers are indexed from one thread and data are
+/// synchronized from another one. Synchronization information is passed from one to the other through a single
+/// producer single consumer ring: as long as information is available, neither thread takes a lock nor makes a system
+/// call. The synchronization blocks when the ring is empty, until triggers are indexed or the synchronization is done.
+///
+/// By default (Parameters::max_pending_triggers_ == 0), the ring grows as needed and indexing never blocks, so that
+/// all triggers can be indexed before synchronizing data from the same thread. When the number of pending triggers is
+/// bounded, the ring applies back-pressure instead: indexing blocks while it is full, until the synchronization uses
+/// some of the triggers or is done. In this case, indexing and synchronization must be called from different threads,
+/// otherwise indexing more triggers than the bound deadlocks.
 ///
 class DataSynchronizerFromTriggers {
 public:
@@ -75,6 +87,11 @@ public:
         uint32_t index_offset_{0};     ///< This is the very first data to synchronize expected index and so the first
                                        ///< trigger index.
         bool reference_polarity_{0};   ///< The trigger's polarity to use.
+        /// Maximum number of indexed triggers pending to be used for synchronization. When reached, indexing triggers
+        /// blocks until some are used, unless the synchronization is done. If 0, the number of pending triggers is not
+        /// bounded and indexing never blocks, so that all triggers can be indexed before synchronizing data from the
+        /// same thread.
+        uint32_t max_pending_triggers_{0};
     };
 
 public:
@@ -88,6 +105,8 @@ public:
 
     /// @brief Resets the synchronization states variables.
     /// Unlocks any pending synchronization before clearing the synchronization information remaining to be used.
+    /// @warning Pending calls are waited for, but no new call to @ref index_triggers or
+    /// @ref synchronize_data_from_triggers must be made until this method returns
     void reset_synchronization();
 
     /// @brief Notifies this object that the synchronization is done
@@ -101,7 +120,10 @@ public:
     /// @brief Generates @ref SynchronizationInformation from the external triggers input stream
     ///
     /// This information is to be used for the synchronization (@ref synchronize_data_from_triggers).
-    /// This method is not blocking: this is not a synchronization point.
+    /// If the number of pending triggers is not bounded (Parameters::max_pending_triggers_ == 0, the default), this
+    /// method never blocks. Otherwise, it blocks while Parameters::max_pending_triggers_ triggers are pending, until
+    /// the synchronization uses some of them or @ref set_synchronization_as_done is called, in which case the remaining
+    /// triggers are dropped.
     ///
     /// @tparam ExtTriggerIterator The type of the external trigger input events iterator
     /// @param trigger_it The first iterator to an external trigger to process
@@ -114,7 +136,10 @@ public:
     /// @brief Generates @ref SynchronizationInformation from the external triggers input stream
     ///
     /// This information is to be used for the synchronization (@ref synchronize_data_from_triggers).
-    /// This method is not blocking: this is not a synchronization point.
+    /// If the number of pending triggers is not bounded (Parameters::max_pending_triggers_ == 0, the default), this
+    /// method never blocks. Otherwise, it blocks while Parameters::max_pending_triggers_ triggers are pending, until
+    /// the synchronization uses some of them or @ref set_synchronization_as_done is called, in which case the remaining
+    /// triggers are dropped.
     ///
     /// @tparam ExtTriggerIterator The type of the external trigger input events iterator
     /// @param trigger_it The first iterator to an external trigger to process
@@ -155,8 +180,65 @@ public:
     void wait_for_triggers_consumed(uint32_t max_remaining_to_be_consumed = 0);
 
 private:
-    /// Queue of synchronization information generated from received external triggers
-    std::deque<SynchronizationInformation> synchronization_information_deque_;
+    /// Counts the calls in progress, so that the synchronization is only reset once they have returned
+    class CallGuard {
+    public:
+        CallGuard(DataSynchronizerFromTriggers &sync);
+        ~CallGuard();
+
+    private:
+        DataSynchronizerFromTriggers &sync_;
+    };
+
+    template<typename ExtTriggerIterator, typename OnIndexedTrigger>
+    void index_triggers_impl(ExtTriggerIterator trigger_it, ExtTriggerIterator trigger_it_end,
+                             OnIndexedTrigger on_indexed_trigger);
+
+    /// Ring buffer of synchronization information, indexed modulo its size
+    struct Ring {
+        Ring(uint64_t size);
+
+        SynchronizationInformation &operator[](uint64_t index);
+        const SynchronizationInformation &operator[](uint64_t index) const;
+
+        std::vector<SynchronizationInformation> infos;
+        uint64_t mask;
+    };
+
+    /// Pushes synchronization information in the ring, it is made available to the consumer by @ref publish
+    void push(const SynchronizationInformation &sync_info);
+    void publish();
+
+    /// Replaces the full ring by a twice larger one holding the same pending synchronization information
+    void grow_ring();
+
+    /// Number of synchronization information in the ring, as seen from any thread
+    uint64_t pending_count() const;
+
+    /// Wakes up the threads blocked in @ref wait_until, if any
+    void notify_waiters();
+
+    /// Blocks until @p predicate is true, the predicate must only depend on the ring indexes and the done state
+    template<typename Predicate>
+    void wait_until(Predicate predicate);
+
+    /// Rings of synchronization information generated from received external triggers, written by
+    /// @ref index_triggers and read by @ref synchronize_data_from_triggers. The last one is the one in use, the
+    /// previous ones are kept until the synchronization is reset, as the consumer may still be reading them after the
+    /// ring has grown
+    std::vector<std::unique_ptr<Ring>> rings_;
+
+    /// Ring in use, the consumer loads it after the tail so that it holds all the published information
+    alignas(64) std::atomic<const Ring *> ring_{nullptr};
+
+    /// Index of the next information to read, only written by the consumer
+    alignas(64) std::atomic<uint64_t> ring_head_{0};
+
+    /// Index of the next information to write, only written by the producer
+    alignas(64) std::atomic<uint64_t> ring_tail_{0};
+
+    /// Producer's copy of the index of the next information to write, published by @ref publish
+    alignas(64) uint64_t ring_write_index_{0};
 
     /// Parameters
     Parameters parameters_;
@@ -164,19 +246,22 @@ private:
     /// States if at least one trigger has been indexed
     bool first_trigger_indexed_;
 
-    /// Sets this triggers source as done i.e. we don't expect to receive anymore events
-    bool triggers_source_is_done_;
-
     /// State variable to keep the count of the last generated index
     uint32_t last_synchronization_index_;
 
     /// Last received trigger's timestamp
     timestamp last_synchronization_ts_us_;
 
-    /// Safety variable
-    std::mutex triggers_updated_mutex_;
-    std::condition_variable wait_for_triggers_cond_;
-    std::condition_variable wait_for_triggers_consumed_cond_;
+    /// Sets this triggers source as done i.e. we don't expect to receive anymore events
+    std::atomic<bool> triggers_source_is_done_{false};
+
+    /// Number of calls to the indexing and synchronization routines in progress
+    std::atomic<int> calls_in_progress_{0};
+
+    /// Blocking is only needed when the ring is empty or full, or to wait for pending calls
+    std::atomic<int> num_waiters_{0};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cond_;
 };
 
 } // namespace Metavision
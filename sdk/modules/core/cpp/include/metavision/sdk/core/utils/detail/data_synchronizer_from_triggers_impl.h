@@ -12,24 +12,20 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_DATA_SYNCHRONIZER_FROM_TRIGGERS_IMPL_H
 #define METAVISION_SDK_CORE_DETAIL_DATA_SYNCHRONIZER_FROM_TRIGGERS_IMPL_H
 
-#include <vector>
-
 namespace Metavision {
 
 template<typename ExtTriggerIterator>
 size_t DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it, ExtTriggerIterator trigger_it_end) {
-    std::vector<EventExtTrigger> out;
-    auto back_ins = std::back_inserter(out);
-    index_triggers(trigger_it, trigger_it_end, back_ins);
-    return out.size();
+    size_t num_indexed_triggers = 0;
+    index_triggers_impl(trigger_it, trigger_it_end, [&num_indexed_triggers](const EventExtTrigger &) {
+        ++num_indexed_triggers;
+    });
+    return num_indexed_triggers;
 }
 
 template<typename ExtTriggerIterator, typename IndexTriggerInserterIterator>
 void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it, ExtTriggerIterator trigger_it_end,
                                                   IndexTriggerInserterIterator indexed_trigger_inserter_it) {
-    static_assert(is_const_iterator_over<ExtTriggerIterator, EventExtTrigger>::value,
-                  "Requires an iterator over EventExtTrigger element.");
-
     static_assert(detail::is_back_inserter_iterator_v<IndexTriggerInserterIterator>,
                   "Requires a back inserter iterator.");
 
@@ -37,8 +33,21 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
         std::is_same<typename iterator_traits<IndexTriggerInserterIterator>::value_type, EventExtTrigger>::value,
         "Requires an output back inserter iterator over EventExtTrigger element.");
 
-    std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
-    for (; trigger_it != trigger_it_end; ++trigger_it, ++indexed_trigger_inserter_it) {
+    index_triggers_impl(trigger_it, trigger_it_end, [&indexed_trigger_inserter_it](const EventExtTrigger &trigger) {
+        *indexed_trigger_inserter_it = trigger;
+        ++indexed_trigger_inserter_it;
+    });
+}
+
+template<typename ExtTriggerIterator, typename OnIndexedTrigger>
+void DataSynchronizerFromTriggers::index_triggers_impl(ExtTriggerIterator trigger_it,
+                                                       ExtTriggerIterator trigger_it_end,
+                                                       OnIndexedTrigger on_indexed_trigger) {
+    static_assert(is_const_iterator_over<ExtTriggerIterator, EventExtTrigger>::value,
+                  "Requires an iterator over EventExtTrigger element.");
+
+    CallGuard guard(*this);
+    for (; trigger_it != trigger_it_end; ++trigger_it) {
         // Consider the trigger only if polarity matches the reference one
         if (trigger_it->p != (parameters_.reference_polarity_ ? 1 : 0)) {
             continue;
@@ -69,14 +78,13 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
             // If trigger index > current_index + 1, then we missed some triggers. We need to interpolate
             // synchronization data.
             for (uint32_t interpolated_index = last_synchronization_index_ + 1;
-                 interpolated_index < new_synchronization_index; ++interpolated_index, ++indexed_trigger_inserter_it) {
+                 interpolated_index < new_synchronization_index; ++interpolated_index) {
                 // Interpolate the timestamp from the last  trigger received timestamp
                 last_synchronization_ts_us_ += parameters_.period_us_;
 
                 // Push the trigger in the queue for synchronization
-                synchronization_information_deque_.push_back({last_synchronization_ts_us_, interpolated_index});
-                *indexed_trigger_inserter_it =
-                    EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id);
+                push({last_synchronization_ts_us_, interpolated_index});
+                on_indexed_trigger(EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id));
             }
 
             // Keep in memory last trigger index for interpolation
@@ -89,11 +97,12 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
         }
 
         last_synchronization_ts_us_ = trigger_it->t;
-        synchronization_information_deque_.push_back({last_synchronization_ts_us_, last_synchronization_index_});
-        *indexed_trigger_inserter_it = EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id);
+        push({last_synchronization_ts_us_, last_synchronization_index_});
+        on_indexed_trigger(EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id));
     }
 
-    wait_for_triggers_cond_.notify_all();
+    // The synchronization information generated from the whole range is made available at once
+    publish();
 }
 
 template<typename DataIterator>
@@ -101,42 +110,64 @@ uint32_t DataSynchronizerFromTriggers::synchronize_data_from_triggers(
     DataIterator data_it_begin, DataIterator data_it_end,
     std::function<timestamp &(detail::value_t<DataIterator> &)> data_timestamp_accessor,
     std::function<uint32_t(const detail::value_t<DataIterator> &)> data_index_accessor) {
+    CallGuard guard(*this);
     auto data_it = data_it_begin;
-    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
+
+    // The ring is read between head and tail without any synchronization, only the head is published when all the
+    // synchronization information available has been used
+    uint64_t head = ring_head_.load(std::memory_order_relaxed);
+    uint64_t tail = ring_tail_.load(std::memory_order_acquire);
+    // The ring is loaded after the tail: it may have grown since, but it then holds all the information up to the tail
+    const Ring *ring = ring_.load(std::memory_order_acquire);
 
     for (; data_it != data_it_end; ++data_it) {
+        const uint32_t data_index = data_index_accessor(*data_it);
+
         // ------------------------------
         // Check if the last sync info is older than the one to be synchronized.
         // Possible cases:
-        // 1- There is sync information in the queue and one has the same index as the current data
-        // 2- No sync info is available in the queue -> we need to wait for some
-        // 3- Sync info are available in the queue but the most recent index is lower than the input data to
+        // 1- There is sync information in the ring and one has the same index as the current data
+        // 2- No sync info is available in the ring -> we need to wait for some
+        // 3- Sync info are available in the ring but the most recent index is lower than the input data to
         // synchronize
-        // 4- Sync info are available in the queue but the oldest one's index is greater than the input data to
+        // 4- Sync info are available in the ring but the oldest one's index is greater than the input data to
         // synchronize
 
         // Cases 2 & 3 -> Need to wait for sync info
         bool has_synchronization_info = false;
-
-        // We wait for new synchronization information if needed.
-        wait_for_triggers_cond_.wait(lock, [&]() {
+        while (true) {
             // We check here if we have enough information to proceed with the synchronization
-            has_synchronization_info = !synchronization_information_deque_.empty() &&
-                                       last_synchronization_index_ >= data_index_accessor(*data_it);
-
-            if (!has_synchronization_info) {
-                if (!synchronization_information_deque_.empty()) {
-                    // The last index is lower than the idx that we are searching. We consume the triggers to avoid
-                    // a deadlock
-                    synchronization_information_deque_.clear();
-                }
+            has_synchronization_info =
+                head != tail && (*ring)[tail - 1].index >= data_index;
+            if (has_synchronization_info) {
+                break;
+            }
 
-                // If not, all triggers have been used for synchronization. We notify to unlock any process
-                // waiting on this condition
-                wait_for_triggers_consumed_cond_.notify_all();
+            // The last index is lower than the idx that we are searching. We consume the triggers to avoid
+            // a deadlock
+            head = tail;
+
+            // All triggers have been used for synchronization. We notify to unlock any process waiting for them to be
+            // consumed
+            ring_head_.store(head, std::memory_order_release);
+            notify_waiters();
+
+            // The done state is read first, so that the triggers indexed before the source is set as done are seen
+            const bool triggers_source_is_done = triggers_source_is_done_.load(std::memory_order_acquire);
+            tail                               = ring_tail_.load(std::memory_order_acquire);
+            ring                               = ring_.load(std::memory_order_acquire);
+            if (head == tail) {
+                if (triggers_source_is_done) {
+                    break;
+                }
+                wait_until([this, head]() {
+                    return ring_tail_.load(std::memory_order_acquire) != head ||
+                           triggers_source_is_done_.load(std::memory_order_acquire);
+                });
+                tail = ring_tail_.load(std::memory_order_acquire);
+                ring = ring_.load(std::memory_order_acquire);
             }
-            return has_synchronization_info || triggers_source_is_done_;
-        });
+        }
 
         if (!has_synchronization_info) {
             // Source is done and no sync info remains
@@ -144,35 +175,44 @@ uint32_t DataSynchronizerFromTriggers::synchronize_data_from_triggers(
         }
         // Here, even if source is done but we have triggers to synchronize, we use all we have.
 
-        // Case 4 -> interpolates sync info in the past
-        if (data_index_accessor(*data_it) < synchronization_information_deque_.front().index) {
-            SynchronizationInformation sync_info_past_interpolated = synchronization_information_deque_.front();
-            const auto data_index                                  = data_index_accessor(*data_it);
-            while (data_index < sync_info_past_interpolated.index) {
-                --sync_info_past_interpolated.index;
-                sync_info_past_interpolated.t -= parameters_.period_us_;
-                synchronization_information_deque_.push_front(sync_info_past_interpolated);
-            }
+        // Case 1 -> Skip the older sync info. No need to check on size: the above checks ensure that the
+        // synchronization information is in the ring.
+        while ((*ring)[head].index < data_index) {
+            ++head;
         }
 
-        // Case 1 -> We have enough triggers
-        SynchronizationInformation sync_information = synchronization_information_deque_.front();
-        synchronization_information_deque_.pop_front();
-        while (data_index_accessor(*data_it) !=
-               sync_information.index) { // No need to check on size: the above checks ensure that the
-            // synchronization information is in the queue.
-            sync_information = synchronization_information_deque_.front();
-            synchronization_information_deque_.pop_front();
+        const SynchronizationInformation &sync_information = (*ring)[head];
+        if (sync_information.index == data_index) {
+            data_timestamp_accessor(*data_it) = sync_information.t;
+            ++head;
+        } else {
+            // Case 4 -> interpolates sync info in the past, the oldest sync info is kept for the next data
+            data_timestamp_accessor(*data_it) =
+                sync_information.t -
+                static_cast<timestamp>(sync_information.index - data_index) * parameters_.period_us_;
         }
-
-        data_timestamp_accessor(*data_it) = sync_information.t;
     }
 
-    wait_for_triggers_consumed_cond_.notify_all();
+    ring_head_.store(head, std::memory_order_release);
+    notify_waiters();
 
     // compute the amount of data synchronized
     return std::distance(data_it_begin, data_it);
 }
+
+template<typename Predicate>
+void DataSynchronizerFromTriggers::wait_until(Predicate predicate) {
+    if (predicate()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    num_waiters_.fetch_add(1, std::memory_order_relaxed);
+    // pairs with the fence in notify_waiters: either the waiter sees the new state, or the notifier sees the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wait_cond_.wait(lock, predicate);
+    num_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
 } // namespace Metavision
 
 #endif // METAVISION_SDK_CORE_DETAIL_DATA_SYNCHRONIZER_FROM_TRIGGERS_IMPL_H
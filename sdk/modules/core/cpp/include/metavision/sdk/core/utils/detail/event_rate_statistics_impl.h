@@ -0,0 +1,45 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENT_RATE_STATISTICS_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_EVENT_RATE_STATISTICS_IMPL_H
+
+namespace Metavision {
+
+template<typename InputIt>
+void EventRateStatistics::process_events(InputIt it_begin, InputIt it_end) {
+    // bins are only completed when an event crosses the end of the current one, the rest of the loop only increments
+    // counters of the finest resolution
+    std::uint64_t count = 0;
+    if (tile_counts_ == nullptr) {
+        for (auto it = it_begin; it != it_end; ++it, ++count) {
+            if (it->t >= current_bin_end_) {
+                *count_ += count;
+                count = 0;
+                advance_time(it->t);
+            }
+        }
+    } else {
+        for (auto it = it_begin; it != it_end; ++it, ++count) {
+            if (it->t >= current_bin_end_) {
+                *count_ += count;
+                count = 0;
+                advance_time(it->t);
+            }
+            ++tile_counts_[tile_of_x_[it->x] + tile_of_y_[it->y]];
+        }
+    }
+    *count_ += count;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENT_RATE_STATISTICS_IMPL_H
@@ -162,7 +162,7 @@ RollingEventBufferConfig RollingEventBufferConfig::make_n_us(Metavision::timesta
 }
 
 template<typename T>
-RollingEventBuffer<T>::RollingEventBuffer(const RollingEventBufferConfig &config) : config_(config) {
+RollingEventBuffer<T>::RollingEventBuffer(const RollingEventBufferConfig &config) : config_(config), epoch_(0) {
     clear();
 }
 
@@ -172,7 +172,8 @@ RollingEventBuffer<T>::RollingEventBuffer(const RollingEventBuffer<T> &other) :
     data_(other.data_),
     virtual_size_(other.virtual_size_),
     start_idx_(other.start_idx_),
-    last_idx_(other.last_idx_) {}
+    last_idx_(other.last_idx_),
+    epoch_(other.epoch_) {}
 
 template<typename T>
 RollingEventBuffer<T>::RollingEventBuffer(RollingEventBuffer<T> &&other) :
@@ -180,7 +181,8 @@ RollingEventBuffer<T>::RollingEventBuffer(RollingEventBuffer<T> &&other) :
     data_(std::move(other.data_)),
     virtual_size_(other.virtual_size_),
     start_idx_(other.start_idx_),
-    last_idx_(other.last_idx_) {}
+    last_idx_(other.last_idx_),
+    epoch_(other.epoch_) {}
 
 template<typename T>
 RollingEventBuffer<T> &RollingEventBuffer<T>::operator=(const RollingEventBuffer<T> &other) {
@@ -189,6 +191,7 @@ RollingEventBuffer<T> &RollingEventBuffer<T>::operator=(const RollingEventBuffer
     virtual_size_ = other.virtual_size_;
     start_idx_    = other.start_idx_;
     last_idx_     = other.last_idx_;
+    epoch_        = std::max(epoch_, other.epoch_) + 1;
 
     return *this;
 }
@@ -200,6 +203,7 @@ RollingEventBuffer<T> &RollingEventBuffer<T>::operator=(RollingEventBuffer<T> &&
     virtual_size_ = other.virtual_size_;
     start_idx_    = other.start_idx_;
     last_idx_     = other.last_idx_;
+    epoch_        = std::max(epoch_, other.epoch_) + 1;
 
     return *this;
 }
@@ -210,6 +214,8 @@ void RollingEventBuffer<T>::insert_events(InputIt begin, InputIt end) {
     if (begin == end)
         return;
 
+    ++epoch_;
+
     if (config_.mode == RollingEventBufferMode::N_EVENTS) {
         insert_n_events_slice(begin, end);
     } else {
@@ -296,6 +302,7 @@ void RollingEventBuffer<T>::clear() {
     virtual_size_ = 0;
     start_idx_    = -1;
     last_idx_     = -1;
+    ++epoch_;
 
     data_.clear();
 
@@ -304,6 +311,27 @@ void RollingEventBuffer<T>::clear() {
     }
 }
 
+template<typename T>
+std::array<typename RollingEventBuffer<T>::ConstSpan, 2> RollingEventBuffer<T>::contiguous_spans() const {
+    if (empty()) {
+        return {ConstSpan{data_.data(), 0}, ConstSpan{data_.data(), 0}};
+    }
+
+    const auto start_idx = static_cast<size_t>(start_idx_);
+    const auto last_idx  = static_cast<size_t>(last_idx_);
+    if (start_idx <= last_idx) {
+        return {ConstSpan{data_.data() + start_idx, last_idx - start_idx + 1}, ConstSpan{data_.data(), 0}};
+    }
+
+    // the window wraps around the end of the storage
+    return {ConstSpan{data_.data() + start_idx, data_.size() - start_idx}, ConstSpan{data_.data(), last_idx + 1}};
+}
+
+template<typename T>
+std::uint64_t RollingEventBuffer<T>::epoch() const {
+    return epoch_;
+}
+
 template<typename T>
 const T &RollingEventBuffer<T>::operator[](size_t idx) const {
     const size_t real_idx = (static_cast<size_t>(start_idx_) + idx) % data_.size();
@@ -274,6 +274,18 @@ size_t SharedBufferQueue<T>::size() const {
     return static_cast<size_t>(end() - begin());
 }
 
+template<typename T>
+template<typename F>
+void SharedBufferQueue<T>::for_each_range(F &&f) const {
+    assert(ranges_.size() == buffer_queue_.size());
+
+    auto buffer_it = buffer_queue_.cbegin();
+    for (const auto &range : ranges_) {
+        f(*buffer_it, range.first, range.last + 1);
+        ++buffer_it;
+    }
+}
+
 template<typename T>
 typename SharedBufferQueue<T>::const_iterator SharedBufferQueue<T>::cbegin() const {
     // it is ok to const_cast here because we are returning a const_iterator anyway
@@ -0,0 +1,55 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TRIPLE_BUFFER_IMPL_H
+#define METAVISION_SDK_CORE_TRIPLE_BUFFER_IMPL_H
+
+namespace Metavision {
+
+template<typename T>
+TripleBuffer<T>::TripleBuffer(const T &init) : buffers_{init, init, init} {}
+
+template<typename T>
+T &TripleBuffer<T>::write_buffer() {
+    return buffers_[write_index_];
+}
+
+template<typename T>
+void TripleBuffer<T>::publish() {
+    // release: the content of the write buffer is visible to the consumer that acquires it
+    // acquire: the consumer is done with the buffer that is given back, if it has been read
+    const std::uint8_t previous = pending_.exchange(write_index_ | kDirtyBit, std::memory_order_acq_rel);
+    write_index_                = previous & kIndexMask;
+}
+
+template<typename T>
+T &TripleBuffer<T>::read_buffer() {
+    return buffers_[read_index_];
+}
+
+template<typename T>
+bool TripleBuffer<T>::update() {
+    if (!has_update()) {
+        return false;
+    }
+    const std::uint8_t latest = pending_.exchange(read_index_, std::memory_order_acq_rel);
+    read_index_               = latest & kIndexMask;
+    return true;
+}
+
+template<typename T>
+bool TripleBuffer<T>::has_update() const {
+    return (pending_.load(std::memory_order_relaxed) & kDirtyBit) != 0;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_TRIPLE_BUFFER_IMPL_H
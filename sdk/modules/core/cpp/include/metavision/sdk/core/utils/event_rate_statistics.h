@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_RATE_STATISTICS_H
+#define METAVISION_SDK_CORE_EVENT_RATE_STATISTICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Event rate statistics computed online at several time resolutions and per region of the sensor
+///
+/// Events are counted in bins of fixed duration, with one circular array of bins per resolution (by default 1ms, 10ms
+/// and 1s). Each completed bin stores the count of events since the first bin, so that the count over any number of
+/// consecutive bins is obtained in constant time, and the peak count of the bins of the previous (finer) resolution it
+/// spans. Optionally, events are also counted per tile of a grid covering the sensor, the tile counts of the last
+/// completed bin of each resolution being available.
+///
+/// Adding events costs a few operations per event and a constant amount of work per completed bin, no memory is
+/// allocated after construction.
+///
+/// @warning Only one thread can add events (typically the decoding thread), but any number of threads can query the
+/// statistics concurrently, without locking nor blocking the writer.
+class EventRateStatistics {
+public:
+    /// @brief Time resolution at which events are counted
+    struct Resolution {
+        timestamp bin_duration; ///< Duration of a bin, in us
+        std::size_t num_bins;   ///< Number of completed bins that can be queried
+    };
+
+    /// @brief Statistics over consecutive completed bins
+    struct WindowStats {
+        timestamp end_time  = 0;  ///< End of the last bin, in us
+        timestamp duration  = 0;  ///< Duration covered by the bins, in us
+        std::uint64_t count = 0;  ///< Number of events in the bins
+        double rate         = 0.; ///< Average event rate in the bins, in ev/s
+    };
+
+    /// @brief Returns the default resolutions: 1000 bins of 1ms, 1000 bins of 10ms and 60 bins of 1s
+    static std::vector<Resolution> default_resolutions();
+
+    /// @brief Constructor
+    /// @param resolutions Resolutions at which events are counted, sorted by increasing bin duration. Each bin
+    /// duration must be a multiple of the previous one
+    /// @param width Width of the sensor, or 0 if counts per tile are not needed
+    /// @param height Height of the sensor, or 0 if counts per tile are not needed
+    /// @param tile_size Size of the side of the tiles, in pixels. Tiles on the right and bottom borders can be smaller
+    /// @throw std::invalid_argument if the resolutions or the tile grid are invalid
+    EventRateStatistics(const std::vector<Resolution> &resolutions = default_resolutions(), int width = 0,
+                        int height = 0, int tile_size = 32);
+
+    EventRateStatistics(const EventRateStatistics &)            = delete;
+    EventRateStatistics &operator=(const EventRateStatistics &) = delete;
+
+    /// @brief Destructor
+    ~EventRateStatistics();
+
+    /// @brief Counts events
+    /// @tparam InputIt Read-only input iterator type on events with (x, y, t) fields
+    /// @param it_begin Iterator to the first event
+    /// @param it_end Iterator to the past-the-end event
+    /// @note Events must be sorted by timestamp and, if tiles are used, located inside the sensor
+    /// @warning Must only be called from the writer thread
+    template<typename InputIt>
+    void process_events(InputIt it_begin, InputIt it_end);
+
+    /// @brief Counts events without location, which are thus not accounted for in the tile counts
+    /// @param t Timestamp of the events
+    /// @param count Number of events
+    /// @warning Must only be called from the writer thread
+    void add_count(timestamp t, std::uint64_t count);
+
+    /// @brief Completes the bins ending before or at @p t, even if no event has been added after them
+    /// @param t Current time
+    /// @warning Must only be called from the writer thread
+    void advance_time(timestamp t);
+
+    /// @brief Discards all counts, the next event added starts new bins
+    /// @warning Must only be called from the writer thread, while no other thread queries the statistics
+    void reset();
+
+    /// @brief Gets the number of resolutions
+    std::size_t get_num_resolutions() const;
+
+    /// @brief Gets a resolution
+    /// @param resolution Index of the resolution
+    const Resolution &get_resolution(std::size_t resolution) const;
+
+    /// @brief Gets the statistics over the last completed bins of a resolution
+    ///
+    /// For instance, the event rate over the last 100ms is given by the last 10 bins of the 10ms resolution.
+    /// @param resolution Index of the resolution
+    /// @param num_bins Number of bins, clamped to the number of bins available
+    /// @param stats Statistics over the bins
+    /// @return False if no bin has been completed yet, true otherwise
+    /// @throw std::out_of_range if @p resolution is not valid
+    bool get_window_stats(std::size_t resolution, std::size_t num_bins, WindowStats &stats) const;
+
+    /// @brief Gets the peak event rate of the bins of the previous resolution within the last completed bins of a
+    /// resolution
+    ///
+    /// For instance, the peak 10ms event rate of the last second is given by the last bin of the 1s resolution. For the
+    /// first resolution, the peak rate is the one of its own bins.
+    /// @param resolution Index of the resolution
+    /// @param num_bins Number of bins, clamped to the number of bins available. The cost of the query is proportional
+    /// to it
+    /// @param peak_rate Peak event rate, in ev/s
+    /// @return False if no bin has been completed yet, true otherwise
+    /// @throw std::out_of_range if @p resolution is not valid
+    bool get_peak_rate(std::size_t resolution, std::size_t num_bins, double &peak_rate) const;
+
+    /// @brief Gets the number of columns of the tile grid, or 0 if counts per tile are not computed
+    int get_tile_columns() const;
+
+    /// @brief Gets the number of rows of the tile grid, or 0 if counts per tile are not computed
+    int get_tile_rows() const;
+
+    /// @brief Gets the counts per tile in the last completed bin of a resolution
+    /// @param resolution Index of the resolution
+    /// @param counts Counts of the tiles, stored row by row
+    /// @param end_time End of the bin, in us
+    /// @return False if counts per tile are not computed or no bin has been completed yet, true otherwise
+    /// @throw std::out_of_range if @p resolution is not valid
+    bool get_tile_counts(std::size_t resolution, std::vector<std::uint32_t> &counts, timestamp &end_time) const;
+
+private:
+    struct Bin;
+    struct Level;
+
+    void start(timestamp t);
+    void advance_level(std::size_t level, std::int64_t bin);
+    void complete_bin(std::size_t level);
+    void publish_tiles(Level &level);
+    const Level &get_level(std::size_t resolution) const;
+
+    std::vector<Resolution> resolutions_;
+    std::unique_ptr<Level[]> levels_;
+    timestamp current_bin_end_ = std::numeric_limits<timestamp>::min();
+
+    int tile_columns_ = 0, tile_rows_ = 0;
+    std::vector<std::uint32_t> tile_of_x_, tile_of_y_;
+    std::uint32_t *tile_counts_ = nullptr;
+    std::uint64_t *count_       = nullptr;
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/utils/detail/event_rate_statistics_impl.h"
+
+#endif // METAVISION_SDK_CORE_EVENT_RATE_STATISTICS_H
@@ -21,6 +21,8 @@
 
 namespace Metavision {
 
+class Tensor;
+
 /// @brief Describes the layout of dimensions in a histogram
 /// CHW : Channel, Height, Width
 /// HWC : Height, Width, Channel
@@ -105,6 +107,32 @@ public:
     template<typename T>
     std::unique_ptr<EventFrameDiff<T>> convert(const RawEventFrameDiff &d) const;
 
+    /// @brief Converts a histogram into a pre-allocated buffer, in the format of the converter
+    /// @param h Histogram to convert
+    /// @param output Buffer of at least height * width * num_channels values
+    template<typename T>
+    void convert(const RawEventFrameHisto &h, T *output) const;
+
+    /// @brief Converts a diff frame into a pre-allocated buffer
+    /// @param d Diff frame to convert
+    /// @param output Buffer of at least height * width values
+    template<typename T>
+    void convert(const RawEventFrameDiff &d, T *output) const;
+
+    /// @brief Converts a histogram into a tensor with the layout of @ref HardwareHistoProcessor
+    ///
+    /// The tensor is filled in one pass, whatever the format of the converter.
+    /// @param h Histogram to convert
+    /// @param tensor Tensor of shape (H, W, C = 2) and type UINT8
+    /// @throw invalid_argument if the tensor does not match the histogram
+    void convert(const RawEventFrameHisto &h, Tensor &tensor) const;
+
+    /// @brief Converts a diff frame into a tensor with the layout of @ref HardwareDiffProcessor
+    /// @param d Diff frame to convert
+    /// @param tensor Tensor of shape (H, W, C = 1) and type INT8
+    /// @throw invalid_argument if the tensor does not match the diff frame
+    void convert(const RawEventFrameDiff &d, Tensor &tensor) const;
+
     unsigned get_height() const {
         return height_;
     }
@@ -125,10 +153,50 @@ private:
     unsigned column_stride_;
 };
 
+namespace detail {
+
+/// @brief Extracts the channels of a histogram, with @p ColumnStride values between two pixels of a channel
+///
+/// The loops have no dependency between pixels and no branch, so that they are vectorized by the compiler.
+template<unsigned ColumnStride, typename T>
+void unpack_histo(const uint8_t *data, size_t num_pixels, bool packed, unsigned neg_bits, unsigned pos_bits,
+                  T *neg_output, T *pos_output) {
+    const uint8_t neg_mask = static_cast<uint8_t>((1 << neg_bits) - 1);
+    const uint8_t pos_mask = static_cast<uint8_t>((1 << pos_bits) - 1);
+    if (packed) {
+        for (size_t i = 0; i < num_pixels; ++i) {
+            neg_output[i * ColumnStride] = static_cast<T>(data[i] & neg_mask);
+            pos_output[i * ColumnStride] = static_cast<T>((data[i] >> neg_bits) & pos_mask);
+        }
+    } else {
+        // Each channel is padded to a byte
+        for (size_t i = 0; i < num_pixels; ++i) {
+            neg_output[i * ColumnStride] = static_cast<T>(data[2 * i] & neg_mask);
+            pos_output[i * ColumnStride] = static_cast<T>(data[2 * i + 1] & pos_mask);
+        }
+    }
+}
+
+} // namespace detail
+
 template<typename T>
 std::unique_ptr<EventFrameHisto<T>> RawEventFrameConverter::convert(const RawEventFrameHisto &h) const {
+    std::vector<T> output(height_ * width_ * num_channels_);
+    convert(h, output.data());
+    return std::make_unique<EventFrameHisto<T>>(height_, width_, num_channels_, format_, std::move(output));
+}
+
+template<typename T>
+std::unique_ptr<EventFrameDiff<T>> RawEventFrameConverter::convert(const RawEventFrameDiff &d) const {
+    std::vector<T> output(height_ * width_);
+    convert(d, output.data());
+    return std::make_unique<EventFrameDiff<T>>(height_, width_, std::move(output));
+}
+
+template<typename T>
+void RawEventFrameConverter::convert(const RawEventFrameHisto &h, T *output) const {
     assert(num_channels_ == 2); /// histo has 2 channels (by definition)
-    auto histo_cfg = h.get_config();
+    auto &histo_cfg = h.get_config();
     assert(height_ == histo_cfg.height);
     assert(width_ == histo_cfg.width);
 
@@ -137,52 +205,33 @@ std::unique_ptr<EventFrameHisto<T>> RawEventFrameConverter::convert(const RawEve
                                     std::to_string(num_channels_) + " channels");
     }
 
-    std::vector<T> output(histo_cfg.height * histo_cfg.width * histo_cfg.channel_bit_size.size());
-
-    unsigned idx = 0;
+    const uint8_t *data = h.get_data().data();
     if (num_channels_ == 2) {
         const unsigned neg_bits = histo_cfg.channel_bit_size[HistogramChannel::NEGATIVE];
         const unsigned pos_bits = histo_cfg.channel_bit_size[HistogramChannel::POSITIVE];
-
-        for (auto data : h.get_data()) {
-            if (histo_cfg.packed) {
-                const T neg_val = data & ((1 << neg_bits) - 1);
-                const T pos_val = (data >> neg_bits) & ((1 << pos_bits) - 1);
-
-                output[idx * column_stride_]                   = neg_val;
-                output[idx * column_stride_ + channel_stride_] = pos_val;
-            } else {
-                if (idx % 2 == 0) {
-                    const T val                        = data & ((1 << neg_bits) - 1);
-                    output[(idx / 2) * column_stride_] = val;
-                } else {
-                    const T val                                          = data & ((1 << pos_bits) - 1);
-                    output[(idx / 2) * column_stride_ + channel_stride_] = val;
-                }
-            }
-            ++idx;
+        const size_t num_pixels = height_ * width_;
+        if (format_ == HistogramFormat::HWC) {
+            detail::unpack_histo<2>(data, num_pixels, histo_cfg.packed, neg_bits, pos_bits, output, output + 1);
+        } else {
+            detail::unpack_histo<1>(data, num_pixels, histo_cfg.packed, neg_bits, pos_bits, output,
+                                    output + channel_stride_);
         }
     } else {
-        for (auto data : h.get_data()) {
-            output[idx] = data & ((1 << histo_cfg.channel_bit_size[0]) - 1);
-            ++idx;
+        const uint8_t mask = static_cast<uint8_t>((1 << histo_cfg.channel_bit_size[0]) - 1);
+        for (size_t i = 0, size = h.get_data().size(); i < size; ++i) {
+            output[i] = static_cast<T>(data[i] & mask);
         }
     }
-    return std::make_unique<EventFrameHisto<T>>(height_, width_, num_channels_, format_, std::move(output));
 }
 
 template<typename T>
-std::unique_ptr<EventFrameDiff<T>> RawEventFrameConverter::convert(const RawEventFrameDiff &d) const {
+void RawEventFrameConverter::convert(const RawEventFrameDiff &d, T *output) const {
     assert(height_ == d.get_config().height);
     assert(width_ == d.get_config().width);
-    std::vector<T> output(height_ * width_);
-
-    unsigned idx = 0;
-    for (auto data : d.get_data()) {
-        output[idx] = data;
-        ++idx;
+    const int8_t *data = d.get_data().data();
+    for (size_t i = 0, size = d.get_data().size(); i < size; ++i) {
+        output[i] = static_cast<T>(data[i]);
     }
-    return std::make_unique<EventFrameDiff<T>>(height_, width_, std::move(output));
 }
 
 } // namespace Metavision
@@ -12,6 +12,8 @@
 #ifndef METAVISION_SDK_CORE_ROLLING_EVENT_BUFFER_H
 #define METAVISION_SDK_CORE_ROLLING_EVENT_BUFFER_H
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
@@ -186,6 +188,12 @@ public:
     using iterator       = detail::RollingEventBufferIterator<T>;
     using const_iterator = detail::RollingEventBufferIterator<const T>;
 
+    /// @brief Contiguous chunk of events stored in the buffer
+    struct ConstSpan {
+        const T *data; ///< Pointer to the first event of the chunk
+        size_t size;   ///< Number of events in the chunk
+    };
+
     /// @brief Constructs a RollingEventBuffer with the specified configuration
     /// @param config The configuration for the rolling buffer
     RollingEventBuffer(const RollingEventBufferConfig &config = RollingEventBufferConfig::make_n_events(5000));
@@ -232,6 +240,26 @@ public:
     /// @brief Clears the buffer, removing all stored events
     void clear();
 
+    /// @brief Returns the events of the buffer as at most two contiguous chunks of memory
+    ///
+    /// The events are stored in a ring, so the window may wrap around the end of the underlying storage. The first
+    /// chunk goes from the oldest event to either the newest one or the end of the storage, the second one holds the
+    /// events that wrapped around (its size is 0 otherwise). Concatenating both chunks gives the same sequence as
+    /// iterating from @ref begin to @ref end.
+    /// @return The two chunks, in chronological order
+    /// @warning The chunks point to the internal storage: they are invalidated by the next call to @ref insert_events or
+    /// @ref clear (see @ref epoch)
+    /// @note Moving the buffer keeps the chunks valid, they then point to the storage of the moved-to buffer
+    std::array<ConstSpan, 2> contiguous_spans() const;
+
+    /// @brief Returns a counter that is incremented every time the content of the buffer is modified by
+    /// @ref insert_events or @ref clear
+    ///
+    /// Comparing two values of this counter is a cheap way to know whether the buffer has changed and whether chunks
+    /// previously returned by @ref contiguous_spans are still valid.
+    /// @return The current modification epoch of the buffer
+    std::uint64_t epoch() const;
+
     /// @brief Accesses events in the buffer using the [] operator
     /// @param idx idx The index of the event to access
     /// @return A reference to the event at the specified index
@@ -281,6 +309,7 @@ private:
     size_t virtual_size_;
     std::int64_t start_idx_;
     std::int64_t last_idx_;
+    std::uint64_t epoch_;
 };
 
 } // namespace Metavision
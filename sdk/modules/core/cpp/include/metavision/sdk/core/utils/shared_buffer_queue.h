@@ -215,6 +215,17 @@ public:
     /// @return The size of the queue
     size_t size() const;
 
+    /// @brief Visits the contiguous chunks of elements of the queue, in order
+    ///
+    /// There is one chunk per internal shared buffer, the first one possibly being truncated by @ref erase_up_to.
+    /// @tparam F Type of the callable, with the signature `void(const SharedBuffer &buffer, const T *first, const T
+    /// *last)` where [first, last) is the chunk of @p buffer that belongs to the queue
+    /// @param f The callable
+    /// @note The shared buffer is passed along so that the caller can keep it alive after the chunk has been erased
+    /// from the queue
+    template<typename F>
+    void for_each_range(F &&f) const;
+
 private:
     std::deque<SharedBuffer> buffer_queue_;
     std::deque<Range> ranges_;
@@ -0,0 +1,92 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TRIPLE_BUFFER_H
+#define METAVISION_SDK_CORE_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Metavision {
+
+/// @brief Lock-free exchange of the latest value produced by one thread with one consumer thread
+///
+/// The producer writes into its own buffer and publishes it, the consumer reads from its own buffer and fetches the
+/// latest published one when it wants to. The third buffer holds the latest published value in between, so that
+/// neither thread ever waits for the other nor copies the data: publishing and fetching only exchange buffer indices.
+/// Values published while the consumer does not fetch are overwritten by the next ones.
+///
+/// A typical use is to hand over frames from a frame generation algorithm to a display:
+/// @code{.cpp}
+/// // producer thread
+/// frame_generator.generate(ts, frames.write_buffer());
+/// frames.publish();
+///
+/// // display thread
+/// if (frames.update())
+///     cv::imshow("frames", frames.read_buffer());
+/// @endcode
+///
+/// @tparam T Type of the exchanged values. Buffers are reused, allocations made in them are thus kept from one value
+/// to the next.
+/// @warning Only one thread can write and only one thread can read
+template<typename T>
+class TripleBuffer {
+public:
+    /// @brief Constructor, buffers are default constructed
+    TripleBuffer() = default;
+
+    /// @brief Constructor
+    /// @param init Value the three buffers are initialized with
+    explicit TripleBuffer(const T &init);
+
+    TripleBuffer(const TripleBuffer &)            = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /// @brief Gets the buffer the producer writes into
+    /// @warning Must only be called from the producer thread
+    T &write_buffer();
+
+    /// @brief Publishes the write buffer, which becomes the latest value
+    ///
+    /// The producer is given another buffer to write into, its content is the one of an older value.
+    /// @warning Must only be called from the producer thread
+    void publish();
+
+    /// @brief Gets the buffer the consumer reads from, i.e. the latest value fetched by @ref update
+    /// @warning Must only be called from the consumer thread
+    T &read_buffer();
+
+    /// @brief Fetches the latest published value, if a new one has been published since the previous call
+    /// @return True if the read buffer has been updated, false otherwise
+    /// @warning Must only be called from the consumer thread
+    bool update();
+
+    /// @brief Checks if a value has been published since the last call to @ref update
+    bool has_update() const;
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x3;
+    static constexpr std::uint8_t kDirtyBit  = 0x4;
+
+    std::array<T, 3> buffers_;
+    std::uint8_t write_index_{0}; ///< Only accessed by the producer
+    std::uint8_t read_index_{1};  ///< Only accessed by the consumer
+    /// Index of the buffer holding the latest value, with @ref kDirtyBit set if it has not been fetched yet
+    alignas(64) std::atomic<std::uint8_t> pending_{2};
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/utils/detail/triple_buffer_impl.h"
+
+#endif // METAVISION_SDK_CORE_TRIPLE_BUFFER_H
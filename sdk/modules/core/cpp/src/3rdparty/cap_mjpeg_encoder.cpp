@@ -160,7 +160,8 @@ public:
     inline void put_bits(unsigned bits, int len)
     {
         CV_Assert(len >=0 && len < 32);
-        if((m_pos == (data.size() - 1) && len > bits_free) || m_pos == data.size())
+        // when len == bits_free the current word is completed and the next one is zeroed, hence the >=
+        if((m_pos == (data.size() - 1) && len >= bits_free) || m_pos == data.size())
         {
             resize(int(2*data.size()));
         }
@@ -252,6 +253,12 @@ public:
 
     void allocate_buffers(int count, int size)
     {
+        // the number of buffers must match the number of stripes of the current frame, otherwise get_data would
+        // stitch stale (empty) buffers left by a previous frame encoded with more stripes
+        while((int)m_buffer_list.size() > count)
+        {
+            m_buffer_list.pop_back();
+        }
         for(int i = (int)m_buffer_list.size(); i < count; ++i)
         {
             m_buffer_list.push_back(mjpeg_buffer());
@@ -371,6 +378,10 @@ private:
             total_size += m_buffer_list[i].get_len();
         }
 
+        // get_data always writes a trailing word holding the pending bits, even when all the stripes end on a word
+        // boundary
+        ++total_size;
+
         if(total_size > m_output_buffer.size())
         {
             m_output_buffer.clear();
@@ -1166,7 +1177,10 @@ public:
         fdct_qtab(_fdct_qtab),
         cat_table(_cat_table)
     {
-#if 0  // disable parallel processing due to buffer overrun bug: https://github.com/opencv/opencv/issues/19634
+        // Parallel processing was disabled upstream because of buffer overruns (https://github.com/opencv/opencv/issues/19634):
+        // the stitched output buffer was one word too small, put_bits did not grow its buffer when a code exactly
+        // filled the last word and stale buffers were stitched when the number of stripes decreased. These are fixed
+        // in mjpeg_buffer and mjpeg_buffer_keeper.
 
         //empirically found value. if number of pixels is less than that value there is no sense to parallelize it.
         const int min_pixels_count = 96*96;
@@ -1177,13 +1191,12 @@ public:
         {
             if(height*width > min_pixels_count)
             {
-                const int default_stripes_count = 4;
-                stripes_count = default_stripes_count;
+                stripes_count = std::max(1, cv::getNumThreads());
             }
         }
         else
         {
-            stripes_count = cvCeil(nstripes);
+            stripes_count = std::max(1, cvCeil(nstripes));
         }
 
         int y_scale = channels > 1 ? 2 : 1;
@@ -1193,12 +1206,6 @@ public:
 
         stripes_count = std::min(stripes_count, max_stripes);
 
-#else
-        if (nstripes > 1)
-            CV_LOG_ONCE_WARNING(NULL, "VIDEOIO/MJPEG: parallel processing is disabled: https://github.com/opencv/opencv/issues/19634");
-        stripes_count = 1;
-#endif
-
         m_buffer_list.allocate_buffers(stripes_count, (height*width*2)/stripes_count);
     }
 
@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/pixel_activity_map_algorithm.h"
+
+namespace Metavision {
+
+PixelActivityMapAlgorithm::PixelActivityMapAlgorithm(int width, int height, timestamp decay_period) :
+    width_(width),
+    height_(height),
+    tile_columns_((width + kTileSide - 1) >> kTileShift),
+    decay_period_(decay_period) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Sensor width and height must be strictly positive");
+    }
+    if (decay_period < 0) {
+        throw std::invalid_argument("Decay period must be positive");
+    }
+
+    const int tile_rows = (height + kTileSide - 1) >> kTileShift;
+    counts_.resize(static_cast<std::size_t>(tile_columns_) * tile_rows * kTileSize, 0);
+
+    // the index of a pixel is split in a part depending on x and a part depending on y, so that computing it for an
+    // event only takes two lookups and an addition
+    index_of_x_.resize(width);
+    for (int x = 0; x < width; ++x) {
+        index_of_x_[x] = (x >> kTileShift) * kTileSize + (x & (kTileSide - 1));
+    }
+    index_of_y_.resize(height);
+    for (int y = 0; y < height; ++y) {
+        index_of_y_[y] = (y >> kTileShift) * tile_columns_ * kTileSize + (y & (kTileSide - 1)) * kTileSide;
+    }
+}
+
+void PixelActivityMapAlgorithm::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    next_decay_time_ = -1;
+}
+
+void PixelActivityMapAlgorithm::decay(timestamp t) {
+    if (next_decay_time_ < 0) {
+        next_decay_time_ = (t / decay_period_ + 1) * decay_period_;
+        return;
+    }
+    const timestamp num_periods = (t - next_decay_time_) / decay_period_ + 1;
+    next_decay_time_ += num_periods * decay_period_;
+
+    // counts are halved once per elapsed period, they are all null after 16 periods
+    const int shift = static_cast<int>(std::min<timestamp>(num_periods, 16));
+    for (auto &count : counts_) {
+        count = static_cast<std::uint16_t>(count >> shift);
+    }
+}
+
+PixelActivityMapAlgorithm::Statistics PixelActivityMapAlgorithm::get_statistics() const {
+    // counts of the padding pixels of the tiles on the borders are always null, so they don't change the sums
+    std::uint64_t sum = 0, sum_squares = 0;
+    std::uint16_t max = 0;
+    for (const auto count : counts_) {
+        sum += count;
+        sum_squares += static_cast<std::uint64_t>(count) * count;
+        max = std::max(max, count);
+    }
+
+    Statistics stats;
+    const double num_pixels = static_cast<double>(width_) * height_;
+    stats.total             = sum;
+    stats.max               = max;
+    stats.mean              = sum / num_pixels;
+    stats.stddev            = std::sqrt(std::max(0., sum_squares / num_pixels - stats.mean * stats.mean));
+    return stats;
+}
+
+std::uint16_t PixelActivityMapAlgorithm::get_count(int x, int y) const {
+    return counts_[index_of_x_[x] + index_of_y_[y]];
+}
+
+void PixelActivityMapAlgorithm::get_counts(cv::Mat_<std::uint16_t> &counts) const {
+    counts.create(height_, width_);
+    for (int y = 0; y < height_; ++y) {
+        auto *row = counts.ptr<std::uint16_t>(y);
+        for (int x = 0; x < width_; ++x) {
+            row[x] = counts_[index_of_x_[x] + index_of_y_[y]];
+        }
+    }
+}
+
+void PixelActivityMapAlgorithm::generate_heat_map(cv::Mat_<std::uint8_t> &heat_map) const {
+    cv::Mat_<std::uint16_t> counts;
+    get_counts(counts);
+    double max;
+    cv::minMaxLoc(counts, nullptr, &max);
+    counts.convertTo(heat_map, CV_8U, max > 0 ? 255. / max : 0.);
+}
+
+std::uint16_t PixelActivityMapAlgorithm::get_hot_threshold(float num_stddev, std::uint16_t min_count) const {
+    const auto stats       = get_statistics();
+    const double threshold = std::floor(stats.mean + num_stddev * stats.stddev) + 1;
+    return static_cast<std::uint16_t>(std::clamp<double>(threshold, std::max<std::uint16_t>(min_count, 1),
+                                                         std::numeric_limits<std::uint16_t>::max()));
+}
+
+cv::Point PixelActivityMapAlgorithm::get_pixel(std::size_t index) const {
+    const int tile   = static_cast<int>(index / kTileSize);
+    const int offset = static_cast<int>(index % kTileSize);
+    return cv::Point((tile % tile_columns_) * kTileSide + (offset & (kTileSide - 1)),
+                     (tile / tile_columns_) * kTileSide + (offset >> kTileShift));
+}
+
+void PixelActivityMapAlgorithm::get_hot_pixels(std::vector<cv::Point> &pixels, float num_stddev,
+                                               std::uint16_t min_count) const {
+    pixels.clear();
+    const std::uint16_t threshold = get_hot_threshold(num_stddev, min_count);
+    for (std::size_t tile_begin = 0; tile_begin < counts_.size(); tile_begin += kTileSize) {
+        // most tiles have no hot pixel, the max of a tile is cheap to compute so that they can be skipped
+        const auto tile_counts = counts_.data() + tile_begin;
+        std::uint16_t tile_max = 0;
+        for (int i = 0; i < kTileSize; ++i) {
+            tile_max = std::max(tile_max, tile_counts[i]);
+        }
+        if (tile_max < threshold) {
+            continue;
+        }
+        for (int i = 0; i < kTileSize; ++i) {
+            if (tile_counts[i] >= threshold) {
+                pixels.emplace_back(get_pixel(tile_begin + i));
+            }
+        }
+    }
+}
+
+void PixelActivityMapAlgorithm::get_dead_pixels(std::vector<cv::Point> &pixels, std::uint16_t max_count) const {
+    pixels.clear();
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            if (counts_[index_of_x_[x] + index_of_y_[y]] <= max_count) {
+                pixels.emplace_back(x, y);
+            }
+        }
+    }
+}
+
+void PixelActivityMapAlgorithm::generate_pixel_mask(cv::Mat_<double> &mask, float num_stddev,
+                                                    std::uint16_t min_count) const {
+    std::vector<cv::Point> hot_pixels;
+    get_hot_pixels(hot_pixels, num_stddev, min_count);
+    mask.create(height_, width_);
+    mask.setTo(1.);
+    for (const auto &pixel : hot_pixels) {
+        mask(pixel) = 0.;
+    }
+}
+
+} // namespace Metavision
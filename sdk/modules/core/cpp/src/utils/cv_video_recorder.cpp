@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <fstream>
@@ -20,7 +21,13 @@ namespace Metavision {
 
 CvVideoRecorder::CvVideoRecorder(const std::filesystem::path &output_video_file, const int fourcc, const uint32_t fps,
                                  const cv::Size &size, bool colored) :
-    writer_(output_video_file.string(), fourcc, fps, size, colored), data_to_write_pool_(DataPool::make_bounded()) {
+    CvVideoRecorder(output_video_file, fourcc, fps, size, colored, Parameters()) {}
+
+CvVideoRecorder::CvVideoRecorder(const std::filesystem::path &output_video_file, const int fourcc, const uint32_t fps,
+                                 const cv::Size &size, bool colored, const Parameters &params) :
+    writer_(output_video_file.string(), fourcc, fps, size, colored),
+    params_(params),
+    data_to_write_pool_(DataPool::make_bounded(params.num_frame_slots, size, colored ? CV_8UC3 : CV_8UC1)) {
     if (!writer_.isOpened()) {
         std::stringstream message;
         message << "'" << output_video_file << "' is not writable. ";
@@ -32,6 +39,11 @@ CvVideoRecorder::CvVideoRecorder(const std::filesystem::path &output_video_file,
 
         throw std::runtime_error(message.str());
     }
+
+    if (params_.num_encoding_threads > 0) {
+        // Ignored by the codecs that can't encode a frame in parallel
+        writer_.set(cv::VIDEOWRITER_PROP_NSTRIPES, params_.num_encoding_threads);
+    }
 }
 
 CvVideoRecorder::~CvVideoRecorder() {
@@ -42,10 +54,23 @@ CvVideoRecorder::~CvVideoRecorder() {
 }
 
 bool CvVideoRecorder::start() {
-    return recorder_thread_.start();
+    data_to_write_queue_.open();
+    if (!recorder_thread_.start()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_         = Statistics();
+        total_latency_ = std::chrono::microseconds(0);
+    }
+    recorder_thread_.add_repeating_task([this]() { return encode_next_frame(); });
+    return true;
 }
 
 void CvVideoRecorder::stop() {
+    // Pending frames are still popped from the closed queue, the encoding task returns once it is drained
+    data_to_write_queue_.close();
     recorder_thread_.stop();
     writer_.release();
 }
@@ -55,13 +80,46 @@ void CvVideoRecorder::write(cv::Mat &data) {
         return;
     }
 
+    if (params_.overflow_policy == OverflowPolicy::DropOldest && data_to_write_pool_.empty()) {
+        // Gives the slot of the oldest pending frame back to the pool
+        if (data_to_write_queue_.pop_front(false)) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            ++stats_.num_dropped_frames;
+        }
+    }
+
     auto to_write = data_to_write_pool_.acquire();
     data.copyTo(*to_write);
-    recorder_thread_.add_task([this, to_write]() { writer_.write(*to_write); });
+    data_to_write_queue_.emplace(PendingFrame{to_write, std::chrono::steady_clock::now()});
 }
 
 bool CvVideoRecorder::is_recording() {
     return recorder_thread_.is_active();
 }
 
+CvVideoRecorder::Statistics CvVideoRecorder::get_statistics() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    Statistics stats        = stats_;
+    stats.num_queued_frames = data_to_write_queue_.size();
+    return stats;
+}
+
+bool CvVideoRecorder::encode_next_frame() {
+    auto pending = data_to_write_queue_.pop_front();
+    if (!pending) {
+        return false;
+    }
+
+    writer_.write(*pending->frame);
+
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                pending->write_time);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++stats_.num_written_frames;
+    total_latency_ += latency;
+    stats_.mean_latency = total_latency_ / stats_.num_written_frames;
+    stats_.max_latency  = std::max(stats_.max_latency, latency);
+    return true;
+}
+
 } // namespace Metavision
@@ -18,7 +18,37 @@ DataSynchronizerFromTriggers::Parameters::Parameters(uint32_t period_us) : perio
     }
 }
 
+DataSynchronizerFromTriggers::CallGuard::CallGuard(DataSynchronizerFromTriggers &sync) : sync_(sync) {
+    sync_.calls_in_progress_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+DataSynchronizerFromTriggers::CallGuard::~CallGuard() {
+    if (sync_.calls_in_progress_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        sync_.notify_waiters();
+    }
+}
+
+DataSynchronizerFromTriggers::Ring::Ring(uint64_t size) : infos(size), mask(size - 1) {}
+
+DataSynchronizerFromTriggers::SynchronizationInformation &
+    DataSynchronizerFromTriggers::Ring::operator[](uint64_t index) {
+    return infos[index & mask];
+}
+
+const DataSynchronizerFromTriggers::SynchronizationInformation &
+    DataSynchronizerFromTriggers::Ring::operator[](uint64_t index) const {
+    return infos[index & mask];
+}
+
 DataSynchronizerFromTriggers::DataSynchronizerFromTriggers(const Parameters &parameters) : parameters_(parameters) {
+    // When the number of pending triggers is not bounded, the ring starts small and grows when full
+    const uint32_t min_ring_size = parameters_.max_pending_triggers_ == 0 ? 1024 : parameters_.max_pending_triggers_;
+    uint64_t ring_size           = 1;
+    while (ring_size < min_ring_size) {
+        ring_size <<= 1;
+    }
+    rings_.emplace_back(std::make_unique<Ring>(ring_size));
+    ring_.store(rings_.back().get(), std::memory_order_release);
     reset_synchronization();
 }
 
@@ -28,27 +58,89 @@ DataSynchronizerFromTriggers::~DataSynchronizerFromTriggers() {
 
 void DataSynchronizerFromTriggers::reset_synchronization() {
     set_synchronization_as_done();
-    std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
-    synchronization_information_deque_.clear();
+    wait_until([this]() { return calls_in_progress_.load(std::memory_order_acquire) == 0; });
+    // nobody reads the previous rings anymore, the one in use is kept as it is large enough for the triggers rate
+    rings_.erase(rings_.begin(), rings_.end() - 1);
+    ring_head_.store(0, std::memory_order_relaxed);
+    ring_tail_.store(0, std::memory_order_relaxed);
+    ring_write_index_           = 0;
     first_trigger_indexed_      = false;
-    triggers_source_is_done_    = false;
     last_synchronization_index_ = 0;
     last_synchronization_ts_us_ = 0;
+    triggers_source_is_done_.store(false, std::memory_order_release);
 }
 
 void DataSynchronizerFromTriggers::set_synchronization_as_done() {
-    std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
-    triggers_source_is_done_ = true;
-    wait_for_triggers_cond_.notify_all();
-    wait_for_triggers_consumed_cond_.notify_all();
+    triggers_source_is_done_.store(true, std::memory_order_release);
+    notify_waiters();
 }
 
 void DataSynchronizerFromTriggers::wait_for_triggers_consumed(uint32_t max_remaining_to_be_consumed) {
-    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
-    if (triggers_source_is_done_)
-        return;
-    wait_for_triggers_consumed_cond_.wait(lock, [this, max_remaining_to_be_consumed]() {
-        return triggers_source_is_done_ || synchronization_information_deque_.size() <= max_remaining_to_be_consumed;
+    CallGuard guard(*this);
+    wait_until([this, max_remaining_to_be_consumed]() {
+        return triggers_source_is_done_.load(std::memory_order_acquire) ||
+               pending_count() <= max_remaining_to_be_consumed;
     });
 }
+
+void DataSynchronizerFromTriggers::push(const SynchronizationInformation &sync_info) {
+    if (parameters_.max_pending_triggers_ == 0) {
+        if (ring_write_index_ - ring_head_.load(std::memory_order_acquire) > rings_.back()->mask) {
+            // The ring is full and nothing guarantees that a consumer will make room (e.g. when all triggers are
+            // indexed before synchronizing data from the same thread), it grows instead
+            grow_ring();
+        }
+    } else if (ring_write_index_ - ring_head_.load(std::memory_order_acquire) >= parameters_.max_pending_triggers_) {
+        // The ring is full, what has been pushed so far is published so that it can be used to make room
+        publish();
+        wait_until([this]() {
+            return ring_write_index_ - ring_head_.load(std::memory_order_acquire) <
+                       parameters_.max_pending_triggers_ ||
+                   triggers_source_is_done_.load(std::memory_order_acquire);
+        });
+        if (ring_write_index_ - ring_head_.load(std::memory_order_acquire) >= parameters_.max_pending_triggers_) {
+            // The synchronization is done, nobody is going to use the information anymore
+            return;
+        }
+    }
+    (*rings_.back())[ring_write_index_] = sync_info;
+    ++ring_write_index_;
+}
+
+void DataSynchronizerFromTriggers::grow_ring() {
+    const Ring &ring = *rings_.back();
+    auto new_ring    = std::make_unique<Ring>(2 * (ring.mask + 1));
+
+    // The information already used may be overwritten in the old ring, only the one from the head is still needed. The
+    // consumer may read the old ring concurrently, but only the producer writes, and never in the old ring anymore.
+    for (uint64_t index = ring_head_.load(std::memory_order_acquire); index != ring_write_index_; ++index) {
+        (*new_ring)[index] = ring[index];
+    }
+
+    // The new ring is published before the information written in it, see @ref publish
+    ring_.store(new_ring.get(), std::memory_order_release);
+    rings_.emplace_back(std::move(new_ring));
+}
+
+void DataSynchronizerFromTriggers::publish() {
+    if (ring_tail_.load(std::memory_order_relaxed) != ring_write_index_) {
+        ring_tail_.store(ring_write_index_, std::memory_order_release);
+        notify_waiters();
+    }
+}
+
+uint64_t DataSynchronizerFromTriggers::pending_count() const {
+    // the head is read first, as it never goes past the tail
+    const uint64_t head = ring_head_.load(std::memory_order_acquire);
+    return ring_tail_.load(std::memory_order_acquire) - head;
+}
+
+void DataSynchronizerFromTriggers::notify_waiters() {
+    // pairs with the fence in wait_until: either the waiter sees the new state, or the waiter is seen here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_waiters_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        wait_cond_.notify_all();
+    }
+}
 } // namespace Metavision
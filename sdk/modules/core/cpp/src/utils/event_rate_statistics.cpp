@@ -0,0 +1,335 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "metavision/sdk/core/utils/event_rate_statistics.h"
+
+namespace Metavision {
+
+namespace {
+// Bins allocated in addition to the ones that can be queried, so that readers do not have to retry when the writer
+// completes a few bins while they read
+constexpr std::int64_t kGuardBins = 8;
+} // namespace
+
+struct EventRateStatistics::Bin {
+    std::atomic<std::uint64_t> cumulative_count{0}; ///< Count of events since the first bin, up to the end of this one
+    std::atomic<std::uint64_t> peak_count{0};       ///< Max count of the bins of the previous resolution in this one
+};
+
+struct EventRateStatistics::Level {
+    timestamp bin_duration = 0;
+    std::int64_t capacity  = 0;
+    std::unique_ptr<Bin[]> bins;
+
+    // Shared with the readers: bins in [first_bin, last_bin] are completed, the writer overwrites the storage of older
+    // bins after having set writing_bin
+    std::atomic<std::int64_t> first_bin{0}, last_bin{-1}, writing_bin{-1};
+
+    // Writer state of the current bin
+    std::int64_t current_bin     = 0;
+    std::uint64_t count          = 0;
+    std::uint64_t peak_count     = 0;
+    std::uint64_t cumulative     = 0;
+    bool published_tiles_cleared = true;
+    std::vector<std::uint32_t> tile_counts;
+
+    // Tile counts of the last completed bin, protected by a sequence lock
+    std::unique_ptr<std::atomic<std::uint32_t>[]> published_tile_counts;
+    std::atomic<timestamp> published_tiles_end_time{0};
+    std::atomic<std::uint32_t> tiles_sequence{0};
+
+    Bin &bin(std::int64_t index) const {
+        return bins[((index % capacity) + capacity) % capacity];
+    }
+};
+
+std::vector<EventRateStatistics::Resolution> EventRateStatistics::default_resolutions() {
+    return {{1000, 1000}, {10000, 1000}, {1000000, 60}};
+}
+
+EventRateStatistics::EventRateStatistics(const std::vector<Resolution> &resolutions, int width, int height,
+                                         int tile_size) :
+    resolutions_(resolutions) {
+    if (resolutions_.empty()) {
+        throw std::invalid_argument("At least one resolution is required");
+    }
+    for (std::size_t i = 0; i < resolutions_.size(); ++i) {
+        const auto &res = resolutions_[i];
+        if (res.bin_duration <= 0 || res.num_bins == 0) {
+            throw std::invalid_argument("Bin duration and number of bins must be strictly positive");
+        }
+        if (i > 0 && (res.bin_duration <= resolutions_[i - 1].bin_duration ||
+                      res.bin_duration % resolutions_[i - 1].bin_duration != 0)) {
+            throw std::invalid_argument("Bin durations must be increasing multiples of the previous ones");
+        }
+    }
+    if (width < 0 || height < 0 || (width > 0) != (height > 0) || (width > 0 && tile_size <= 0)) {
+        throw std::invalid_argument("Invalid sensor size or tile size");
+    }
+
+    if (width > 0) {
+        tile_columns_ = (width + tile_size - 1) / tile_size;
+        tile_rows_    = (height + tile_size - 1) / tile_size;
+        tile_of_x_.resize(width);
+        tile_of_y_.resize(height);
+        for (int x = 0; x < width; ++x) {
+            tile_of_x_[x] = x / tile_size;
+        }
+        for (int y = 0; y < height; ++y) {
+            tile_of_y_[y] = (y / tile_size) * tile_columns_;
+        }
+    }
+
+    const std::size_t num_tiles = static_cast<std::size_t>(tile_columns_) * tile_rows_;
+    levels_.reset(new Level[resolutions_.size()]);
+    for (std::size_t i = 0; i < resolutions_.size(); ++i) {
+        auto &level        = levels_[i];
+        level.bin_duration = resolutions_[i].bin_duration;
+        // one more bin holds the cumulative count before the oldest bin that can be queried
+        level.capacity = static_cast<std::int64_t>(resolutions_[i].num_bins) + 1 + kGuardBins;
+        level.bins.reset(new Bin[level.capacity]);
+        if (num_tiles > 0) {
+            level.tile_counts.resize(num_tiles, 0);
+            level.published_tile_counts.reset(new std::atomic<std::uint32_t>[num_tiles]);
+            for (std::size_t t = 0; t < num_tiles; ++t) {
+                level.published_tile_counts[t].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    count_       = &levels_[0].count;
+    tile_counts_ = num_tiles > 0 ? levels_[0].tile_counts.data() : nullptr;
+}
+
+EventRateStatistics::~EventRateStatistics() = default;
+
+void EventRateStatistics::add_count(timestamp t, std::uint64_t count) {
+    if (t >= current_bin_end_) {
+        advance_time(t);
+    }
+    *count_ += count;
+}
+
+void EventRateStatistics::advance_time(timestamp t) {
+    if (current_bin_end_ == std::numeric_limits<timestamp>::min()) {
+        start(t);
+    }
+    // finer levels first, so that the counts of the bins they complete are added to the coarser ones before those
+    // are completed in turn
+    for (std::size_t i = 0; i < resolutions_.size(); ++i) {
+        advance_level(i, t / levels_[i].bin_duration);
+    }
+    current_bin_end_ = (levels_[0].current_bin + 1) * levels_[0].bin_duration;
+}
+
+void EventRateStatistics::reset() {
+    for (std::size_t i = 0; i < resolutions_.size(); ++i) {
+        auto &level = levels_[i];
+        level.last_bin.store(level.first_bin.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+        level.count      = 0;
+        level.peak_count = 0;
+        level.cumulative = 0;
+        std::fill(level.tile_counts.begin(), level.tile_counts.end(), 0);
+        publish_tiles(level);
+        level.published_tiles_cleared = true;
+    }
+    current_bin_end_ = std::numeric_limits<timestamp>::min();
+}
+
+void EventRateStatistics::start(timestamp t) {
+    for (std::size_t i = 0; i < resolutions_.size(); ++i) {
+        auto &level       = levels_[i];
+        level.current_bin = t / level.bin_duration;
+        level.writing_bin.store(level.current_bin - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        auto &bin = level.bin(level.current_bin - 1);
+        bin.cumulative_count.store(0, std::memory_order_relaxed);
+        bin.peak_count.store(0, std::memory_order_relaxed);
+        level.first_bin.store(level.current_bin, std::memory_order_relaxed);
+        level.last_bin.store(level.current_bin - 1, std::memory_order_release);
+    }
+}
+
+void EventRateStatistics::advance_level(std::size_t index, std::int64_t bin) {
+    auto &level = levels_[index];
+    if (bin <= level.current_bin) {
+        return;
+    }
+    complete_bin(index);
+    ++level.current_bin;
+    // the following bins are empty, only the ones that can still be queried need to be written
+    const std::int64_t max_empty_bins = level.capacity - kGuardBins;
+    if (bin - level.current_bin > max_empty_bins) {
+        // the bins skipped are not written, so they are excluded from the ones readers can query
+        level.current_bin = bin - max_empty_bins;
+        level.writing_bin.store(level.current_bin - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        level.bin(level.current_bin - 1).cumulative_count.store(level.cumulative, std::memory_order_relaxed);
+        level.first_bin.store(level.current_bin, std::memory_order_relaxed);
+    }
+    while (level.current_bin < bin) {
+        complete_bin(index);
+        ++level.current_bin;
+    }
+}
+
+void EventRateStatistics::complete_bin(std::size_t index) {
+    auto &level = levels_[index];
+    level.cumulative += level.count;
+
+    // announces the bin whose storage is about to be overwritten, so that readers detect that the older bin sharing
+    // it is no longer valid
+    level.writing_bin.store(level.current_bin, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    auto &bin = level.bin(level.current_bin);
+    bin.cumulative_count.store(level.cumulative, std::memory_order_relaxed);
+    bin.peak_count.store(index == 0 ? level.count : level.peak_count, std::memory_order_relaxed);
+    level.last_bin.store(level.current_bin, std::memory_order_release);
+
+    if (index + 1 < resolutions_.size()) {
+        auto &next = levels_[index + 1];
+        advance_level(index + 1, (level.current_bin * level.bin_duration) / next.bin_duration);
+        next.count += level.count;
+        next.peak_count = std::max(next.peak_count, level.count);
+        if (level.count > 0) {
+            std::transform(level.tile_counts.begin(), level.tile_counts.end(), next.tile_counts.begin(),
+                           next.tile_counts.begin(), std::plus<std::uint32_t>());
+        }
+    }
+
+    // empty bins are published once only, the published counts are then already cleared
+    if (!level.tile_counts.empty() && (level.count > 0 || !level.published_tiles_cleared)) {
+        publish_tiles(level);
+        level.published_tiles_cleared = (level.count == 0);
+        std::fill(level.tile_counts.begin(), level.tile_counts.end(), 0);
+    } else if (!level.tile_counts.empty()) {
+        level.published_tiles_end_time.store((level.current_bin + 1) * level.bin_duration, std::memory_order_relaxed);
+    }
+
+    level.count      = 0;
+    level.peak_count = 0;
+}
+
+void EventRateStatistics::publish_tiles(Level &level) {
+    if (level.tile_counts.empty()) {
+        return;
+    }
+    const std::uint32_t sequence = level.tiles_sequence.load(std::memory_order_relaxed);
+    level.tiles_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t t = 0; t < level.tile_counts.size(); ++t) {
+        level.published_tile_counts[t].store(level.tile_counts[t], std::memory_order_relaxed);
+    }
+    level.published_tiles_end_time.store((level.current_bin + 1) * level.bin_duration, std::memory_order_relaxed);
+    level.tiles_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+std::size_t EventRateStatistics::get_num_resolutions() const {
+    return resolutions_.size();
+}
+
+const EventRateStatistics::Resolution &EventRateStatistics::get_resolution(std::size_t resolution) const {
+    return resolutions_.at(resolution);
+}
+
+const EventRateStatistics::Level &EventRateStatistics::get_level(std::size_t resolution) const {
+    if (resolution >= resolutions_.size()) {
+        throw std::out_of_range("Invalid resolution index");
+    }
+    return levels_[resolution];
+}
+
+bool EventRateStatistics::get_window_stats(std::size_t resolution, std::size_t num_bins, WindowStats &stats) const {
+    const auto &level = get_level(resolution);
+    const auto max_bins = static_cast<std::int64_t>(std::min(num_bins, resolutions_[resolution].num_bins));
+    while (true) {
+        const std::int64_t last  = level.last_bin.load(std::memory_order_acquire);
+        const std::int64_t first = level.first_bin.load(std::memory_order_relaxed);
+        const std::int64_t n     = std::min(max_bins, last - first + 1);
+        if (n <= 0) {
+            return false;
+        }
+        const std::uint64_t end_count   = level.bin(last).cumulative_count.load(std::memory_order_relaxed);
+        const std::uint64_t begin_count = level.bin(last - n).cumulative_count.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (level.writing_bin.load(std::memory_order_relaxed) >= last - n + level.capacity) {
+            continue; // the writer has overwritten the bins in the meantime
+        }
+        stats.end_time = (last + 1) * level.bin_duration;
+        stats.duration = n * level.bin_duration;
+        stats.count    = end_count - begin_count;
+        stats.rate     = stats.count * 1.e6 / stats.duration;
+        return true;
+    }
+}
+
+bool EventRateStatistics::get_peak_rate(std::size_t resolution, std::size_t num_bins, double &peak_rate) const {
+    const auto &level = get_level(resolution);
+    const auto max_bins = static_cast<std::int64_t>(std::min(num_bins, resolutions_[resolution].num_bins));
+    const timestamp peak_duration = resolution == 0 ? level.bin_duration : levels_[resolution - 1].bin_duration;
+    while (true) {
+        const std::int64_t last  = level.last_bin.load(std::memory_order_acquire);
+        const std::int64_t first = level.first_bin.load(std::memory_order_relaxed);
+        const std::int64_t n     = std::min(max_bins, last - first + 1);
+        if (n <= 0) {
+            return false;
+        }
+        std::uint64_t peak_count = 0;
+        for (std::int64_t i = last - n + 1; i <= last; ++i) {
+            peak_count = std::max(peak_count, level.bin(i).peak_count.load(std::memory_order_relaxed));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (level.writing_bin.load(std::memory_order_relaxed) >= last - n + level.capacity) {
+            continue;
+        }
+        peak_rate = peak_count * 1.e6 / peak_duration;
+        return true;
+    }
+}
+
+int EventRateStatistics::get_tile_columns() const {
+    return tile_columns_;
+}
+
+int EventRateStatistics::get_tile_rows() const {
+    return tile_rows_;
+}
+
+bool EventRateStatistics::get_tile_counts(std::size_t resolution, std::vector<std::uint32_t> &counts,
+                                          timestamp &end_time) const {
+    const auto &level = get_level(resolution);
+    if (level.tile_counts.empty()) {
+        return false;
+    }
+    counts.resize(level.tile_counts.size());
+    while (true) {
+        const std::uint32_t sequence = level.tiles_sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue; // the writer is publishing new counts
+        }
+        const std::int64_t last  = level.last_bin.load(std::memory_order_relaxed);
+        const std::int64_t first = level.first_bin.load(std::memory_order_relaxed);
+        for (std::size_t t = 0; t < counts.size(); ++t) {
+            counts[t] = level.published_tile_counts[t].load(std::memory_order_relaxed);
+        }
+        end_time = level.published_tiles_end_time.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (level.tiles_sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        return last >= first;
+    }
+}
+
+} // namespace Metavision
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <stdexcept>
 #include "metavision/sdk/core/utils/rate_estimator.h"
 
@@ -59,17 +60,22 @@ void RateEstimator::add_data(timestamp time, size_t count) {
         while (current_time > next_time_ + step_time_) {
             next_time_ += step_time_;
         }
+        timestamp callback_time = (system_time_flag_ ? time : next_time_);
+
+        // find the first count corresponding to the next callback timestamp minus the time window
+        // counts older than the previous window have already been removed and at most the last added sample can be
+        // more recent than the callback time, so both searches only visit a few elements
+        auto begin_it = std::find_if(counts_.begin(), counts_.end(),
+                                     [&](const auto &p) { return p.first > callback_time - window_time_; });
+        auto end_it   = counts_.end();
+        while (end_it != begin_it && std::prev(end_it)->first > callback_time) {
+            --end_it;
+        }
+
         if (cb_) {
             timestamp next_peak_time = peak_time_;
-            timestamp callback_time  = (system_time_flag_ ? time : next_time_);
             double cur_peak_rate = 0., peak_rate = 0., avg_rate = 0.;
 
-            // find the first count corresponding to the next callback timestamp minus the time window
-            auto begin_it = std::lower_bound(counts_.begin(), counts_.end(), callback_time - window_time_ + 1,
-                                             [](const auto &p, const timestamp &t) { return p.first < t; }),
-                 end_it   = std::lower_bound(counts_.begin(), counts_.end(), callback_time + 1,
-                                           [](const auto &p, const timestamp &t) { return p.first < t; });
-
             // update the average and peak rate from counts in the window timespan
             for (auto it = begin_it; it != end_it; ++it) {
                 avg_rate += it->second;
@@ -83,10 +89,10 @@ void RateEstimator::add_data(timestamp time, size_t count) {
             }
             avg_rate /= std::min(callback_time, window_time_);
             cb_(callback_time, avg_rate * 1.e6, peak_rate * 1.e6);
-
-            // remove older countime from the map, they won't be needed anymore
-            counts_.erase(counts_.begin(), begin_it);
         }
+
+        // remove older counts, they won't be needed anymore
+        counts_.erase(counts_.begin(), begin_it);
         next_time_ += step_time_;
     }
 }
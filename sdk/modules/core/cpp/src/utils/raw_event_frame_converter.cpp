@@ -9,9 +9,11 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
+#include "metavision/sdk/core/preprocessors/tensor.h"
 #include "metavision/sdk/core/utils/raw_event_frame_converter.h"
 
 namespace Metavision {
@@ -34,4 +36,37 @@ void RawEventFrameConverter::set_format(HistogramFormat output_format) {
     column_stride_  = format_ == HistogramFormat::HWC ? num_channels_ : 1;
 }
 
+namespace {
+
+void check_tensor(const Tensor &tensor, unsigned height, unsigned width, int num_channels, BaseType type) {
+    const TensorShape expected_shape(
+        {{"H", static_cast<int>(height)}, {"W", static_cast<int>(width)}, {"C", num_channels}});
+    if (tensor.shape() != expected_shape || tensor.type() != type) {
+        throw std::invalid_argument("Tensor does not match the event frame. Expected a tensor of type " +
+                                    to_string(type) + " with (H, W, C) dimensions (" + std::to_string(height) +
+                                    ", " + std::to_string(width) + ", " + std::to_string(num_channels) + ")");
+    }
+}
+
+} // namespace
+
+void RawEventFrameConverter::convert(const RawEventFrameHisto &h, Tensor &tensor) const {
+    const auto &histo_cfg = h.get_config();
+    if (histo_cfg.channel_bit_size.size() != 2) {
+        throw std::invalid_argument("Invalid number of channels in histogram. Expected 2 channels");
+    }
+    check_tensor(tensor, histo_cfg.height, histo_cfg.width, 2, BaseType::UINT8);
+
+    detail::unpack_histo<2>(h.get_data().data(), histo_cfg.height * histo_cfg.width, histo_cfg.packed,
+                            histo_cfg.channel_bit_size[HistogramChannel::NEGATIVE],
+                            histo_cfg.channel_bit_size[HistogramChannel::POSITIVE], tensor.data<uint8_t>(),
+                            tensor.data<uint8_t>() + 1);
+}
+
+void RawEventFrameConverter::convert(const RawEventFrameDiff &d, Tensor &tensor) const {
+    const auto &diff_cfg = d.get_config();
+    check_tensor(tensor, diff_cfg.height, diff_cfg.width, 1, BaseType::INT8);
+    std::copy(d.get_data().begin(), d.get_data().end(), tensor.data<int8_t>());
+}
+
 }; // namespace Metavision
@@ -103,6 +103,7 @@ enum Code {
 
 using ::cv::error;
 using ::cv::format;
+using ::cv::getNumThreads;
 using ::cv::makePtr;
 using ::cv::parallel_for_;
 
@@ -0,0 +1,234 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/callback_manager.h"
+#include "metavision/sdk/core/utils/index_manager.h"
+
+using namespace Metavision;
+
+namespace {
+using Callback = std::function<void(int)>;
+constexpr uint8_t kTagId = 3;
+} // namespace
+
+TEST(CallbackManager_GTest, dispatches_to_callbacks_in_registration_order) {
+    // GIVEN a callback manager with several callbacks
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager, kTagId);
+    std::vector<int> calls;
+    manager.add_callback([&](int v) { calls.push_back(v); });
+    const size_t id = manager.add_callback([&](int v) { calls.push_back(10 * v); });
+    manager.add_callback([&](int v) { calls.push_back(100 * v); });
+    EXPECT_EQ(3u, index_manager.counter_map_.tag_count(kTagId));
+
+    // WHEN dispatching, before and after removing a callback
+    manager(1);
+    EXPECT_TRUE(manager.remove_callback(id));
+    EXPECT_FALSE(manager.remove_callback(id));
+    manager(2);
+
+    // THEN the remaining callbacks are called in the order they were added
+    EXPECT_EQ(std::vector<int>({1, 10, 100, 2, 200}), calls);
+    EXPECT_EQ(2u, index_manager.counter_map_.tag_count(kTagId));
+    EXPECT_EQ(2u, manager.get_cbs().size());
+}
+
+TEST(CallbackManager_GTest, view_keeps_callbacks_removed_after_its_creation) {
+    // GIVEN a callback manager with a callback
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    int sum       = 0;
+    const auto id = manager.add_callback([&](int v) { sum += v; });
+
+    // WHEN a callback removes another one and adds a new one while being dispatched
+    manager.add_callback([&](int) {
+        manager.remove_callback(id);
+        manager.add_callback([&](int v) { sum += 100 * v; });
+    });
+    manager(1);
+
+    // THEN the dispatch in progress is not affected, and the next ones use the updated callbacks
+    EXPECT_EQ(1, sum);
+    sum = 0;
+    manager(2);
+    EXPECT_EQ(200, sum);
+}
+
+TEST(CallbackManager_GTest, removed_callback_is_not_called_once_removal_returned) {
+    // GIVEN a callback manager dispatching continuously from another thread
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> removed{false};
+    std::atomic<int> calls_after_removal{0};
+    std::thread dispatcher([&]() {
+        while (!stop) {
+            manager(0);
+        }
+    });
+
+    // WHEN callbacks are added and removed repeatedly
+    for (int i = 0; i < 200; ++i) {
+        removed        = false;
+        const auto id  = manager.add_callback([&](int) {
+            if (removed) {
+                ++calls_after_removal;
+            }
+        });
+        const auto id2 = manager.add_callback([](int) {});
+        std::this_thread::yield();
+        manager.remove_callback(id);
+        removed = true;
+        manager.remove_callback(id2);
+    }
+    stop = true;
+    dispatcher.join();
+
+    // THEN a removed callback is never called after its removal returned
+    EXPECT_EQ(0, calls_after_removal);
+    EXPECT_TRUE(manager.get_cbs().empty());
+}
+
+TEST(CallbackManager_GTest, snapshots_retired_from_callbacks_are_reclaimed_after_dispatch) {
+    // GIVEN a callback manager with a callback holding a resource
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    auto resource = std::make_shared<int>(0);
+    const auto id = manager.add_callback([resource](int) {});
+
+    // WHEN only callbacks update the manager
+    manager.add_callback([&](int) {
+        manager.remove_callback(id);
+        manager.add_callback([](int) {});
+    });
+    manager(0);
+
+    // THEN the removed callback is released once the dispatch is over
+    EXPECT_EQ(1, resource.use_count());
+}
+
+TEST(CallbackManager_GTest, update_from_callback_while_another_thread_updates) {
+    // GIVEN a callback manager whose callback updates it, dispatching continuously from another thread
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    std::atomic<bool> stop{false};
+    std::atomic<int> dispatches{0};
+    manager.add_callback([&](int) {
+        manager.remove_callback(manager.add_callback([](int) {}));
+        ++dispatches;
+    });
+    std::thread dispatcher([&]() {
+        while (!stop) {
+            manager(0);
+        }
+    });
+
+    // WHEN another thread adds and removes callbacks at the same time
+    for (int i = 0; i < 1000 || dispatches < 1000; ++i) {
+        manager.remove_callback(manager.add_callback([](int) {}));
+    }
+    stop = true;
+    dispatcher.join();
+
+    // THEN none of the updates deadlocks
+    EXPECT_EQ(1u, manager.get_cbs().size());
+}
+
+TEST(CallbackManager_GTest, removal_from_another_manager_callback_waits_for_dispatches) {
+    // GIVEN a callback manager dispatching continuously from another thread
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    CallbackManager<Callback> other_manager(index_manager);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> removed{false};
+    std::atomic<int> calls_after_removal{0};
+    std::thread dispatcher([&]() {
+        while (!stop) {
+            manager(0);
+        }
+    });
+
+    // WHEN its callbacks are removed from the callback of another manager
+    for (int i = 0; i < 200; ++i) {
+        removed       = false;
+        const auto id = manager.add_callback([&](int) {
+            std::this_thread::yield();
+            if (removed) {
+                ++calls_after_removal;
+            }
+        });
+        const auto other_id = other_manager.add_callback([&](int) {
+            manager.remove_callback(id);
+            removed = true;
+        });
+        std::this_thread::yield();
+        other_manager(0);
+        other_manager.remove_callback(other_id);
+    }
+    stop = true;
+    dispatcher.join();
+
+    // THEN a removed callback is never called after its removal returned
+    EXPECT_EQ(0, calls_after_removal);
+}
+
+TEST(CallbackManager_GTest, removal_blocks_until_callback_holding_a_lock_returns) {
+    // GIVEN a callback manager whose callback holds a lock while it is dispatched from another thread
+    IndexManager index_manager;
+    CallbackManager<Callback> manager(index_manager);
+    std::mutex callback_mutex;
+    std::atomic<bool> in_callback{false};
+    std::atomic<bool> release{false};
+    std::atomic<bool> removal_returned{false};
+    std::atomic<int> calls{0};
+    const auto id = manager.add_callback([&](int) {
+        std::lock_guard<std::mutex> lock(callback_mutex);
+        ++calls;
+        in_callback = true;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    std::thread dispatcher([&]() { manager(0); });
+    while (!in_callback) {
+        std::this_thread::yield();
+    }
+
+    // WHEN the callback is removed from a third thread while the lock is held
+    std::thread remover([&]() {
+        EXPECT_TRUE(manager.remove_callback(id));
+        removal_returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // THEN the removal waits for the callback to return
+    EXPECT_FALSE(removal_returned);
+    EXPECT_FALSE(callback_mutex.try_lock());
+    release = true;
+    remover.join();
+    dispatcher.join();
+    EXPECT_TRUE(removal_returned);
+
+    // THEN the lock is released and the callback is not called anymore
+    EXPECT_TRUE(callback_mutex.try_lock());
+    callback_mutex.unlock();
+    manager(0);
+    EXPECT_EQ(1, calls);
+}
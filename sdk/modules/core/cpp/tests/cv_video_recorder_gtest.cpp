@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/core/utils/cv_video_recorder.h"
+
+using namespace Metavision;
+
+class CvVideoRecorder_GTest : public GTestWithTmpDir {
+protected:
+    const cv::Size size_{1280, 720};
+    const int fourcc_ = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+};
+
+TEST_F(CvVideoRecorder_GTest, block_policy_writes_all_frames) {
+    // GIVEN a recorder with few frame slots, blocking when they are all in use
+    CvVideoRecorder::Parameters params;
+    params.num_frame_slots = 2;
+    params.overflow_policy = CvVideoRecorder::OverflowPolicy::Block;
+    CvVideoRecorder recorder(tmpdir_handler_->get_full_path("block.avi"), fourcc_, 30, size_, true, params);
+    ASSERT_TRUE(recorder.start());
+
+    // WHEN writing more frames than slots
+    const size_t n_frames = 20;
+    cv::Mat frame(size_, CV_8UC3);
+    for (size_t i = 0; i < n_frames; ++i) {
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+        recorder.write(frame);
+        EXPECT_LE(recorder.get_statistics().num_queued_frames, params.num_frame_slots);
+    }
+    recorder.stop();
+
+    // THEN all the frames are written
+    const auto stats = recorder.get_statistics();
+    EXPECT_EQ(n_frames, stats.num_written_frames);
+    EXPECT_EQ(0u, stats.num_dropped_frames);
+    EXPECT_EQ(0u, stats.num_queued_frames);
+    EXPECT_LE(stats.mean_latency, stats.max_latency);
+}
+
+TEST_F(CvVideoRecorder_GTest, drop_oldest_policy_accounts_for_all_frames) {
+    // GIVEN a recorder with few frame slots, dropping the oldest frame when they are all in use
+    CvVideoRecorder::Parameters params;
+    params.num_frame_slots = 2;
+    params.overflow_policy = CvVideoRecorder::OverflowPolicy::DropOldest;
+    CvVideoRecorder recorder(tmpdir_handler_->get_full_path("drop.avi"), fourcc_, 30, size_, true, params);
+    ASSERT_TRUE(recorder.start());
+
+    // WHEN writing frames faster than they can be encoded
+    const size_t n_frames = 100;
+    cv::Mat frame(size_, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    for (size_t i = 0; i < n_frames; ++i) {
+        recorder.write(frame);
+    }
+    recorder.stop();
+
+    // THEN each frame is either written or dropped
+    const auto stats = recorder.get_statistics();
+    EXPECT_EQ(n_frames, stats.num_written_frames + stats.num_dropped_frames);
+    EXPECT_LT(0u, stats.num_written_frames);
+    EXPECT_EQ(0u, stats.num_queued_frames);
+}
+
+TEST_F(CvVideoRecorder_GTest, write_when_not_recording_is_ignored) {
+    // GIVEN a recorder that is not started
+    CvVideoRecorder recorder(tmpdir_handler_->get_full_path("idle.avi"), fourcc_, 30, size_, true);
+
+    // WHEN writing a frame
+    cv::Mat frame(size_, CV_8UC3, cv::Scalar::all(0));
+    recorder.write(frame);
+
+    // THEN the frame is neither queued nor written
+    const auto stats = recorder.get_statistics();
+    EXPECT_EQ(0u, stats.num_queued_frames);
+    EXPECT_EQ(0u, stats.num_written_frames);
+}
@@ -428,4 +428,204 @@ TEST_F(DataSynchronizerFromTriggers_GTest, LostTriggersThreaded) {
     trigger_thread.join();
 }
 
+TEST_F(DataSynchronizerFromTriggers_GTest, IndexAllTriggersBeforeSynchronizing) {
+    // Checks that, by default, all triggers can be indexed before synchronizing data from the same thread
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.reference_polarity_ = 1;
+    DataSynchronizerFromTriggers sync(param);
+
+    std::vector<uint32_t> indices(10000);
+    std::vector<Event2dIndex> to_index(indices.size());
+    for (SizeType i = 0; i < indices.size(); ++i) {
+        indices[i]        = i;
+        to_index[i].index = i;
+    }
+    auto trigger_buffer = create_trigger_buffer(indices, period_us, 0);
+
+    ASSERT_EQ(indices.size(), sync.index_triggers(trigger_buffer.cbegin(), trigger_buffer.cend()));
+    ASSERT_EQ(indices.size(),
+              sync.synchronize_data_from_triggers(to_index.begin(), to_index.end(), &Event2dIndex::timestamp_accessor,
+                                                  &Event2dIndex::index_accessor));
+
+    for (SizeType i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(trigger_buffer[2 * i + !param.reference_polarity_].t, to_index[i].t);
+    }
+}
+
+TEST_F(DataSynchronizerFromTriggers_GTest, IndexingBlocksWhenTooManyTriggersArePending) {
+    // Checks that indexing triggers waits for the pending ones to be used, and that the synchronization is still
+    // correct
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.reference_polarity_   = 1;
+    param.max_pending_triggers_ = 4;
+    DataSynchronizerFromTriggers sync(param);
+
+    std::vector<uint32_t> indices(100);
+    std::vector<Event2dIndex> to_index(indices.size());
+    for (SizeType i = 0; i < indices.size(); ++i) {
+        indices[i]        = i;
+        to_index[i].index = i;
+    }
+    auto trigger_buffer = create_trigger_buffer(indices, period_us, 0);
+
+    std::atomic<bool> indexing_done{false};
+    std::thread trigger_thread([&]() {
+        EXPECT_EQ(indices.size(), sync.index_triggers(trigger_buffer.cbegin(), trigger_buffer.cend()));
+        indexing_done = true;
+    });
+
+    // the indexing can not be done before data have been synchronized
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(indexing_done);
+
+    EXPECT_EQ(indices.size(),
+              sync.synchronize_data_from_triggers(to_index.begin(), to_index.end(), &Event2dIndex::timestamp_accessor,
+                                                  &Event2dIndex::index_accessor));
+    trigger_thread.join();
+
+    for (SizeType i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(trigger_buffer[2 * i + !param.reference_polarity_].t, to_index[i].t);
+    }
+}
+
+TEST_F(DataSynchronizerFromTriggers_GTest, BlockedIndexingIsReleasedWhenDone) {
+    // Checks that indexing does not wait for triggers to be used once the synchronization is done
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.max_pending_triggers_ = 2;
+    DataSynchronizerFromTriggers sync(param);
+
+    auto trigger_buffer = create_trigger_buffer(std::vector<uint32_t>{0, 1, 2, 3, 4}, period_us, 0);
+    std::thread trigger_thread([&]() { sync.index_triggers(trigger_buffer.cbegin(), trigger_buffer.cend()); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sync.set_synchronization_as_done();
+    trigger_thread.join();
+
+    // only the triggers that could be pending are used
+    std::vector<Event2dIndex> to_index(5);
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        to_index[i].index = i;
+    }
+    ASSERT_EQ(2, sync.synchronize_data_from_triggers(to_index.begin(), to_index.end(),
+                                                     &Event2dIndex::timestamp_accessor, &Event2dIndex::index_accessor));
+}
+
+TEST_F(DataSynchronizerFromTriggers_GTest, WaitForTriggersConsumed) {
+    // Checks that waiting for the triggers to be consumed returns once data have been synchronized
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    DataSynchronizerFromTriggers sync(param);
+
+    auto trigger_buffer = create_trigger_buffer(std::vector<uint32_t>{0, 1, 2, 3, 4}, period_us, 0);
+    ASSERT_EQ(5, sync.index_triggers(trigger_buffer.cbegin(), trigger_buffer.cend()));
+
+    std::atomic<bool> consumed{false};
+    std::thread waiting_thread([&]() {
+        sync.wait_for_triggers_consumed(2);
+        consumed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(consumed);
+
+    std::vector<Event2dIndex> to_index(3);
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        to_index[i].index = i;
+    }
+    ASSERT_EQ(3, sync.synchronize_data_from_triggers(to_index.begin(), to_index.end(),
+                                                     &Event2dIndex::timestamp_accessor, &Event2dIndex::index_accessor));
+    waiting_thread.join();
+    EXPECT_TRUE(consumed);
+}
+
+TEST_F(DataSynchronizerFromTriggers_GTest, HighRateThreaded) {
+    // Checks that synchronizing at a high rate in small batches, with lost triggers, from two threads is correct
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.reference_polarity_   = 1;
+    param.max_pending_triggers_ = 64;
+    DataSynchronizerFromTriggers sync(param);
+
+    const uint32_t num_data = 20000;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < num_data; ++i) {
+        if (i % 97 != 50) {
+            indices.push_back(i);
+        }
+    }
+    auto trigger_buffer = create_trigger_buffer(indices, period_us, 0);
+
+    std::thread trigger_thread([&]() {
+        for (SizeType i = 0; i < trigger_buffer.size(); i += 10) {
+            sync.index_triggers(trigger_buffer.cbegin() + i,
+                                trigger_buffer.cbegin() + std::min(i + 10, trigger_buffer.size()));
+        }
+    });
+
+    std::vector<Event2dIndex> to_index(num_data);
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        to_index[i].index = i;
+    }
+    for (SizeType i = 0; i < to_index.size(); i += 7) {
+        const auto end = std::min<SizeType>(i + 7, to_index.size());
+        ASSERT_EQ(end - i, sync.synchronize_data_from_triggers(to_index.begin() + i, to_index.begin() + end,
+                                                               &Event2dIndex::timestamp_accessor,
+                                                               &Event2dIndex::index_accessor));
+    }
+    trigger_thread.join();
+
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        ASSERT_EQ(static_cast<timestamp>(i * period_us), to_index[i].t);
+    }
+}
+
+TEST_F(DataSynchronizerFromTriggers_GTest, HighRateThreadedUnbounded) {
+    // Checks that synchronizing from two threads is correct while the pending triggers grow past the initial room
+
+    const int32_t period_us = 1000;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.reference_polarity_ = 1;
+    DataSynchronizerFromTriggers sync(param);
+
+    const uint32_t num_data = 20000;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < num_data; ++i) {
+        if (i % 97 != 50) {
+            indices.push_back(i);
+        }
+    }
+    auto trigger_buffer = create_trigger_buffer(indices, period_us, 0);
+
+    std::thread trigger_thread([&]() {
+        for (SizeType i = 0; i < trigger_buffer.size(); i += 1000) {
+            sync.index_triggers(trigger_buffer.cbegin() + i,
+                                trigger_buffer.cbegin() + std::min(i + 1000, trigger_buffer.size()));
+        }
+    });
+
+    std::vector<Event2dIndex> to_index(num_data);
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        to_index[i].index = i;
+    }
+    for (SizeType i = 0; i < to_index.size(); i += 7) {
+        const auto end = std::min<SizeType>(i + 7, to_index.size());
+        ASSERT_EQ(end - i, sync.synchronize_data_from_triggers(to_index.begin() + i, to_index.begin() + end,
+                                                               &Event2dIndex::timestamp_accessor,
+                                                               &Event2dIndex::index_accessor));
+    }
+    trigger_thread.join();
+
+    for (SizeType i = 0; i < to_index.size(); ++i) {
+        ASSERT_EQ(static_cast<timestamp>(i * period_us), to_index[i].t);
+    }
+}
+
 } // namespace Metavision
@@ -0,0 +1,242 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/event_rate_statistics.h"
+
+using namespace Metavision;
+
+namespace {
+// one event every 100us, i.e. 10 events per ms
+std::vector<EventCD> make_regular_events(timestamp t_begin, timestamp t_end, int x = 0, int y = 0) {
+    std::vector<EventCD> events;
+    for (timestamp t = t_begin; t < t_end; t += 100) {
+        events.emplace_back(x, y, 0, t);
+    }
+    return events;
+}
+} // namespace
+
+TEST(EventRateStatistics_GTest, invalid_configurations) {
+    using Res = EventRateStatistics::Resolution;
+    EXPECT_THROW(EventRateStatistics(std::vector<Res>{}), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{0, 10}}), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{1000, 0}}), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{1000, 10}, {1500, 10}}), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{1000, 10}, {1000, 10}}), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{1000, 10}}, 640, 0), std::invalid_argument);
+    EXPECT_THROW(EventRateStatistics({{1000, 10}}, 640, 480, 0), std::invalid_argument);
+    EXPECT_NO_THROW(EventRateStatistics({{1000, 10}, {10000, 10}}, 640, 480, 16));
+}
+
+TEST(EventRateStatistics_GTest, no_stats_before_first_bin_is_completed) {
+    // GIVEN statistics with the default resolutions
+    EventRateStatistics stats;
+    ASSERT_EQ(3, stats.get_num_resolutions());
+    EXPECT_EQ(1000, stats.get_resolution(0).bin_duration);
+    EXPECT_EQ(1000000, stats.get_resolution(2).bin_duration);
+
+    // WHEN adding events within the first ms only
+    auto events = make_regular_events(0, 1000);
+    stats.process_events(events.cbegin(), events.cend());
+
+    // THEN no statistics are available yet
+    EventRateStatistics::WindowStats window;
+    double peak_rate;
+    EXPECT_FALSE(stats.get_window_stats(0, 1, window));
+    EXPECT_FALSE(stats.get_peak_rate(0, 1, peak_rate));
+    EXPECT_THROW(stats.get_window_stats(3, 1, window), std::out_of_range);
+}
+
+TEST(EventRateStatistics_GTest, counts_at_all_resolutions) {
+    // GIVEN statistics with the default resolutions
+    EventRateStatistics stats;
+
+    // WHEN adding events at 10kev/s during 2s, in several buffers
+    auto events = make_regular_events(0, 2000000);
+    stats.process_events(events.cbegin(), events.cbegin() + 12345);
+    stats.process_events(events.cbegin() + 12345, events.cend());
+    stats.advance_time(2000000);
+
+    // THEN the rate is the same at all resolutions and over any number of bins
+    EventRateStatistics::WindowStats window;
+    ASSERT_TRUE(stats.get_window_stats(0, 1, window));
+    EXPECT_EQ(2000000, window.end_time);
+    EXPECT_EQ(1000, window.duration);
+    EXPECT_EQ(10, window.count);
+    EXPECT_DOUBLE_EQ(10000., window.rate);
+
+    ASSERT_TRUE(stats.get_window_stats(1, 10, window));
+    EXPECT_EQ(100000, window.duration);
+    EXPECT_EQ(1000, window.count);
+    EXPECT_DOUBLE_EQ(10000., window.rate);
+
+    // the number of bins is clamped to the ones available
+    ASSERT_TRUE(stats.get_window_stats(2, 10, window));
+    EXPECT_EQ(2000000, window.duration);
+    EXPECT_EQ(20000, window.count);
+    EXPECT_DOUBLE_EQ(10000., window.rate);
+
+    ASSERT_TRUE(stats.get_window_stats(0, 5000, window));
+    EXPECT_EQ(1000000, window.duration);
+    EXPECT_EQ(10000, window.count);
+}
+
+TEST(EventRateStatistics_GTest, peak_rate_of_finer_resolution) {
+    // GIVEN statistics with the default resolutions
+    EventRateStatistics stats;
+
+    // WHEN adding events at 10kev/s during 1s, with a burst of 100 more events in a single ms
+    auto events = make_regular_events(0, 1000000);
+    std::vector<EventCD> burst(100, EventCD(0, 0, 1, 500500));
+    events.insert(events.begin() + 5006, burst.cbegin(), burst.cend());
+    stats.process_events(events.cbegin(), events.cend());
+    stats.advance_time(1000000);
+
+    // THEN the peak rate of the ms bins is found at all resolutions spanning the burst
+    double peak_rate;
+    ASSERT_TRUE(stats.get_peak_rate(0, 1000, peak_rate));
+    EXPECT_DOUBLE_EQ(110000., peak_rate);
+    ASSERT_TRUE(stats.get_peak_rate(1, 1, peak_rate));
+    EXPECT_DOUBLE_EQ(10000., peak_rate);
+    ASSERT_TRUE(stats.get_peak_rate(1, 100, peak_rate));
+    EXPECT_DOUBLE_EQ(110000., peak_rate);
+
+    // the 1s bin holds the peak count of the 10ms bins
+    ASSERT_TRUE(stats.get_peak_rate(2, 1, peak_rate));
+    EXPECT_DOUBLE_EQ(20000., peak_rate);
+
+    EventRateStatistics::WindowStats window;
+    ASSERT_TRUE(stats.get_window_stats(2, 1, window));
+    EXPECT_EQ(10100, window.count);
+}
+
+TEST(EventRateStatistics_GTest, empty_bins_and_time_gaps) {
+    // GIVEN statistics with short histories
+    EventRateStatistics stats({{1000, 10}, {10000, 10}});
+
+    // WHEN adding counts, then letting time pass without events
+    stats.add_count(500, 42);
+    stats.advance_time(25000);
+
+    // THEN the older bins hold the counts and the latest ones are empty
+    EventRateStatistics::WindowStats window;
+    ASSERT_TRUE(stats.get_window_stats(0, 1, window));
+    EXPECT_EQ(25000, window.end_time);
+    EXPECT_EQ(0, window.count);
+    ASSERT_TRUE(stats.get_window_stats(1, 10, window));
+    EXPECT_EQ(20000, window.end_time);
+    EXPECT_EQ(20000, window.duration);
+    EXPECT_EQ(42, window.count);
+
+    // WHEN a much longer gap than the history happens before new counts
+    stats.add_count(10000500, 7);
+    stats.advance_time(10001000);
+
+    // THEN the bins in the history are consistent
+    ASSERT_TRUE(stats.get_window_stats(0, 10, window));
+    EXPECT_EQ(10001000, window.end_time);
+    EXPECT_EQ(10000, window.duration);
+    EXPECT_EQ(7, window.count);
+    ASSERT_TRUE(stats.get_window_stats(1, 10, window));
+    EXPECT_EQ(10000000, window.end_time);
+    EXPECT_EQ(0, window.count);
+
+    // WHEN resetting the statistics
+    stats.reset();
+
+    // THEN no statistics are available until a new bin is completed
+    EXPECT_FALSE(stats.get_window_stats(0, 1, window));
+    stats.add_count(20000000, 3);
+    stats.advance_time(20001000);
+    ASSERT_TRUE(stats.get_window_stats(0, 10, window));
+    EXPECT_EQ(1000, window.duration);
+    EXPECT_EQ(3, window.count);
+}
+
+TEST(EventRateStatistics_GTest, counts_per_tile) {
+    // GIVEN statistics on a 100x50 sensor split in tiles of 32 pixels
+    EventRateStatistics stats({{1000, 10}, {10000, 10}}, 100, 50, 32);
+    ASSERT_EQ(4, stats.get_tile_columns());
+    ASSERT_EQ(2, stats.get_tile_rows());
+
+    // WHEN adding events in 2 tiles during 10ms
+    auto events       = make_regular_events(0, 10000, 10, 10);
+    auto other_events = make_regular_events(50, 10000, 99, 49);
+    events.insert(events.end(), other_events.cbegin(), other_events.cend());
+    std::stable_sort(events.begin(), events.end(), [](const auto &a, const auto &b) { return a.t < b.t; });
+    stats.process_events(events.cbegin(), events.cend());
+    stats.advance_time(10000);
+
+    // THEN the tile counts are available for the last bin at each resolution
+    std::vector<std::uint32_t> counts;
+    timestamp end_time;
+    ASSERT_TRUE(stats.get_tile_counts(0, counts, end_time));
+    EXPECT_EQ(10000, end_time);
+    EXPECT_EQ((std::vector<std::uint32_t>{10, 0, 0, 0, 0, 0, 0, 10}), counts);
+    ASSERT_TRUE(stats.get_tile_counts(1, counts, end_time));
+    EXPECT_EQ(10000, end_time);
+    EXPECT_EQ((std::vector<std::uint32_t>{100, 0, 0, 0, 0, 0, 0, 100}), counts);
+
+    // WHEN time passes without events
+    stats.advance_time(12000);
+
+    // THEN the tile counts of the finest resolution are cleared
+    ASSERT_TRUE(stats.get_tile_counts(0, counts, end_time));
+    EXPECT_EQ(12000, end_time);
+    EXPECT_EQ(std::vector<std::uint32_t>(8, 0), counts);
+}
+
+TEST(EventRateStatistics_GTest, concurrent_readers_get_consistent_stats) {
+    // GIVEN statistics with short histories, so that bins are overwritten while being read
+    EventRateStatistics stats({{100, 20}, {1000, 20}});
+
+    // WHEN a thread adds 1 event per us, while other threads read the statistics
+    std::atomic<bool> done{false};
+    std::atomic<int> num_errors{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&, i] {
+            EventRateStatistics::WindowStats window;
+            double peak_rate;
+            while (!done) {
+                // 1 event per us in every bin
+                if (stats.get_window_stats(i, 1 + i * 7, window) &&
+                    window.count != static_cast<std::uint64_t>(window.duration)) {
+                    ++num_errors;
+                }
+                if (stats.get_peak_rate(i, 20, peak_rate) && peak_rate != 1.e6) {
+                    ++num_errors;
+                }
+            }
+        });
+    }
+    std::vector<EventCD> events(1000);
+    for (timestamp t = 0; t < 2000000; t += 1000) {
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            events[i].t = t + i;
+        }
+        stats.process_events(events.cbegin(), events.cend());
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    // THEN the readers always get the statistics of complete bins
+    EXPECT_EQ(0, num_errors);
+}
@@ -0,0 +1,148 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/pixel_activity_map_algorithm.h"
+
+using namespace Metavision;
+
+TEST(PixelActivityMapAlgorithm_GTest, invalid_configurations) {
+    EXPECT_THROW(PixelActivityMapAlgorithm(0, 10), std::invalid_argument);
+    EXPECT_THROW(PixelActivityMapAlgorithm(10, -1), std::invalid_argument);
+    EXPECT_THROW(PixelActivityMapAlgorithm(10, 10, -1), std::invalid_argument);
+}
+
+TEST(PixelActivityMapAlgorithm_GTest, counts_events_per_pixel) {
+    // GIVEN an activity map on a sensor whose size is not a multiple of the tiles one
+    PixelActivityMapAlgorithm algo(21, 13);
+
+    // WHEN processing events on pixels of different tiles, including the last pixel of the sensor
+    std::vector<EventCD> events = {{0, 0, 1, 1}, {20, 12, 0, 2}, {9, 3, 1, 3}, {20, 12, 1, 4}, {20, 12, 1, 5}};
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN each pixel holds its own count
+    EXPECT_EQ(1, algo.get_count(0, 0));
+    EXPECT_EQ(1, algo.get_count(9, 3));
+    EXPECT_EQ(3, algo.get_count(20, 12));
+    EXPECT_EQ(0, algo.get_count(3, 9));
+
+    cv::Mat_<std::uint16_t> counts;
+    algo.get_counts(counts);
+    ASSERT_EQ(13, counts.rows);
+    ASSERT_EQ(21, counts.cols);
+    EXPECT_EQ(3, counts(12, 20));
+    EXPECT_EQ(5, cv::sum(counts)[0]);
+
+    const auto stats = algo.get_statistics();
+    EXPECT_EQ(5, stats.total);
+    EXPECT_EQ(3, stats.max);
+    EXPECT_DOUBLE_EQ(5. / (21 * 13), stats.mean);
+
+    cv::Mat_<std::uint8_t> heat_map;
+    algo.generate_heat_map(heat_map);
+    EXPECT_EQ(255, heat_map(12, 20));
+    EXPECT_EQ(85, heat_map(0, 0));
+
+    // WHEN resetting the map
+    algo.reset();
+
+    // THEN all the counts are null
+    EXPECT_EQ(0, algo.get_statistics().total);
+}
+
+TEST(PixelActivityMapAlgorithm_GTest, counts_saturate) {
+    // GIVEN an activity map
+    PixelActivityMapAlgorithm algo(8, 8);
+
+    // WHEN processing more events on a pixel than its counter can hold
+    std::vector<EventCD> events(70000, EventCD(1, 2, 0, 0));
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN the count saturates
+    EXPECT_EQ(65535, algo.get_count(1, 2));
+}
+
+TEST(PixelActivityMapAlgorithm_GTest, counts_decay_periodically) {
+    // GIVEN an activity map whose counts are halved every 10ms
+    PixelActivityMapAlgorithm algo(16, 16, 10000);
+
+    // WHEN processing 8 events on a pixel, then one event 10ms later
+    std::vector<EventCD> events(8, EventCD(5, 5, 0, 1000));
+    events.emplace_back(0, 0, 0, 10000);
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN the count of the pixel has been halved
+    EXPECT_EQ(4, algo.get_count(5, 5));
+    EXPECT_EQ(1, algo.get_count(0, 0));
+
+    // WHEN 2 more periods elapse before the next event
+    events = {EventCD(15, 15, 0, 30500)};
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN the counts have been halved twice
+    EXPECT_EQ(1, algo.get_count(5, 5));
+    EXPECT_EQ(0, algo.get_count(0, 0));
+
+    // WHEN a very long time elapses
+    events = {EventCD(15, 15, 0, 100000000)};
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN only the latest event is counted
+    EXPECT_EQ(1, algo.get_statistics().total);
+}
+
+TEST(PixelActivityMapAlgorithm_GTest, detects_hot_and_dead_pixels) {
+    // GIVEN an activity map where all pixels have 10 events, but 2 hot pixels with 100 events and a dead one
+    const int width = 40, height = 30;
+    PixelActivityMapAlgorithm algo(width, height);
+    std::vector<EventCD> events;
+    for (int i = 0; i < 10; ++i) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (x != 7 || y != 21) {
+                    events.emplace_back(x, y, 0, i);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 90; ++i) {
+        events.emplace_back(3, 4, 0, 10);
+        events.emplace_back(39, 29, 0, 10);
+    }
+    algo.process_events(events.cbegin(), events.cend());
+
+    // THEN the hot pixels are detected
+    std::vector<cv::Point> pixels;
+    algo.get_hot_pixels(pixels);
+    EXPECT_EQ((std::vector<cv::Point>{{3, 4}, {39, 29}}), pixels);
+
+    // and are not when the threshold is too high
+    algo.get_hot_pixels(pixels, 3.f, 101);
+    EXPECT_TRUE(pixels.empty());
+
+    // THEN the dead pixel is detected
+    algo.get_dead_pixels(pixels);
+    EXPECT_EQ((std::vector<cv::Point>{{7, 21}}), pixels);
+    algo.get_dead_pixels(pixels, 10);
+    EXPECT_EQ(width * height - 2, pixels.size());
+
+    // THEN the pixel mask filters out the hot pixels only
+    cv::Mat_<double> mask;
+    algo.generate_pixel_mask(mask);
+    ASSERT_EQ(height, mask.rows);
+    ASSERT_EQ(width, mask.cols);
+    EXPECT_EQ(0., mask(4, 3));
+    EXPECT_EQ(0., mask(29, 39));
+    EXPECT_EQ(width * height - 2, cv::sum(mask)[0]);
+}
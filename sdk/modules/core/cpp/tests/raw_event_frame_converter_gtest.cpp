@@ -0,0 +1,148 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/preprocessors/hardware_diff_processor.h"
+#include "metavision/sdk/core/preprocessors/hardware_histo_processor.h"
+#include "metavision/sdk/core/preprocessors/tensor.h"
+#include "metavision/sdk/core/utils/raw_event_frame_converter.h"
+
+using namespace Metavision;
+using InputIt = std::vector<EventCD>::const_iterator;
+
+namespace {
+
+constexpr unsigned kWidth  = 37;
+constexpr unsigned kHeight = 5;
+
+// Fills the frame with all the possible byte values, including garbage in the bits above the channels
+RawEventFrameHisto make_histo(unsigned neg_bits, unsigned pos_bits, bool packed) {
+    RawEventFrameHisto histo(kHeight, kWidth, neg_bits, pos_bits, packed);
+    auto &data = histo.get_data();
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    return histo;
+}
+
+std::vector<EventCD> make_events() {
+    std::vector<EventCD> events;
+    for (unsigned i = 0; i < 2000; ++i) {
+        events.emplace_back((i * 13) % kWidth, (i * 7) % kHeight, (i / 3) % 2, i);
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(RawEventFrameConverter_GTest, convert_histo_matches_per_pixel_extraction) {
+    for (const bool packed : {true, false}) {
+        for (const auto format : {HistogramFormat::HWC, HistogramFormat::CHW}) {
+            const unsigned neg_bits = 3, pos_bits = packed ? 5 : 4;
+            const auto histo        = make_histo(neg_bits, pos_bits, packed);
+            RawEventFrameConverter converter(kHeight, kWidth, 2, format);
+
+            const auto converted = converter.convert<float>(histo);
+            ASSERT_EQ(kHeight * kWidth * 2, converted->get_size());
+            ASSERT_EQ(format, converted->get_format());
+            for (unsigned y = 0; y < kHeight; ++y) {
+                for (unsigned x = 0; x < kWidth; ++x) {
+                    const unsigned idx = x + y * kWidth;
+                    const uint8_t neg  = packed ? histo.get_data()[idx] : histo.get_data()[2 * idx];
+                    const uint8_t pos  = packed ? histo.get_data()[idx] >> neg_bits : histo.get_data()[2 * idx + 1];
+                    EXPECT_EQ(neg & ((1 << neg_bits) - 1), (*converted)(x, y, HistogramChannel::NEGATIVE));
+                    EXPECT_EQ(pos & ((1 << pos_bits) - 1), (*converted)(x, y, HistogramChannel::POSITIVE));
+                }
+            }
+        }
+    }
+}
+
+TEST(RawEventFrameConverter_GTest, convert_diff) {
+    RawEventFrameDiff diff(kHeight, kWidth, 8);
+    for (size_t i = 0; i < diff.get_data().size(); ++i) {
+        diff.get_data()[i] = static_cast<int8_t>(i * 7);
+    }
+    RawEventFrameConverter converter(kHeight, kWidth, 1);
+
+    const auto converted = converter.convert<int>(diff);
+    ASSERT_EQ(kHeight * kWidth, converted->get_size());
+    for (unsigned y = 0; y < kHeight; ++y) {
+        for (unsigned x = 0; x < kWidth; ++x) {
+            EXPECT_EQ(diff.get_data()[x + y * kWidth], (*converted)(x, y));
+        }
+    }
+}
+
+TEST(RawEventFrameConverter_GTest, convert_histo_to_hardware_histo_processor_tensor) {
+    // GIVEN the tensor computed from events by the HardwareHistoProcessor and the frame a sensor would produce
+    const auto events = make_events();
+    HardwareHistoProcessor<InputIt> processor(kWidth, kHeight, 15, 15);
+    Tensor expected(processor.get_output_shape(), processor.get_output_type());
+    expected.set_to(0);
+    processor.process_events(0, events.cbegin(), events.cend(), expected);
+
+    for (const bool packed : {true, false}) {
+        RawEventFrameHisto histo(kHeight, kWidth, 4, 4, packed);
+        auto &data = histo.get_data();
+        const auto values = expected.data<uint8_t>();
+        for (unsigned i = 0; i < kWidth * kHeight; ++i) {
+            if (packed) {
+                data[i] = values[2 * i] | values[2 * i + 1] << 4;
+            } else {
+                // Garbage in the bits above the channels must be ignored
+                data[2 * i]     = values[2 * i] | 0xF0;
+                data[2 * i + 1] = values[2 * i + 1] | 0xF0;
+            }
+        }
+
+        // WHEN converting the frame into a tensor
+        RawEventFrameConverter converter(kHeight, kWidth, 2, HistogramFormat::CHW);
+        Tensor tensor(processor.get_output_shape(), processor.get_output_type());
+        converter.convert(histo, tensor);
+
+        // THEN the tensor is the one of the processor, whatever the converter format
+        const auto result = tensor.data<uint8_t>();
+        EXPECT_TRUE(std::equal(values, values + 2 * kWidth * kHeight, result)) << "packed = " << packed;
+    }
+}
+
+TEST(RawEventFrameConverter_GTest, convert_diff_to_hardware_diff_processor_tensor) {
+    const auto events = make_events();
+    HardwareDiffProcessor<InputIt> processor(kWidth, kHeight, -128, 127, false);
+    RawEventFrameDiff diff(kHeight, kWidth, 8);
+    processor.process_events(events.cbegin(), events.cend(), diff);
+
+    Tensor expected(processor.get_output_shape(), processor.get_output_type());
+    expected.set_to(0);
+    processor.process_events(0, events.cbegin(), events.cend(), expected);
+
+    RawEventFrameConverter converter(kHeight, kWidth, 1);
+    Tensor tensor(processor.get_output_shape(), processor.get_output_type());
+    converter.convert(diff, tensor);
+
+    const auto values = expected.data<int8_t>();
+    EXPECT_TRUE(std::equal(values, values + kWidth * kHeight, tensor.data<int8_t>()));
+}
+
+TEST(RawEventFrameConverter_GTest, convert_to_tensor_throws_on_mismatching_tensor) {
+    RawEventFrameConverter converter(kHeight, kWidth, 2);
+    const auto histo = make_histo(4, 4, false);
+
+    Tensor wrong_size(TensorShape({{"H", kHeight}, {"W", kWidth + 1}, {"C", 2}}), BaseType::UINT8);
+    EXPECT_THROW(converter.convert(histo, wrong_size), std::invalid_argument);
+
+    Tensor wrong_type(TensorShape({{"H", kHeight}, {"W", kWidth}, {"C", 2}}), BaseType::FLOAT32);
+    EXPECT_THROW(converter.convert(histo, wrong_type), std::invalid_argument);
+}
@@ -10,6 +10,8 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/core/utils/rolling_event_buffer.h"
@@ -42,6 +44,18 @@ void check_rolling_buffer_content(const RollingEventBuffer &buffer, const std::v
         ASSERT_EQ(ev.t, gt_it->t);
         ++gt_it;
     }
+
+    // WHEN we compare the buffer to the GT using its contiguous chunks
+    // THEN the chunks cover the whole buffer and all the elements match
+    const auto spans = buffer.contiguous_spans();
+    ASSERT_EQ(gt.size(), spans[0].size + spans[1].size);
+    gt_it = gt.cbegin();
+    for (const auto &span : spans) {
+        for (size_t i = 0; i < span.size; ++i) {
+            ASSERT_EQ(span.data[i].t, gt_it->t);
+            ++gt_it;
+        }
+    }
 }
 
 void check_iterators(const RollingEventBuffer &buffer) {
@@ -200,4 +214,99 @@ TEST(RollingEventBuffer, n_us_warp_up) {
     ASSERT_EQ(8, buffer.capacity());
     check_rolling_buffer_content(buffer, {{35}, {36}, {37}, {38}, {39}});
     check_iterators(buffer);
-}
\ No newline at end of file
+}
+
+TEST(RollingEventBuffer, contiguous_spans_and_epoch) {
+    // GIVEN a rolling buffer configured to store at most 5 events
+    RollingEventBuffer buffer(RollingEventBufferConfig::make_n_events(5));
+    const auto initial_epoch = buffer.epoch();
+
+    // WHEN we retrieve the chunks of the empty buffer
+    // THEN both are empty
+    auto spans = buffer.contiguous_spans();
+    ASSERT_EQ(0, spans[0].size);
+    ASSERT_EQ(0, spans[1].size);
+
+    // WHEN we insert 3 events
+    insert_events(buffer, {{0}, {1}, {2}});
+
+    // THEN
+    // - the epoch changes
+    // - all the events are stored in the first chunk
+    const auto epoch = buffer.epoch();
+    ASSERT_NE(initial_epoch, epoch);
+    spans = buffer.contiguous_spans();
+    ASSERT_EQ(3, spans[0].size);
+    ASSERT_EQ(0, spans[1].size);
+
+    // WHEN we insert an empty range
+    insert_events(buffer, {});
+
+    // THEN the epoch does not change
+    ASSERT_EQ(epoch, buffer.epoch());
+
+    // WHEN we insert 4 more events (memory layout [5, 6, 2, 3, 4])
+    insert_events(buffer, {{3}, {4}, {5}, {6}});
+
+    // THEN
+    // - the epoch changes
+    // - the oldest events are in the first chunk and the ones that wrapped around are in the second chunk, at the
+    // beginning of the storage
+    ASSERT_NE(epoch, buffer.epoch());
+    spans = buffer.contiguous_spans();
+    ASSERT_EQ(3, spans[0].size);
+    ASSERT_EQ(2, spans[1].size);
+    ASSERT_EQ(2, spans[0].data[0].t);
+    ASSERT_EQ(5, spans[1].data[0].t);
+    ASSERT_EQ(spans[0].data, spans[1].data + 2);
+
+    // WHEN we clear the buffer
+    const auto epoch_before_clear = buffer.epoch();
+    buffer.clear();
+
+    // THEN the epoch changes
+    ASSERT_NE(epoch_before_clear, buffer.epoch());
+}
+
+TEST(RollingEventBuffer, contiguous_spans_stay_valid_when_the_buffer_is_moved) {
+    // GIVEN a rolling buffer configured to store at most 5 events
+    RollingEventBuffer buffer(RollingEventBufferConfig::make_n_events(5));
+
+    std::vector<std::unique_ptr<RollingEventBuffer>> snapshots;
+    std::vector<std::vector<Metavision::timestamp>> snapshots_gt;
+    for (Metavision::timestamp t = 0; t < 20; t += 3) {
+        // WHEN we insert events, take the chunks of the buffer and move its storage to a snapshot before inserting
+        // again, the buffer continuing with a copy of its content
+        insert_events(buffer, {{t}, {t + 1}, {t + 2}});
+        const auto spans = buffer.contiguous_spans();
+        snapshots_gt.emplace_back();
+        for (const auto &span : spans) {
+            for (size_t i = 0; i < span.size; ++i) {
+                snapshots_gt.back().push_back(span.data[i].t);
+            }
+        }
+        snapshots.push_back(std::make_unique<RollingEventBuffer>(std::move(buffer)));
+        buffer = *snapshots.back();
+
+        // THEN
+        // - the chunks now point to the storage of the snapshot
+        // - the buffer has the same content in another storage
+        const auto snapshot_spans = snapshots.back()->contiguous_spans();
+        ASSERT_EQ(spans[0].data, snapshot_spans[0].data);
+        ASSERT_EQ(spans[1].data, snapshot_spans[1].data);
+        ASSERT_NE(spans[0].data, buffer.contiguous_spans()[0].data);
+        ASSERT_EQ(spans[0].size + spans[1].size, buffer.size());
+    }
+
+    // THEN the inserts that followed did not modify the chunks taken before them
+    check_rolling_buffer_content(buffer, {{16}, {17}, {18}, {19}, {20}});
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        std::vector<Metavision::timestamp> content;
+        for (const auto &span : snapshots[i]->contiguous_spans()) {
+            for (size_t j = 0; j < span.size; ++j) {
+                content.push_back(span.data[j].t);
+            }
+        }
+        ASSERT_EQ(snapshots_gt[i], content);
+    }
+}
@@ -254,3 +254,35 @@ TEST_F(SharedBufferQueue_GTest, erase) {
     ASSERT_TRUE(have_been_freed[1]);
     ASSERT_TRUE(shared_queue.empty());
 }
+
+TEST_F(SharedBufferQueue_GTest, for_each_range) {
+    using IntBuffer = std::vector<int>;
+
+    // GIVEN a shared buffer queue built upon two shared integer buffers [0, 1, 2, 3, 4] and [5, 6, 7, 8, 9, 10]
+    auto b1 = std::make_shared<IntBuffer>(IntBuffer{0, 1, 2, 3, 4});
+    auto b2 = std::make_shared<IntBuffer>(IntBuffer{5, 6, 7, 8, 9, 10});
+
+    Metavision::SharedBufferQueue<int> shared_queue;
+    shared_queue.insert(b1);
+    shared_queue.insert(b2);
+
+    // WHEN we clean the first 3 elements and visit the chunks of the queue
+    shared_queue.erase_up_to(std::find(shared_queue.cbegin(), shared_queue.cend(), 3));
+
+    std::vector<std::shared_ptr<const IntBuffer>> buffers;
+    std::vector<int> values;
+    shared_queue.for_each_range([&](const std::shared_ptr<const IntBuffer> &buffer, const int *first, const int *last) {
+        buffers.push_back(buffer);
+        values.insert(values.end(), first, last);
+    });
+
+    // THEN
+    // - there is one chunk per internal buffer, in order
+    // - the chunks point to the internal buffers, the first one being truncated
+    // - concatenating the chunks gives the content of the queue
+    ASSERT_EQ(2, buffers.size());
+    ASSERT_EQ(b1, buffers[0]);
+    ASSERT_EQ(b2, buffers[1]);
+    ASSERT_EQ(std::vector<int>({3, 4, 5, 6, 7, 8, 9, 10}), values);
+    ASSERT_TRUE(std::equal(shared_queue.cbegin(), shared_queue.cend(), values.cbegin()));
+}
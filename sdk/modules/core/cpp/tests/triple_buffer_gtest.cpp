@@ -0,0 +1,100 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/triple_buffer.h"
+
+using namespace Metavision;
+
+TEST(TripleBuffer_GTest, no_update_before_publish) {
+    // GIVEN a triple buffer initialized with a value
+    TripleBuffer<int> buffer(-1);
+
+    // WHEN nothing has been published
+    // THEN there is no update and the read buffer holds the initial value
+    EXPECT_FALSE(buffer.has_update());
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(-1, buffer.read_buffer());
+}
+
+TEST(TripleBuffer_GTest, update_fetches_latest_published_value) {
+    // GIVEN a triple buffer
+    TripleBuffer<int> buffer;
+
+    // WHEN publishing several values before the consumer fetches them
+    for (int i = 0; i < 5; ++i) {
+        buffer.write_buffer() = i;
+        buffer.publish();
+    }
+
+    // THEN only the latest one is fetched, once
+    EXPECT_TRUE(buffer.has_update());
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(4, buffer.read_buffer());
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(4, buffer.read_buffer());
+}
+
+TEST(TripleBuffer_GTest, producer_and_consumer_never_share_a_buffer) {
+    // GIVEN a triple buffer
+    TripleBuffer<int> buffer;
+
+    for (int i = 0; i < 10; ++i) {
+        // WHEN alternatively publishing and fetching values
+        buffer.write_buffer() = i;
+        buffer.publish();
+        ASSERT_TRUE(buffer.update());
+
+        // THEN the buffers of the producer and the consumer are always different
+        EXPECT_NE(&buffer.write_buffer(), &buffer.read_buffer());
+        EXPECT_EQ(i, buffer.read_buffer());
+    }
+}
+
+TEST(TripleBuffer_GTest, concurrent_producer_and_consumer) {
+    // GIVEN a triple buffer exchanging vectors filled with a single value
+    TripleBuffer<std::vector<int>> buffer;
+    const int n_values   = 20000;
+    const size_t n_elems = 256;
+
+    // WHEN a producer publishes increasing values while a consumer fetches them
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        for (int i = 1; i <= n_values; ++i) {
+            auto &values = buffer.write_buffer();
+            values.assign(n_elems, i);
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    // THEN the consumer only sees complete values, in increasing order, and eventually the last one
+    int last_value = 0;
+    while (!done || buffer.has_update()) {
+        if (!buffer.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto &values = buffer.read_buffer();
+        ASSERT_EQ(n_elems, values.size());
+        for (auto v : values) {
+            ASSERT_EQ(values.front(), v);
+        }
+        ASSERT_GT(values.front(), last_value);
+        last_value = values.front();
+    }
+    producer.join();
+    EXPECT_EQ(n_values, last_value);
+}
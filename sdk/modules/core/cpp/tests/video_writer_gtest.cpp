@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/sdk/core/utils/video_writer.h"
+
+using namespace Metavision;
+
+class VideoWriter_GTest : public GTestWithTmpDir {
+protected:
+    // Encodes the frames with the given number of stripes and returns the content of the resulting file
+    std::vector<char> encode(const std::vector<cv::Mat> &frames, int nstripes, const std::string &filename) {
+        const std::string path = tmpdir_handler_->get_full_path(filename);
+        {
+            VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30, frames.front().size(),
+                               frames.front().channels() == 3);
+            EXPECT_TRUE(writer.isOpened());
+            EXPECT_TRUE(writer.set(cv::VIDEOWRITER_PROP_NSTRIPES, nstripes));
+            for (const auto &frame : frames) {
+                writer.write(frame);
+            }
+        }
+        std::ifstream ifs(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    static std::vector<cv::Mat> make_frames(int width, int height, int type, int n) {
+        std::mt19937 rng(42);
+        std::vector<cv::Mat> frames;
+        for (int i = 0; i < n; ++i) {
+            cv::Mat frame(height, width, type);
+            // mix of smooth gradients and noise, so that codes of all lengths are produced
+            cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+            frame.rowRange(0, height / 2).setTo(cv::Scalar::all(rng() % 256));
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+};
+
+TEST_F(VideoWriter_GTest, striped_encoding_is_bit_exact_color) {
+    // GIVEN color frames, whose height is not a multiple of the MCU height
+    const auto frames = make_frames(640, 483, CV_8UC3, 5);
+
+    // WHEN encoding them with one and several stripes
+    const auto ref = encode(frames, 1, "ref.avi");
+    ASSERT_FALSE(ref.empty());
+
+    // THEN the encoded files are identical
+    for (int nstripes : {2, 3, 4, 7, 16, 1000}) {
+        EXPECT_EQ(ref, encode(frames, nstripes, "striped_" + std::to_string(nstripes) + ".avi"));
+    }
+}
+
+TEST_F(VideoWriter_GTest, striped_encoding_is_bit_exact_gray) {
+    // GIVEN grayscale frames
+    const auto frames = make_frames(321, 240, CV_8UC1, 5);
+
+    // WHEN encoding them with one and several stripes
+    const auto ref = encode(frames, 1, "ref.avi");
+    ASSERT_FALSE(ref.empty());
+
+    // THEN the encoded files are identical
+    for (int nstripes : {2, 5, 8, 30}) {
+        EXPECT_EQ(ref, encode(frames, nstripes, "striped_" + std::to_string(nstripes) + ".avi"));
+    }
+}
+
+TEST_F(VideoWriter_GTest, decreasing_number_of_stripes_between_frames) {
+    // GIVEN a writer encoding a first frame with many stripes
+    const auto frames = make_frames(320, 240, CV_8UC3, 2);
+    const auto ref    = encode(frames, 1, "ref.avi");
+
+    const std::string path = tmpdir_handler_->get_full_path("changing.avi");
+    {
+        VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30, frames.front().size(), true);
+        ASSERT_TRUE(writer.isOpened());
+        writer.set(cv::VIDEOWRITER_PROP_NSTRIPES, 8);
+        writer.write(frames[0]);
+
+        // WHEN encoding the next frame with less stripes
+        writer.set(cv::VIDEOWRITER_PROP_NSTRIPES, 2);
+        writer.write(frames[1]);
+    }
+
+    // THEN the output is the same as when encoding sequentially
+    std::ifstream ifs(path, std::ios::binary);
+    EXPECT_EQ(ref, std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()));
+}
@@ -12,6 +12,7 @@
 #include <pybind11/stl.h>
 
 #include "metavision/utils/pybind/py_array_to_cv_mat.h"
+#include "metavision/utils/pybind/rolling_event_buffer.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
 #include "metavision/sdk/core/utils/rolling_event_buffer.h"
 #include "metavision/sdk/base/events/event_cd.h"
@@ -33,16 +34,22 @@ void generate_frame_from_event_array(const py::array_t<EventCD> &events, py::arr
     }
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<EventCD *>(info.ptr);
+
+    py::gil_scoped_release release;
     BaseFrameGenerationAlgorithm::generate_frame_from_events(in_ptr, in_ptr + nelem, img_cv, accumulation_time_us,
                                                              palette);
 }
 
-void generate_frame_from_event_rolling_buffer(const RollingEventBuffer<EventCD> &events, py::array &frame,
-                                              uint32_t accumulation_time_us, const Metavision::ColorPalette &palette) {
+void generate_frame_from_event_rolling_buffer(const std::shared_ptr<RollingEventBuffer<EventCD>> &events,
+                                              py::array &frame, uint32_t accumulation_time_us,
+                                              const Metavision::ColorPalette &palette) {
     cv::Mat img_cv;
     Metavision::py_array_to_cv_mat(frame, img_cv, true);
 
-    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), img_cv,
+    // the read lock prevents other python threads from modifying the rolling buffer while the GIL is released
+    detail::RollingEventBufferReadLock<EventCD> lock(events);
+    py::gil_scoped_release release;
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events->cbegin(), events->cend(), img_cv,
                                                              accumulation_time_us, palette);
 }
 
@@ -106,7 +113,10 @@ void export_base_frame_generation_algorithm(py::module &m) {
         "input"
         " event source, and the color corresponding to the given palette (3 channels by default)\n"
         "   :accumulation_time_us: Time range of events to update the frame with (in us). 0 to use all events.\n"
-        "   :palette: The Prophesee's color palette to use";
+        "   :palette: The Prophesee's color palette to use\n"
+        "\n"
+        "   The GIL is released while the frame is generated, so this method can be called from several threads in "
+        "parallel as long as each call uses a distinct frame";
 
     py::class_<BaseFrameGenerationAlgorithm>(m, "BaseFrameGenerationAlgorithm")
         .def_static("generate_frame", &generate_frame_from_event_array, py::arg("events"), py::arg("frame"),
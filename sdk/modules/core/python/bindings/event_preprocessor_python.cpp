@@ -23,6 +23,12 @@
 
 #include "pb_doc_core.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
@@ -140,9 +146,81 @@ void EventPreprocessorArray_process_events_array(const EventPreprocessorArray &c
 
     Metavision::Tensor t(cdproc.get_output_shape(), cdproc.get_output_type(),
                          reinterpret_cast<std::byte *>(info_frame.ptr), false);
+
+    py::gil_scoped_release release;
     cdproc.process_events(cur_frame_start_ts, events_ptr, events_ptr + nb_events, t);
 }
 
+void EventPreprocessorArray_process_many(const EventPreprocessorArray &cdproc,
+                                         const std::vector<Metavision::timestamp> &cur_frame_start_ts,
+                                         const std::vector<py::array_t<Metavision::EventCD>> &events,
+                                         std::vector<py::array> &frames_np, unsigned int num_threads) {
+    if (cur_frame_start_ts.size() != events.size() || events.size() != frames_np.size()) {
+        std::ostringstream oss;
+        oss << "Lists should have the same size. Got " << cur_frame_start_ts.size() << " timestamps, "
+            << events.size() << " event arrays and " << frames_np.size() << " frames" << std::endl;
+        throw std::runtime_error(oss.str());
+    }
+
+    // all the python objects are accessed upfront, with the GIL held. The buffer infos keep the arrays from being
+    // resized while the GIL is released
+    const size_t n = events.size();
+    std::vector<py::buffer_info> infos_events, infos_frames;
+    std::vector<Metavision::Tensor> tensors;
+    infos_events.reserve(n);
+    infos_frames.reserve(n);
+    tensors.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        infos_events.emplace_back(events[i].request());
+        if (infos_events.back().ndim != 1) {
+            throw std::runtime_error("Wrong events dim");
+        }
+        EventPreprocessorArray_check_output_frame_validity(cdproc, frames_np[i]);
+        infos_frames.emplace_back(frames_np[i].request());
+        tensors.emplace_back(cdproc.get_output_shape(), cdproc.get_output_type(),
+                             reinterpret_cast<std::byte *>(infos_frames.back().ptr), false);
+    }
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = static_cast<unsigned int>(std::min<size_t>(num_threads, n));
+
+    py::gil_scoped_release release;
+
+    // EventPreprocessor::process_events is const, so the arrays can be dispatched to the threads in any order
+    std::atomic<size_t> next_idx{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const auto process = [&]() {
+        for (size_t i = next_idx++; i < n; i = next_idx++) {
+            try {
+                const auto events_ptr = static_cast<Metavision::EventCD *>(infos_events[i].ptr);
+                const auto nb_events  = infos_events[i].shape[0];
+                cdproc.process_events(cur_frame_start_ts[i], events_ptr, events_ptr + nb_events, tensors[i]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < num_threads; ++i) {
+        threads.emplace_back(process);
+    }
+    process();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
 template<typename T>
 py::array_t<T> produce_array(const Metavision::TensorShape &shape, const Metavision::BaseType type) {
     const auto &dimensions = shape.dimensions;
@@ -277,6 +355,14 @@ void export_event_preprocessor(py::module &m) {
         .def("process_events", &EventPreprocessorArray_process_events_array, py::arg("cur_frame_start_ts"),
              py::arg("events_np"), py::arg("frame_tensor_np"),
              "Takes a chunk of events (numpy array of EventCD) and updates the frame_tensor (numpy array of float)")
+        .def("process_many", &EventPreprocessorArray_process_many, py::arg("cur_frame_start_ts"),
+             py::arg("events_np_list"), py::arg("frame_tensor_np_list"), py::arg("num_threads") = 0,
+             "Takes lists of chunks of events (numpy arrays of EventCD) and updates the corresponding frame_tensors "
+             "(numpy arrays of float) in parallel, with the GIL released.\n"
+             "    :cur_frame_start_ts: list of the starting timestamps of the frames\n"
+             "    :events_np_list: list of chunks of events\n"
+             "    :frame_tensor_np_list: list of frame tensors to update, one per chunk of events\n"
+             "    :num_threads: number of threads to use, 0 to use as many threads as available cores")
         .def(
             "get_frame_size",
             [](const EventPreprocessorArray &cdproc) { return cdproc.get_output_shape().get_nb_values(); },
@@ -19,7 +19,12 @@
 namespace Metavision {
 
 void export_events_integration_algorithm(py::module &m) {
-    py::class_<EventsIntegrationAlgorithm>(m, "EventsIntegrationAlgorithm")
+    py::class_<EventsIntegrationAlgorithm>(
+        m, "EventsIntegrationAlgorithm",
+        "Algorithm that integrates events into a grayscale frame.\n\n"
+        "Instances are not thread-safe: a given instance must not be used from several threads at the same time. The "
+        "GIL is released while events are processed and while frames are generated, so distinct instances can run in "
+        "parallel from several python threads.")
         .def(py::init<unsigned int, unsigned int, Metavision::timestamp, float, float, int, int, float>(),
              py::arg("width"), py::arg("height"), py::arg("decay_time") = 1'000'000, py::arg("contrast_on") = 1.2f,
              py::arg("contrast_off") = -1.f, py::arg("tonemapping_max_ev_count") = 5,
@@ -36,6 +41,7 @@ void export_events_integration_algorithm(py::module &m) {
                 cv::Mat img_cv;
                 Metavision::py_array_to_cv_mat(frame, img_cv, false);
 
+                py::gil_scoped_release release;
                 return algo.generate(img_cv);
             },
             py::arg("frame"), pybind_doc_core["Metavision::EventsIntegrationAlgorithm::generate"])
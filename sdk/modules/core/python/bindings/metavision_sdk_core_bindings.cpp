@@ -63,6 +63,7 @@ void export_shared_cd_events_buffer_producer(py::module &);
 void export_stream_logger_algorithm(py::module &);
 void export_transpose_events_algorithm(py::module &);
 void export_rolling_event_cd_buffer(py::module &);
+void export_shared_event_cd_buffer_queue(py::module &);
 } // namespace Metavision
 
 PYBIND11_MODULE(MODULE_NAME, m) {
@@ -108,4 +109,5 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 
     // 4. Export utils
     Metavision::export_rolling_event_cd_buffer(m);
+    Metavision::export_shared_event_cd_buffer_queue(m);
 }
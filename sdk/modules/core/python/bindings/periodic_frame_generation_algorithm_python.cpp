@@ -41,11 +41,18 @@ void export_periodic_frame_generation_algorithm(py::module &m) {
              "input events (@ref set_fps) \n"
              "    palette (ColorPalette): The Prophesee's color palette to use (@ref set_color_palette)\n"
              "@throw std::invalid_argument If the input fps is not positive or if the input accumulation time is not "
-             "strictly positive\n")
+             "strictly positive\n"
+             "\n"
+             "Instances are not thread-safe: a given instance must not be used from several threads at the same "
+             "time. The GIL is released while events are processed and only reacquired to call the output callback, "
+             "so distinct instances can run in parallel from several python threads.\n")
         .def(
             "set_output_callback",
             [](PeriodicFrameGenerationAlgorithm &algo, const py::object &object) {
                 PeriodicFrameGenerationAlgorithm::OutputCb cb = [object](timestamp ts, cv::Mat &mat) {
+                    // process_events releases the GIL, it must be reacquired before touching any python object
+                    py::gil_scoped_acquire acquire;
+
                     auto frame = frame_pool.acquire();
                     cv::swap(*frame, mat);
 
@@ -38,23 +38,23 @@ void RawEventFrameConverter_set_CHW_helper(RawEventFrameConverter &frame_convert
 
 py::array_t<int8_t> RawEventFrameConverter_convert_diff_to_int8(const RawEventFrameConverter &frame_converter,
                                                                 const RawEventFrameDiff &d) {
-    std::unique_ptr<EventFrameDiff<int8_t>> frame = frame_converter.convert<int8_t>(d);
-    assert(frame->get_size() == frame_converter.get_height() * frame_converter.get_width());
     std::vector<py::ssize_t> shape = {frame_converter.get_height(), frame_converter.get_width()};
-    return py::array_t<int8_t>(shape, frame->get_data().data());
+    py::array_t<int8_t> frame(shape);
+    frame_converter.convert(d, frame.mutable_data());
+    return frame;
 }
 
 py::array_t<uint8_t> RawEventFrameConverter_convert_histo_to_uint8(const RawEventFrameConverter &frame_converter,
                                                                    const RawEventFrameHisto &h) {
-    std::unique_ptr<EventFrameHisto<uint8_t>> frame = frame_converter.convert<uint8_t>(h);
-    assert(frame->get_size() == 2 * frame_converter.get_height() * frame_converter.get_width());
     std::vector<py::ssize_t> shape;
     if (frame_converter.get_format() == HistogramFormat::HWC) {
         shape = {frame_converter.get_height(), frame_converter.get_width(), 2};
     } else {
         shape = {2, frame_converter.get_height(), frame_converter.get_width()};
     }
-    return py::array_t<uint8_t>(shape, frame->get_data().data());
+    py::array_t<uint8_t> frame(shape);
+    frame_converter.convert(h, frame.mutable_data());
+    return frame;
 }
 
 void export_raw_event_frame_converter(py::module &m) {
@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/shared_buffer_queue.h"
+
+#include "pb_doc_core.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace {
+
+using SharedEventCDBufferQueue = SharedBufferQueue<EventCD>;
+
+struct SharedBufferHolder {
+    SharedEventCDBufferQueue::SharedBuffer ptr;
+};
+
+void insert_numpy_array(SharedEventCDBufferQueue &queue, const py::array_t<EventCD> &in) {
+    auto info = in.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array");
+    }
+    const auto *in_ptr = static_cast<const EventCD *>(info.ptr);
+    const auto nelem   = static_cast<size_t>(info.shape[0]);
+
+    // the queue only holds immutable buffers, so the events are copied once here and are then shared without copy
+    queue.insert(std::make_shared<const std::vector<EventCD>>(in_ptr, in_ptr + nelem));
+}
+
+void erase_up_to(SharedEventCDBufferQueue &queue, size_t n) {
+    if (n >= queue.size()) {
+        queue.clear();
+    } else {
+        queue.erase_up_to(queue.cbegin() + static_cast<std::ptrdiff_t>(n));
+    }
+}
+
+py::list ranges(const SharedEventCDBufferQueue &queue) {
+    py::list views;
+    queue.for_each_range([&views](const SharedEventCDBufferQueue::SharedBuffer &buffer, const EventCD *first,
+                                  const EventCD *last) {
+        // each view keeps its own shared buffer alive, so it stays valid even after being erased from the queue
+        auto holder = new SharedBufferHolder{buffer};
+        py::capsule capsule(holder, [](void *v) { delete reinterpret_cast<SharedBufferHolder *>(v); });
+        py::array_t<EventCD> view(static_cast<size_t>(last - first), first, capsule);
+        py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+        views.append(std::move(view));
+    });
+    return views;
+}
+
+} // namespace
+
+void export_shared_event_cd_buffer_queue(py::module &m) {
+    py::class_<SharedEventCDBufferQueue, std::shared_ptr<SharedEventCDBufferQueue>>(
+        m, "SharedEventCDBufferQueue",
+        "Read-only FIFO of EventCD made of a list of immutable shared buffers.\n\n"
+        "The content of the queue can be retrieved without copy, as a list of numpy arrays (one per buffer).")
+        .def(py::init<>())
+        .def("insert", &insert_numpy_array, py::arg("events_np"),
+             "Inserts a new buffer of events at the end of the queue.\n"
+             "    :events_np: input chunk of events. It is copied once into an immutable buffer that is then shared "
+             "with the arrays returned by ranges()\n")
+        .def("erase_up_to", &erase_up_to, py::arg("n"),
+             "Erases the n first events of the queue. The buffers that are no longer used are released.\n"
+             "    :n: number of events to erase\n")
+        .def("clear", &SharedEventCDBufferQueue::clear, pybind_doc_core["Metavision::SharedBufferQueue::clear"])
+        .def("empty", &SharedEventCDBufferQueue::empty, pybind_doc_core["Metavision::SharedBufferQueue::empty"])
+        .def("size", &SharedEventCDBufferQueue::size, pybind_doc_core["Metavision::SharedBufferQueue::size"])
+        .def("__len__", &SharedEventCDBufferQueue::size)
+        .def("ranges", &ranges,
+             "Returns the content of the queue as a list of read-only numpy arrays, one per internal buffer, sharing "
+             "the buffers' memory (no copy is done). Each array keeps its buffer alive, so it remains valid even "
+             "after the events have been erased from the queue.\n");
+}
+
+} // namespace Metavision
@@ -32,6 +32,9 @@ struct Memo {
 
 static BufferCallback python_callback_wrapper(py::object object) {
     BufferCallback gil_cb = [object](timestamp end_ts, const EventsBufferPtr &buffer) {
+        // process_events releases the GIL, it must be reacquired before creating any python object
+        py::gil_scoped_acquire acquire;
+
         auto memo = new Memo();
         memo->ptr = buffer; // copy of the shared ptr
         // this capsule contains a copy of the event buffers shared pointer, that will be destroyed
@@ -40,7 +43,6 @@ static BufferCallback python_callback_wrapper(py::object object) {
         // we reinterpret the vector as a numpy array
         auto py_array = py::array_t<Metavision::EventCD>(buffer->size(), buffer->data(), capsule);
 
-        py::gil_scoped_acquire acquire;
         // actual python call
         object(end_ts, py_array);
     };
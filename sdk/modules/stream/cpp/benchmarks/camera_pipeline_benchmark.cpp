@@ -0,0 +1,459 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+#if defined(__linux__)
+#elif !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "metavision/hal/utils/buffer_memory.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/stream/camera.h"
+#include "metavision/sdk/stream/camera_stream_slicer.h"
+#include "metavision/sdk/stream/file_config_hints.h"
+#include "metavision/sdk/stream/hdf5_event_file_writer.h"
+#include "metavision/sdk/stream/raw_evt2_event_file_writer.h"
+
+using namespace Metavision;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kWidth  = 1280;
+constexpr int kHeight = 720;
+
+// Parameters of the frame generation stages
+constexpr std::uint32_t kAccumulationTimeUs = 10000;
+constexpr double kFps                       = 100.;
+
+/// @brief Sweeps of the pipeline parameters, overridable from the command line
+struct Sweeps {
+    std::vector<std::int64_t> max_read_per_op_kib = {64, 1024, 4096};
+    std::vector<std::int64_t> max_memory_mib      = {12, 48};
+    std::vector<std::int64_t> num_callbacks       = {1, 4};
+};
+
+struct InputFile {
+    std::string name;
+    std::filesystem::path path;
+    /// Whether the FileConfigHints affect the reading of the file, false for HDF5 files
+    bool uses_read_hints;
+};
+
+struct SliceConditionSpec {
+    std::string name;
+    CameraStreamSlicer::SliceCondition condition;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Peak resident set size
+//
+// On Linux the peak is reset before each benchmark, on the other platforms it is the peak of the whole process.
+#if defined(__linux__)
+bool reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    return static_cast<bool>(clear_refs << "5" << std::flush);
+}
+
+std::size_t get_peak_rss_bytes() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoull(line.substr(6)) * 1024;
+        }
+    }
+    return 0;
+}
+#elif !defined(_WIN32)
+bool reset_peak_rss() {
+    return false;
+}
+
+std::size_t get_peak_rss_bytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024;
+#endif
+}
+#else
+bool reset_peak_rss() {
+    return false;
+}
+
+std::size_t get_peak_rss_bytes() {
+    return 0;
+}
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// Input files
+
+/// @brief Writes a deterministic stream of CD events, a vertical edge sweeping the sensor over uniform noise
+void write_synthetic_events(EventFileWriter &writer, std::size_t num_events, double events_per_us) {
+    constexpr std::size_t kBatchSize = 100000;
+    constexpr int kEdgeSpeedUsPerPx  = 100;
+    constexpr int kEdgeWidth         = 3;
+
+    std::mt19937 mt(42);
+    std::vector<EventCD> events;
+    events.reserve(kBatchSize);
+    for (std::size_t i = 0; i < num_events; ++i) {
+        const auto t = static_cast<timestamp>(i / events_per_us);
+        // 70% of the events are on the edge, the others are noise
+        const bool on_edge = mt() % 10 < 7;
+        const auto x       = on_edge ? (t / kEdgeSpeedUsPerPx + mt() % kEdgeWidth) % kWidth : mt() % kWidth;
+        events.emplace_back(static_cast<unsigned short>(x), static_cast<unsigned short>(mt() % kHeight),
+                            static_cast<short>(on_edge ? 1 : mt() & 1), t);
+        if (events.size() == kBatchSize || i + 1 == num_events) {
+            writer.add_events(events.data(), events.data() + events.size());
+            events.clear();
+        }
+    }
+    writer.close();
+}
+
+std::vector<InputFile> generate_input_files(const std::filesystem::path &dir, std::size_t num_events,
+                                            double events_per_us) {
+    std::filesystem::create_directories(dir);
+    std::vector<InputFile> files;
+
+    const auto raw_path = dir / "synthetic_evt2.raw";
+    RAWEvt2EventFileWriter raw_writer(kWidth, kHeight, raw_path);
+    write_synthetic_events(raw_writer, num_events, events_per_us);
+    files.push_back({"raw", raw_path, true});
+
+#ifdef HAS_HDF5
+    const auto hdf5_path = dir / "synthetic.hdf5";
+    HDF5EventFileWriter hdf5_writer(hdf5_path, {{"geometry", std::to_string(kWidth) + "x" + std::to_string(kHeight)}});
+    write_synthetic_events(hdf5_writer, num_events, events_per_us);
+    files.push_back({"hdf5", hdf5_path, false});
+#endif
+    return files;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Pipelines
+
+Camera open_camera(const InputFile &file, const benchmark::State &state, std::chrono::nanoseconds &open_time) {
+    const auto start        = Clock::now();
+    FileConfigHints hints   = FileConfigHints().real_time_playback(false);
+    hints.max_read_per_op(static_cast<std::size_t>(state.range(0)) * 1024);
+    hints.max_memory(static_cast<std::size_t>(state.range(1)) * 1024 * 1024);
+    auto camera = Camera::from_file(file.path, hints);
+    open_time += Clock::now() - start;
+    return camera;
+}
+
+void wait_end_of_file(Camera &camera) {
+    while (camera.is_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    camera.stop();
+}
+
+/// @brief Sets the counters shared by all the pipelines
+///
+/// The memory access counters cover all the iterations, including the threads of the cameras created after the probe,
+/// and are only reported when they are available on this system.
+void set_counters(benchmark::State &state, std::uint64_t num_events,
+                  const std::vector<std::pair<std::string, std::chrono::nanoseconds>> &stage_times,
+                  const MemoryAccessProbe &probe) {
+    if (num_events == 0) {
+        state.SkipWithError("No event read from the file");
+        return;
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(num_events));
+    state.counters["events"] = benchmark::Counter(static_cast<double>(num_events), benchmark::Counter::kAvgIterations);
+    state.counters["Mev/s"]  = benchmark::Counter(num_events * 1e-6, benchmark::Counter::kIsRate);
+    for (const auto &stage_time : stage_times) {
+        state.counters[stage_time.first + "_ms"] = benchmark::Counter(
+            std::chrono::duration<double, std::milli>(stage_time.second).count(), benchmark::Counter::kAvgIterations);
+    }
+    state.counters["peak_rss_MiB"] = static_cast<double>(get_peak_rss_bytes()) / (1024 * 1024);
+
+    const auto memory_accesses                                    = probe.read();
+    const std::pair<const char *, std::int64_t> memory_counters[] = {
+        {"minor_page_faults", memory_accesses.minor_page_faults},
+        {"major_page_faults", memory_accesses.major_page_faults},
+        {"dtlb_load_misses", memory_accesses.dtlb_load_misses},
+    };
+    for (const auto &counter : memory_counters) {
+        if (counter.second >= 0) {
+            state.counters[counter.first] =
+                benchmark::Counter(static_cast<double>(counter.second), benchmark::Counter::kAvgIterations);
+        }
+    }
+}
+
+/// @brief Camera -> CD callbacks, measures the reading, decoding and dispatching of the events
+void camera_callbacks(benchmark::State &state, const InputFile &file) {
+    reset_peak_rss();
+    const auto num_callbacks = state.range(2);
+    const MemoryAccessProbe probe(true);
+
+    std::uint64_t num_events = 0;
+    std::chrono::nanoseconds open_time{0}, stream_time{0}, callbacks_time{0};
+    for (auto _ : state) {
+        auto camera = open_camera(file, state, open_time);
+
+        std::vector<std::uint64_t> polarity_sums(num_callbacks, 0);
+        for (std::int64_t i = 0; i < num_callbacks; ++i) {
+            camera.cd().add_callback([&, i](const EventCD *begin, const EventCD *end) {
+                const auto start = Clock::now();
+                if (i == 0) {
+                    num_events += end - begin;
+                }
+                // Touches all the events, as a typical callback would
+                for (auto it = begin; it != end; ++it) {
+                    polarity_sums[i] += it->p;
+                }
+                callbacks_time += Clock::now() - start;
+            });
+        }
+
+        const auto start = Clock::now();
+        camera.start();
+        wait_end_of_file(camera);
+        stream_time += Clock::now() - start;
+        benchmark::DoNotOptimize(polarity_sums.data());
+    }
+
+    set_counters(state, num_events, {{"open", open_time}, {"stream", stream_time}, {"callbacks", callbacks_time}},
+                 probe);
+}
+
+/// @brief Camera -> CD callback -> periodic frame generation
+void camera_frame_generation(benchmark::State &state, const InputFile &file) {
+    reset_peak_rss();
+    const MemoryAccessProbe probe(true);
+
+    std::uint64_t num_events = 0, num_frames = 0;
+    std::chrono::nanoseconds open_time{0}, stream_time{0}, frame_generation_time{0};
+    for (auto _ : state) {
+        auto camera          = open_camera(file, state, open_time);
+        const auto &geometry = camera.geometry();
+
+        PeriodicFrameGenerationAlgorithm frame_generation(geometry.get_width(), geometry.get_height(),
+                                                          kAccumulationTimeUs, kFps);
+        frame_generation.set_output_callback([&](timestamp, cv::Mat &) { ++num_frames; });
+        camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+            const auto start = Clock::now();
+            num_events += end - begin;
+            frame_generation.process_events(begin, end);
+            frame_generation_time += Clock::now() - start;
+        });
+
+        const auto start = Clock::now();
+        camera.start();
+        wait_end_of_file(camera);
+        stream_time += Clock::now() - start;
+    }
+
+    set_counters(state, num_events,
+                 {{"open", open_time}, {"stream", stream_time}, {"frame_generation", frame_generation_time}}, probe);
+    state.counters["frames/s"] = benchmark::Counter(static_cast<double>(num_frames), benchmark::Counter::kIsRate);
+}
+
+/// @brief Camera -> CameraStreamSlicer -> frame generation of each slice
+void camera_stream_slicer(benchmark::State &state, const InputFile &file,
+                          const CameraStreamSlicer::SliceCondition &condition) {
+    reset_peak_rss();
+    const MemoryAccessProbe probe(true);
+
+    std::uint64_t num_events = 0, num_slices = 0;
+    std::chrono::nanoseconds open_time{0}, slicing_wait_time{0}, frame_generation_time{0};
+    cv::Mat frame;
+    for (auto _ : state) {
+        CameraStreamSlicer slicer(open_camera(file, state, open_time), condition);
+
+        // The time spent waiting for the slices includes the start of the camera
+        auto last = Clock::now();
+        for (const auto &slice : slicer) {
+            const auto slice_time = Clock::now();
+            slicing_wait_time += slice_time - last;
+
+            num_events += slice.n_events;
+            ++num_slices;
+            frame.create(kHeight, kWidth, CV_8UC3);
+            BaseFrameGenerationAlgorithm::generate_frame_from_events(slice.events->cbegin(), slice.events->cend(),
+                                                                     frame);
+
+            last = Clock::now();
+            frame_generation_time += last - slice_time;
+        }
+    }
+
+    set_counters(state, num_events,
+                 {{"open", open_time},
+                  {"slicing_wait", slicing_wait_time},
+                  {"frame_generation", frame_generation_time}},
+                 probe);
+    state.counters["slices/s"] = benchmark::Counter(static_cast<double>(num_slices), benchmark::Counter::kIsRate);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Registration
+
+benchmark::internal::Benchmark *configure(benchmark::internal::Benchmark *b, const InputFile &file,
+                                          const Sweeps &sweeps, const std::vector<std::int64_t> &num_callbacks) {
+    // The hints are ignored by the readers of some formats, there is no need to sweep them
+    const std::vector<std::int64_t> default_read = {4096}, default_memory = {12};
+    b->ArgNames({"max_read_per_op_kib", "max_memory_mib", "callbacks"})
+        ->ArgsProduct({file.uses_read_hints ? sweeps.max_read_per_op_kib : default_read,
+                       file.uses_read_hints ? sweeps.max_memory_mib : default_memory, num_callbacks})
+        // The pipelines run in the background threads of the camera: the wall clock time and the CPU time of all the
+        // threads are the relevant measures
+        ->UseRealTime()
+        ->MeasureProcessCPUTime()
+        ->Unit(benchmark::kMillisecond);
+    return b;
+}
+
+void register_benchmarks(const InputFile &file, const Sweeps &sweeps) {
+    configure(benchmark::RegisterBenchmark(("CameraCallbacks/" + file.name).c_str(),
+                                           [file](benchmark::State &state) { camera_callbacks(state, file); }),
+              file, sweeps, sweeps.num_callbacks);
+
+    configure(benchmark::RegisterBenchmark(("CameraFrameGeneration/" + file.name).c_str(),
+                                           [file](benchmark::State &state) { camera_frame_generation(state, file); }),
+              file, sweeps, {1});
+
+    const std::vector<SliceConditionSpec> conditions = {
+        {"n_us:1000", CameraStreamSlicer::SliceCondition::make_n_us(1000)},
+        {"n_us:10000", CameraStreamSlicer::SliceCondition::make_n_us(10000)},
+        {"n_events:10000", CameraStreamSlicer::SliceCondition::make_n_events(10000)},
+        {"n_events:100000", CameraStreamSlicer::SliceCondition::make_n_events(100000)},
+        {"mixed:10000:100000", CameraStreamSlicer::SliceCondition::make_mixed(10000, 100000)},
+    };
+    for (const auto &spec : conditions) {
+        const auto condition = spec.condition;
+        configure(benchmark::RegisterBenchmark(
+                      ("CameraStreamSlicer/" + file.name + "/" + spec.name).c_str(),
+                      [file, condition](benchmark::State &state) { camera_stream_slicer(state, file, condition); }),
+                  file, sweeps, {1});
+    }
+}
+
+std::vector<std::int64_t> parse_list(const std::string &value) {
+    std::vector<std::int64_t> values;
+    std::istringstream iss(value);
+    for (std::string token; std::getline(iss, token, ',');) {
+        values.push_back(std::stoll(token));
+    }
+    if (values.empty()) {
+        throw std::invalid_argument("Empty list of values");
+    }
+    return values;
+}
+
+void print_usage(const char *program) {
+    std::cerr
+        << "Usage: " << program << " [benchmark options] [options]" << std::endl
+        << std::endl
+        << "  --input_file=<path>             Also benchmarks the pipelines on this RAW or HDF5 file" << std::endl
+        << "  --num_events=<n>                Number of events in the generated files (default 5000000)" << std::endl
+        << "  --events_per_us=<r>             Event rate of the generated files (default 10)" << std::endl
+        << "  --max_read_per_op_kib=<n,...>   Values of FileConfigHints::max_read_per_op to sweep (default "
+           "64,1024,4096)"
+        << std::endl
+        << "  --max_memory_mib=<n,...>        Values of FileConfigHints::max_memory to sweep (default 12,48)"
+        << std::endl
+        << "  --num_callbacks=<n,...>         Numbers of CD callbacks to sweep (default 1,4)" << std::endl
+        << "  --work_dir=<path>               Directory of the generated files (default: temporary directory)"
+        << std::endl
+        << std::endl
+        << "Use --benchmark_out=<file> --benchmark_out_format=json to get machine-readable results." << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    benchmark::Initialize(&argc, argv);
+
+    Sweeps sweeps;
+    std::vector<std::string> input_files;
+    std::size_t num_events = 5000000;
+    double events_per_us   = 10.;
+    auto work_dir          = std::filesystem::temp_directory_path() / "metavision_pipeline_benchmark";
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto sep        = arg.find('=');
+            const auto key        = arg.substr(0, sep);
+            const auto value      = sep == std::string::npos ? std::string() : arg.substr(sep + 1);
+            if (value.empty()) {
+                print_usage(argv[0]);
+                return 1;
+            } else if (key == "--input_file") {
+                input_files.push_back(value);
+            } else if (key == "--num_events") {
+                num_events = std::stoull(value);
+            } else if (key == "--events_per_us") {
+                events_per_us = std::stod(value);
+            } else if (key == "--max_read_per_op_kib") {
+                sweeps.max_read_per_op_kib = parse_list(value);
+            } else if (key == "--max_memory_mib") {
+                sweeps.max_memory_mib = parse_list(value);
+            } else if (key == "--num_callbacks") {
+                sweeps.num_callbacks = parse_list(value);
+            } else if (key == "--work_dir") {
+                work_dir = value;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+
+        for (const auto &file : generate_input_files(work_dir, num_events, events_per_us)) {
+            register_benchmarks(file, sweeps);
+        }
+        for (const auto &path : input_files) {
+            const auto extension = std::filesystem::path(path).extension().string();
+            register_benchmarks({"file:" + path, path, extension == ".raw"}, sweeps);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    benchmark::AddCustomContext("generated_num_events", std::to_string(num_events));
+    benchmark::AddCustomContext("generated_events_per_us", std::to_string(events_per_us));
+    benchmark::AddCustomContext("peak_rss_per_benchmark", reset_peak_rss() ? "true" : "false");
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    std::error_code ec;
+    std::filesystem::remove_all(work_dir, ec);
+    return 0;
+}
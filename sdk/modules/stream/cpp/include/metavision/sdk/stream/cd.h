@@ -21,11 +21,20 @@
 // Definition of CallbackId
 #include "metavision/sdk/base/utils/callback_id.h"
 
+// Definition of timestamp
+#include "metavision/sdk/base/utils/timestamp.h"
+
+// Metavision HAL event decoder, defining the sinks of decoded events
+#include "metavision/hal/facilities/i_event_decoder.h"
+
 namespace Metavision {
 
 /// @brief Type alias for a callback on a buffer of @ref EventCD
 using EventsCDCallback = std::function<void(const EventCD *begin, const EventCD *end)>;
 
+/// @brief Type alias for a sink of buffers of @ref EventCD
+using EventsCDSink = I_EventDecoder<EventCD>::EventBufferSink;
+
 /// @brief Facility class to handle CD events
 class CD {
 public:
@@ -43,9 +52,35 @@ public:
     /// @return ID of the added callback
     CallbackId add_callback(const EventsCDCallback &cb);
 
+    /// @brief Subscribes a sink to CD events
+    ///
+    /// With a live camera, the sink is called directly by the events decoder, through a single virtual call per buffer
+    /// and with the batch size and latency it prefers. Otherwise, it is called like a regular callback. The events a
+    /// sink is still waiting for are delivered when the camera stops or reaches the end of its stream.
+    ///
+    /// @param sink Sink to call with the buffers of decoded events, which must outlive its registration
+    /// @return ID of the added sink, which can be removed with @ref remove_callback
+    /// @throw CameraException if the sink is to be called by the decoder of a running camera
+    /// @warning Contrary to callbacks, sinks must be added and removed while the camera is not running
+    CallbackId add_sink(EventsCDSink &sink);
+
+    /// @brief Subscribes a functor to CD events through a sink
+    ///
+    /// The functor is stored in a sink of its own type, so that its call is inlined in the processing of the buffer.
+    ///
+    /// @tparam Functor Type of a functor callable with (const EventCD *begin, const EventCD *end)
+    /// @param f Functor to call with the buffers of decoded events
+    /// @param batch_size Number of events to gather before calling the functor, 0 for the buffers as decoded
+    /// @param max_latency Maximum duration, in us, during which events can wait for a batch to be complete
+    /// @return ID of the added sink, which can be removed with @ref remove_callback
+    /// @sa @ref add_sink
+    template<typename Functor>
+    CallbackId add_typed_callback(Functor &&f, size_t batch_size = 0, timestamp max_latency = 0);
+
     /// @brief Removes a previously registered callback
     /// @param callback_id Callback ID
     /// @return true if the callback has been unregistered correctly, false otherwise.
+    /// @throw CameraException if the callback is a sink called by the decoder of a running camera
     /// @sa @ref add_callback
     bool remove_callback(CallbackId callback_id);
 
@@ -56,9 +91,12 @@ public:
 
 private:
     CD(Private *);
+    CallbackId add_owned_sink(std::unique_ptr<EventsCDSink> sink);
     std::unique_ptr<Private> pimpl_;
 };
 
 } // namespace Metavision
 
+#include "metavision/sdk/stream/detail/cd_impl.h"
+
 #endif // METAVISION_SDK_STREAM_CD_H
@@ -0,0 +1,56 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_CD_IMPL_H
+#define METAVISION_SDK_STREAM_CD_IMPL_H
+
+#include <type_traits>
+#include <utility>
+
+namespace Metavision {
+namespace detail {
+
+template<typename Functor>
+class FunctorEventsCDSink final : public EventsCDSink {
+public:
+    template<typename F>
+    FunctorEventsCDSink(F &&f, size_t batch_size, timestamp max_latency) :
+        f_(std::forward<F>(f)), batch_size_(batch_size), max_latency_(max_latency) {}
+
+    void on_event_buffer(const EventCD *begin, const EventCD *end) override {
+        f_(begin, end);
+    }
+
+    size_t get_preferred_batch_size() const override {
+        return batch_size_;
+    }
+
+    timestamp get_max_latency() const override {
+        return max_latency_;
+    }
+
+private:
+    Functor f_;
+    const size_t batch_size_;
+    const timestamp max_latency_;
+};
+
+} // namespace detail
+
+template<typename Functor>
+CallbackId CD::add_typed_callback(Functor &&f, size_t batch_size, timestamp max_latency) {
+    return add_owned_sink(std::make_unique<detail::FunctorEventsCDSink<std::decay_t<Functor>>>(
+        std::forward<Functor>(f), batch_size, max_latency));
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_CD_IMPL_H
@@ -40,6 +40,10 @@ public:
         return "max_read_per_op";
     }
 
+    static std::string get_buffer_memory_key() {
+        return "buffer_memory";
+    }
+
     /// @brief Constructor
     ///
     /// By default, if applicable, the file will be read using a maximum memory footprint of 12Mo,
@@ -107,6 +111,23 @@ public:
         return *this;
     }
 
+    /// @brief Gets the type of memory backing the read buffers (if applicable) setting
+    /// @return Type of memory, among "default", "hugepages" and "arena"
+    std::string buffer_memory() const {
+        return get<std::string>(get_buffer_memory_key(), "default");
+    }
+
+    /// @brief Named constructor for the type of memory backing the read buffers
+    ///
+    /// Huge pages reduce the page faults and TLB misses when reading large buffers. This setting can be overridden
+    /// by the MV_HAL_BUFFER_MEMORY environment variable.
+    /// @param buffer_memory Type of memory, among "default", "hugepages" and "arena"
+    /// @return FileConfigHints& Reference to the modified config
+    FileConfigHints &buffer_memory(const std::string &buffer_memory) {
+        map[get_buffer_memory_key()] = buffer_memory;
+        return *this;
+    }
+
     /// @brief Sets a value for a named key in the config dictionary
     /// @param key Key of the config
     /// @param value Value of the config
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_ROLLING_EVENT_STORE_H
+#define METAVISION_SDK_STREAM_ROLLING_EVENT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class EventFileWriter;
+
+/// @brief Rolling store keeping the most recent CD events within a strict memory budget
+///
+/// Events are appended in fixed size blocks indexed by their time range. Blocks older than the retention duration are
+/// discarded. When the blocks kept in RAM exceed the memory budget, the oldest ones are compressed and spilled to a
+/// memory mapped ring file on disk, or discarded if no spill file is configured.
+///
+/// A time window of the store (e.g. the last seconds before a trigger) can be exported to any @ref EventFileWriter
+/// while events keep being added from another thread.
+///
+/// @warning Events must be added in chronological order
+class RollingEventStore {
+public:
+    /// @brief Configuration of a @ref RollingEventStore
+    struct Config {
+        /// Duration of the history to keep, in us
+        timestamp retention_us = 60'000'000;
+
+        /// Maximum number of bytes used by the blocks kept in RAM
+        std::size_t memory_budget_bytes = 256 * 1024 * 1024;
+
+        /// Number of events per block
+        std::size_t block_num_events = 64 * 1024;
+
+        /// Path of the ring file where blocks are spilled when the memory budget is reached. If empty, blocks are
+        /// discarded instead
+        std::filesystem::path spill_path;
+
+        /// Size of the spill ring file, in bytes
+        std::size_t spill_budget_bytes = std::size_t(4) * 1024 * 1024 * 1024;
+    };
+
+    /// @brief Statistics of a @ref RollingEventStore
+    struct Statistics {
+        /// Number of bytes used by the blocks kept in RAM
+        std::size_t memory_bytes = 0;
+
+        /// Number of bytes used by the blocks spilled to disk
+        std::size_t spilled_bytes = 0;
+
+        /// Number of events currently available in the store
+        std::uint64_t num_events = 0;
+
+        /// Number of events discarded before the end of the retention duration, because the memory and spill budgets
+        /// were reached or because the spill region was being exported
+        std::uint64_t num_evicted_events = 0;
+
+        /// Timestamp of the oldest available event
+        timestamp first_ts = 0;
+
+        /// Timestamp of the most recent event
+        timestamp last_ts = 0;
+    };
+
+    /// @brief Builds a rolling event store
+    /// @param config Configuration of the store
+    /// @throw std::invalid_argument if the configuration is invalid
+    /// @throw std::runtime_error if the spill file can not be created
+    RollingEventStore(const Config &config);
+
+    /// @brief Destructor
+    ///
+    /// The spill file is removed
+    ~RollingEventStore();
+
+    /// @brief Adds a buffer of events to the store
+    /// @param begin Pointer to the beginning of the buffer
+    /// @param end Pointer to the end of the buffer
+    void add_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Exports the events of the last @p duration us to a writer
+    /// @param duration Duration of the window to export, ending at the most recent event of the store
+    /// @param writer Writer the events are added to (e.g. @ref RAWEvt2EventFileWriter or @ref HDF5EventFileWriter)
+    /// @return Number of events exported
+    std::uint64_t export_last(timestamp duration, EventFileWriter &writer);
+
+    /// @brief Exports the events in the time range [ts_begin, ts_end[ to a writer
+    /// @param ts_begin Beginning of the time range
+    /// @param ts_end End of the time range
+    /// @param writer Writer the events are added to
+    /// @return Number of events exported
+    /// @note Blocks being exported stay pinned on disk, while new blocks that would overwrite them are evicted instead
+    std::uint64_t export_range(timestamp ts_begin, timestamp ts_end, EventFileWriter &writer);
+
+    /// @brief Gets the statistics of the store
+    Statistics get_statistics() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_ROLLING_EVENT_STORE_H
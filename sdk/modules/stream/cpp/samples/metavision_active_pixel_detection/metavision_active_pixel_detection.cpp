@@ -9,14 +9,18 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <optional>
 #include <regex>
 #include <signal.h>
 #include <thread>
+#include <tuple>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #if CV_MAJOR_VERSION >= 4
@@ -25,6 +29,7 @@
 #include <opencv2/imgproc.hpp>
 #include <metavision/sdk/base/utils/generic_header.h>
 #include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/core/algorithms/pixel_activity_map_algorithm.h>
 #include <metavision/sdk/core/utils/cd_frame_generator.h>
 #include <metavision/sdk/core/utils/colors.h>
 #include <metavision/sdk/core/utils/misc.h>
@@ -45,29 +50,43 @@ namespace po = boost::program_options;
 
 namespace {
 struct Data {
-    cv::Mat counts;
-    cv::Mat mask;
-    double max, mean, stddev, threshold;
-    int num_active_pixels;
+    // Counts of the last calibration, kept while a new acquisition is running
+    std::optional<Metavision::PixelActivityMapAlgorithm> activity_map;
+    Metavision::PixelActivityMapAlgorithm::Statistics stats;
+    float num_stddev = 3.f;
+    std::vector<cv::Point> active_pixels;
+    cv::Mat_<std::uint8_t> mask;
     Metavision::Camera *camera = nullptr;
 
-    Data(int width, int height) : counts(height, width, CV_32F), mask(height, width, CV_32F), threshold(10) {}
+    Data(int width, int height) : mask(height, width, std::uint8_t(0)) {}
+
+    double threshold() const {
+        return stats.mean + num_stddev * stats.stddev;
+    }
 };
 
 void onTrackbarCallback(int value, void *args) {
     Data *data = reinterpret_cast<Data *>(args);
+    if (!data->activity_map) {
+        return;
+    }
 
-    data->threshold = data->mean + value * 0.5 * data->stddev;
-    data->counts.copyTo(data->mask);
+    data->num_stddev = value * 0.5f;
+    data->activity_map->get_hot_pixels(data->active_pixels, data->num_stddev);
+    // hot pixels are sorted by tile, the calibration results list them by row
+    std::sort(data->active_pixels.begin(), data->active_pixels.end(),
+              [](const cv::Point &p1, const cv::Point &p2) { return std::tie(p1.y, p1.x) < std::tie(p2.y, p2.x); });
 
-    cv::threshold(data->counts, data->mask, data->threshold, 1.0, cv::THRESH_BINARY);
+    data->mask.setTo(0);
+    for (const auto &pixel : data->active_pixels) {
+        data->mask(pixel) = 255;
+    }
     cv::imshow("Active pixel detection", data->mask);
 
-    data->num_active_pixels = cv::sum(data->mask)[0];
-    double ratio            = static_cast<double>(data->num_active_pixels) / data->mask.total();
+    double ratio = static_cast<double>(data->active_pixels.size()) / data->mask.total();
     MV_LOG_INFO() << Metavision::Log::no_space << std::fixed << std::setw(15) << std::setprecision(2) << std::right
-                  << "Threshold :" << std::setw(15) << (data->threshold * data->max) << "  " << std::setw(15)
-                  << "Active pixels: " << std::setw(15) << data->num_active_pixels << " (" << std::setw(7)
+                  << "Threshold :" << std::setw(15) << data->threshold() << "  " << std::setw(15)
+                  << "Active pixels: " << std::setw(15) << data->active_pixels.size() << " (" << std::setw(7)
                   << (ratio * 100.0) << "% )";
 }
 
@@ -80,14 +99,9 @@ void applyROI(const Data &data) {
     bool ret    = false;
     auto roi_px = data.camera->get_device().get_facility<Metavision::I_RoiPixelMask>();
     if (roi_px) {
-        if (!data.mask.empty()) {
-            for (int y = 0; y < data.mask.rows; ++y) {
-                const float *ptr = data.mask.ptr<float>(y);
-                for (int x = 0; x < data.mask.cols; ++x) {
-                    if (ptr[x] > 0.5) {
-                        roi_px->set_pixel(x, y, false);
-                    }
-                }
+        if (data.activity_map) {
+            for (const auto &pixel : data.active_pixels) {
+                roi_px->set_pixel(pixel.x, pixel.y, false);
             }
             roi_px->apply_pixels();
             ret = true;
@@ -101,6 +115,10 @@ void applyROI(const Data &data) {
 }
 
 void saveDetectionData(const std::string &calib_output_path, const std::string &counts_output_path, const Data &data) {
+    if (!data.activity_map) {
+        MV_LOG_ERROR() << "No calibration data to save";
+        return;
+    }
     bool ret = false;
     std::ofstream ofs(calib_output_path);
     if (ofs.is_open()) {
@@ -123,31 +141,26 @@ void saveDetectionData(const std::string &calib_output_path, const std::string &
                     header.set_field(it->first, std::to_string(it->second));
                 }
             }
-            header.set_field("mean", std::to_string(data.mean * data.max));
-            header.set_field("stddev", std::to_string(data.stddev * data.max));
-            header.set_field("threshold", std::to_string(data.threshold * data.max));
-            header.set_field("max", std::to_string(data.max));
-            header.set_field("active_pixels_count", std::to_string(data.num_active_pixels));
+            header.set_field("mean", std::to_string(data.stats.mean));
+            header.set_field("stddev", std::to_string(data.stats.stddev));
+            header.set_field("threshold", std::to_string(data.threshold()));
+            header.set_field("max", std::to_string(data.stats.max));
+            header.set_field("active_pixels_count", std::to_string(data.active_pixels.size()));
             header.set_field("active_pixels_percentage",
-                             std::to_string(data.num_active_pixels * 100. / data.counts.total()));
+                             std::to_string(data.active_pixels.size() * 100. / data.mask.total()));
 
             ofs << header.to_string();
             ret = true;
         } catch (...) {}
     }
     if (ret) {
-        for (int y = 0; y < data.mask.rows; ++y) {
-            const float *ptr = data.mask.ptr<float>(y);
-            for (int x = 0; x < data.mask.cols; ++x) {
-                if (ptr[x] > 0.5) {
-                    ofs << x << " " << y << "\n";
-                }
-            }
+        for (const auto &pixel : data.active_pixels) {
+            ofs << pixel.x << " " << pixel.y << "\n";
         }
 
-        cv::Mat counts;
-        data.counts.convertTo(counts, CV_8U, 255.0f);
-        cv::imwrite(counts_output_path, counts);
+        cv::Mat_<std::uint8_t> heat_map;
+        data.activity_map->generate_heat_map(heat_map);
+        cv::imwrite(counts_output_path, heat_map);
         MV_LOG_INFO() << "Calibration results saved in" << calib_output_path;
         MV_LOG_INFO() << "Calibration data saved in" << counts_output_path;
     } else {
@@ -377,7 +390,11 @@ int main(int argc, char *argv[]) {
         // Start the camera streaming
         camera.start();
 
-        std::vector<Metavision::EventCD> events;
+        // Counts of the events of each pixel during the acquisition
+        std::mutex activity_map_mutex;
+        Metavision::PixelActivityMapAlgorithm activity_map(geometry.get_width(), geometry.get_height());
+        size_t num_acquired_events = 0;
+        Metavision::timestamp first_acquired_ts = -1, last_acquired_ts = -1;
 
         Data data(geometry.get_width(), geometry.get_height());
         data.camera = &camera;
@@ -399,8 +416,13 @@ int main(int argc, char *argv[]) {
                     cv::imshow(cd_window_name, cd_frame);
                 }
             }
-            if (events.size() > static_cast<size_t>(min_event_count) &&
-                (events.front().t + duration * 1e6) < events.back().t) {
+            bool acquisition_done;
+            {
+                std::unique_lock<std::mutex> lock(activity_map_mutex);
+                acquisition_done = num_acquired_events > static_cast<size_t>(min_event_count) &&
+                                   (first_acquired_ts + duration * 1e6) < last_acquired_ts;
+            }
+            if (acquisition_done) {
                 MV_LOG_INFO() << "Acquisition done\n";
                 camera.cd().remove_callback(calib_cb_id);
 
@@ -420,33 +442,26 @@ int main(int argc, char *argv[]) {
                     calib_setup = true;
                 }
 
-                MV_LOG_INFO() << "Starting calibration with" << events.size() << "events...";
-                double max = 0;
-                data.counts.setTo(cv::Scalar::all(0));
-                for (const auto &event : events) {
-                    const double count = ++data.counts.at<float>(event.y, event.x);
-                    max                = std::max(count, max);
+                {
+                    std::unique_lock<std::mutex> lock(activity_map_mutex);
+                    MV_LOG_INFO() << "Starting calibration with" << num_acquired_events << "events...";
+                    data.activity_map.emplace(activity_map);
+                    activity_map.reset();
+                    num_acquired_events = 0;
+                    first_acquired_ts   = -1;
                 }
-                data.max = max;
-                data.counts /= data.max;
-                events.clear();
-
-                double mult = 3.0;
-                cv::Scalar mean, stddev;
-                cv::meanStdDev(data.counts, mean, stddev);
-                data.mean      = mean[0];
-                data.stddev    = stddev[0];
-                data.threshold = data.mean + mult * data.stddev;
+                data.stats = data.activity_map->get_statistics();
 
                 MV_LOG_INFO() << "Calibration done";
                 MV_LOG_INFO() << Metavision::Log::no_space << std::fixed << std::setw(15) << std::setprecision(2)
-                              << std::right << "Max :" << std::setw(15) << static_cast<size_t>(data.max);
+                              << std::right << "Max :" << std::setw(15) << data.stats.max;
                 MV_LOG_INFO() << Metavision::Log::no_space << std::fixed << std::setw(15) << std::setprecision(2)
-                              << std::right << "Mean :" << std::setw(15) << (data.mean * data.max);
+                              << std::right << "Mean :" << std::setw(15) << data.stats.mean;
                 MV_LOG_INFO() << Metavision::Log::no_space << std::fixed << std::setw(15) << std::setprecision(2)
-                              << std::right << "Stddev :" << std::setw(15) << (data.stddev * data.max);
+                              << std::right << "Stddev :" << std::setw(15) << data.stats.stddev;
 
-                int pos = std::round(mult / 0.5);
+                const float num_stddev = 3.f;
+                int pos                = std::round(num_stddev / 0.5f);
                 cv::setTrackbarPos(calib_trackbar_name, calib_window_name, pos);
                 onTrackbarCallback(pos, &data);
                 applyROI(data);
@@ -478,8 +493,18 @@ int main(int argc, char *argv[]) {
                        "-------\n";
                 log << "Started acquisition for " << duration << "s...";
                 calib_cb_id = camera.cd().add_callback(
-                    [&events](const Metavision::EventCD *ev_begin, const Metavision::EventCD *ev_end) {
-                        events.insert(events.end(), ev_begin, ev_end);
+                    [&activity_map_mutex, &activity_map, &num_acquired_events, &first_acquired_ts,
+                     &last_acquired_ts](const Metavision::EventCD *ev_begin, const Metavision::EventCD *ev_end) {
+                        if (ev_begin == ev_end) {
+                            return;
+                        }
+                        std::unique_lock<std::mutex> lock(activity_map_mutex);
+                        activity_map.process_events(ev_begin, ev_end);
+                        num_acquired_events += std::distance(ev_begin, ev_end);
+                        if (first_acquired_ts < 0) {
+                            first_acquired_ts = ev_begin->t;
+                        }
+                        last_acquired_ts = std::prev(ev_end)->t;
                     });
                 break;
             }
@@ -296,6 +296,8 @@ bool Camera::Private::process_impl() {
     throw CameraException(CameraErrorCode::CameraNotInitialized);
 }
 
+void Camera::Private::flush_impl() {}
+
 bool Camera::Private::start_recording_impl(const std::filesystem::path &file_path) {
     std::string ext = file_path.extension().string();
     std::shared_ptr<Metavision::EventFileWriter> writer;
@@ -430,6 +432,15 @@ void Camera::Private::run() {
             break;
         }
     }
+
+    try {
+        // delivers what is still pending now that no more data will be processed
+        flush_impl();
+    } catch (const std::exception &e) {
+        const CameraException camera_error =
+            CameraException(CameraErrorCode::RuntimeError, std::string("Unexpected error : ") + e.what());
+        propagate_runtime_error(camera_error);
+    }
     set_is_running(false);
 }
 
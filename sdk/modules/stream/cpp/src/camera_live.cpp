@@ -129,6 +129,12 @@ bool LivePrivate::process_impl() {
     }
 }
 
+void LivePrivate::flush_impl() {
+    if (i_events_stream_decoder_) {
+        i_events_stream_decoder_->flush_sinks();
+    }
+}
+
 template<typename TimingProfilerType>
 bool LivePrivate::process_impl(TimingProfilerType *profiler) {
     int res = 0;
@@ -210,8 +216,8 @@ void LivePrivate::init() {
 
     raw_data_.reset(RawData::Private::build(index_manager_));
 
-    cd_.reset(CD::Private::build(index_manager_));
     I_EventDecoder<EventCD> *i_cd_events_decoder = device_->get_facility<I_EventDecoder<EventCD>>();
+    cd_.reset(CD::Private::build(index_manager_, i_cd_events_decoder, &is_running_));
     if (i_cd_events_decoder) {
         i_cd_events_decoder->add_event_buffer_callback([this](const EventCD *begin, const EventCD *end) {
             for (auto &&cb : cd_->get_pimpl().get_cbs()) {
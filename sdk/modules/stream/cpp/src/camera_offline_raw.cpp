@@ -17,6 +17,7 @@
 #include "metavision/hal/facilities/i_event_frame_decoder.h"
 #include "metavision/hal/facilities/i_hw_identification.h"
 #include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/hal_exception.h"
 #include "metavision/sdk/base/utils/get_time.h"
 #include "metavision/sdk/stream/internal/callback_tag_ids.h"
 #include "metavision/sdk/stream/internal/camera_error_code_internal.h"
@@ -42,6 +43,9 @@ OfflineRawPrivate::OfflineRawPrivate(const std::filesystem::path &rawfile, const
     raw_file_stream_config.n_read_buffers_   = hints.max_memory() / hints.max_read_per_op();
     raw_file_stream_config.do_time_shifting_ = hints.time_shift();
     raw_file_stream_config.build_index_      = hints.get<bool>("index", raw_file_stream_config.build_index_);
+    try {
+        raw_file_stream_config.buffer_memory_type_ = parse_buffer_memory_type(hints.buffer_memory());
+    } catch (const HalException &e) { throw CameraException(CameraErrorCode::InvalidArgument, e.what()); }
 
     device_ = DeviceDiscovery::open_raw_file(rawfile, raw_file_stream_config);
     if (!device_) {
@@ -12,28 +12,85 @@
 #include "metavision/sdk/stream/cd.h"
 
 #include "metavision/sdk/stream/internal/cd_internal.h"
+#include "metavision/sdk/stream/camera_exception.h"
 #include "metavision/sdk/core/utils/index_manager.h"
 #include "metavision/sdk/stream/internal/callback_tag_ids.h"
 
 namespace Metavision {
 
-CD *CD::Private::build(IndexManager &index_manager) {
-    return new CD(new Private(index_manager));
+CD *CD::Private::build(IndexManager &index_manager, I_EventDecoder<EventCD> *decoder,
+                       const std::atomic<bool> *camera_is_running) {
+    return new CD(new Private(index_manager, decoder, camera_is_running));
 }
 
-CD::Private::Private(IndexManager &index_manager) :
-    CallbackManager<EventsCDCallback>(index_manager, CallbackTagIds::DECODE_CALLBACK_TAG_ID) {}
+CD::Private::Private(IndexManager &index_manager, I_EventDecoder<EventCD> *decoder,
+                     const std::atomic<bool> *camera_is_running) :
+    CallbackManager<EventsCDCallback>(index_manager, CallbackTagIds::DECODE_CALLBACK_TAG_ID),
+    index_manager_(index_manager),
+    decoder_(decoder),
+    camera_is_running_(camera_is_running) {}
 
 CD::Private::~Private() {}
 
+void CD::Private::check_camera_is_not_running() const {
+    // the sinks of the decoder are iterated by the decoding thread without synchronization
+    if (camera_is_running_ && *camera_is_running_) {
+        throw CameraException(CameraErrorCode::RuntimeError,
+                              "Sinks can not be added or removed while the camera is running.");
+    }
+}
+
+CallbackId CD::Private::add_sink(EventsCDSink &sink, std::unique_ptr<EventsCDSink> owned_sink) {
+    std::unique_lock<std::mutex> lock(sinks_mutex_);
+    CallbackId id;
+    size_t decoder_sink_id = 0;
+    if (decoder_) {
+        check_camera_is_not_running();
+        // The sink is called by the decoder, it only needs to be accounted for so that decoding is enabled
+        id = index_manager_.index_generator_.get_next_index();
+        index_manager_.counter_map_.tag(CallbackTagIds::DECODE_CALLBACK_TAG_ID);
+        decoder_sink_id = decoder_->add_event_buffer_sink(sink);
+    } else {
+        id = add_callback([&sink](const EventCD *begin, const EventCD *end) { sink.on_event_buffer(begin, end); });
+    }
+    sinks_[id] = Sink{std::move(owned_sink), decoder_sink_id};
+    return id;
+}
+
+bool CD::Private::remove_sink(CallbackId callback_id) {
+    std::unique_lock<std::mutex> lock(sinks_mutex_);
+    auto it = sinks_.find(callback_id);
+    if (it == sinks_.end()) {
+        return false;
+    }
+    if (decoder_) {
+        check_camera_is_not_running();
+        decoder_->remove_callback(it->second.decoder_sink_id);
+        index_manager_.counter_map_.untag(CallbackTagIds::DECODE_CALLBACK_TAG_ID);
+    } else {
+        remove_callback(callback_id);
+    }
+    sinks_.erase(it);
+    return true;
+}
+
 CD::~CD() {}
 
 CallbackId CD::add_callback(const EventsCDCallback &cb) {
     return pimpl_->add_callback(cb);
 }
 
+CallbackId CD::add_sink(EventsCDSink &sink) {
+    return pimpl_->add_sink(sink, nullptr);
+}
+
+CallbackId CD::add_owned_sink(std::unique_ptr<EventsCDSink> sink) {
+    auto &sink_ref = *sink;
+    return pimpl_->add_sink(sink_ref, std::move(sink));
+}
+
 bool CD::remove_callback(CallbackId callback_id) {
-    return pimpl_->remove_callback(callback_id);
+    return pimpl_->remove_sink(callback_id) || pimpl_->remove_callback(callback_id);
 }
 
 CD::Private &CD::get_pimpl() {
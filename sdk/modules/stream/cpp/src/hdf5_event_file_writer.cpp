@@ -81,23 +81,26 @@ public:
     }
 
     bool sync() {
+        return sync(events_.data(), pos_);
+    }
+
+    // Writes a chunk holding the @p count events starting at @p data, which must be readable up to a full chunk when
+    // no encoding is done
+    bool sync(const EventType *data, size_t count) {
         hsize_t offset[1] = {offset_};
         size_t num_bytes_in_chunk;
 
-        if (encoding_cb_) {
-            hsize_t dims[1] = {offset_ + pos_};
-            dset_.extend(dims);
+        hsize_t dims[1] = {offset_ + count};
+        dset_.extend(dims);
 
-            num_bytes_in_chunk = encoding_cb_(events_.data(), events_.data() + pos_, outbuf_.data());
+        if (encoding_cb_) {
+            num_bytes_in_chunk = encoding_cb_(data, data + count, outbuf_.data());
             if (H5Dwrite_chunk(dset_.getId(), H5P_DEFAULT, 0, offset, num_bytes_in_chunk, outbuf_.data()) < 0) {
                 return false;
             }
         } else {
-            hsize_t dims[1] = {offset_ + pos_};
-            dset_.extend(dims);
-
             num_bytes_in_chunk = chunk_size_ * sizeof(EventType);
-            if (H5Dwrite_chunk(dset_.getId(), H5P_DEFAULT, 0, offset, num_bytes_in_chunk, events_.data()) < 0) {
+            if (H5Dwrite_chunk(dset_.getId(), H5P_DEFAULT, 0, offset, num_bytes_in_chunk, data) < 0) {
                 return false;
             }
         }
@@ -105,12 +108,22 @@ public:
     }
 
     bool operator()(const EventType *begin, const EventType *end) {
-        size_t num_events_to_consume = std::distance(begin, end);
-        size_t num_events_to_copy    = std::min(chunk_size_ - pos_, num_events_to_consume);
-        auto *ev_ptr                 = begin;
-        while (num_events_to_consume > 0) {
-            std::copy(ev_ptr, ev_ptr + num_events_to_copy, events_.data() + pos_);
+        while (begin != end) {
+            const size_t num_events_to_consume = std::distance(begin, end);
+            if (pos_ == 0 && num_events_to_consume >= chunk_size_) {
+                // Full chunks are written directly from the input buffer, without going through events_
+                if (!sync(begin, chunk_size_)) {
+                    return false;
+                }
+                offset_ += chunk_size_;
+                begin += chunk_size_;
+                continue;
+            }
+
+            const size_t num_events_to_copy = std::min(chunk_size_ - pos_, num_events_to_consume);
+            std::copy(begin, begin + num_events_to_copy, events_.data() + pos_);
             pos_ += num_events_to_copy;
+            begin += num_events_to_copy;
             if (pos_ == chunk_size_) {
                 if (!sync()) {
                     return false;
@@ -118,9 +131,6 @@ public:
                 offset_ += pos_;
                 pos_ = 0;
             }
-            num_events_to_consume -= num_events_to_copy;
-            ev_ptr += num_events_to_copy;
-            num_events_to_copy = std::min(chunk_size_, num_events_to_consume);
         }
         return true;
     }
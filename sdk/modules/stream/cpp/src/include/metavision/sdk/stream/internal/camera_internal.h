@@ -70,6 +70,7 @@ public:
     virtual void start_impl();
     virtual void stop_impl();
     virtual bool process_impl();
+    virtual void flush_impl();
     virtual bool start_recording_impl(const std::filesystem::path &file_path);
     virtual bool stop_recording_impl(const std::filesystem::path &file_path);
     virtual I_Geometry &get_geometry();
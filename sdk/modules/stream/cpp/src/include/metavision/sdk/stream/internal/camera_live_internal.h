@@ -44,6 +44,7 @@ private:
     void start_impl() override;
     void stop_impl() override;
     bool process_impl() override;
+    void flush_impl() override;
 
     template<typename TimingProfilerType>
     bool process_impl(TimingProfilerType *);
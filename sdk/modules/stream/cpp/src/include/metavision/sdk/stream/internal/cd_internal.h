@@ -12,8 +12,10 @@
 #ifndef METAVISION_SDK_STREAM_CD_INTERNAL_H
 #define METAVISION_SDK_STREAM_CD_INTERNAL_H
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 
 #include "metavision/sdk/core/utils/callback_manager.h"
@@ -24,11 +26,31 @@ class IndexGenerator;
 
 class CD::Private : public CallbackManager<EventsCDCallback> {
 public:
-    Private(IndexManager &index_manager);
+    Private(IndexManager &index_manager, I_EventDecoder<EventCD> *decoder,
+            const std::atomic<bool> *camera_is_running);
 
     virtual ~Private();
 
-    static CD *build(IndexManager &index_manager);
+    static CD *build(IndexManager &index_manager, I_EventDecoder<EventCD> *decoder = nullptr,
+                     const std::atomic<bool> *camera_is_running = nullptr);
+
+    CallbackId add_sink(EventsCDSink &sink, std::unique_ptr<EventsCDSink> owned_sink);
+
+    bool remove_sink(CallbackId callback_id);
+
+private:
+    struct Sink {
+        std::unique_ptr<EventsCDSink> owned_sink;
+        size_t decoder_sink_id;
+    };
+
+    void check_camera_is_not_running() const;
+
+    IndexManager &index_manager_;
+    I_EventDecoder<EventCD> *decoder_;
+    const std::atomic<bool> *camera_is_running_;
+    std::mutex sinks_mutex_;
+    std::map<CallbackId, Sink> sinks_;
 };
 
 } // namespace Metavision
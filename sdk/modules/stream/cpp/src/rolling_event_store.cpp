@@ -0,0 +1,456 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/sdk/stream/event_file_writer.h"
+#include "metavision/sdk/stream/rolling_event_store.h"
+
+namespace Metavision {
+namespace {
+
+// Ring file mapped in memory, removed on destruction
+class SpillFile {
+public:
+    SpillFile(const std::filesystem::path &path, std::size_t size) : path_(path), size_(size) {
+#ifdef _WIN32
+        file_ = CreateFileW(path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Unable to open " + path.string() + " for writing");
+        }
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READWRITE, DWORD(std::uint64_t(size) >> 32),
+                                      DWORD(size & 0xFFFFFFFF), nullptr);
+        if (mapping_ != nullptr) {
+            data_ = static_cast<std::uint8_t *>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+        }
+        if (data_ == nullptr) {
+            release();
+            throw std::runtime_error("Unable to map " + path.string() + " in memory");
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd_ < 0) {
+            throw std::runtime_error("Unable to open " + path.string() + " for writing");
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            release();
+            throw std::runtime_error("Unable to allocate " + std::to_string(size) + " bytes for " + path.string());
+        }
+        void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED) {
+            release();
+            throw std::runtime_error("Unable to map " + path.string() + " in memory");
+        }
+        data_ = static_cast<std::uint8_t *>(data);
+        // Blocks are written and read sequentially
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+    ~SpillFile() {
+        release();
+    }
+
+    SpillFile(const SpillFile &)            = delete;
+    SpillFile &operator=(const SpillFile &) = delete;
+
+    std::uint8_t *data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    void release() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+        file_ = INVALID_HANDLE_VALUE;
+        mapping_ = nullptr;
+#else
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            std::error_code ec;
+            std::filesystem::remove(path_, ec);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+    }
+
+    std::filesystem::path path_;
+    std::size_t size_;
+    std::uint8_t *data_ = nullptr;
+#ifdef _WIN32
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// Spilled blocks are encoded event by event as a varint of the zigzag encoded time delta with the polarity in its
+// lowest bit, followed by the x and y coordinates as little endian 16 bits words. At usual event rates, this takes
+// 5 to 7 bytes per event instead of 16.
+void encode_block(const EventCD *begin, const EventCD *end, std::vector<std::uint8_t> &out) {
+    out.clear();
+    timestamp prev_ts = begin->t;
+    for (auto ev = begin; ev != end; ++ev) {
+        const std::int64_t dt = ev->t - prev_ts;
+        prev_ts               = ev->t;
+        std::uint64_t v = (((std::uint64_t(dt) << 1) ^ std::uint64_t(dt >> 63)) << 1) | std::uint64_t(ev->p & 1);
+        while (v >= 0x80) {
+            out.push_back(std::uint8_t(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(std::uint8_t(v));
+        out.push_back(std::uint8_t(ev->x));
+        out.push_back(std::uint8_t(ev->x >> 8));
+        out.push_back(std::uint8_t(ev->y));
+        out.push_back(std::uint8_t(ev->y >> 8));
+    }
+}
+
+void decode_block(const std::uint8_t *data, std::size_t num_events, timestamp first_ts, std::vector<EventCD> &out) {
+    out.resize(num_events);
+    timestamp prev_ts = first_ts;
+    for (auto &ev : out) {
+        std::uint64_t v = 0;
+        for (int shift = 0;; shift += 7) {
+            const std::uint8_t byte = *data++;
+            v |= std::uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        const std::uint64_t zz = v >> 1;
+        prev_ts += static_cast<std::int64_t>(zz >> 1) ^ -static_cast<std::int64_t>(zz & 1);
+        ev.t = prev_ts;
+        ev.p = static_cast<short>(v & 1);
+        ev.x = static_cast<unsigned short>(data[0] | (data[1] << 8));
+        ev.y = static_cast<unsigned short>(data[2] | (data[3] << 8));
+        data += 4;
+    }
+}
+
+} // namespace
+
+class RollingEventStore::Private {
+public:
+    Private(const Config &config) : config_(config), block_bytes_(config.block_num_events * sizeof(EventCD)) {
+        if (config_.block_num_events == 0) {
+            throw std::invalid_argument("Rolling event store blocks must hold at least one event");
+        }
+        if (config_.memory_budget_bytes < block_bytes_) {
+            throw std::invalid_argument("Rolling event store memory budget must hold at least one block of " +
+                                        std::to_string(block_bytes_) + " bytes");
+        }
+        if (!config_.spill_path.empty()) {
+            if (config_.spill_budget_bytes == 0) {
+                throw std::invalid_argument("Rolling event store spill budget must not be empty");
+            }
+            spill_file_ = std::make_unique<SpillFile>(config_.spill_path, config_.spill_budget_bytes);
+        }
+        open_block_.reserve(config_.block_num_events);
+        memory_bytes_ = block_bytes_;
+    }
+
+    void add_events(const EventCD *begin, const EventCD *end) {
+        while (begin != end) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                const auto n = std::min<std::size_t>(end - begin, config_.block_num_events - open_block_.size());
+                open_block_.insert(open_block_.end(), begin, begin + n);
+                begin += n;
+                last_ts_ = open_block_.back().t;
+                if (open_block_.size() == config_.block_num_events) {
+                    seal_open_block();
+                }
+                evict_expired_blocks();
+            }
+            enforce_memory_budget();
+        }
+    }
+
+    std::uint64_t export_range(timestamp ts_begin, timestamp ts_end, EventFileWriter &writer) {
+        if (!writer.is_open()) {
+            throw std::runtime_error("Unable to export events from the rolling event store, the writer is not open");
+        }
+
+        // Takes a snapshot of the blocks overlapping the range, the spilled ones are pinned so that they are not
+        // overwritten while being read
+        std::vector<DiskBlock> disk_blocks;
+        std::vector<MemoryBlock> memory_blocks;
+        std::vector<EventCD> open_events;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &block : disk_blocks_) {
+                if (block.last_ts >= ts_begin && block.first_ts < ts_end) {
+                    disk_blocks.push_back(block);
+                    pinned_.emplace_back(block.offset, block.size);
+                }
+            }
+            for (const auto &block : memory_blocks_) {
+                if (block.last_ts >= ts_begin && block.first_ts < ts_end) {
+                    memory_blocks.push_back(block);
+                }
+            }
+            auto range = time_range(open_block_.data(), open_block_.data() + open_block_.size(), ts_begin, ts_end);
+            open_events.assign(range.first, range.second);
+        }
+
+        struct Unpin {
+            ~Unpin() {
+                std::lock_guard<std::mutex> lock(store.mutex_);
+                for (const auto &block : blocks) {
+                    store.pinned_.erase(std::find(store.pinned_.begin(), store.pinned_.end(),
+                                                  std::make_pair(block.offset, block.size)));
+                }
+            }
+            Private &store;
+            const std::vector<DiskBlock> &blocks;
+        } unpin{*this, disk_blocks};
+
+        std::uint64_t num_exported = 0;
+        auto write                 = [&](const EventCD *begin, const EventCD *end) {
+            auto range = time_range(begin, end, ts_begin, ts_end);
+            if (writer.add_events(range.first, range.second)) {
+                num_exported += range.second - range.first;
+            }
+        };
+        std::vector<EventCD> decoded;
+        for (const auto &block : disk_blocks) {
+            decode_block(spill_file_->data() + block.offset, block.num_events, block.first_ts, decoded);
+            write(decoded.data(), decoded.data() + decoded.size());
+        }
+        for (const auto &block : memory_blocks) {
+            write(block.events->data(), block.events->data() + block.events->size());
+        }
+        write(open_events.data(), open_events.data() + open_events.size());
+        return num_exported;
+    }
+
+    std::uint64_t export_last(timestamp duration, EventFileWriter &writer) {
+        timestamp last_ts;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_ts = last_ts_;
+        }
+        return export_range(last_ts - duration, last_ts + 1, writer);
+    }
+
+    Statistics get_statistics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Statistics stats;
+        stats.memory_bytes       = memory_bytes_;
+        stats.spilled_bytes      = spilled_bytes_;
+        stats.num_evicted_events = num_evicted_events_;
+        stats.last_ts            = last_ts_;
+        stats.num_events         = open_block_.size();
+        for (const auto &block : disk_blocks_) {
+            stats.num_events += block.num_events;
+        }
+        for (const auto &block : memory_blocks_) {
+            stats.num_events += block.events->size();
+        }
+        if (!disk_blocks_.empty()) {
+            stats.first_ts = disk_blocks_.front().first_ts;
+        } else if (!memory_blocks_.empty()) {
+            stats.first_ts = memory_blocks_.front().first_ts;
+        } else if (!open_block_.empty()) {
+            stats.first_ts = open_block_.front().t;
+        }
+        return stats;
+    }
+
+private:
+    struct MemoryBlock {
+        std::shared_ptr<const std::vector<EventCD>> events;
+        timestamp first_ts;
+        timestamp last_ts;
+    };
+
+    struct DiskBlock {
+        std::size_t offset;
+        std::size_t size;
+        std::size_t num_events;
+        timestamp first_ts;
+        timestamp last_ts;
+    };
+
+    static std::pair<const EventCD *, const EventCD *> time_range(const EventCD *begin, const EventCD *end,
+                                                                  timestamp ts_begin, timestamp ts_end) {
+        auto first = std::lower_bound(begin, end, ts_begin, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        auto last  = std::lower_bound(first, end, ts_end, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        return {first, last};
+    }
+
+    // Must be called with mutex_ locked
+    void seal_open_block() {
+        auto events = std::make_shared<std::vector<EventCD>>(std::move(open_block_));
+        memory_blocks_.push_back({events, events->front().t, events->back().t});
+        open_block_ = std::vector<EventCD>();
+        open_block_.reserve(config_.block_num_events);
+        memory_bytes_ += block_bytes_;
+    }
+
+    // Must be called with mutex_ locked
+    void evict_expired_blocks() {
+        const timestamp expiry_ts = last_ts_ - config_.retention_us;
+        while (!disk_blocks_.empty() && disk_blocks_.front().last_ts < expiry_ts) {
+            spilled_bytes_ -= disk_blocks_.front().size;
+            disk_blocks_.pop_front();
+        }
+        while (!memory_blocks_.empty() && memory_blocks_.front().last_ts < expiry_ts) {
+            memory_bytes_ -= block_bytes_;
+            memory_blocks_.pop_front();
+        }
+    }
+
+    // Only called from the thread adding events, which is the only one removing memory blocks
+    void enforce_memory_budget() {
+        while (true) {
+            MemoryBlock block;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (memory_bytes_ <= config_.memory_budget_bytes || memory_blocks_.empty()) {
+                    return;
+                }
+                block = memory_blocks_.front();
+                if (!spill_file_) {
+                    num_evicted_events_ += block.events->size();
+                    pop_memory_block();
+                    continue;
+                }
+            }
+
+            // The block is immutable, it is compressed without holding the lock
+            encode_block(block.events->data(), block.events->data() + block.events->size(), encoded_);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            spill(block);
+            pop_memory_block();
+        }
+    }
+
+    // Must be called with mutex_ locked
+    void pop_memory_block() {
+        memory_bytes_ -= block_bytes_;
+        memory_blocks_.pop_front();
+    }
+
+    // Writes the encoded block in the ring file, overwriting the oldest spilled blocks. Spilled blocks are stored in
+    // the order of the ring, so that the blocks to overwrite are always at the front of disk_blocks_.
+    // Must be called with mutex_ locked
+    void spill(const MemoryBlock &block) {
+        const std::size_t size = encoded_.size();
+        const bool wrap        = write_offset_ + size > spill_file_->size();
+        const std::size_t offset = wrap ? 0 : write_offset_;
+        const bool pinned =
+            std::any_of(pinned_.begin(), pinned_.end(), [offset, size](const std::pair<std::size_t, std::size_t> &p) {
+                return p.first < offset + size && offset < p.first + p.second;
+            });
+        if (size > spill_file_->size() || pinned) {
+            num_evicted_events_ += block.events->size();
+            return;
+        }
+
+        auto evict_front = [this] {
+            num_evicted_events_ += disk_blocks_.front().num_events;
+            spilled_bytes_ -= disk_blocks_.front().size;
+            disk_blocks_.pop_front();
+        };
+        if (wrap) {
+            // The end of the file is left unused for this round
+            while (!disk_blocks_.empty() && disk_blocks_.front().offset >= write_offset_) {
+                evict_front();
+            }
+        }
+        while (!disk_blocks_.empty() && disk_blocks_.front().offset >= offset &&
+               disk_blocks_.front().offset < offset + size) {
+            evict_front();
+        }
+
+        std::memcpy(spill_file_->data() + offset, encoded_.data(), size);
+        disk_blocks_.push_back({offset, size, block.events->size(), block.first_ts, block.last_ts});
+        spilled_bytes_ += size;
+        write_offset_ = offset + size;
+    }
+
+    const Config config_;
+    const std::size_t block_bytes_;
+    std::unique_ptr<SpillFile> spill_file_;
+    std::vector<std::uint8_t> encoded_;
+
+    mutable std::mutex mutex_;
+    std::vector<EventCD> open_block_;
+    std::deque<MemoryBlock> memory_blocks_;
+    std::deque<DiskBlock> disk_blocks_;
+    std::vector<std::pair<std::size_t, std::size_t>> pinned_;
+    std::size_t write_offset_         = 0;
+    std::size_t memory_bytes_         = 0;
+    std::size_t spilled_bytes_        = 0;
+    std::uint64_t num_evicted_events_ = 0;
+    timestamp last_ts_                = 0;
+};
+
+RollingEventStore::RollingEventStore(const Config &config) : pimpl_(std::make_unique<Private>(config)) {}
+
+RollingEventStore::~RollingEventStore() = default;
+
+void RollingEventStore::add_events(const EventCD *begin, const EventCD *end) {
+    pimpl_->add_events(begin, end);
+}
+
+std::uint64_t RollingEventStore::export_last(timestamp duration, EventFileWriter &writer) {
+    return pimpl_->export_last(duration, writer);
+}
+
+std::uint64_t RollingEventStore::export_range(timestamp ts_begin, timestamp ts_end, EventFileWriter &writer) {
+    return pimpl_->export_range(ts_begin, ts_end, writer);
+}
+
+RollingEventStore::Statistics RollingEventStore::get_statistics() const {
+    return pimpl_->get_statistics();
+}
+
+} // namespace Metavision
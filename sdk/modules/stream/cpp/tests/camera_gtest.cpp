@@ -742,6 +742,42 @@ TEST_F(Camera_Gtest, cd_events_callbacks) {
     ASSERT_EQ(expected_events.size(), n_events2);
 }
 
+TEST_F(Camera_Gtest, cd_events_sinks) {
+    class CountingSink : public EventsCDSink {
+    public:
+        void on_event_buffer(const EventCD *begin, const EventCD *end) override {
+            n_events_ += std::distance(begin, end);
+        }
+
+        size_t n_events_ = 0;
+    };
+
+    const auto expected_events = write_evt2_raw_data();
+    size_t n_events0           = 0;
+    CountingSink sink;
+
+    Camera camera  = Camera::from_file(tmp_file_);
+    CallbackId id0 = camera.cd().add_typed_callback(
+        [&n_events0](const EventCD *ev_begin, const EventCD *ev_end) { n_events0 += std::distance(ev_begin, ev_end); });
+    CallbackId id1 = camera.cd().add_sink(sink);
+    ASSERT_NE(id0, id1);
+    ASSERT_EQ(2, camera.get_pimpl().index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID));
+
+    camera.start();
+
+    while (camera.is_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+
+    ASSERT_EQ(expected_events.size(), n_events0);
+    ASSERT_EQ(expected_events.size(), sink.n_events_);
+
+    ASSERT_TRUE(camera.cd().remove_callback(id0));
+    ASSERT_TRUE(camera.cd().remove_callback(id1));
+    ASSERT_FALSE(camera.cd().remove_callback(id1));
+    ASSERT_EQ(0, camera.get_pimpl().index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID));
+}
+
 TEST_F(Camera_Gtest, no_error_callbacks_called) {
     write_evt2_raw_data();
     Camera camera = Camera::from_file(tmp_file_);
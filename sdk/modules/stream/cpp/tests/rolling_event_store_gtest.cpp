@@ -0,0 +1,335 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/event_file_writer.h"
+#include "metavision/sdk/stream/rolling_event_store.h"
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+
+using namespace Metavision;
+
+namespace {
+
+class RecordingEventFileWriter : public EventFileWriter {
+public:
+    ~RecordingEventFileWriter() override {
+        close();
+    }
+
+    std::vector<EventCD> events;
+
+protected:
+    bool is_open_impl() const override {
+        return true;
+    }
+
+private:
+    void open_impl(const std::filesystem::path &path) override {}
+    void close_impl() override {}
+    void flush_impl() override {}
+
+    void add_metadata_impl(const std::string &key, const std::string &value) override {}
+    void add_metadata_map_from_camera_impl(const Camera &camera) override {}
+    void remove_metadata_impl(const std::string &key) override {}
+
+    bool add_events_impl(const EventCD *begin, const EventCD *end) override {
+        events.insert(events.end(), begin, end);
+        return true;
+    }
+    bool add_events_impl(const EventExtTrigger *begin, const EventExtTrigger *end) override {
+        return true;
+    }
+};
+
+// Writer holding the export in progress at the first buffer it receives, until it is released
+//
+// EventFileWriter::add_events checks synchronously that the writer is open, which happens while the exported blocks
+// are pinned, after the one of export_range itself
+class HoldingEventFileWriter : public RecordingEventFileWriter {
+public:
+    void wait_held() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return held_; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        cond_.notify_all();
+    }
+
+private:
+    bool is_open_impl() const override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (++num_open_checks_ == 2) {
+            held_ = true;
+            cond_.notify_all();
+            cond_.wait(lock, [this] { return released_; });
+        }
+        return true;
+    }
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cond_;
+    mutable int num_open_checks_ = 0;
+    mutable bool held_           = false;
+    bool released_               = false;
+};
+
+// One event per us, with coordinates and polarity derived from the timestamp
+std::vector<EventCD> make_events(timestamp ts_begin, timestamp ts_end) {
+    std::vector<EventCD> events;
+    for (timestamp t = ts_begin; t < ts_end; ++t) {
+        events.emplace_back(static_cast<unsigned short>(t % 1280), static_cast<unsigned short>((t / 7) % 720),
+                            static_cast<short>(t % 3 == 0), t);
+    }
+    return events;
+}
+
+void expect_events_eq(const std::vector<EventCD> &expected, const std::vector<EventCD> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].x, actual[i].x);
+        ASSERT_EQ(expected[i].y, actual[i].y);
+        ASSERT_EQ(expected[i].p, actual[i].p);
+        ASSERT_EQ(expected[i].t, actual[i].t);
+    }
+}
+
+} // namespace
+
+class RollingEventStore_GTest : public GTestWithTmpDir {
+protected:
+    RollingEventStore::Config make_config() const {
+        RollingEventStore::Config config;
+        config.retention_us        = 1'000'000;
+        config.block_num_events    = 1000;
+        config.memory_budget_bytes = 4 * config.block_num_events * sizeof(EventCD);
+        config.spill_budget_bytes  = 1024 * 1024;
+        return config;
+    }
+};
+
+TEST_F(RollingEventStore_GTest, invalid_config) {
+    // GIVEN a memory budget smaller than a block
+    auto config                = make_config();
+    config.memory_budget_bytes = config.block_num_events * sizeof(EventCD) - 1;
+
+    // WHEN building the store
+    // THEN it throws
+    ASSERT_THROW(RollingEventStore store(config), std::invalid_argument);
+}
+
+TEST_F(RollingEventStore_GTest, export_from_memory) {
+    // GIVEN a store holding fewer events than its memory budget
+    RollingEventStore store(make_config());
+    auto events = make_events(0, 2500);
+    store.add_events(events.data(), events.data() + events.size());
+
+    // WHEN exporting the last 1000 us
+    RecordingEventFileWriter writer;
+    auto num_exported = store.export_last(1000, writer);
+    writer.flush();
+
+    // THEN the events of the window are exported
+    std::vector<EventCD> expected(events.begin() + 1499, events.end());
+    EXPECT_EQ(expected.size(), num_exported);
+    expect_events_eq(expected, writer.events);
+    auto stats = store.get_statistics();
+    EXPECT_EQ(2500u, stats.num_events);
+    EXPECT_EQ(0u, stats.num_evicted_events);
+    EXPECT_EQ(0u, stats.spilled_bytes);
+}
+
+TEST_F(RollingEventStore_GTest, memory_budget_without_spill) {
+    // GIVEN a store without spill file
+    auto config = make_config();
+    RollingEventStore store(config);
+
+    // WHEN adding more events than the memory budget
+    auto events = make_events(0, 10000);
+    store.add_events(events.data(), events.data() + events.size());
+
+    // THEN the oldest blocks are evicted and the budget is respected
+    auto stats = store.get_statistics();
+    EXPECT_LE(stats.memory_bytes, config.memory_budget_bytes);
+    EXPECT_EQ(7000u, stats.num_evicted_events);
+    EXPECT_EQ(3000u, stats.num_events);
+    EXPECT_EQ(7000, stats.first_ts);
+    EXPECT_EQ(9999, stats.last_ts);
+}
+
+TEST_F(RollingEventStore_GTest, spill_to_disk_and_export) {
+    // GIVEN a store spilling to disk
+    auto config        = make_config();
+    config.spill_path  = tmpdir_handler_->get_full_path("spill.bin");
+    RollingEventStore store(config);
+
+    // WHEN adding more events than the memory budget, in buffers not aligned on blocks
+    auto events = make_events(0, 20000);
+    for (size_t i = 0; i < events.size(); i += 333) {
+        store.add_events(events.data() + i, events.data() + std::min(events.size(), i + 333));
+    }
+
+    // THEN the oldest blocks are compressed on disk and can be exported along with the ones in memory
+    auto stats = store.get_statistics();
+    EXPECT_LE(stats.memory_bytes, config.memory_budget_bytes);
+    EXPECT_GT(stats.spilled_bytes, 0u);
+    EXPECT_LT(stats.spilled_bytes, 17000 * sizeof(EventCD) / 2);
+    EXPECT_EQ(0u, stats.num_evicted_events);
+    EXPECT_EQ(20000u, stats.num_events);
+
+    RecordingEventFileWriter writer;
+    auto num_exported = store.export_range(1234, 19000, writer);
+    writer.flush();
+    std::vector<EventCD> expected(events.begin() + 1234, events.begin() + 19000);
+    EXPECT_EQ(expected.size(), num_exported);
+    expect_events_eq(expected, writer.events);
+}
+
+TEST_F(RollingEventStore_GTest, spill_ring_overwrites_oldest_blocks) {
+    // GIVEN a store with a spill ring smaller than the retention
+    auto config               = make_config();
+    config.spill_path         = tmpdir_handler_->get_full_path("spill.bin");
+    config.spill_budget_bytes = 32 * 1024;
+    RollingEventStore store(config);
+
+    // WHEN adding many more events than both budgets
+    auto events = make_events(0, 100000);
+    store.add_events(events.data(), events.data() + events.size());
+
+    // THEN the oldest spilled blocks are overwritten and the most recent events are still exported
+    auto stats = store.get_statistics();
+    EXPECT_LE(stats.spilled_bytes, config.spill_budget_bytes);
+    EXPECT_GT(stats.num_evicted_events, 0u);
+    EXPECT_EQ(100000u, stats.num_events + stats.num_evicted_events);
+
+    RecordingEventFileWriter writer;
+    auto num_exported = store.export_last(100000, writer);
+    writer.flush();
+    EXPECT_EQ(stats.num_events, num_exported);
+    std::vector<EventCD> expected(events.end() - stats.num_events, events.end());
+    expect_events_eq(expected, writer.events);
+}
+
+TEST_F(RollingEventStore_GTest, retention) {
+    // GIVEN a store with a retention of 1s
+    auto config = make_config();
+    config.spill_path = tmpdir_handler_->get_full_path("spill.bin");
+    RollingEventStore store(config);
+
+    // WHEN adding events spanning more than the retention duration
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < 3'000'000; t += 100) {
+        events.emplace_back(0, 0, 0, t);
+    }
+    store.add_events(events.data(), events.data() + events.size());
+
+    // THEN the expired blocks are dropped without being counted as evicted
+    auto stats = store.get_statistics();
+    EXPECT_EQ(0u, stats.num_evicted_events);
+    EXPECT_GE(stats.first_ts, 3'000'000 - 100 - config.retention_us - 1000 * 100);
+    EXPECT_LT(stats.num_events, events.size());
+}
+
+TEST_F(RollingEventStore_GTest, export_while_adding_events) {
+    // GIVEN a store spilling to disk, to which events are added from another thread
+    auto config       = make_config();
+    config.spill_path = tmpdir_handler_->get_full_path("spill.bin");
+    RollingEventStore store(config);
+    const auto events = make_events(0, 100000);
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (size_t i = 0; i < events.size(); i += 333) {
+            store.add_events(events.data() + i, events.data() + std::min(events.size(), i + 333));
+        }
+        done = true;
+    });
+
+    // WHEN exporting the last events repeatedly at the same time
+    size_t num_exports = 0;
+    while (!done || num_exports == 0) {
+        RecordingEventFileWriter writer;
+        const auto num_exported = store.export_last(5000, writer);
+        writer.flush();
+        ++num_exports;
+
+        // THEN each export is a consistent window of the added events
+        ASSERT_EQ(num_exported, writer.events.size());
+        ASSERT_LE(num_exported, 5001u);
+        if (num_exported == 0) {
+            continue;
+        }
+        const auto first_ts = writer.events.front().t;
+        ASSERT_LT(writer.events.back().t, 100000);
+        std::vector<EventCD> expected(events.begin() + first_ts, events.begin() + first_ts + num_exported);
+        expect_events_eq(expected, writer.events);
+    }
+    producer.join();
+
+    // THEN the last window is complete once all the events have been added
+    RecordingEventFileWriter writer;
+    EXPECT_EQ(5001u, store.export_last(5000, writer));
+    writer.flush();
+    expect_events_eq(std::vector<EventCD>(events.end() - 5001, events.end()), writer.events);
+}
+
+TEST_F(RollingEventStore_GTest, pinned_block_survives_spill) {
+    // GIVEN a store spilling to a ring of about a dozen blocks, with 5 blocks spilled
+    auto config               = make_config();
+    config.spill_path         = tmpdir_handler_->get_full_path("spill.bin");
+    config.spill_budget_bytes = 64 * 1024;
+    RollingEventStore store(config);
+    const auto events = make_events(0, 40000);
+    store.add_events(events.data(), events.data() + 8000);
+    ASSERT_EQ(0u, store.get_statistics().num_evicted_events);
+
+    // WHEN the third spilled block is being exported
+    HoldingEventFileWriter holding_writer;
+    std::uint64_t num_exported_while_held = 0;
+    std::thread exporter([&] { num_exported_while_held = store.export_range(2000, 3000, holding_writer); });
+    holding_writer.wait_held();
+
+    // WHEN adding enough events for the ring to wrap around several times
+    store.add_events(events.data() + 8000, events.data() + events.size());
+    holding_writer.release();
+    exporter.join();
+    holding_writer.flush();
+
+    // THEN
+    // - the export in progress completes
+    // - the spilled blocks overwritten by the ring are evicted, as well as the new blocks that would have overwritten
+    // the pinned one
+    // - the pinned block is still on disk once the export is over
+    std::vector<EventCD> pinned_events(events.begin() + 2000, events.begin() + 3000);
+    EXPECT_EQ(pinned_events.size(), num_exported_while_held);
+    expect_events_eq(pinned_events, holding_writer.events);
+
+    const auto stats = store.get_statistics();
+    EXPECT_LE(stats.spilled_bytes, config.spill_budget_bytes);
+    EXPECT_GT(stats.num_evicted_events, 2000u);
+    EXPECT_EQ(events.size(), stats.num_events + stats.num_evicted_events);
+
+    RecordingEventFileWriter evicted_writer;
+    EXPECT_EQ(0u, store.export_range(0, 2000, evicted_writer));
+
+    RecordingEventFileWriter pinned_writer;
+    EXPECT_EQ(pinned_events.size(), store.export_range(2000, 3000, pinned_writer));
+    pinned_writer.flush();
+    expect_events_eq(pinned_events, pinned_writer.events);
+}
@@ -0,0 +1,148 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_PYTHON_BINDINGS_EVENT_FILE_WRITER_PYTHON_H
+#define METAVISION_SDK_STREAM_PYTHON_BINDINGS_EVENT_FILE_WRITER_PYTHON_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/stream/event_file_writer.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+/// @brief Adds CD events given as separate columns to a writer
+///
+/// Events are assembled chunk by chunk with the GIL released, so that no full array of EventCD needs to be built.
+inline void add_cd_events_columns(EventFileWriter &writer,
+                                  const py::array_t<std::uint16_t, py::array::forcecast> &x,
+                                  const py::array_t<std::uint16_t, py::array::forcecast> &y,
+                                  const py::array_t<std::int16_t, py::array::forcecast> &p,
+                                  const py::array_t<std::int64_t, py::array::forcecast> &t) {
+    if (x.ndim() != 1 || y.ndim() != 1 || p.ndim() != 1 || t.ndim() != 1) {
+        throw std::invalid_argument("EventFileWriter.add_cd_events_columns expects one dimensional arrays");
+    }
+    const py::ssize_t n = x.shape(0);
+    if (y.shape(0) != n || p.shape(0) != n || t.shape(0) != n) {
+        throw std::invalid_argument("EventFileWriter.add_cd_events_columns expects arrays of the same size");
+    }
+
+    auto xs = x.unchecked<1>();
+    auto ys = y.unchecked<1>();
+    auto ps = p.unchecked<1>();
+    auto ts = t.unchecked<1>();
+
+    constexpr py::ssize_t kChunkSize = 65536;
+    py::gil_scoped_release release;
+    std::vector<EventCD> chunk;
+    chunk.reserve(static_cast<size_t>(std::min(n, kChunkSize)));
+    for (py::ssize_t i = 0; i < n;) {
+        chunk.clear();
+        for (const py::ssize_t end = std::min(n, i + kChunkSize); i < end; ++i) {
+            chunk.emplace_back(xs(i), ys(i), ps(i), ts(i));
+        }
+        writer.add_events(chunk.data(), chunk.data() + chunk.size());
+    }
+}
+
+/// @brief Adds CD events given as a structured array to a writer
+///
+/// Contiguous arrays of EventCD are passed as is to the writer, other structured arrays with x, y, p and t fields are
+/// added column by column.
+inline void add_cd_events(EventFileWriter &writer, const py::array &events) {
+    if (events.ndim() != 1) {
+        throw std::invalid_argument("EventFileWriter.add_cd_events expects one dimentional arrays");
+    }
+    if (py::isinstance<py::array_t<EventCD>>(events) && (events.flags() & py::array::c_style)) {
+        auto *begin = static_cast<const EventCD *>(events.data());
+        auto *end   = begin + events.size();
+        py::gil_scoped_release release;
+        writer.add_events(begin, end);
+        return;
+    }
+    if (events.dtype().attr("names").is_none()) {
+        throw std::invalid_argument("EventFileWriter.add_cd_events expects a structured array with x, y, p and t "
+                                    "fields");
+    }
+    using ColumnU16 = py::array_t<std::uint16_t, py::array::forcecast>;
+    add_cd_events_columns(writer, ColumnU16(py::object(events[py::str("x")])),
+                          ColumnU16(py::object(events[py::str("y")])),
+                          py::array_t<std::int16_t, py::array::forcecast>(py::object(events[py::str("p")])),
+                          py::array_t<std::int64_t, py::array::forcecast>(py::object(events[py::str("t")])));
+}
+
+/// @brief Adds trigger events to a writer, with the GIL released
+inline void add_ext_trigger_events(
+    EventFileWriter &writer,
+    const py::array_t<EventExtTrigger, py::array::c_style | py::array::forcecast> &events) {
+    if (events.ndim() > 1) {
+        throw std::invalid_argument("EventFileWriter.add_ext_trigger_events expects one dimentional arrays");
+    }
+    auto *begin = events.data();
+    auto *end   = begin + events.size();
+    py::gil_scoped_release release;
+    writer.add_events(begin, end);
+}
+
+/// @brief Binds the methods adding events to a writer
+template<typename Writer>
+void export_event_file_writer_add_events(py::class_<Writer> &writer) {
+    writer
+        .def(
+            "add_cd_events", [](Writer &self, const py::array &events) { add_cd_events(self, events); },
+            py::arg("events"),
+            "Adds an array of CD events to write to the file\n"
+            "\n"
+            "The GIL is released while the events are added, they are then encoded and written by a background "
+            "thread.\n"
+            "\n"
+            "Args:\n"
+            "    events: numpy array of EventCD, or any structured array with x, y, p and t fields\n")
+        .def(
+            "add_cd_events_columns",
+            [](Writer &self, const py::array_t<std::uint16_t, py::array::forcecast> &x,
+               const py::array_t<std::uint16_t, py::array::forcecast> &y,
+               const py::array_t<std::int16_t, py::array::forcecast> &p,
+               const py::array_t<std::int64_t, py::array::forcecast> &t) { add_cd_events_columns(self, x, y, p, t); },
+            py::arg("x"), py::arg("y"), py::arg("p"), py::arg("t"),
+            "Adds CD events given as separate arrays to write to the file\n"
+            "\n"
+            "The GIL is released while the events are added, they are then encoded and written by a background "
+            "thread.\n"
+            "\n"
+            "Args:\n"
+            "    x: numpy array of the events' columns\n"
+            "    y: numpy array of the events' rows\n"
+            "    p: numpy array of the events' polarities\n"
+            "    t: numpy array of the events' timestamps\n")
+        .def(
+            "add_ext_trigger_events",
+            [](Writer &self, const py::array_t<EventExtTrigger, py::array::c_style | py::array::forcecast> &events) {
+                add_ext_trigger_events(self, events);
+            },
+            py::arg("events"),
+            "Adds an array of EventExtTrigger to write to the file\n"
+            "\n"
+            "Args:\n"
+            "    events: numpy array of EventExtTrigger\n");
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_PYTHON_BINDINGS_EVENT_FILE_WRITER_PYTHON_H
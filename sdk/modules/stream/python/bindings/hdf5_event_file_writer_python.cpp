@@ -16,6 +16,7 @@
 
 #include "metavision/sdk/stream/camera.h"
 #include "metavision/sdk/stream/hdf5_event_file_writer.h"
+#include "event_file_writer_python.h"
 #include "pb_doc_stream.h"
 
 namespace py = pybind11;
@@ -23,7 +24,9 @@ namespace py = pybind11;
 namespace Metavision {
 
 void export_hdf5_event_file_writer(py::module &m) {
-    py::class_<HDF5EventFileWriter>(m, "HDF5EventFileWriter", pybind_doc_stream["Metavision::HDF5EventFileWriter"])
+    py::class_<HDF5EventFileWriter> writer(m, "HDF5EventFileWriter",
+                                           pybind_doc_stream["Metavision::HDF5EventFileWriter"]);
+    writer
         .def(py::init<const std::filesystem::path &, const std::unordered_map<std::string, std::string>>(),
              py::arg("path") = "", py::arg("metadata_map") = std::unordered_map<std::string, std::string>())
         .def("open", &HDF5EventFileWriter::open, py::arg("path"),
@@ -34,45 +37,9 @@ void export_hdf5_event_file_writer(py::module &m) {
         .def("add_metadata", &HDF5EventFileWriter::add_metadata, py::arg("key"), py::arg("value"),
              pybind_doc_stream["Metavision::EventFileWriter::add_metadata"])
         .def("add_metadata_map_from_camera", &HDF5EventFileWriter::add_metadata_map_from_camera, py::arg("camera"),
-             pybind_doc_stream["Metavision::EventFileWriter::add_metadata_map_from_camera"])
-        .def(
-            "add_cd_events",
-            [](HDF5EventFileWriter &writer, py::array_t<EventCD> buffer) {
-                py::buffer_info buffer_info = buffer.request();
-                if (buffer_info.ndim > 1) {
-                    throw std::invalid_argument("EventFileWriter.add_cd_events expects one dimentional arrays");
-                }
-                if (buffer_info.itemsize != sizeof(EventCD)) {
-                    throw std::invalid_argument("EventFileWriter.add_cd_events received array with invalid items");
-                }
-                bool res = writer.add_events(static_cast<const EventCD *>(buffer_info.ptr),
-                                             static_cast<const EventCD *>(buffer_info.ptr) + buffer_info.size);
-            },
-            py ::arg("events"),
-            "Adds an array of EventCD to write to the file\n"
-            "\n"
-            "Args:\n"
-            "    events: numpy array of EventCD\n")
-        .def(
-            "add_ext_trigger_events",
-            [](HDF5EventFileWriter &writer, py::array_t<EventExtTrigger> buffer) {
-                py::buffer_info buffer_info = buffer.request();
-                if (buffer_info.ndim > 1) {
-                    throw std::invalid_argument(
-                        "EventFileWriter.add_ext_trigger_events expects one dimentional arrays");
-                }
-                if (buffer_info.itemsize != sizeof(EventExtTrigger)) {
-                    throw std::invalid_argument(
-                        "EventFileWriter.add_ext_trigger_events received array with invalid items");
-                }
-                bool res = writer.add_events(static_cast<const EventExtTrigger *>(buffer_info.ptr),
-                                             static_cast<const EventExtTrigger *>(buffer_info.ptr) + buffer_info.size);
-            },
-            py ::arg("events"),
-            "Adds an array of EventExtTrigger to write to the file\n"
-            "\n"
-            "Args:\n"
-            "    events: numpy array of EventExtTrigger\n");
+             pybind_doc_stream["Metavision::EventFileWriter::add_metadata_map_from_camera"]);
+
+    export_event_file_writer_add_events(writer);
 }
 
 } // namespace Metavision
@@ -18,6 +18,7 @@
 
 #include "metavision/sdk/stream/camera.h"
 #include "metavision/sdk/stream/raw_evt2_event_file_writer.h"
+#include "event_file_writer_python.h"
 #include "pb_doc_stream.h"
 
 namespace py = pybind11;
@@ -25,8 +26,9 @@ namespace py = pybind11;
 namespace Metavision {
 
 void export_raw_evt2_event_file_writer(py::module &m) {
-    py::class_<RAWEvt2EventFileWriter>(m, "RAWEvt2EventFileWriter",
-                                       pybind_doc_stream["Metavision::RAWEvt2EventFileWriter"])
+    py::class_<RAWEvt2EventFileWriter> writer(m, "RAWEvt2EventFileWriter",
+                                              pybind_doc_stream["Metavision::RAWEvt2EventFileWriter"]);
+    writer
         .def(py::init<int, int, const std::filesystem::path &, bool,
                       const std::unordered_map<std::string, std::string> &, timestamp>(),
              py::arg("stream_width"), py::arg("stream_height"), py::arg("path") = std::filesystem::path(),
@@ -39,45 +41,9 @@ void export_raw_evt2_event_file_writer(py::module &m) {
         .def("is_open", &RAWEvt2EventFileWriter::is_open, pybind_doc_stream["Metavision::EventFileWriter::is_open"])
         .def("flush", &RAWEvt2EventFileWriter::flush, pybind_doc_stream["Metavision::EventFileWriter::flush"])
         .def("add_metadata", &RAWEvt2EventFileWriter::add_metadata, py::arg("key"), py::arg("value"),
-             pybind_doc_stream["Metavision::EventFileWriter::add_metadata"])
-        .def(
-            "add_cd_events",
-            [](RAWEvt2EventFileWriter &writer, py::array_t<EventCD> buffer) {
-                py::buffer_info buffer_info = buffer.request();
-                if (buffer_info.ndim > 1) {
-                    throw std::invalid_argument("EventFileWriter.add_cd_events expects one dimentional arrays");
-                }
-                if (buffer_info.itemsize != sizeof(EventCD)) {
-                    throw std::invalid_argument("EventFileWriter.add_cd_events received array with invalid items");
-                }
-                bool res = writer.add_events(static_cast<const EventCD *>(buffer_info.ptr),
-                                             static_cast<const EventCD *>(buffer_info.ptr) + buffer_info.size);
-            },
-            py ::arg("events"),
-            "Adds an array of EventCD to write to the file\n"
-            "\n"
-            "Args:\n"
-            "    events: numpy array of EventCD\n")
-        .def(
-            "add_ext_trigger_events",
-            [](RAWEvt2EventFileWriter &writer, py::array_t<EventExtTrigger> buffer) {
-                py::buffer_info buffer_info = buffer.request();
-                if (buffer_info.ndim > 1) {
-                    throw std::invalid_argument(
-                        "EventFileWriter.add_ext_trigger_events expects one dimentional arrays");
-                }
-                if (buffer_info.itemsize != sizeof(EventExtTrigger)) {
-                    throw std::invalid_argument(
-                        "EventFileWriter.add_ext_trigger_events received array with invalid items");
-                }
-                bool res = writer.add_events(static_cast<const EventExtTrigger *>(buffer_info.ptr),
-                                             static_cast<const EventExtTrigger *>(buffer_info.ptr) + buffer_info.size);
-            },
-            py ::arg("events"),
-            "Adds an array of EventExtTrigger to write to the file\n"
-            "\n"
-            "Args:\n"
-            "    events: numpy array of EventExtTrigger\n");
+             pybind_doc_stream["Metavision::EventFileWriter::add_metadata"]);
+
+    export_event_file_writer_add_events(writer);
 }
 
 } // namespace Metavision
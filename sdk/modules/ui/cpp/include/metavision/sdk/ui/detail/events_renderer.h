@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_EVENTS_RENDERER_H
+#define METAVISION_EVENTS_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/colors.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Renders CD events as points, without generating any image on the CPU side
+///
+/// The events are appended as is to a ring vertex buffer. The decay of the events and their coloring are computed by
+/// the shaders, based on the age of each event with respect to the most recent one.
+/// @warning All the methods must be called from the thread in which the OpenGL context is current
+class EventsRenderer {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param capacity Maximum number of events that can be displayed at once
+    EventsRenderer(int width, int height, std::size_t capacity);
+
+    /// @brief Destructor
+    ~EventsRenderer();
+
+    EventsRenderer(const EventsRenderer &)            = delete;
+    EventsRenderer &operator=(const EventsRenderer &) = delete;
+
+    /// @brief Sets the duration after which an event is no longer displayed
+    void set_decay_time(timestamp decay_time_us);
+
+    /// @brief Sets the colors of the background and of the events
+    void set_color_palette(ColorPalette palette);
+
+    /// @brief Uploads events to the vertex buffer
+    ///
+    /// Only the last @p capacity events are kept when more are added.
+    /// @param begin Beginning of the events, sorted by timestamps
+    /// @param end End of the events
+    void add_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Discards all the events
+    void clear();
+
+    /// @brief Draws the events still alive at the timestamp of the most recent event in the current viewport
+    /// @param viewport_width Width of the current viewport
+    void draw(int viewport_width);
+
+private:
+    /// @brief Range of events uploaded in a call to @ref add_events
+    struct Chunk {
+        std::uint64_t end;    ///< Absolute index of the chunk's last event, plus one
+        timestamp last_ts;    ///< Timestamp of the chunk's last event
+    };
+
+    void draw_range(std::uint64_t begin, std::uint64_t end);
+
+    const int width_;
+    const int height_;
+    const std::size_t capacity_;
+
+    unsigned int program_id_{0};
+    unsigned int vertex_array_id_{0};
+    unsigned int vertex_buffer_{0};
+
+    timestamp decay_time_us_{20000};
+    RGBColor bg_color_, on_color_, off_color_;
+
+    std::uint64_t head_{0}; ///< Absolute index of the next event to write
+    std::uint64_t tail_{0}; ///< Absolute index of the oldest event to draw
+    std::deque<Chunk> chunks_;
+    timestamp last_ts_{0};
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_EVENTS_RENDERER_H
@@ -12,6 +12,8 @@
 #ifndef METAVISION_TEXTURE_UTILS_H
 #define METAVISION_TEXTURE_UTILS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <opencv2/core.hpp>
 
 namespace Metavision {
@@ -32,6 +34,41 @@ unsigned int initialize_texture(const TextureOptions &options);
 
 void upload_texture(const cv::Mat &img, const unsigned int &tex_id);
 
+/// @brief Buffer object used as source of asynchronous texture uploads
+struct PixelBuffer {
+    unsigned int id{0};
+    std::size_t size{0};
+    /// Pointer to the buffer's memory when persistently mapped, nullptr otherwise
+    std::uint8_t *mapped{nullptr};
+};
+
+/// @brief Checks if the current context supports persistently mapped buffers (i.e. GL 4.4 or ARB_buffer_storage)
+bool is_persistent_mapping_supported();
+
+/// @brief Creates a pixel unpack buffer
+/// @param size Size of the buffer in bytes
+/// @param persistent If true, the buffer is persistently and coherently mapped for writing
+PixelBuffer create_pixel_buffer(std::size_t size, bool persistent);
+
+/// @brief Unmaps and deletes a pixel buffer
+void destroy_pixel_buffer(PixelBuffer &pbo);
+
+/// @brief Copies an image into a pixel buffer, rows being tightly packed
+/// @note The buffer is temporarily mapped if it is not persistently mapped
+void write_pixel_buffer(const cv::Mat &img, PixelBuffer &pbo);
+
+/// @brief Uploads tightly packed pixels stored in a pixel buffer to a texture
+///
+/// The copy is performed asynchronously by the driver. The texture storage is reused when its size matches the
+/// image's one.
+/// @param pbo Buffer holding the pixels
+/// @param size Size of the image stored in the buffer
+/// @param type OpenCV type of the image stored in the buffer
+/// @param tex_id Texture to upload to
+/// @param reallocate If true, the texture storage is reallocated to the image's size
+void upload_texture(const PixelBuffer &pbo, const cv::Size &size, int type, const unsigned int &tex_id,
+                    bool reallocate);
+
 } // namespace detail
 } // namespace Metavision
 
@@ -12,20 +12,41 @@
 #ifndef METAVISION_SDK_UI_MT_WINDOW_H
 #define METAVISION_SDK_UI_MT_WINDOW_H
 
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include <opencv2/core.hpp>
 
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/utils/colors.h"
+#include "metavision/sdk/core/utils/triple_buffer.h"
 #include "metavision/sdk/ui/utils/base_window.h"
+#include "metavision/sdk/ui/detail/texture_utils.h"
 
 namespace Metavision {
 
+namespace detail {
+class EventsRenderer;
+} // namespace detail
+
 /// @brief Window using its own rendering thread to render images
 ///
 /// Images are displayed at a fixed frequency (i.e. the screen's refresh one) by the internal rendering thread.
 ///
+/// Instead of images, CD events can directly be displayed with @ref show_events_async. In that case, no frame is
+/// generated on the CPU side: the events are streamed to the GPU and their decay and coloring is done by the shaders.
+///
 /// @warning The constructor and destructor of this class must only be called from the main thread
 class MTWindow : public BaseWindow {
 public:
+    /// @brief Parameters of the events rendering mode
+    struct EventsRenderingParameters {
+        timestamp decay_time_us = 20000;              ///< Duration after which an event is no longer displayed
+        ColorPalette palette    = ColorPalette::Dark; ///< Colors of the background and of the events
+        std::size_t max_events  = 1 << 22;            ///< Maximum number of events that can be displayed at once
+    };
+
     /// @brief Constructor
     /// @param title The window's title
     /// @param width Width of the window at starting time (can be resized later on) and width of the images that will be
@@ -44,28 +65,113 @@ public:
     ///
     /// Here asynchronously means that the image is not immediately displayed, but will be done later on by the internal
     /// rendering thread.
-    /// This window uses a front/back buffers mechanism to avoid copying images.
+    /// This window hands the images over to the rendering thread through a lock-free triple buffer to avoid copying
+    /// them. The images are then uploaded to the GPU through a ring of pixel buffer objects, so that the rendering
+    /// thread does not wait for the copy to complete.
     ///
     /// @param image The image to display. The image is passed as a non constant reference in order to be swapped with
-    /// the front buffer and thus avoid useless copies.
+    /// a buffer of the triple buffer and thus avoid useless copies. If the image has been obtained from
+    /// @ref acquire_image, it is replaced by a newly acquired one.
     /// @param auto_poll If True, events in this window's queue are dequeued and processed. If false,
     /// @ref BaseWindow::poll_events must explicitly be called.
     /// @warning If @p auto_poll is True, the events are processed in this method's calling thread, not in the internal
     /// rendering one.
+    /// @note This method can be called from several threads, the images are then displayed in the order they are
+    /// published
     void show_async(cv::Mat &image, bool auto_poll = true);
 
+    /// @brief Gets an image to render into before passing it to @ref show_async
+    ///
+    /// When persistently mapped buffers are supported by the OpenGL implementation, the returned image directly wraps
+    /// the memory of a pixel buffer object. Rendering into it (e.g. with a frame generation algorithm) and passing it
+    /// to @ref show_async then avoids any copy of the image on the CPU side. Otherwise, or if all the pixel buffers are
+    /// in use, a regular image is returned. A pixel buffer is given back to the window once the image wrapping it is
+    /// shown, or once all the references to this image are released.
+    /// @return An image of the window's initial size and of the type corresponding to the rendering mode
+    /// @warning The returned image must not be resized. It remains valid after the window is closed (e.g. by the user),
+    /// but its content must not be accessed anymore once the window has been destroyed
+    cv::Mat acquire_image();
+
+    /// @brief Sets the parameters used to display the events passed to @ref show_events_async
+    /// @param params The rendering parameters
+    /// @note The maximum number of events is only taken into account before the first events are displayed
+    void set_events_rendering_parameters(const EventsRenderingParameters &params);
+
+    /// @brief Asynchronously displays CD events
+    ///
+    /// The events are appended to the ones already displayed and the window switches to the events rendering mode,
+    /// until @ref show_async is called again. An event is displayed with an intensity that decreases linearly with its
+    /// age, relative to the most recent event, and it disappears once older than the decay time.
+    /// Events that have not been displayed yet are dropped, oldest first, when more than the maximum number of events
+    /// that can be displayed at once are pending.
+    /// @param begin Beginning of the events, sorted by timestamps
+    /// @param end End of the events
+    /// @param auto_poll If True, events in this window's queue are dequeued and processed. If false,
+    /// @ref BaseWindow::poll_events must explicitly be called.
+    void show_events_async(const EventCD *begin, const EventCD *end, bool auto_poll = true);
+
 private:
+    /// @brief State of a pixel buffer object of the upload ring
+    struct UploadSlot {
+        enum class State { Free, Acquired, Writing, Ready, Uploading };
+
+        detail::PixelBuffer pbo;
+        State state{State::Free};
+        GLsync fence{nullptr};
+    };
+
+    class MappedImageAllocator;
+
     /// @brief The internal rendering thread
     void rendering_loop();
 
-    /// @brief If the front buffer has been updated, swaps the front and back buffers and uploads the back buffer to the
-    /// GPU.
+    /// @brief Creates the pixel buffer objects used to upload the images
+    void initialize_upload_slots();
+
+    /// @brief Releases the pixel buffer objects
+    /// @warning Must be called with the OpenGL context current, once the rendering thread has exited
+    void release_upload_slots();
+
+    /// @brief Checks if a slot can be written to, i.e. if it is free or if the image acquired from it has been released
+    /// without being shown
+    bool is_slot_available(int slot_index) const;
+
+    /// @brief Gives back to the pool the slots whose upload is complete
+    /// @param lock Lock held on @ref swap_mtx_
+    /// @param wait If true, waits for the oldest pending upload to complete if no slot is free. The lock is released
+    /// while waiting, so that the producers are not blocked by the GPU
+    void recycle_upload_slots(std::unique_lock<std::mutex> &lock, bool wait);
+
+    /// @brief Same as @ref acquire_image but expects @ref swap_mtx_ to be locked
+    cv::Mat acquire_image_locked();
+
+    /// @brief If a new image has been shown, uploads it to the GPU
     void upload_texture_if_updated();
 
-    bool has_been_updated_;
-    std::mutex swap_mtx_;
-    cv::Mat front_;
-    cv::Mat back_;
+    /// @brief Uploads the content of a slot to the texture and protects the slot until the upload is complete
+    void upload_slot(UploadSlot &slot);
+
+    /// @brief Uploads the events received since the last call and draws them
+    void draw_events();
+
+    TripleBuffer<cv::Mat> images_;
+    std::mutex publish_mtx_; ///< Serializes the threads showing images, as @ref images_ only supports one producer
+    std::mutex swap_mtx_; ///< Protects the upload slots and the events rendering state
+
+    static constexpr int kNumUploadSlots = 3;
+    std::vector<UploadSlot> upload_slots_;
+    int ready_slot_{-1};
+    MappedImageAllocator *mapped_image_allocator_{nullptr}; ///< Outlives the window until its images are released
+    bool use_mapped_slots_{false};
+    cv::Size image_size_;   ///< Size of the images stored in the pixel buffers
+    cv::Size texture_size_; ///< Size of the texture storage
+
+    bool events_mode_{false};
+    bool events_params_updated_{false};
+    EventsRenderingParameters events_params_;
+    std::vector<EventCD> events_front_;
+    std::vector<EventCD> events_back_;
+    std::unique_ptr<detail::EventsRenderer> events_renderer_;
 
     std::thread rendering_loop_;
 };
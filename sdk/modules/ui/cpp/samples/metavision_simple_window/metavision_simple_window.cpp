@@ -92,7 +92,9 @@ int main() {
         // Poll all the events from the system and send them to the corresponding windows' internal queues.
         Metavision::EventLoop::poll_and_dispatch();
 
-        auto img2 = img.clone();
+        // The image is acquired from the window, so that it can be directly uploaded to the GPU without another copy
+        auto img2 = w2.acquire_image();
+        img.copyTo(img2);
 
         // This call will:
         // - Poll and process the events received by the window 2. The attached callbacks are processed here in the main
@@ -0,0 +1,191 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "metavision/sdk/ui/utils/opengl_api.h"
+#include "metavision/sdk/ui/detail/shader_utils.h"
+#include "metavision/sdk/ui/detail/events_renderer.h"
+
+namespace Metavision {
+namespace detail {
+
+namespace {
+
+// The events are read as is from the vertex buffer, the timestamps being truncated to their 32 least significant bits
+// (little endian). Ages are computed with unsigned arithmetic, which makes them robust to the wrap-around of the
+// truncated timestamps.
+const char *vertex_shader_str = "#version 310 es\n"
+                                "layout(location = 0) in uint x;\n"
+                                "layout(location = 1) in uint y;\n"
+                                "layout(location = 2) in int p;\n"
+                                "layout(location = 3) in uint t;\n"
+                                "uniform uint current_ts;\n"
+                                "uniform float decay_time;\n"
+                                "uniform vec2 sensor_size;\n"
+                                "uniform float point_size;\n"
+                                "out float intensity;\n"
+                                "out float polarity;\n"
+                                "void main(){\n"
+                                "    intensity = 1.0 - float(current_ts - t) / decay_time;\n"
+                                "    polarity = p > 0 ? 1.0 : 0.0;\n"
+                                "    vec2 pos = (vec2(float(x), float(y)) + 0.5) / sensor_size;\n"
+                                "    // Expired events are moved out of the clip volume to be culled before rasterization\n"
+                                "    gl_Position = intensity > 0.0 ? vec4(2.0 * pos.x - 1.0, 1.0 - 2.0 * pos.y, 0.0, 1.0) :\n"
+                                "                                    vec4(2.0, 2.0, 2.0, 1.0);\n"
+                                "    gl_PointSize = point_size;\n"
+                                "}\n";
+
+const char *fragment_shader_str = "#version 310 es\n"
+                                  "in mediump float intensity;\n"
+                                  "in mediump float polarity;\n"
+                                  "uniform mediump vec3 background_color;\n"
+                                  "uniform mediump vec3 on_color;\n"
+                                  "uniform mediump vec3 off_color;\n"
+                                  "out mediump vec3 color;\n"
+                                  "void main(){\n"
+                                  "    if (intensity <= 0.0) discard;\n"
+                                  "    color = mix(background_color, mix(off_color, on_color, polarity), intensity);\n"
+                                  "}\n";
+
+template<typename T>
+const void *offset_of(const EventCD &ev, const T &field) {
+    return reinterpret_cast<const void *>(reinterpret_cast<const char *>(&field) -
+                                          reinterpret_cast<const char *>(&ev));
+}
+
+} // anonymous namespace
+
+EventsRenderer::EventsRenderer(int width, int height, std::size_t capacity) :
+    width_(width), height_(height), capacity_(std::max<std::size_t>(1, capacity)) {
+    program_id_ = load_program(vertex_shader_str, fragment_shader_str);
+    set_color_palette(ColorPalette::Dark);
+
+    glGenVertexArrays(1, &vertex_array_id_);
+    glBindVertexArray(vertex_array_id_);
+
+    glGenBuffers(1, &vertex_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    glBufferData(GL_ARRAY_BUFFER, capacity_ * sizeof(EventCD), nullptr, GL_STREAM_DRAW);
+
+    const EventCD ev{};
+    const GLsizei stride = sizeof(EventCD);
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_SHORT, stride, offset_of(ev, ev.x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_SHORT, stride, offset_of(ev, ev.y));
+    glEnableVertexAttribArray(1);
+    glVertexAttribIPointer(2, 1, GL_SHORT, stride, offset_of(ev, ev.p));
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, stride, offset_of(ev, ev.t));
+    glEnableVertexAttribArray(3);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+#ifdef GL_PROGRAM_POINT_SIZE
+    // Always enabled in OpenGL ES
+    glEnable(GL_PROGRAM_POINT_SIZE);
+#endif
+}
+
+EventsRenderer::~EventsRenderer() {
+    glDeleteBuffers(1, &vertex_buffer_);
+    glDeleteVertexArrays(1, &vertex_array_id_);
+    glDeleteProgram(program_id_);
+}
+
+void EventsRenderer::set_decay_time(timestamp decay_time_us) {
+    decay_time_us_ = std::max<timestamp>(1, decay_time_us);
+}
+
+void EventsRenderer::set_color_palette(ColorPalette palette) {
+    bg_color_  = get_color(palette, ColorType::Background);
+    on_color_  = get_color(palette, ColorType::Positive);
+    off_color_ = get_color(palette, ColorType::Negative);
+}
+
+void EventsRenderer::add_events(const EventCD *begin, const EventCD *end) {
+    if (begin == end) {
+        return;
+    }
+
+    // Older events would be overwritten anyway
+    if (static_cast<std::size_t>(end - begin) > capacity_) {
+        head_ += (end - begin) - capacity_;
+        begin = end - capacity_;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    while (begin != end) {
+        const std::size_t pos   = head_ % capacity_;
+        const std::size_t count = std::min<std::size_t>(capacity_ - pos, end - begin);
+        glBufferSubData(GL_ARRAY_BUFFER, pos * sizeof(EventCD), count * sizeof(EventCD), begin);
+        head_ += count;
+        begin += count;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    last_ts_ = std::max(last_ts_, (end - 1)->t);
+    chunks_.push_back({head_, (end - 1)->t});
+    tail_ = std::max(tail_, head_ > capacity_ ? head_ - capacity_ : 0);
+}
+
+void EventsRenderer::clear() {
+    tail_ = head_;
+    chunks_.clear();
+}
+
+void EventsRenderer::draw(int viewport_width) {
+    // Skips the chunks whose events have all expired
+    while (!chunks_.empty() && chunks_.front().last_ts <= last_ts_ - decay_time_us_) {
+        tail_ = std::max(tail_, chunks_.front().end);
+        chunks_.pop_front();
+    }
+
+    glClearColor(static_cast<GLfloat>(bg_color_.r), static_cast<GLfloat>(bg_color_.g),
+                 static_cast<GLfloat>(bg_color_.b), 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (tail_ == head_) {
+        return;
+    }
+
+    glUseProgram(program_id_);
+    glUniform1ui(glGetUniformLocation(program_id_, "current_ts"), static_cast<GLuint>(last_ts_));
+    glUniform1f(glGetUniformLocation(program_id_, "decay_time"), static_cast<GLfloat>(decay_time_us_));
+    glUniform2f(glGetUniformLocation(program_id_, "sensor_size"), static_cast<GLfloat>(width_),
+                static_cast<GLfloat>(height_));
+    glUniform1f(glGetUniformLocation(program_id_, "point_size"),
+                std::max(1.f, static_cast<GLfloat>(viewport_width) / width_));
+    glUniform3f(glGetUniformLocation(program_id_, "background_color"), bg_color_.r, bg_color_.g, bg_color_.b);
+    glUniform3f(glGetUniformLocation(program_id_, "on_color"), on_color_.r, on_color_.g, on_color_.b);
+    glUniform3f(glGetUniformLocation(program_id_, "off_color"), off_color_.r, off_color_.g, off_color_.b);
+
+    glBindVertexArray(vertex_array_id_);
+    // The events are drawn from the oldest to the most recent one, so that the most recent event of a pixel is the one
+    // displayed
+    const std::uint64_t wrap = (tail_ / capacity_ + 1) * capacity_;
+    if (head_ > wrap) {
+        draw_range(tail_, wrap);
+        draw_range(wrap, head_);
+    } else {
+        draw_range(tail_, head_);
+    }
+    glBindVertexArray(0);
+}
+
+void EventsRenderer::draw_range(std::uint64_t begin, std::uint64_t end) {
+    glDrawArrays(GL_POINTS, static_cast<GLint>(begin % capacity_), static_cast<GLsizei>(end - begin));
+}
+
+} // namespace detail
+} // namespace Metavision
@@ -9,15 +9,113 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <opencv2/core/version.hpp>
+
 #include "metavision/sdk/ui/utils/mt_window.h"
+#include "metavision/sdk/ui/detail/events_renderer.h"
 #include "metavision/sdk/ui/detail/texture_utils.h"
 
 namespace Metavision {
 
+/// @brief Allocator of the images wrapping the pixel buffers, counting the references to each of them
+///
+/// The allocator is detached from the window when it is destroyed, and deletes itself once the last image is released.
+class MTWindow::MappedImageAllocator : public cv::MatAllocator {
+public:
+#if CV_VERSION_MAJOR >= 4
+    using AccessFlag = cv::AccessFlag;
+#else
+    using AccessFlag = int;
+#endif
+
+    explicit MappedImageAllocator(int num_slots) : num_refs_(num_slots, 0) {}
+
+    /// @brief Creates an image wrapping the memory of a slot
+    cv::Mat make_image(int slot_index, std::uint8_t *data, const cv::Size &size, int type) {
+        pending_slot_index_ = slot_index;
+        pending_data_       = data;
+
+        cv::Mat image;
+        image.allocator = this;
+        image.create(size, type);
+        return image;
+    }
+
+    bool is_referenced(int slot_index) const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return num_refs_[slot_index] > 0;
+    }
+
+    void detach() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        detached_ = true;
+        if (num_images_ == 0) {
+            lock.unlock();
+            delete this;
+        }
+    }
+
+    cv::UMatData *allocate(int dims, const int *sizes, int type, void *, size_t *step, AccessFlag,
+                           cv::UMatUsageFlags) const override {
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; --i) {
+            if (step) {
+                step[i] = total;
+            }
+            total *= sizes[i];
+        }
+
+        auto u      = new cv::UMatData(this);
+        u->data     = pending_data_;
+        u->origdata = pending_data_;
+        u->size     = total;
+        u->userdata = reinterpret_cast<void *>(static_cast<std::intptr_t>(pending_slot_index_));
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        ++num_refs_[pending_slot_index_];
+        ++num_images_;
+        return u;
+    }
+
+    bool allocate(cv::UMatData *u, AccessFlag, cv::UMatUsageFlags) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData *u) const override {
+        if (!u) {
+            return;
+        }
+        const auto slot_index = static_cast<int>(reinterpret_cast<std::intptr_t>(u->userdata));
+        delete u;
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        --num_refs_[slot_index];
+        if (--num_images_ == 0 && detached_) {
+            lock.unlock();
+            delete this;
+        }
+    }
+
+private:
+    // Only accessed by make_image, which is called with the window's swap mutex locked
+    int pending_slot_index_{0};
+    std::uint8_t *pending_data_{nullptr};
+
+    mutable std::mutex mtx_;
+    mutable std::vector<int> num_refs_;
+    mutable int num_images_{0};
+    bool detached_{false};
+};
+
 MTWindow::MTWindow(const std::string &title, int width, int height, RenderMode mode) :
-    BaseWindow(title, width, height, mode) {
-    has_been_updated_ = false;
-    rendering_loop_   = std::thread(&MTWindow::rendering_loop, this);
+    BaseWindow(title, width, height, mode),
+    mapped_image_allocator_(new MappedImageAllocator(kNumUploadSlots)),
+    image_size_(width, height),
+    texture_size_(width, height) {
+    rendering_loop_ = std::thread(&MTWindow::rendering_loop, this);
 }
 
 MTWindow::~MTWindow() noexcept {
@@ -26,6 +124,12 @@ MTWindow::~MTWindow() noexcept {
 
         rendering_loop_.join();
     }
+
+    // The pixel buffers are kept mapped until now, even if the window has been closed before, as the images acquired
+    // from them may still be in use
+    glfwMakeContextCurrent(glfw_window_);
+    release_upload_slots();
+    mapped_image_allocator_->detach();
 }
 
 void MTWindow::show_async(cv::Mat &image, bool auto_poll) {
@@ -35,13 +139,85 @@ void MTWindow::show_async(cv::Mat &image, bool auto_poll) {
     if (auto_poll)
         poll_events();
 
-    std::lock_guard<std::mutex> lock(swap_mtx_);
+    {
+        std::lock_guard<std::mutex> lock(swap_mtx_);
+        events_mode_ = false;
+
+        // the previous image has not been uploaded yet, it is skipped
+        if (ready_slot_ >= 0) {
+            upload_slots_[ready_slot_].state = UploadSlot::State::Free;
+            ready_slot_                      = -1;
+        }
+
+        for (int i = 0; i < static_cast<int>(upload_slots_.size()); ++i) {
+            auto &slot = upload_slots_[i];
+            if (slot.state == UploadSlot::State::Acquired && image.data == slot.pbo.mapped) {
+                // the image has been rendered directly in the pixel buffer, there is nothing to copy
+                slot.state  = UploadSlot::State::Ready;
+                ready_slot_ = i;
+                image       = acquire_image_locked();
+                return;
+            }
+        }
+    }
+
+    // the triple buffer only supports one producer, while images may be shown from several threads
+    std::lock_guard<std::mutex> lock(publish_mtx_);
 
     // pre-allocate the frame for the next time
-    front_.create(image.size(), image.type());
+    cv::Mat &back = images_.write_buffer();
+    back.create(image.size(), image.type());
 
-    cv::swap(image, front_);
-    has_been_updated_ = true;
+    cv::swap(image, back);
+    images_.publish();
+}
+
+cv::Mat MTWindow::acquire_image() {
+    std::lock_guard<std::mutex> lock(swap_mtx_);
+    return acquire_image_locked();
+}
+
+cv::Mat MTWindow::acquire_image_locked() {
+    const int type = (render_mode_ == RenderMode::GRAY) ? CV_8UC1 : CV_8UC3;
+    if (use_mapped_slots_) {
+        for (int i = 0; i < static_cast<int>(upload_slots_.size()); ++i) {
+            if (is_slot_available(i)) {
+                auto &slot = upload_slots_[i];
+                slot.state = UploadSlot::State::Acquired;
+                return mapped_image_allocator_->make_image(i, slot.pbo.mapped, image_size_, type);
+            }
+        }
+    }
+
+    return cv::Mat(image_size_, type);
+}
+
+void MTWindow::set_events_rendering_parameters(const EventsRenderingParameters &params) {
+    std::lock_guard<std::mutex> lock(swap_mtx_);
+    events_params_         = params;
+    events_params_updated_ = true;
+}
+
+void MTWindow::show_events_async(const EventCD *begin, const EventCD *end, bool auto_poll) {
+    if (auto_poll)
+        poll_events();
+
+    std::lock_guard<std::mutex> lock(swap_mtx_);
+    events_mode_ = true;
+
+    // Only the most recent events can be displayed at once. Keeping only them also bounds the memory used when the
+    // events are not consumed by the rendering thread (e.g. the window has been closed)
+    const std::size_t max_events = events_params_.max_events;
+    const std::size_t num_events = static_cast<std::size_t>(end - begin);
+    if (num_events >= max_events) {
+        events_front_.assign(end - max_events, end);
+        return;
+    }
+    if (events_front_.size() + num_events > max_events) {
+        events_front_.erase(events_front_.begin(),
+                            events_front_.begin() + (events_front_.size() + num_events - max_events));
+    }
+    events_front_.insert(events_front_.end(), begin, end);
 }
 
 void MTWindow::rendering_loop() {
@@ -50,30 +226,179 @@ void MTWindow::rendering_loop() {
     // Enable the V-Sync
     glfwSwapInterval(1);
 
+    initialize_upload_slots();
+
     while (!glfwWindowShouldClose(glfw_window_)) {
-        upload_texture_if_updated();
+        bool events_mode;
+        {
+            std::lock_guard<std::mutex> lock(swap_mtx_);
+            events_mode = events_mode_;
+        }
 
-        draw_background_texture();
+        if (events_mode) {
+            draw_events();
+        } else {
+            upload_texture_if_updated();
+
+            draw_background_texture();
+        }
     }
 
+    events_renderer_.reset();
+
+    // the pixel buffers are released by the destructor, once the images acquired from them can't be used anymore
     glfwMakeContextCurrent(nullptr);
 }
 
+void MTWindow::initialize_upload_slots() {
+    const bool persistent = detail::is_persistent_mapping_supported();
+    const std::size_t size =
+        image_size_.area() * static_cast<std::size_t>(render_mode_ == RenderMode::GRAY ? 1 : 3);
+
+    std::lock_guard<std::mutex> lock(swap_mtx_);
+    upload_slots_.resize(kNumUploadSlots);
+    use_mapped_slots_ = persistent;
+    for (auto &slot : upload_slots_) {
+        slot.pbo = detail::create_pixel_buffer(size, persistent);
+        use_mapped_slots_ &= (slot.pbo.mapped != nullptr);
+    }
+}
+
+void MTWindow::release_upload_slots() {
+    std::lock_guard<std::mutex> lock(swap_mtx_);
+    for (auto &slot : upload_slots_) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        detail::destroy_pixel_buffer(slot.pbo);
+    }
+    upload_slots_.clear();
+    ready_slot_       = -1;
+    use_mapped_slots_ = false;
+}
+
+bool MTWindow::is_slot_available(int slot_index) const {
+    const auto state = upload_slots_[slot_index].state;
+    return (state == UploadSlot::State::Free || state == UploadSlot::State::Acquired) &&
+           !mapped_image_allocator_->is_referenced(slot_index);
+}
+
+void MTWindow::recycle_upload_slots(std::unique_lock<std::mutex> &lock, bool wait) {
+    UploadSlot *oldest_uploading = nullptr;
+    bool has_free_slot           = false;
+
+    for (int i = 0; i < static_cast<int>(upload_slots_.size()); ++i) {
+        auto &slot = upload_slots_[i];
+        if (slot.state == UploadSlot::State::Uploading) {
+            if (glClientWaitSync(slot.fence, 0, 0) != GL_TIMEOUT_EXPIRED) {
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                slot.state = UploadSlot::State::Free;
+            } else {
+                oldest_uploading = oldest_uploading ? oldest_uploading : &slot;
+            }
+        }
+        has_free_slot |= is_slot_available(i);
+    }
+
+    if (wait && !has_free_slot && oldest_uploading) {
+        // the uploading slots are only modified by the rendering thread, the slot can be waited for without the lock
+        lock.unlock();
+        glClientWaitSync(oldest_uploading->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        lock.lock();
+        glDeleteSync(oldest_uploading->fence);
+        oldest_uploading->fence = nullptr;
+        oldest_uploading->state = UploadSlot::State::Free;
+    }
+}
+
+void MTWindow::upload_slot(UploadSlot &slot) {
+    const int type = (render_mode_ == RenderMode::GRAY) ? CV_8UC1 : CV_8UC3;
+    // the texture storage is only reallocated if a synchronous upload of an image of another size happened before
+    detail::upload_texture(slot.pbo, image_size_, type, tex_id_, texture_size_ != image_size_);
+    texture_size_ = image_size_;
+
+    slot.state = UploadSlot::State::Uploading;
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
 void MTWindow::upload_texture_if_updated() {
-    bool do_upload = false;
+    std::unique_lock<std::mutex> lock(swap_mtx_);
 
+    recycle_upload_slots(lock, false);
+
+    if (ready_slot_ >= 0) {
+        // the image has been rendered directly in a pixel buffer, any image shown before is outdated
+        upload_slot(upload_slots_[ready_slot_]);
+        ready_slot_ = -1;
+        images_.update();
+        return;
+    }
+
+    if (!images_.update() || images_.read_buffer().empty())
+        return;
+
+    // the read buffer is only accessed by this thread, it can be used without holding the lock
+    const cv::Mat &image = images_.read_buffer();
+
+    // Images that don't match the pixel buffers are uploaded synchronously
+    if (image.size() != image_size_ || upload_slots_.empty()) {
+        texture_size_ = image.size();
+        lock.unlock();
+        detail::upload_texture(image, tex_id_);
+        return;
+    }
+
+    recycle_upload_slots(lock, true);
+    for (int i = 0; i < static_cast<int>(upload_slots_.size()); ++i) {
+        if (is_slot_available(i)) {
+            // the slot is reserved while the lock is released for the copy
+            auto &slot = upload_slots_[i];
+            slot.state = UploadSlot::State::Writing;
+            lock.unlock();
+            detail::write_pixel_buffer(image, slot.pbo);
+            lock.lock();
+            upload_slot(slot);
+            return;
+        }
+    }
+
+    // All the slots are held by the producer, falls back to a synchronous upload
+    texture_size_ = image.size();
+    lock.unlock();
+    detail::upload_texture(image, tex_id_);
+}
+
+void MTWindow::draw_events() {
+    bool params_updated;
+    EventsRenderingParameters params;
     {
         std::lock_guard<std::mutex> lock(swap_mtx_);
+        std::swap(events_front_, events_back_);
+        params_updated         = events_params_updated_ || !events_renderer_;
+        params                 = events_params_;
+        events_params_updated_ = false;
+    }
 
-        if (has_been_updated_) {
-            cv::swap(front_, back_);
-            has_been_updated_ = false;
-            do_upload         = !back_.empty();
-        }
+    // the vertex buffer is only allocated once events are displayed
+    if (!events_renderer_) {
+        events_renderer_ = std::make_unique<detail::EventsRenderer>(width_, height_, params.max_events);
+    }
+    if (params_updated) {
+        events_renderer_->set_decay_time(params.decay_time_us);
+        events_renderer_->set_color_palette(params.palette);
     }
 
-    if (do_upload)
-        detail::upload_texture(back_, tex_id_);
+    events_renderer_->add_events(events_back_.data(), events_back_.data() + events_back_.size());
+    events_back_.clear();
+
+    int width, height;
+    glfwGetFramebufferSize(glfw_window_, &width, &height);
+    glViewport(0, 0, width, height);
+
+    events_renderer_->draw(width);
+
+    glfwSwapBuffers(glfw_window_);
 }
 
 } // namespace Metavision
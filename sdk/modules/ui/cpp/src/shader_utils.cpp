@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <string>
+
+#include "metavision/sdk/ui/utils/opengl_api.h"
+#include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/ui/detail/shader_utils.h"
+
+namespace Metavision {
+namespace detail {
+
+unsigned int load_program(const char *vertex_shader_str, const char *fragment_shader_str) {
+    // Create the shaders
+    GLuint vertex_shader_id   = glCreateShader(GL_VERTEX_SHADER);
+    GLuint fragment_shader_id = glCreateShader(GL_FRAGMENT_SHADER);
+
+    GLint result = GL_FALSE;
+    int info_log_length;
+
+    // Compile Vertex Shader
+    glShaderSource(vertex_shader_id, 1, &vertex_shader_str, NULL);
+    glCompileShader(vertex_shader_id);
+
+    // Check Vertex Shader
+    glGetShaderiv(vertex_shader_id, GL_COMPILE_STATUS, &result);
+    glGetShaderiv(vertex_shader_id, GL_INFO_LOG_LENGTH, &info_log_length);
+    if (info_log_length > 0) {
+        std::string VertexShaderErrorMessage;
+        VertexShaderErrorMessage.resize(info_log_length + 1);
+        glGetShaderInfoLog(vertex_shader_id, info_log_length, NULL, &VertexShaderErrorMessage[0]);
+        MV_SDK_LOG_ERROR() << VertexShaderErrorMessage;
+    }
+
+    // Compile Fragment Shader
+    glShaderSource(fragment_shader_id, 1, &fragment_shader_str, NULL);
+    glCompileShader(fragment_shader_id);
+
+    // Check Fragment Shader
+    glGetShaderiv(fragment_shader_id, GL_COMPILE_STATUS, &result);
+    glGetShaderiv(fragment_shader_id, GL_INFO_LOG_LENGTH, &info_log_length);
+    if (info_log_length > 0) {
+        std::string FragmentShaderErrorMessage;
+        FragmentShaderErrorMessage.resize(info_log_length + 1);
+        glGetShaderInfoLog(fragment_shader_id, info_log_length, NULL, &FragmentShaderErrorMessage[0]);
+        MV_SDK_LOG_ERROR() << FragmentShaderErrorMessage;
+    }
+
+    // Link the program
+    GLuint program_id = glCreateProgram();
+    glAttachShader(program_id, vertex_shader_id);
+    glAttachShader(program_id, fragment_shader_id);
+    glLinkProgram(program_id);
+
+    // Check the program
+    glGetProgramiv(program_id, GL_LINK_STATUS, &result);
+    glGetProgramiv(program_id, GL_INFO_LOG_LENGTH, &info_log_length);
+    if (info_log_length > 0) {
+        std::string ProgramErrorMessage;
+        ProgramErrorMessage.resize(info_log_length + 1);
+        glGetProgramInfoLog(program_id, info_log_length, NULL, &ProgramErrorMessage[0]);
+        MV_SDK_LOG_ERROR() << ProgramErrorMessage;
+    }
+
+    glDetachShader(program_id, vertex_shader_id);
+    glDetachShader(program_id, fragment_shader_id);
+
+    glDeleteShader(vertex_shader_id);
+    glDeleteShader(fragment_shader_id);
+
+    return program_id;
+}
+
+} // namespace detail
+} // namespace Metavision
@@ -9,6 +9,8 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <cassert>
+#include <cstring>
 #include <unordered_map>
 
 #include "metavision/sdk/ui/utils/opengl_api.h"
@@ -77,5 +79,94 @@ void upload_texture(const cv::Mat &img, const unsigned int &tex_id) {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+bool is_persistent_mapping_supported() {
+#if defined(GLEW_VERSION_4_4) && defined(GLEW_ARB_buffer_storage)
+    return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+#else
+    return false;
+#endif
+}
+
+PixelBuffer create_pixel_buffer(std::size_t size, bool persistent) {
+    PixelBuffer pbo;
+    pbo.size = size;
+
+    glGenBuffers(1, &pbo.id);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.id);
+#if defined(GLEW_VERSION_4_4) && defined(GLEW_ARB_buffer_storage)
+    if (persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+        pbo.mapped = static_cast<std::uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+    }
+#endif
+    if (!pbo.mapped) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    return pbo;
+}
+
+void destroy_pixel_buffer(PixelBuffer &pbo) {
+    if (pbo.mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.id);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &pbo.id);
+    pbo = PixelBuffer();
+}
+
+void write_pixel_buffer(const cv::Mat &img, PixelBuffer &pbo) {
+    const std::size_t row_size = img.cols * img.elemSize();
+    assert(row_size * img.rows <= pbo.size);
+
+    std::uint8_t *dst = pbo.mapped;
+    if (!dst) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.id);
+        // Invalidating the buffer lets the driver hand out fresh memory instead of waiting for a pending upload
+        dst = static_cast<std::uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, pbo.size,
+                                                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    }
+
+    if (dst) {
+        if (img.isContinuous()) {
+            std::memcpy(dst, img.ptr(), row_size * img.rows);
+        } else {
+            for (int y = 0; y < img.rows; ++y) {
+                std::memcpy(dst + y * row_size, img.ptr(y), row_size);
+            }
+        }
+    }
+
+    if (!pbo.mapped) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+}
+
+void upload_texture(const PixelBuffer &pbo, const cv::Size &size, int type, const unsigned int &tex_id,
+                    bool reallocate) {
+    glBindTexture(GL_TEXTURE_2D, tex_id);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.id);
+
+    // Rows are tightly packed in the buffer
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    // With a bound pixel unpack buffer, the data pointer is an offset in the buffer
+    if (reallocate) {
+        glTexImage2D(GL_TEXTURE_2D, 0, cv_to_gl_internal_format.at(type), size.width, size.height, 0,
+                     cv_to_gl_format.at(type), GL_UNSIGNED_BYTE, nullptr);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width, size.height, cv_to_gl_format.at(type), GL_UNSIGNED_BYTE,
+                        nullptr);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 } // namespace detail
 } // namespace Metavision
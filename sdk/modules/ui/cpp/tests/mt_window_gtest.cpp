@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/ui/utils/mt_window.h"
+
+using namespace Metavision;
+
+class MTWindow_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        try {
+            window_ = std::make_unique<MTWindow>("MTWindow_GTest", kWidth, kHeight, BaseWindow::RenderMode::BGR);
+        } catch (const std::runtime_error &e) { GTEST_SKIP() << "No window can be created: " << e.what(); }
+    }
+
+    // Returns true if the image wraps the memory of a pixel buffer, rather than being a regular image
+    static bool is_mapped(const cv::Mat &image) {
+        return image.allocator != nullptr;
+    }
+
+    static constexpr int kWidth  = 64;
+    static constexpr int kHeight = 48;
+    std::unique_ptr<MTWindow> window_;
+};
+
+TEST_F(MTWindow_GTest, acquired_image_matches_window) {
+    // GIVEN a window
+
+    // WHEN an image is acquired, rendered into and shown
+    cv::Mat image = window_->acquire_image();
+    EXPECT_EQ(cv::Size(kWidth, kHeight), image.size());
+    EXPECT_EQ(CV_8UC3, image.type());
+    image.setTo(cv::Scalar(0, 128, 255));
+    window_->show_async(image);
+
+    // THEN it is replaced by another image that can be rendered into
+    EXPECT_EQ(cv::Size(kWidth, kHeight), image.size());
+    EXPECT_EQ(CV_8UC3, image.type());
+}
+
+TEST_F(MTWindow_GTest, images_are_shown_continuously) {
+    // GIVEN a window
+
+    // WHEN many more images than pixel buffers are acquired and shown
+    cv::Mat image = window_->acquire_image();
+    for (int i = 0; i < 200; ++i) {
+        image.setTo(cv::Scalar(i % 256));
+        window_->show_async(image);
+
+        // THEN an image can always be rendered into
+        ASSERT_EQ(cv::Size(kWidth, kHeight), image.size());
+    }
+}
+
+TEST_F(MTWindow_GTest, released_image_gives_back_its_pixel_buffer) {
+    // GIVEN an image acquired from a window
+    cv::Mat image = window_->acquire_image();
+    if (!is_mapped(image)) {
+        GTEST_SKIP() << "Persistently mapped pixel buffers are not supported";
+    }
+    const uchar *data = image.data;
+
+    // WHEN it is released without being shown
+    image.release();
+
+    // THEN its pixel buffer is reused by the next acquired image
+    cv::Mat next_image = window_->acquire_image();
+    EXPECT_TRUE(is_mapped(next_image));
+    EXPECT_EQ(data, next_image.data);
+}
+
+TEST_F(MTWindow_GTest, held_images_fall_back_to_regular_images) {
+    // GIVEN a window whose pixel buffers are all held by acquired images
+    std::vector<cv::Mat> images;
+    images.push_back(window_->acquire_image());
+    if (!is_mapped(images.back())) {
+        GTEST_SKIP() << "Persistently mapped pixel buffers are not supported";
+    }
+    while (is_mapped(images.back())) {
+        ASSERT_LT(images.size(), 16u);
+        images.push_back(window_->acquire_image());
+    }
+
+    // WHEN one of them is shown
+    cv::Mat shown = images.front();
+    images.front().release();
+    window_->show_async(shown);
+
+    // THEN images can still be acquired and shown
+    cv::Mat image = window_->acquire_image();
+    EXPECT_EQ(cv::Size(kWidth, kHeight), image.size());
+    window_->show_async(image);
+}
+
+TEST_F(MTWindow_GTest, acquired_image_outlives_window) {
+    // GIVEN an image acquired from a window
+    cv::Mat image = window_->acquire_image();
+    image.setTo(cv::Scalar(255));
+
+    // WHEN the window is destroyed before the image
+    window_.reset();
+
+    // THEN the image can still be released
+    image.release();
+    EXPECT_TRUE(image.empty());
+}
+
+TEST_F(MTWindow_GTest, events_are_shown_until_an_image_is) {
+    // GIVEN a window displaying events
+    MTWindow::EventsRenderingParameters params;
+    params.max_events = 1024;
+    window_->set_events_rendering_parameters(params);
+
+    std::vector<EventCD> events;
+    for (int i = 0; i < 4096; ++i) {
+        events.emplace_back(i % kWidth, (i / kWidth) % kHeight, i % 2, i);
+    }
+
+    // WHEN more events than can be displayed are shown in several batches, then an image
+    for (std::size_t i = 0; i < events.size(); i += 512) {
+        window_->show_events_async(events.data() + i, events.data() + i + 512);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    cv::Mat image = window_->acquire_image();
+    window_->show_async(image);
+
+    // THEN the window keeps rendering
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(window_->should_close());
+}
+
+TEST_F(MTWindow_GTest, events_can_be_shown_after_close) {
+    // GIVEN a window that has been closed
+    window_->set_close_flag();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(window_->should_close());
+
+    // WHEN events are still shown, while they are not rendered anymore
+    MTWindow::EventsRenderingParameters params;
+    params.max_events = 1024;
+    window_->set_events_rendering_parameters(params);
+    std::vector<EventCD> events(100000, EventCD(1, 1, 1, 0));
+    for (int i = 0; i < 100; ++i) {
+        window_->show_events_async(events.data(), events.data() + events.size());
+    }
+
+    // THEN the window can be destroyed
+    window_.reset();
+}
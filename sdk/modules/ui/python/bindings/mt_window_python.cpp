@@ -12,6 +12,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/ui/utils/mt_window.h"
 
 #include "pb_doc_ui.h"
@@ -69,6 +70,41 @@ void export_mt_window(py::module &m) {
                 mt_window_ptr->show_async(image_copy, auto_poll);
             },
             "image"_a, "auto_poll"_a = true, pybind_doc_ui["Metavision::MTWindow::show_async"])
+        .def(
+            "show_events_async",
+            [](MTWindowWrapper &mt_window, py::array_t<EventCD> events, bool auto_poll) {
+                MTWindow *mt_window_ptr = mt_window.get<MTWindow>();
+                if (!mt_window_ptr)
+                    throw std::logic_error(
+                        "The window must be open to call the show method. Use open_directly=True "
+                        "when constructing the window or instantiate it using the 'with' statement.");
+
+                py::buffer_info buffer_info = events.request();
+                if (buffer_info.ndim != 1)
+                    throw std::invalid_argument("MTWindow.show_events_async expects one dimensional arrays");
+                if (buffer_info.itemsize != sizeof(EventCD))
+                    throw std::invalid_argument("MTWindow.show_events_async received array with invalid items");
+
+                auto *begin = static_cast<const EventCD *>(buffer_info.ptr);
+                mt_window_ptr->show_events_async(begin, begin + buffer_info.size, auto_poll);
+            },
+            "events"_a, "auto_poll"_a = true, pybind_doc_ui["Metavision::MTWindow::show_events_async"])
+        .def(
+            "set_events_rendering_parameters",
+            [](MTWindowWrapper &mt_window, timestamp decay_time_us, ColorPalette palette) {
+                MTWindow *mt_window_ptr = mt_window.get<MTWindow>();
+                if (!mt_window_ptr)
+                    throw std::logic_error(
+                        "The window must be open to set the rendering parameters. Use open_directly=True "
+                        "when constructing the window or instantiate it using the 'with' statement.");
+
+                MTWindow::EventsRenderingParameters params;
+                params.decay_time_us = decay_time_us;
+                params.palette       = palette;
+                mt_window_ptr->set_events_rendering_parameters(params);
+            },
+            "decay_time_us"_a = 20000, "palette"_a = ColorPalette::Dark,
+            pybind_doc_ui["Metavision::MTWindow::set_events_rendering_parameters"])
         .def(
             "__enter__",
             [](MTWindowWrapper &mt_window, py::args) {
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <sstream>
@@ -32,16 +33,22 @@
 
 #if defined(_WIN32)
 #include <conio.h>
+#else
+#include <poll.h>
+#include <unistd.h>
 #endif
 
 #include <metavision/hal/facilities/i_ll_biases.h>
 #include <metavision/sdk/base/events/event_cd.h>
+#include <metavision/sdk/core/utils/triple_buffer.h>
 #include <metavision/sdk/stream/camera.h>
 
 namespace {
 constexpr Metavision::timestamp kWindowUs = 2000;
 constexpr std::size_t kMaxQueueSize = 200;
 constexpr int kDisplayDelayMs = 1;
+constexpr int kCommandWaitMs = 100;
+constexpr int kConsolePollMs = 10;
 const char kWindowName[] = "EVS 2ms Accumulation";
 std::atomic<bool> *g_running = nullptr;
 
@@ -51,6 +58,54 @@ struct ChunkQueue {
     std::deque<std::vector<Metavision::EventCD>> queue;
 };
 
+// A key pressed in the window or on the console. Bias names typed on the console are passed as argument of 'n'.
+struct Command {
+    char key = 0;
+    std::optional<std::string> argument;
+};
+
+// Commands are executed by the control thread, so that slow operations (opening the camera, listing the biases...)
+// never stall the display nor the data path.
+struct CommandQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Command> queue;
+
+    void push(Command cmd) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(cmd));
+        }
+        cv.notify_one();
+    }
+
+    std::optional<Command> pop(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cv.wait_for(lock, timeout, [&]() { return !queue.empty(); })) {
+            return std::nullopt;
+        }
+        Command cmd = std::move(queue.front());
+        queue.pop_front();
+        return cmd;
+    }
+};
+
+// State shared between the control, consumer and display threads
+struct SharedState {
+    std::atomic<bool> running{true};
+    std::atomic<bool> camera_on{false};
+    std::atomic<bool> recording_enabled{false};
+    std::atomic<bool> verbose_logging{false};
+    std::atomic<bool> reset_requested{false};
+    std::atomic<bool> recording_reset_requested{false};
+    std::atomic<bool> bias_name_requested{false};
+    std::atomic<int> camera_width{0};
+    std::atomic<int> camera_height{0};
+
+    std::mutex output_mutex;
+    std::string output_dir;
+};
+
 struct BiasCliOptions {
     std::optional<int> bias_diff;
     std::optional<int> bias_diff_on;
@@ -65,6 +120,16 @@ struct BiasCliOptions {
     }
 };
 
+// State only accessed by the control thread
+struct ControlState {
+    std::unique_ptr<Metavision::Camera> camera;
+    Metavision::I_LL_Biases *biases = nullptr;
+    std::string selected_bias;
+    int bias_step_index = 0;
+    std::vector<int> step_options = {1, 5, 10, 20, 50};
+    BiasCliOptions bias_options;
+};
+
 void print_usage(const char *app_name) {
     std::cout << "Usage: " << app_name << " [options]\n"
               << "Options:\n"
@@ -143,8 +208,8 @@ bool parse_cli_options(int argc, char **argv, BiasCliOptions &options, bool &sho
     return true;
 }
 
-std::optional<char> poll_console_command() {
 #if defined(_WIN32)
+std::optional<char> poll_console_command() {
     if (_kbhit()) {
         int ch = _getch();
         if (ch == 0 || ch == 224) {
@@ -153,20 +218,14 @@ std::optional<char> poll_console_command() {
             }
             return std::nullopt;
         }
-        return static_cast<char>(ch);
-    }
-    return std::nullopt;
-#else
-    if (std::cin.rdbuf()->in_avail() > 0) {
-        char cmd = static_cast<char>(std::cin.get());
-        if (cmd == '\n' || cmd == '\r') {
+        if (ch == '\n' || ch == '\r') {
             return std::nullopt;
         }
-        return cmd;
+        return static_cast<char>(ch);
     }
     return std::nullopt;
-#endif
 }
+#endif
 
 std::string make_timestamped_output_dir() {
     auto now = std::chrono::system_clock::now();
@@ -422,18 +481,12 @@ void print_selected_bias(Metavision::I_LL_Biases *biases, const std::string &bia
     std::cout << "Selected bias: " << bias_name << " = " << it->second << " | step=" << step << std::endl;
 }
 
-void prompt_bias_name(Metavision::I_LL_Biases *biases, std::string &selected_bias) {
+void select_bias_by_name(Metavision::I_LL_Biases *biases, const std::string &name, std::string &selected_bias) {
     if (!biases) {
         std::cout << "이 디바이스는 bias 조절 미지원 (I_LL_Biases facility unavailable)." << std::endl;
         return;
     }
-    std::cout << "Enter bias name: " << std::flush;
-    std::string input;
-    if (!std::getline(std::cin, input)) {
-        std::cin.clear();
-        return;
-    }
-    input = trim_bias_name(input);
+    std::string input = trim_bias_name(name);
     if (input.empty()) {
         std::cout << "Bias name not changed (empty input)." << std::endl;
         return;
@@ -461,54 +514,35 @@ void adjust_step(int direction, int &step_index, const std::vector<int> &step_op
     std::cout << "Bias step set to " << step_options[step_index] << std::endl;
 }
 
-void handle_command(char cmd,
-                    std::unique_ptr<Metavision::Camera> &camera,
-                    Metavision::I_LL_Biases *&biases,
-                    std::atomic<bool> &camera_on,
-                    std::atomic<bool> &recording_enabled,
-                    std::atomic<bool> &verbose_logging,
-                    std::atomic<bool> &running,
-                    std::atomic<bool> &reset_requested,
-                    std::atomic<bool> &recording_reset_requested,
-                    std::mutex &output_mutex,
-                    std::string &output_dir,
-                    std::atomic<int> &camera_width,
-                    std::atomic<int> &camera_height,
-                    std::string &selected_bias,
-                    int &bias_step_index,
-                    const std::vector<int> &step_options,
-                    ChunkQueue &chunk_queue,
-                    BiasCliOptions &bias_options) {
-    switch (cmd) {
-    case 'o':
-    case 'O': {
-        if (camera_on.load()) {
-            std::cout << "Camera already ON." << std::endl;
-            return;
-        }
-        try {
-            camera = std::make_unique<Metavision::Camera>(Metavision::Camera::from_first_available());
-        } catch (const std::exception &e) {
-            std::cerr << "Failed to open camera: " << e.what() << std::endl;
-            return;
-        }
-        camera_width.store(camera->geometry().get_width());
-        camera_height.store(camera->geometry().get_height());
-        camera_on.store(true);
-        reset_requested.store(true);
-        biases = camera->get_device().get_facility<Metavision::I_LL_Biases>();
-        selected_bias.clear();
-        if (!biases) {
-            std::cout << "이 디바이스는 bias 조절 미지원 (I_LL_Biases facility unavailable)." << std::endl;
-        }
-        apply_bias_settings(biases, bias_options);
-        if (bias_options.print_bias_on_open) {
-            print_bias_values(biases);
-            bias_options.print_bias_on_open = false;
-        }
-        camera->cd().add_callback([&chunk_queue, &camera_on, &running](const Metavision::EventCD *begin,
-                                                                       const Metavision::EventCD *end) {
-            if (!camera_on.load() || !running.load()) {
+
+void open_camera(ControlState &control, SharedState &shared, ChunkQueue &chunk_queue) {
+    if (shared.camera_on.load()) {
+        std::cout << "Camera already ON." << std::endl;
+        return;
+    }
+    try {
+        control.camera = std::make_unique<Metavision::Camera>(Metavision::Camera::from_first_available());
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to open camera: " << e.what() << std::endl;
+        return;
+    }
+    shared.camera_width.store(control.camera->geometry().get_width());
+    shared.camera_height.store(control.camera->geometry().get_height());
+    shared.camera_on.store(true);
+    shared.reset_requested.store(true);
+    control.biases = control.camera->get_device().get_facility<Metavision::I_LL_Biases>();
+    control.selected_bias.clear();
+    if (!control.biases) {
+        std::cout << "이 디바이스는 bias 조절 미지원 (I_LL_Biases facility unavailable)." << std::endl;
+    }
+    apply_bias_settings(control.biases, control.bias_options);
+    if (control.bias_options.print_bias_on_open) {
+        print_bias_values(control.biases);
+        control.bias_options.print_bias_on_open = false;
+    }
+    control.camera->cd().add_callback(
+        [&chunk_queue, &shared](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
+            if (!shared.camera_on.load() || !shared.running.load()) {
                 return;
             }
             std::vector<Metavision::EventCD> chunk(begin, end);
@@ -517,44 +551,59 @@ void handle_command(char cmd,
             }
             std::unique_lock<std::mutex> lock(chunk_queue.mutex);
             chunk_queue.cv.wait(lock, [&]() {
-                return !running.load() || !camera_on.load() || chunk_queue.queue.size() < kMaxQueueSize;
+                return !shared.running.load() || !shared.camera_on.load() || chunk_queue.queue.size() < kMaxQueueSize;
             });
-            if (!running.load() || !camera_on.load()) {
+            if (!shared.running.load() || !shared.camera_on.load()) {
                 return;
             }
             chunk_queue.queue.push_back(std::move(chunk));
             lock.unlock();
             chunk_queue.cv.notify_one();
         });
-        camera->start();
-        std::cout << "Camera ON. Resolution: " << camera_width.load() << "x" << camera_height.load() << std::endl;
+    control.camera->start();
+    std::cout << "Camera ON. Resolution: " << shared.camera_width.load() << "x" << shared.camera_height.load()
+              << std::endl;
+}
+
+void close_camera(ControlState &control, SharedState &shared, ChunkQueue &chunk_queue) {
+    if (!shared.camera_on.load()) {
+        std::cout << "Camera already OFF." << std::endl;
+        return;
+    }
+    shared.camera_on.store(false);
+    // Wakes up the camera callback if it waits for room in the queue
+    chunk_queue.cv.notify_all();
+    if (control.camera) {
+        control.camera->stop();
+        control.camera.reset();
+    }
+    control.biases = nullptr;
+    control.selected_bias.clear();
+    {
+        std::lock_guard<std::mutex> lock(chunk_queue.mutex);
+        chunk_queue.queue.clear();
+    }
+    chunk_queue.cv.notify_all();
+    shared.reset_requested.store(true);
+    std::cout << "Camera OFF." << std::endl;
+}
+
+void handle_command(const Command &cmd, ControlState &control, SharedState &shared, ChunkQueue &chunk_queue) {
+    const auto &step_options = control.step_options;
+    switch (cmd.key) {
+    case 'o':
+    case 'O': {
+        open_camera(control, shared, chunk_queue);
         return;
     }
     case 'f':
     case 'F': {
-        if (!camera_on.load()) {
-            std::cout << "Camera already OFF." << std::endl;
-            return;
-        }
-        camera_on.store(false);
-        if (camera) {
-            camera->stop();
-            camera.reset();
-        }
-        biases = nullptr;
-        selected_bias.clear();
-        {
-            std::lock_guard<std::mutex> lock(chunk_queue.mutex);
-            chunk_queue.queue.clear();
-        }
-        chunk_queue.cv.notify_all();
-        reset_requested.store(true);
-        std::cout << "Camera OFF." << std::endl;
+        close_camera(control, shared, chunk_queue);
         return;
     }
     case 's':
     case 'S': {
-        if (recording_enabled.load()) {
+        if (shared.recording_enabled.load()) {
             std::cout << "Recording already ON." << std::endl;
             return;
         }
@@ -566,82 +615,89 @@ void handle_command(char cmd,
             return;
         }
         {
-            std::lock_guard<std::mutex> lock(output_mutex);
-            output_dir = std::move(new_dir);
+            std::lock_guard<std::mutex> lock(shared.output_mutex);
+            shared.output_dir = new_dir;
         }
-        recording_reset_requested.store(true);
-        recording_enabled.store(true);
-        std::cout << "Recording ON. Output dir: " << output_dir << std::endl;
+        shared.recording_reset_requested.store(true);
+        shared.recording_enabled.store(true);
+        std::cout << "Recording ON. Output dir: " << new_dir << std::endl;
         return;
     }
     case 'e':
     case 'E': {
-        if (!recording_enabled.load()) {
+        if (!shared.recording_enabled.load()) {
             std::cout << "Recording already OFF." << std::endl;
             return;
         }
-        recording_enabled.store(false);
+        shared.recording_enabled.store(false);
         std::cout << "Recording OFF." << std::endl;
         return;
     }
     case 'q':
     case 'Q': {
-        running.store(false);
+        shared.running.store(false);
         chunk_queue.cv.notify_all();
         std::cout << "Exit requested." << std::endl;
         return;
     }
     case 'v':
     case 'V': {
-        bool next = !verbose_logging.load();
-        verbose_logging.store(next);
+        bool next = !shared.verbose_logging.load();
+        shared.verbose_logging.store(next);
         std::cout << "[INFO] Verbose logging " << (next ? "ON" : "OFF") << std::endl;
         return;
     }
     case 'b':
     case 'B': {
-        if (!camera_biases_ready(camera_on, biases)) {
+        if (!camera_biases_ready(shared.camera_on, control.biases)) {
             return;
         }
-        list_biases(biases, cmd == 'B', selected_bias, step_options[bias_step_index], step_options);
+        list_biases(control.biases, cmd.key == 'B', control.selected_bias, step_options[control.bias_step_index],
+                    step_options);
         return;
     }
     case 'n':
     case 'N': {
-        if (!camera_biases_ready(camera_on, biases)) {
+        if (!camera_biases_ready(shared.camera_on, control.biases)) {
             return;
         }
-        prompt_bias_name(biases, selected_bias);
+        if (!cmd.argument) {
+            // The name is read by the console thread, the next line typed being passed back as argument
+            std::cout << "Enter bias name: " << std::flush;
+            shared.bias_name_requested.store(true);
+            return;
+        }
+        select_bias_by_name(control.biases, *cmd.argument, control.selected_bias);
         return;
     }
     case '+': {
-        if (!camera_biases_ready(camera_on, biases)) {
+        if (!camera_biases_ready(shared.camera_on, control.biases)) {
             return;
         }
-        adjust_bias(biases, selected_bias, step_options[bias_step_index]);
+        adjust_bias(control.biases, control.selected_bias, step_options[control.bias_step_index]);
         return;
     }
     case '-': {
-        if (!camera_biases_ready(camera_on, biases)) {
+        if (!camera_biases_ready(shared.camera_on, control.biases)) {
             return;
         }
-        adjust_bias(biases, selected_bias, -step_options[bias_step_index]);
+        adjust_bias(control.biases, control.selected_bias, -step_options[control.bias_step_index]);
         return;
     }
     case ']': {
-        adjust_step(1, bias_step_index, step_options);
+        adjust_step(1, control.bias_step_index, step_options);
         return;
     }
     case '[': {
-        adjust_step(-1, bias_step_index, step_options);
+        adjust_step(-1, control.bias_step_index, step_options);
         return;
     }
     case 'p':
     case 'P': {
-        if (!camera_biases_ready(camera_on, biases)) {
+        if (!camera_biases_ready(shared.camera_on, control.biases)) {
             return;
         }
-        print_selected_bias(biases, selected_bias, step_options[bias_step_index]);
+        print_selected_bias(control.biases, control.selected_bias, step_options[control.bias_step_index]);
         return;
     }
     default:
@@ -649,161 +705,242 @@ void handle_command(char cmd,
     }
 }
 
-} // namespace
-
-int main(int argc, char **argv) {
-    BiasCliOptions bias_options;
-    bool show_help = false;
-    if (!parse_cli_options(argc, argv, bias_options, show_help)) {
-        if (show_help) {
-            return 0;
+// Executes the commands one after the other until exit is requested, then releases the camera
+void control_loop(ControlState &control, SharedState &shared, CommandQueue &commands, ChunkQueue &chunk_queue) {
+    while (shared.running.load()) {
+        auto cmd = commands.pop(std::chrono::milliseconds(kCommandWaitMs));
+        if (!cmd) {
+            continue;
         }
-        if (argc > 1) {
-            print_usage(argv[0]);
-            return 1;
+        try {
+            handle_command(*cmd, control, shared, chunk_queue);
+        } catch (const std::exception &e) {
+            std::cerr << "Command '" << cmd->key << "' failed: " << e.what() << std::endl;
         }
     }
-    std::atomic<bool> verbose_logging{bias_options.verbose_logging};
 
-    std::atomic<bool> running{true};
-    std::atomic<bool> camera_on{false};
-    std::atomic<bool> recording_enabled{false};
-    std::atomic<bool> reset_requested{false};
-    std::atomic<bool> recording_reset_requested{false};
-    std::atomic<int> camera_width{0};
-    std::atomic<int> camera_height{0};
-
-    std::mutex output_mutex;
-    std::string output_dir;
-
-    ChunkQueue chunk_queue;
-
-    std::mutex frame_mutex;
-    cv::Mat latest_frame;
+    if (shared.camera_on.load()) {
+        close_camera(control, shared, chunk_queue);
+    }
+}
 
-    g_running = &running;
-    std::signal(SIGINT, [](int) {
-        if (g_running) {
-            g_running->store(false);
+// Forwards the console input to the control thread. The console is polled with a timeout and never read in a blocking
+// way, so that the thread notices the end of the program and can be joined on exit.
+void console_loop(SharedState &shared, CommandQueue &commands) {
+#if defined(_WIN32)
+    std::string name;
+    bool reading_name = false;
+    while (shared.running.load()) {
+        reading_name = reading_name || shared.bias_name_requested.exchange(false);
+        if (!_kbhit()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kConsolePollMs));
+            continue;
         }
-    });
-
-    std::unique_ptr<Metavision::Camera> camera;
-    Metavision::I_LL_Biases *biases = nullptr;
-    std::string selected_bias;
-    int bias_step_index = 0;
-    std::vector<int> step_options = {1, 5, 10, 20, 50};
-
-    std::thread consumer_thread([&]() {
-        std::optional<Metavision::timestamp> window_start;
-        Metavision::timestamp window_end = 0;
-        std::vector<Metavision::EventCD> window_events;
-        cv::Mat current_frame;
-        std::size_t frame_index = 0;
-        std::size_t recording_frame_index = 0;
-        bool window_recording = false;
-
-        while (running.load()) {
-            if (reset_requested.exchange(false)) {
-                window_start.reset();
-                window_events.clear();
-                current_frame.release();
-                frame_index = 0;
-                recording_frame_index = 0;
+        if (!reading_name) {
+            if (auto cmd = poll_console_command()) {
+                commands.push({*cmd, std::nullopt});
             }
-            if (recording_reset_requested.exchange(false)) {
-                recording_frame_index = 0;
+            continue;
+        }
+        int ch = _getch();
+        if (ch == '\r' || ch == '\n') {
+            std::cout << std::endl;
+            commands.push({'n', name});
+            name.clear();
+            reading_name = false;
+        } else if (ch == '\b') {
+            if (!name.empty()) {
+                name.pop_back();
+                std::cout << "\b \b" << std::flush;
             }
+        } else if (ch != 0 && ch != 224) {
+            name.push_back(static_cast<char>(ch));
+            std::cout << static_cast<char>(ch) << std::flush;
+        }
+    }
+#else
+    // stdin is read directly rather than through std::cin, whose getline would block on a partially typed line
+    std::string pending;
+    while (shared.running.load()) {
+        pollfd stdin_fd{STDIN_FILENO, POLLIN, 0};
+        if (poll(&stdin_fd, 1, kConsolePollMs) <= 0) {
+            continue;
+        }
+        char buffer[256];
+        const ssize_t num_read = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (num_read <= 0) {
+            // End of input, or error: commands can still be typed in the display window
+            break;
+        }
+        pending.append(buffer, static_cast<std::size_t>(num_read));
 
-            std::vector<Metavision::EventCD> chunk;
-            {
-                std::unique_lock<std::mutex> lock(chunk_queue.mutex);
-                chunk_queue.cv.wait(lock, [&]() { return !running.load() || !chunk_queue.queue.empty(); });
-                if (!running.load()) {
-                    break;
-                }
-                if (chunk_queue.queue.empty()) {
-                    continue;
+        std::size_t line_end;
+        while ((line_end = pending.find('\n')) != std::string::npos) {
+            const std::string line = pending.substr(0, line_end);
+            pending.erase(0, line_end + 1);
+            if (shared.bias_name_requested.exchange(false)) {
+                commands.push({'n', line});
+                continue;
+            }
+            for (char key : line) {
+                if (key != '\r') {
+                    commands.push({key, std::nullopt});
                 }
-                chunk = std::move(chunk_queue.queue.front());
-                chunk_queue.queue.pop_front();
             }
-            chunk_queue.cv.notify_one();
+        }
+    }
+#endif
+}
 
-            if (chunk.empty()) {
+// Accumulates the events of the data path into 2ms frames, records them if requested and publishes them for display
+void consumer_loop(SharedState &shared, ChunkQueue &chunk_queue, Metavision::TripleBuffer<cv::Mat> &frames) {
+    std::optional<Metavision::timestamp> window_start;
+    Metavision::timestamp window_end = 0;
+    std::vector<Metavision::EventCD> window_events;
+    // Frames are directly accumulated in the write buffer of the exchange with the display
+    cv::Mat *current_frame = nullptr;
+    cv::Size frame_size;
+    std::size_t frame_index = 0;
+    std::size_t recording_frame_index = 0;
+    bool window_recording = false;
+
+    while (shared.running.load()) {
+        if (shared.reset_requested.exchange(false)) {
+            window_start.reset();
+            window_events.clear();
+            current_frame = nullptr;
+            frame_index = 0;
+            recording_frame_index = 0;
+        }
+        if (shared.recording_reset_requested.exchange(false)) {
+            recording_frame_index = 0;
+        }
+
+        std::vector<Metavision::EventCD> chunk;
+        {
+            std::unique_lock<std::mutex> lock(chunk_queue.mutex);
+            chunk_queue.cv.wait(lock, [&]() { return !shared.running.load() || !chunk_queue.queue.empty(); });
+            if (!shared.running.load()) {
+                break;
+            }
+            if (chunk_queue.queue.empty()) {
                 continue;
             }
+            chunk = std::move(chunk_queue.queue.front());
+            chunk_queue.queue.pop_front();
+        }
+        chunk_queue.cv.notify_one();
 
-            for (const auto &ev : chunk) {
-                if (!window_start) {
-                    int width = camera_width.load();
-                    int height = camera_height.load();
-                    if (width <= 0 || height <= 0) {
-                        continue;
-                    }
-                    current_frame = cv::Mat(height, width, CV_8UC1, cv::Scalar(0));
-                    window_events.clear();
-                    window_start = ev.t;
-                    window_end = *window_start + kWindowUs;
-                    window_recording = recording_enabled.load();
-                }
+        if (chunk.empty()) {
+            continue;
+        }
 
-                while (ev.t >= window_end) {
-                    if (window_start) {
-                        if (window_recording) {
-                            std::string dir_copy;
-                            {
-                                std::lock_guard<std::mutex> lock(output_mutex);
-                                dir_copy = output_dir;
-                            }
-                            if (!dir_copy.empty()) {
-                                ++recording_frame_index;
-                                std::ostringstream filename;
-                                filename << dir_copy << "/frame_" << std::setw(6) << std::setfill('0')
-                                         << recording_frame_index << "_t0_" << *window_start << "us.txt";
-                                std::ofstream out(filename.str());
-                                for (const auto &evt : window_events) {
-                                    out << evt.x << " " << evt.y << "\n";
-                                }
-                            }
-                        }
+        for (const auto &ev : chunk) {
+            if (!window_start) {
+                int width = shared.camera_width.load();
+                int height = shared.camera_height.load();
+                if (width <= 0 || height <= 0) {
+                    continue;
+                }
+                frame_size = cv::Size(width, height);
+                current_frame = &frames.write_buffer();
+                current_frame->create(frame_size, CV_8UC1);
+                current_frame->setTo(0);
+                window_events.clear();
+                window_start = ev.t;
+                window_end = *window_start + kWindowUs;
+                window_recording = shared.recording_enabled.load();
+            }
 
+            while (ev.t >= window_end) {
+                if (window_start) {
+                    if (window_recording) {
+                        std::string dir_copy;
                         {
-                            std::lock_guard<std::mutex> lock(frame_mutex);
-                            latest_frame = current_frame.clone();
+                            std::lock_guard<std::mutex> lock(shared.output_mutex);
+                            dir_copy = shared.output_dir;
                         }
-
-                        std::size_t queue_size = 0;
-                        {
-                            std::lock_guard<std::mutex> lock(chunk_queue.mutex);
-                            queue_size = chunk_queue.queue.size();
+                        if (!dir_copy.empty()) {
+                            ++recording_frame_index;
+                            std::ostringstream filename;
+                            filename << dir_copy << "/frame_" << std::setw(6) << std::setfill('0')
+                                     << recording_frame_index << "_t0_" << *window_start << "us.txt";
+                            std::ofstream out(filename.str());
+                            for (const auto &evt : window_events) {
+                                out << evt.x << " " << evt.y << "\n";
+                            }
                         }
+                    }
 
-                        if (verbose_logging.load()) {
-                            std::cout << "Frame " << frame_index << " t0=" << *window_start << "us | queue="
-                                      << queue_size << " | recording=" << (window_recording ? "ON" : "OFF")
-                                      << std::endl;
-                        }
+                    // The frame is handed over without copy, and a buffer released by the display is reused for the
+                    // next one
+                    frames.publish();
+                    current_frame = &frames.write_buffer();
+                    current_frame->create(frame_size, CV_8UC1);
+
+                    std::size_t queue_size = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(chunk_queue.mutex);
+                        queue_size = chunk_queue.queue.size();
                     }
 
-                    ++frame_index;
-                    window_start = window_end;
-                    window_end = *window_start + kWindowUs;
-                    current_frame.setTo(0);
-                    window_events.clear();
-                    window_recording = recording_enabled.load();
+                    if (shared.verbose_logging.load()) {
+                        std::cout << "Frame " << frame_index << " t0=" << *window_start << "us | queue=" << queue_size
+                                  << " | recording=" << (window_recording ? "ON" : "OFF") << std::endl;
+                    }
                 }
 
-                if (ev.x < current_frame.cols && ev.y < current_frame.rows) {
-                    current_frame.at<std::uint8_t>(ev.y, ev.x) = 255;
-                }
-                if (window_recording) {
-                    window_events.push_back(ev);
-                }
+                ++frame_index;
+                window_start = window_end;
+                window_end = *window_start + kWindowUs;
+                current_frame->setTo(0);
+                window_events.clear();
+                window_recording = shared.recording_enabled.load();
+            }
+
+            if (ev.x < current_frame->cols && ev.y < current_frame->rows) {
+                current_frame->at<std::uint8_t>(ev.y, ev.x) = 255;
+            }
+            if (window_recording) {
+                window_events.push_back(ev);
             }
         }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    ControlState control;
+    bool show_help = false;
+    if (!parse_cli_options(argc, argv, control.bias_options, show_help)) {
+        if (show_help) {
+            return 0;
+        }
+        if (argc > 1) {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    SharedState shared;
+    shared.verbose_logging.store(control.bias_options.verbose_logging);
+
+    ChunkQueue chunk_queue;
+    CommandQueue commands;
+    Metavision::TripleBuffer<cv::Mat> frames;
+
+    g_running = &shared.running;
+    std::signal(SIGINT, [](int) {
+        if (g_running) {
+            g_running->store(false);
+        }
     });
 
+    std::thread consumer_thread([&]() { consumer_loop(shared, chunk_queue, frames); });
+    std::thread control_thread([&]() { control_loop(control, shared, commands, chunk_queue); });
+    std::thread console_thread([&]() { console_loop(shared, commands); });
+
     cv::namedWindow(kWindowName, cv::WINDOW_NORMAL);
     std::cout
         << "Commands: o(Camera ON), f(Camera OFF), s(Record START), e(Record END), v(Verbose log ON/OFF), "
@@ -811,51 +948,33 @@ int main(int argc, char **argv) {
            "q(Quit)"
         << std::endl;
 
-    if (bias_options.has_bias_values() || bias_options.print_bias_on_open) {
-        handle_command('o', camera, biases, camera_on, recording_enabled, verbose_logging, running, reset_requested,
-                       recording_reset_requested, output_mutex, output_dir, camera_width, camera_height, selected_bias,
-                       bias_step_index, step_options, chunk_queue, bias_options);
+    if (control.bias_options.has_bias_values() || control.bias_options.print_bias_on_open) {
+        commands.push({'o', std::nullopt});
     }
 
-    while (running.load()) {
-        cv::Mat frame_copy;
-        {
-            std::lock_guard<std::mutex> lock(frame_mutex);
-            if (!latest_frame.empty()) {
-                frame_copy = latest_frame.clone();
-            }
-        }
-        if (!frame_copy.empty()) {
-            cv::imshow(kWindowName, frame_copy);
+    // The display thread only shows the latest frame and forwards the keys pressed in the window
+    while (shared.running.load()) {
+        if (frames.update() && !frames.read_buffer().empty()) {
+            cv::imshow(kWindowName, frames.read_buffer());
         }
 
         int key = cv::waitKey(kDisplayDelayMs);
-        if (key == 'q' || key == 'Q') {
-            handle_command('q', camera, biases, camera_on, recording_enabled, verbose_logging, running, reset_requested,
-                           recording_reset_requested, output_mutex, output_dir, camera_width, camera_height,
-                           selected_bias, bias_step_index, step_options, chunk_queue, bias_options);
-        } else if (key > 0) {
-            handle_command(static_cast<char>(key), camera, biases, camera_on, recording_enabled, verbose_logging, running,
-                           reset_requested, recording_reset_requested, output_mutex, output_dir, camera_width,
-                           camera_height, selected_bias, bias_step_index, step_options, chunk_queue, bias_options);
-        }
-
-        if (auto cmd = poll_console_command()) {
-            handle_command(*cmd, camera, biases, camera_on, recording_enabled, verbose_logging, running, reset_requested,
-                           recording_reset_requested, output_mutex, output_dir, camera_width, camera_height,
-                           selected_bias, bias_step_index, step_options, chunk_queue, bias_options);
+        if (key > 0) {
+            commands.push({static_cast<char>(key), std::nullopt});
         }
     }
 
-    if (camera_on.load() && camera) {
-        camera->stop();
-        camera.reset();
+    chunk_queue.cv.notify_all();
+    if (control_thread.joinable()) {
+        control_thread.join();
     }
-
     chunk_queue.cv.notify_all();
     if (consumer_thread.joinable()) {
         consumer_thread.join();
     }
+    if (console_thread.joinable()) {
+        console_thread.join();
+    }
 
     cv::destroyAllWindows();
 
@@ -12,6 +12,9 @@
 #ifndef METAVISION_UTILS_PYBIND_ASYNC_ALGORITHM_PROCESS_HELPER_H
 #define METAVISION_UTILS_PYBIND_ASYNC_ALGORITHM_PROCESS_HELPER_H
 
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
 #include "metavision/utils/pybind/pod_event_buffer.h"
 
 namespace Metavision {
@@ -28,6 +31,8 @@ static const char doc_process_events_array_ts_async_str[] =
     "mandatory"
     "   :ts: array of events' timestamp";
 
+// The GIL is released while the algorithm processes the events, so the output callbacks of the algorithms exported with
+// these helpers must acquire it before calling back into python
 template<typename Algo, typename InputEvent>
 void process_events_array_async(Algo &algo, const py::array_t<InputEvent> &in) {
     auto info = in.request();
@@ -37,6 +42,7 @@ void process_events_array_async(Algo &algo, const py::array_t<InputEvent> &in) {
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<InputEvent *>(info.ptr);
 
+    py::gil_scoped_release release;
     algo.process_events(in_ptr, in_ptr + nelem);
 }
 
@@ -49,6 +55,7 @@ void process_events_array_ts_async(Algo &algo, const py::array_t<InputEvent> &in
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<InputEvent *>(info.ptr);
 
+    py::gil_scoped_release release;
     algo.process_events(in_ptr, in_ptr + nelem, ts);
 }
 
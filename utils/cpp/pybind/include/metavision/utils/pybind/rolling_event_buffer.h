@@ -12,11 +12,15 @@
 #ifndef METAVISION_UTILS_PYBIND_ROLLING_EVENT_BUFFER_H
 #define METAVISION_UTILS_PYBIND_ROLLING_EVENT_BUFFER_H
 
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "metavision/sdk/base/utils/python_bindings_doc.h"
 #include "metavision/sdk/core/utils/rolling_event_buffer.h"
+#include "metavision/utils/pybind/pod_event_buffer.h"
 
 namespace py = pybind11;
 
@@ -29,6 +33,115 @@ static const char doc_insert_buffer_str[] = "This function inserts events from a
                                             "based on the current mode (N_US or N_EVENTS)\n"
                                             "    :input_buf: input chunk of events\n";
 
+static const char doc_views_str[] =
+    "This function returns the events of the buffer as a list of at most two read-only numpy arrays sharing the "
+    "buffer's memory (no copy is done). The second array is only returned when the rolling window wraps around the "
+    "end of the internal storage, concatenating the arrays gives the events in chronological order.\n"
+    "The arrays are a snapshot of the buffer: they keep the events of the time of the call. The buffer can be "
+    "modified while they are alive, its content is then copied once, by the first call to insert_events() or clear(), "
+    "and the arrays keep the memory they point to. Delete the arrays (or let them go out of scope) before modifying "
+    "the buffer to avoid this copy.\n";
+
+static const char doc_epoch_str[] = "This function returns a counter that is incremented every time the content of the "
+                                    "buffer is modified. It can be used to cheaply check whether the buffer has changed "
+                                    "since the last poll.\n";
+
+namespace detail {
+
+/// @brief Memory of a rolling buffer referenced by the numpy arrays returned by @ref rolling_event_buffer_views
+template<typename T>
+struct RollingEventBufferPin {
+    explicit RollingEventBufferPin(std::shared_ptr<RollingEventBuffer<T>> b) : buffer(std::move(b)) {}
+
+    ~RollingEventBufferPin();
+
+    /// Buffer whose memory is referenced, until it is modified
+    std::shared_ptr<RollingEventBuffer<T>> buffer;
+    /// Memory moved out of the buffer when it was modified while the arrays were alive
+    std::unique_ptr<RollingEventBuffer<T>> storage;
+};
+
+/// @brief Returns the pin of each rolling buffer whose memory is referenced by numpy arrays
+///
+/// Only accessed with the GIL held
+inline std::unordered_map<const void *, std::weak_ptr<void>> &rolling_event_buffer_pins() {
+    static std::unordered_map<const void *, std::weak_ptr<void>> pins;
+    return pins;
+}
+
+template<typename T>
+RollingEventBufferPin<T>::~RollingEventBufferPin() {
+    if (buffer) {
+        rolling_event_buffer_pins().erase(buffer.get());
+    }
+}
+
+/// @brief Returns the pin shared by the arrays referencing the current memory of a rolling buffer
+template<typename T>
+std::shared_ptr<RollingEventBufferPin<T>>
+    pin_rolling_event_buffer(const std::shared_ptr<RollingEventBuffer<T>> &buffer) {
+    auto &weak_pin = rolling_event_buffer_pins()[buffer.get()];
+    auto pin       = std::static_pointer_cast<RollingEventBufferPin<T>>(weak_pin.lock());
+    if (!pin) {
+        pin      = std::make_shared<RollingEventBufferPin<T>>(buffer);
+        weak_pin = pin;
+    }
+    return pin;
+}
+
+/// @brief Gives the memory of a rolling buffer to the numpy arrays still referencing it, if any, before modifying it
+///
+/// The memory is moved to the pin of the arrays and the buffer continues with a copy of its content, unless it is
+/// about to be cleared.
+template<typename T>
+void unpin_rolling_event_buffer(RollingEventBuffer<T> &buffer, bool keep_content = true) {
+    auto &pins = rolling_event_buffer_pins();
+    auto it    = pins.find(&buffer);
+    if (it == pins.end()) {
+        return;
+    }
+    auto pin = std::static_pointer_cast<RollingEventBufferPin<T>>(it->second.lock());
+    pins.erase(it);
+    if (pin) {
+        // moving the buffer keeps its memory, hence the arrays, valid
+        pin->storage = std::make_unique<RollingEventBuffer<T>>(std::move(buffer));
+        if (keep_content) {
+            buffer = *pin->storage;
+        } else {
+            // the configuration is kept by the move, clearing restores a valid empty buffer
+            buffer.clear();
+        }
+        pin->buffer.reset();
+    }
+}
+
+} // namespace detail
+
+template<typename T>
+py::list rolling_event_buffer_views(const std::shared_ptr<RollingEventBuffer<T>> &buffer) {
+    py::list views;
+    if (buffer->empty()) {
+        return views;
+    }
+
+    // the capsule is shared by the arrays, the memory is released when the last one is garbage collected
+    auto pin = new std::shared_ptr<detail::RollingEventBufferPin<T>>(detail::pin_rolling_event_buffer(buffer));
+    py::capsule capsule(pin, [](void *p) {
+        delete reinterpret_cast<std::shared_ptr<detail::RollingEventBufferPin<T>> *>(p);
+    });
+
+    for (const auto &span : buffer->contiguous_spans()) {
+        if (span.size == 0) {
+            continue;
+        }
+        py::array_t<T> view(span.size, span.data, capsule);
+        py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+        views.append(std::move(view));
+    }
+
+    return views;
+}
+
 template<typename T>
 void insert_numpy_array(RollingEventBuffer<T> &buffer, const py::array_t<T> &in) {
     auto info = in.request();
@@ -38,11 +151,13 @@ void insert_numpy_array(RollingEventBuffer<T> &buffer, const py::array_t<T> &in)
     auto nelem   = static_cast<size_t>(info.shape[0]);
     auto *in_ptr = static_cast<T *>(info.ptr);
 
+    detail::unpin_rolling_event_buffer(buffer);
     buffer.insert_events(in_ptr, in_ptr + nelem);
 }
 
 template<typename T>
 void insert_buffer(RollingEventBuffer<T> &buffer, const PODEventBuffer<T> &in) {
+    detail::unpin_rolling_event_buffer(buffer);
     buffer.insert_events(in.buffer_.cbegin(), in.buffer_.cend());
 }
 
@@ -57,7 +172,15 @@ void export_rolling_event_buffer(py::module &m, const std::string &event_buffer_
         .def("size", &RollingEventBuffer::size, doc["Metavision::RollingEventBuffer::size"])
         .def("capacity", &RollingEventBuffer::capacity, doc["Metavision::RollingEventBuffer::capacity"])
         .def("empty", &RollingEventBuffer::empty, doc["Metavision::RollingEventBuffer::empty"])
-        .def("clear", &RollingEventBuffer::clear, doc["Metavision::RollingEventBuffer::clear"])
+        .def(
+            "clear",
+            [](RollingEventBuffer &b) {
+                detail::unpin_rolling_event_buffer(b, false);
+                b.clear();
+            },
+            doc["Metavision::RollingEventBuffer::clear"])
+        .def("epoch", &RollingEventBuffer::epoch, doc_epoch_str)
+        .def("views", &rolling_event_buffer_views<EventType>, doc_views_str)
         .def(
             "__iter__", [](const RollingEventBuffer &b) { return py::make_iterator(b.cbegin(), b.cend()); },
             py::keep_alive<0, 1>())
@@ -12,8 +12,12 @@
 #ifndef METAVISION_UTILS_PYBIND_SYNC_ALGORITHM_PROCESS_HELPER_H
 #define METAVISION_UTILS_PYBIND_SYNC_ALGORITHM_PROCESS_HELPER_H
 
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
 #include "metavision/sdk/core/utils/rolling_event_buffer.h"
 #include "metavision/utils/pybind/pod_event_buffer.h"
+#include "metavision/utils/pybind/rolling_event_buffer.h"
 
 namespace Metavision {
 
@@ -42,6 +46,8 @@ static const char doc_process_events_buffer_sync_inplace_str[] =
     "   :events_buf: Buffer of events used as input/output. Its content will be overwritten. "
     "It can be converted to a numpy structured array using .numpy()";
 
+// The GIL is released while the algorithm processes the events. The buffer info of the input arrays is kept alive in the
+// meantime, which prevents numpy from resizing them, and is only released once the GIL has been reacquired.
 template<typename Algo, typename InputEvent, typename OutputEvent = InputEvent>
 void process_events_array_sync(Algo &algo, const py::array_t<InputEvent> &in, PODEventBuffer<OutputEvent> &out) {
     auto info = in.request();
@@ -59,6 +65,7 @@ void process_events_array_sync(Algo &algo, const py::array_t<InputEvent> &in, PO
 
     out.buffer_.clear();
 
+    py::gil_scoped_release release;
     algo.process_events(in_ptr, in_ptr + nelem, std::back_inserter(out.buffer_));
 }
 
@@ -71,15 +78,19 @@ void process_events_buffer_sync(Algo &algo, const PODEventBuffer<InputEvent> &in
     }
     out.buffer_.clear();
 
+    py::gil_scoped_release release;
     algo.process_events(in.buffer_.cbegin(), in.buffer_.cend(), std::back_inserter(out.buffer_));
 }
 
 template<typename Algo, typename InputEvent, typename OutputEvent = InputEvent>
-void process_events_rolling_buffer_sync(Algo &algo, const RollingEventBuffer<InputEvent> &in,
+void process_events_rolling_buffer_sync(Algo &algo, const std::shared_ptr<RollingEventBuffer<InputEvent>> &in,
                                         PODEventBuffer<OutputEvent> &out) {
     out.buffer_.clear();
 
-    algo.process_events(in.cbegin(), in.cend(), std::back_inserter(out.buffer_));
+    // the read lock prevents other python threads from modifying the rolling buffer while the GIL is released
+    detail::RollingEventBufferReadLock<InputEvent> lock(in);
+    py::gil_scoped_release release;
+    algo.process_events(in->cbegin(), in->cend(), std::back_inserter(out.buffer_));
 }
 
 // This should only be used when the number of output events is the same as the number of input events
@@ -92,12 +103,14 @@ void process_events_array_sync_inplace(Algo &algo, py::array_t<InputEvent> &even
     auto nelem    = static_cast<size_t>(info.shape[0]);
     auto *buf_ptr = static_cast<InputEvent *>(info.ptr);
 
+    py::gil_scoped_release release;
     algo.process_events(buf_ptr, buf_ptr + nelem, buf_ptr);
 }
 
 // This should only be used when the number of output events is equal or smaller as the number of input events
 template<typename Algo, typename InputEvent>
 void process_events_buffer_sync_inplace(Algo &algo, PODEventBuffer<InputEvent> &buf) {
+    py::gil_scoped_release release;
     auto it_end = algo.process_events(buf.buffer_.cbegin(), buf.buffer_.cend(), buf.buffer_.begin());
     buf.buffer_.resize(std::distance(buf.buffer_.begin(), it_end));
 }